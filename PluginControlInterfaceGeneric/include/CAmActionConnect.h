@@ -81,6 +81,9 @@
  *                                 The connection format for the connection. Predefined values are:
  *                                 CF_GENIVI_MONO, CF_GENIVI_STEREO, CF_GENIVI_ANALOG and CF_GENIVI_AUTO.
  *                                 Optionally projects can define more formats.
+ *  + __parallel__ (bool):         If TRUE, the route segments of a main connection are connected in
+ *                                 parallel instead of one after the other. The source states are set
+ *                                 after all segments have been established. Defaults to FALSE.
  *  + __timeOut__ (uint32):        This is the maximum duration, specified in milliseconds, the execution
  *                                 may take before an error action is started.  
  *                                 Defaults to [DEFAULT_ASYNC_ACTION_TIME](@ref am::gc::DEFAULT_ASYNC_ACTION_TIME).
@@ -171,6 +174,7 @@ private:
     CAmActionParam<std::vector<std::string > >   mExceptClassParam;
     CAmActionParam<gc_Order_e >                  mOrderParam;
     CAmActionParam<am_CustomConnectionFormat_t > mConnectionFormatParam;
+    CAmActionParam<bool >                        mParallelRoutesParam;
     bool mDisposeMainConnection;
 
     // optional parameters to pass-on to the implicit CAmMainConnectionActionConnect action
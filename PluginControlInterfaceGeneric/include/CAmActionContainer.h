@@ -182,6 +182,27 @@ public:
      * @return bool true if no child actions and vice-versa.
      */
     bool isEmpty(void);
+
+    /**
+     * @brief This function selects how the child actions are dispatched.
+     *
+     *  In sequential mode (default) a child action is started only after its predecessor has
+     *  completed. In parallel mode all child actions are started at once and the container
+     *  completes after every started child has reported its result. On error no further children
+     *  are started and the container stops as soon as the outstanding ones have finished. The
+     *  undo is performed sequentially in reverse order in both modes.
+     *
+     *  @param parallel true if the child actions are independent of each other and shall be
+     *                  dispatched together.
+     */
+    void setParallel(const bool parallel);
+
+    /**
+     * @brief This function returns the dispatching mode of the child actions.
+     *
+     * @return bool true if child actions are dispatched in parallel and vice-versa.
+     */
+    bool isParallel(void) const;
     void setTimeout(uint32_t timeout);
     uint32_t getTimeout(void);
     uint32_t getExecutionTime(void);
@@ -246,7 +267,15 @@ public:
      */
     void _registerParam(const std::string &paramName, IAmActionParam *pBaseParam);
 
+    /**
+     * @brief This function allows a concrete action to accept the ACTION_PARAM_PARALLEL parameter,
+     * thus its dispatching mode can be selected from the policy configuration.
+     */
+    void _registerParallelParam(void);
+
 private:
+    int _executeParallel(void);
+    int _updateParallel(const int result);
     int _incrementIndex(void);
     int _decrementIndex(void);
     int _getIndex(void);
@@ -273,6 +302,24 @@ private:
     timespec                                 mStartTime;
     uint32_t                                 mExecutionTime;
     uint32_t                                 mUndoTime;
+    // true if all child actions are dispatched at once
+    bool                                     mParallel;
+    CAmActionParam<bool >                    mParallelParam;
+
+};
+
+/**
+ * Container without own operation, used to combine independent child actions which shall be
+ * dispatched together, e.g. the route connect actions of a main connection.
+ */
+class CAmActionGroup : public CAmActionContainer
+{
+public:
+    CAmActionGroup(const std::string &name, const bool parallel = true)
+        : CAmActionContainer(name)
+    {
+        setParallel(parallel);
+    }
 
 };
 
@@ -51,6 +51,9 @@
  *  + __exceptSink__ (string)      Sink names to be excluded from target selection.
  *
  * #### Optional execution parameters: #
+ *  + __parallel__ (bool):         If TRUE, the route segments of a main connection are disconnected in
+ *                                 parallel after all source states have been switched off.
+ *                                 Defaults to FALSE.
  *  + __timeOut__ (uint32):        This is the maximum duration, specified in milliseconds, the execution
  *                                 may take before an error action is started.  
  *                                 Defaults to [DEFAULT_ASYNC_ACTION_TIME](@ref am::gc::DEFAULT_ASYNC_ACTION_TIME).
@@ -153,6 +156,7 @@ private:
     CAmActionParam<std::vector<std::string > >          mListClassExceptionsParam;
     CAmActionParam<std::vector<std::string > >          mListSinkExceptionsParam;
     CAmActionParam<std::vector<std::string > >          mlistSourceExceptionsParam;
+    CAmActionParam<bool >                               mParallelRoutesParam;
 };
 
 } /* namespace gc */
@@ -56,6 +56,8 @@
  *                                    - RAMP_GENIVI_EXP_INV, 
  *                                    - RAMP_GENIVI_LINEAR and 
  *                                    - RAMP_GENIVI_EXP
+ *  - __parallel__ (bool):         If TRUE, the volume changes of all involved sources and sinks are
+ *                                 requested at once instead of one after the other. Defaults to FALSE.
  *  - __timeOut__ (uint32):        This is the maximum duration, specified in milliseconds, the execution
  *                                 may take before an error action is started.  
  *                                 Defaults to [DEFAULT_ASYNC_ACTION_TIME](@ref am::gc::DEFAULT_ASYNC_ACTION_TIME).
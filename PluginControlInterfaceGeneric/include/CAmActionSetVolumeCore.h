@@ -192,7 +192,16 @@ protected:
 
     /// sub-action for sink or source element, interacting with the routing side
     class CAmActionSetElementVolume;
+    /// sub-action for all sink and source elements of one domain, using a single batched request
+    class CAmActionSetDomainVolumes;
     void _createActionSetElementVolume(const std::shared_ptr<CAmRoutePointElement> &pElement, const ChangeInfo_t &settings);
+    void _createActionsSetElementVolume(void);
+    static am_volume_t _getRoutingSideVolume(const std::shared_ptr<CAmRoutePointElement> &pElement
+            , const VolumeInfo_t &request);
+
+    // true if element volume changes shall be combined per domain (see SYP_VOLUME_BATCHED_REQUESTS)
+    bool                                 mBatchedRequests;
+    std::map<am_domainID_t, CAmActionSetDomainVolumes * > mMapDomainVolumeActions;
 
     // connection table with total volume information summed over all sources and sinks
     ConnectionMap_t                      mConnectionMap;
@@ -276,6 +285,52 @@ private:
     am_CustomRampType_t                   mRampType;
 };
 
+/**************************************************************************//**
+ * @class CAmActionSetVolumeCore::CAmActionSetDomainVolumes
+ * 
+ * Sub-action of @ref CAmActionSetVolumeCore for all sink and source elements
+ * of one domain, forwarding their volume changes to the routing side in one
+ * single setVolumes() request.
+ * 
+ * If the routing side reports an error, the volumes nevertheless confirmed with the
+ * acknowledgment are adopted by the related elements.
+ */
+
+class CAmActionSetVolumeCore::CAmActionSetDomainVolumes  : public CAmActionCommand
+{
+public:
+    CAmActionSetDomainVolumes(const am_domainID_t domainID, am_time_t rampTime, am_CustomRampType_t rampType);
+    virtual ~CAmActionSetDomainVolumes();
+
+    void addElement(const std::shared_ptr<CAmRoutePointElement> &pElement, const VolumeInfo_t &settings);
+
+    /** @name IAmAction implementation *//**@{*/
+    int _execute(void) override;
+    int _update(int result) override;
+    int _undo(void) override;
+    /**@}*/
+
+private:
+    struct ElementInfo_t
+    {
+        std::shared_ptr<CAmRoutePointElement> pElement;
+        VolumeInfo_t                          requested;
+        VolumeInfo_t                          recent;
+    };
+
+    int _setRoutingSideVolumes(const bool rollBack);
+    static void _applyVolume(const ElementInfo_t &info, const VolumeInfo_t &settings);
+    static bool _isConfirmed(const ElementInfo_t &info, const std::vector<am_Volumes_s > &listVolumes);
+
+    am_domainID_t                         mDomainID;
+    am_Handle_s                           mHandle;
+    std::vector<ElementInfo_t >           mListElements;
+
+    // ramp parameters
+    am_time_t                             mRampTime;
+    am_CustomRampType_t                   mRampType;
+};
+
 
 } /* namespace gc */
 } /* namespace am */
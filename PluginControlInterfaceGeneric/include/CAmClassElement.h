@@ -24,6 +24,7 @@
 
 #include "CAmElement.h"
 #include "CAmTypes.h"
+#include <unordered_map>
 
 namespace am {
 namespace gc {
@@ -135,6 +136,23 @@ public:
         const gc_Element_e type) const;
 
     std::shared_ptr<CAmElement > getElement();
+
+    /**
+     * @brief Drop the cached routes of all classes. Must be called whenever domains, sources,
+     *        sinks or gateways are registered, deregistered or updated, or if their availability changes.
+     * @param none
+     * @return none
+     */
+    static void invalidateRouteCache(void);
+
+    /**
+     * @brief Provide the route cache statistics accumulated over all classes
+     * @param hits: number of connection requests served from the route cache
+     *        misses: number of connection requests which needed to query the daemon
+     * @return none
+     */
+    static void getRouteCacheStatistics(uint32_t &hits, uint32_t &misses);
+
     void setLastSoundProperty(const gc_ElementTypeName_s &elementInfo, const am_MainSoundProperty_s &mainSoundProperty);
     am_Error_e getLastSoundProperty(const gc_ElementTypeName_s &elementInfo,
         std::vector<am_MainSoundProperty_s> &listLastMainSoundProperty);
@@ -178,6 +196,14 @@ private:
     gc_LastMainSoundProperties_s   mLastMainSoundProperties;
     gc_LastMainSoundProperties_s   mLastMainSoundPropertiesFromPersistence;
 
+    /* routes resolved by createMainConnection(), keyed by "<source>:<sink>". The cache is
+     * valid as long as mRouteCacheGeneration matches the global generation counter.
+     */
+    std::unordered_map<std::string, gc_Route_s > mMapRouteCache;
+    uint32_t                                     mRouteCacheGeneration;
+    static uint32_t                              mRouteCacheCurrentGeneration;
+    static uint32_t                              mRouteCacheHits;
+    static uint32_t                              mRouteCacheMisses;
 };
 
 class CAmClassFactory : public CAmFactory<gc_Class_s, CAmClassElement >
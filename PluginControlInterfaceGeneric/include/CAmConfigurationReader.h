@@ -49,6 +49,14 @@ public:
      */
      void reload(void);
 
+    /**
+     * @brief  Number of completed reload() invocations
+     *
+     *         Allows users to detect whether data they derived from the configuration
+     *         (e.g. compiled policy conditions) is outdated.
+     */
+    unsigned int getLoadCount(void) const;
+
     /**
      * @brief It is API providing the interface to get the list of sources as defined in configuration
      * @param listSources: list in which sources will be returned
@@ -92,12 +100,10 @@ public:
     /**
      * @brief It is API providing the interface to get the list of polices as defined in configuration for given trigger
      * @param trigger: trigger for which policy need to be retrieved
-     *        listPolicySets: list in which polices will be returned
-     * @return E_OK on success
-     *         E_UNKNOWN on error
+     * @return list of processes matching the trigger or USER_ALL_TRIGGER, already sorted in
+     *         ascending order of priority. The list stays valid until next reload().
      */
-    am_Error_e getListProcess(const gc_Trigger_e trigger,
-        std::vector<gc_Process_s > &listProcesses);
+    const std::vector<const gc_Process_s * > &getListProcess(const gc_Trigger_e trigger) const;
 
     /**
      * @brief It is API providing the interface to get the gateway information by name as defined in configuration
@@ -214,7 +220,15 @@ private:
      */
     template <class T>
     void _prepareElementSet(gc_Configuration_s *pConfiguration, T &itListElement);
-    static bool _policysorting(gc_Process_s i, gc_Process_s j);
+    static bool _policysorting(const gc_Process_s *pFirst, const gc_Process_s *pSecond);
+
+    /**
+     * @brief It is the internal function use to prepare the per-trigger process index from the
+     *        list of policies. Must be re-run whenever mListPolicies is modified.
+     * @param none
+     * @return none
+     */
+    void _prepareProcessIndex(void);
 
     std::map<std::string, gc_Source_s >  mMapSources;
     std::map<std::string, gc_Sink_s >    mMapSinks;
@@ -222,8 +236,10 @@ private:
     std::map<std::string, gc_Domain_s >  mMapDomains;
     std::map<std::string, gc_Class_s >   mMapClasses;
     std::vector<gc_Policy_s >            mListPolicies;
+    std::vector<const gc_Process_s * >   mListProcessIndex[TRIGGER_MAX];
     std::vector<gc_SystemProperty_s >    mListSystemProperties;
     std::map<std::string, std::map<float, float> > mMapScaleConversions;
+    unsigned int                         mLoadCount;
 };
 
 }
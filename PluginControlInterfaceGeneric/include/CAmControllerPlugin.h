@@ -181,8 +181,9 @@ public:
 #endif // ifdef UNIT_TEST
 private:
     void _freeMemory(void);
+    void _invalidateRoutes(void);
     am_Error_e _forwardTriggertoPolicyEngine(gc_Trigger_e triggerType,
-        gc_TriggerElement_s *triggerData);
+        const gc_TriggerData_t &triggerData);
     am_Error_e _createLastMainConnection(std::string);
     bool _checkAllDomainRegistered(void);
     bool _isDomainRegistrationComplete(const std::string &domainName);
@@ -198,12 +199,26 @@ private:
     am_Error_e _storeSystemPropertytoPersistence();
     am_Error_e _restoreSystemPropertyfromPersistence();
 
+    // persistence keys to be updated once the actions of the current trigger are completed
+    enum gc_PersistenceChange_e
+    {
+        PC_NONE                = 0x00,
+        PC_VOLUME              = 0x01,
+        PC_MAIN_CONNECTION     = 0x02,
+        PC_MAIN_SOUND_PROPERTY = 0x04,
+        PC_SYSTEM_PROPERTY     = 0x08
+    };
+    static uint32_t _getPersistenceChanges(const gc_Trigger_e triggerType);
+    void _persistChanges(void);
+
     // private values
     IAmControlReceive              *mpControlReceive;
     IAmPolicySend                  *mpPolicySend;
     IAmPolicyReceive               *mpPolicyReceive;
     Tcallback<CAmControllerPlugin > mpdomainRegiTimerCallback;
     sh_timerHandle_t                mDomainRegistrationTimerHandle;
+    uint32_t                        mPendingPersistence;
+    bool                            mConnectionsRestored;
     /*
      * For parsing the command line arguments
      */
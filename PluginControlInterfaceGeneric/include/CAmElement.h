@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <vector>
 #include <set>
+#include <unordered_map>
 using namespace std;
 namespace am {
 namespace gc {
@@ -260,6 +261,12 @@ am_Error_e unregisterElement(std::shared_ptr<CAmElement > pElement)
 
 // *****************************************************************************
 
+/**
+ * Element storage, ordered by name for deterministic iteration. Lookups by name
+ * and ID are served from hashed indices. Since the ID of an element may change
+ * after its creation (e.g. on (de-)registration with the AudioManager daemon),
+ * the ID index acts as a validated cache which is refreshed on a miss.
+ */
 template <typename TconstructorParam, typename Telement>
 class CAmFactory
 {
@@ -277,10 +284,12 @@ public:
         // no need to delete shared pointer as it get deleted when ref. count reaches to zero
 
         mMapElements.clear();
+        mHashNameIndex.clear();
+        mHashIDIndex.clear();
         return E_OK;
     }
 
-    static am_Error_e destroyElement(const std::string name)
+    static am_Error_e destroyElement(const std::string &name)
     {
         am_Error_e returnValue = E_OK;
         /*
@@ -292,7 +301,7 @@ public:
         {
             if (E_OK == unregisterElement(pElement))
             {
-                mMapElements.erase(name);
+                _eraseElement(pElement);
             }
         }
 
@@ -311,25 +320,22 @@ public:
         {
             if (E_OK == unregisterElement(pElement))
             {
-                mMapElements.erase(pElement->getName());
+                _eraseElement(pElement);
             }
         }
 
         return returnValue;
     }
 
-    static std::shared_ptr<Telement > getElement(std::string name)
+    static std::shared_ptr<Telement > getElement(const std::string &name)
     {
-        std::shared_ptr<Telement >                                            pElement = nullptr;
-        typename std::map<std::string, std::shared_ptr<Telement > >::iterator itMapElements;
-
-        itMapElements = mMapElements.find(name);
-        if (itMapElements != mMapElements.end())
+        auto itHashNameIndex = mHashNameIndex.find(name);
+        if (itHashNameIndex != mHashNameIndex.end())
         {
-            pElement = itMapElements->second;
+            return itHashNameIndex->second;
         }
 
-        return pElement;
+        return nullptr;
     }
 
     static std::shared_ptr<Telement > getElement(uint16_t ID)
@@ -339,10 +345,23 @@ public:
             return nullptr;
         }
 
+        auto itHashIDIndex = mHashIDIndex.find(ID);
+        if (itHashIDIndex != mHashIDIndex.end())
+        {
+            if (itHashIDIndex->second->getID() == ID)
+            {
+                return itHashIDIndex->second;
+            }
+
+            // ID of cached element has changed in the meantime
+            mHashIDIndex.erase(itHashIDIndex);
+        }
+
         for (auto &itMapElements : mMapElements)
         {
             if (itMapElements.second->getID() == ID)
             {
+                mHashIDIndex[ID] = itMapElements.second;
                 return itMapElements.second;
             }
         }
@@ -382,7 +401,12 @@ public:
                     return nullptr;
                 }
 
-                mMapElements[t.name] = pElement;
+                mMapElements[t.name]   = pElement;
+                mHashNameIndex[t.name] = pElement;
+                if (pElement->getID() != 0)
+                {
+                    mHashIDIndex[pElement->getID()] = pElement;
+                }
             }
         }
 
@@ -391,12 +415,39 @@ public:
 
 protected:
     static std::map<std::string, std::shared_ptr<Telement > > mMapElements;
+
+private:
+    static void _eraseElement(const std::shared_ptr<Telement > &pElement)
+    {
+        // remove also outdated ID index entries, which would keep the element alive
+        for (auto itHashIDIndex = mHashIDIndex.begin(); itHashIDIndex != mHashIDIndex.end(); )
+        {
+            if (itHashIDIndex->second == pElement)
+            {
+                itHashIDIndex = mHashIDIndex.erase(itHashIDIndex);
+            }
+            else
+            {
+                ++itHashIDIndex;
+            }
+        }
+
+        mHashNameIndex.erase(pElement->getName());
+        mMapElements.erase(pElement->getName());
+    }
+
+    static std::unordered_map<std::string, std::shared_ptr<Telement > > mHashNameIndex;
+    static std::unordered_map<uint16_t, std::shared_ptr<Telement > >    mHashIDIndex;
 };
 
 // *****************************************************************************
 
 template <typename TconstructorParam, typename Telement>
 std::map<std::string, std::shared_ptr<Telement > > CAmFactory<TconstructorParam, Telement >::mMapElements;
+template <typename TconstructorParam, typename Telement>
+std::unordered_map<std::string, std::shared_ptr<Telement > > CAmFactory<TconstructorParam, Telement >::mHashNameIndex;
+template <typename TconstructorParam, typename Telement>
+std::unordered_map<uint16_t, std::shared_ptr<Telement > > CAmFactory<TconstructorParam, Telement >::mHashIDIndex;
 
 } /* namespace gc */
 } /* namespace am */
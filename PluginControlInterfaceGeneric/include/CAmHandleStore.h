@@ -47,11 +47,18 @@ public:
     // call the notify() function of all subscribers registered for given handle
     void notifyAsyncResult(am_Handle_s handle, am_Error_e Error);
 
+    // same as above, additionally providing the volumes confirmed with a setVolumes() acknowledgment
+    void notifyAsyncResult(am_Handle_s handle, am_Error_e Error, const std::vector<am_Volumes_s > &listVolumes);
+
+    // volumes confirmed by the acknowledgment currently being notified, empty otherwise
+    const std::vector<am_Volumes_s > &getConfirmedVolumes(void) const;
+
 private:
     CAmHandleStore();
     ~CAmHandleStore();
 
     std::map<uint16_t, IAmEventObserver * > mMapHandles;
+    std::vector<am_Volumes_s >              mListConfirmedVolumes;
 };
 
 
@@ -78,7 +78,8 @@ protected:
 private:
     am_Error_e _createListActionsRouteConnect(
         std::vector<std::shared_ptr<CAmRouteElement > > &listRouteElements);
-    am_Error_e _createActionRouteConnect(std::shared_ptr<CAmRouteElement > routeElement);
+    am_Error_e _createActionRouteConnect(std::shared_ptr<CAmRouteElement > routeElement,
+        CAmActionContainer *pParentAction);
     am_Error_e _createListActionsSetSourceState(
         std::vector<std::shared_ptr<CAmRouteElement > > &listRouteElementst,
         const am_SourceState_e requestedSourceState);
@@ -88,6 +89,8 @@ private:
     std::shared_ptr<CAmMainConnectionElement >   mpMainConnection;
     CAmActionParam<am_CustomConnectionFormat_t>  mConnectionFormatParam;
     CAmActionParam<gc_SetSourceStateDirection_e> mSetSourceStateDirectionParam;
+    // true if the route segments shall be connected in parallel
+    CAmActionParam<bool >                        mParallelRoutesParam;
 
 };
 
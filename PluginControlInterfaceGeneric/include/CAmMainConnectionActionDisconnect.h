@@ -76,7 +76,8 @@ protected:
 private:
     am_Error_e _createListActionsRouteDisconnect(
         std::vector<std::shared_ptr<CAmRouteElement > > &listRouteElements);
-    am_Error_e _createActionRouteDisconnect(std::shared_ptr<CAmRouteElement > routeElement);
+    am_Error_e _createActionRouteDisconnect(std::shared_ptr<CAmRouteElement > routeElement,
+        CAmActionContainer *pParentAction);
 
     am_Error_e _createListActionsSetSourceState(
         std::vector<std::shared_ptr<CAmRouteElement > > &listRouteElementst,
@@ -93,6 +94,8 @@ private:
     bool mActionCompleted;
     // Variables in which parent action will set the parameters.
     CAmActionParam<gc_SetSourceStateDirection_e> mSetSourceStateDirectionParam;
+    // true if the route segments shall be disconnected in parallel
+    CAmActionParam<bool >                        mParallelRoutesParam;
 
 };
 
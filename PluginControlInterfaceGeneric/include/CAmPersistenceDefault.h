@@ -36,6 +36,22 @@
 #define PERISTENCE_FILE_PATH_ENV_VAR_NAME      "GENERIC_CONTROLLER_PERISTENCE_FILE_PATH"
 #define FILE_ACCESS_MODE                       0477
 
+/*
+ * Every write() is appended to a journal file next to the XML snapshot. The journal
+ * is synchronized to the storage after the given number of records (0 leaves it to
+ * the OS). open() compacts it into the snapshot once it holds the given number of records.
+ */
+#ifndef GENERIC_CONTROLLER_PERSISTENCE_SYNC_INTERVAL
+#  define GENERIC_CONTROLLER_PERSISTENCE_SYNC_INTERVAL  1
+#endif
+#ifndef GENERIC_CONTROLLER_PERSISTENCE_JOURNAL_LIMIT
+#  define GENERIC_CONTROLLER_PERSISTENCE_JOURNAL_LIMIT  256
+#endif
+#define PERSISTENCE_SYNC_INTERVAL_ENV_VAR_NAME "GENERIC_CONTROLLER_PERSISTENCE_SYNC_INTERVAL"
+#define PERSISTENCE_JOURNAL_LIMIT_ENV_VAR_NAME "GENERIC_CONTROLLER_PERSISTENCE_JOURNAL_LIMIT"
+#define PERSISTENCE_JOURNAL_SUFFIX             ".journal"
+#define PERSISTENCE_SNAPSHOT_TEMP_SUFFIX       ".tmp"
+
 
 using namespace std;
 
@@ -130,6 +146,16 @@ public:
 private:
     bool _writeTOXML();
     am_Error_e _readFromXML();
+
+    // append-only journal of write() requests between two snapshots
+    am_Error_e _openJournal();
+    void _closeJournal();
+    am_Error_e _appendJournal(const std::string &keyName, const std::string &writeData);
+    uint32_t _replayJournal(size_t &journalSize);
+    bool _compact();
+    static uint32_t _checksum(const std::string &keyName, const std::string &writeData);
+    static uint32_t _getEnvValue(const char *envVarName, const uint32_t defaultValue);
+
     bool _stringToStruct(std::vector<gc_persistence_classData_s > &outVClassDataS, std::vector<gc_persistence_systemProperty_s > &outVSystemPropertyS);
     bool _lastMainConnectionVolumeStruct(std::string inputStr, std::vector<gc_persistence_classData_s > &outVClassDataS, std::vector<gc_persistence_systemProperty_s > &outVSystemPropertyS);
     bool _lastClassVolumeStruct(std::string inputStr, std::vector<gc_persistence_classData_s > &outVClassDataS, std::vector<gc_persistence_systemProperty_s > &outVSystemPropertyS);
@@ -145,6 +171,12 @@ private:
 
     MapData             mFileData;
     std::string         mFileName;
+    std::string         mJournalName;
+    int                 mJournalFd;
+    uint32_t            mJournalRecords;
+    uint32_t            mUnsyncedRecords;
+    uint32_t            mSyncInterval;
+    uint32_t            mJournalLimit;
 };
 
 } /* namespace gc */
@@ -203,6 +203,36 @@ inline std::ostream &operator<<(std::ostream &out, const gc_triggerParams_s &tri
     return out << "}" << std::endl;
 }
 
+/// trigger-dependent macros (REQ_xxx) as usable in action parameters and function arguments
+enum gc_Macro_e
+{
+    MACRO_UNKNOWN,
+    MACRO_REQ_TRIG_TYPE,
+    MACRO_REQ_SINK_NAME,
+    MACRO_REQ_SOURCE_NAME,
+    MACRO_REQ_DOMAIN_NAME,
+    MACRO_REQ_GATEWAY_NAME,
+    MACRO_REQ_CLASS_NAME,
+    MACRO_REQ_CONNECTION_NAME,
+    MACRO_REQ_CONNECTION_STATE,
+    MACRO_REQ_STATUS,
+    MACRO_MAIN_VOLUME,
+    MACRO_MSP_TYPE,
+    MACRO_MSP_VAL,
+    MACRO_SYP_TYPE,
+    MACRO_SYP_VAL,
+    MACRO_AVAIL_STATE,
+    MACRO_AVAIL_REASON,
+    MACRO_MUTE_STATE,
+    MACRO_INT_STATE,
+    MACRO_NP_TYPE,
+    MACRO_NP_VAL,
+    MACRO_NC_TYPE,
+    MACRO_NC_STATUS,
+    MACRO_NC_PARAM,
+    MACRO_MAX
+};
+
 class IAmPolicyReceive;
 class CAmPolicyFunctions;
 
@@ -247,8 +277,32 @@ public:
      */
     void stopPolicyEngine();
 
+    /**
+     * @brief Replace a parameter consisting of a macro (e.g. REQ_SINK_NAME) by the
+     *        corresponding value from given trigger. Other parameters are left untouched.
+     * @param trigger: trigger providing the values
+     *        parameter: parameter to be evaluated in place
+     * @return none
+     */
     static void evaluateMacro(const gc_triggerParams_s &trigger, std::string &parameter);
 
+    /**
+     * @brief Replace given parameter by the trigger value selected through an already
+     *        resolved macro. Only the requested field is formatted.
+     * @param trigger: trigger providing the values
+     *        macro: identifier as obtained from resolveMacro()
+     *        parameter: variable in which the value will be returned
+     * @return none
+     */
+    static void evaluateMacro(const gc_triggerParams_s &trigger, const gc_Macro_e macro, std::string &parameter);
+
+    /**
+     * @brief Translate macro name into its identifier
+     * @param name: macro as given in configuration, e.g. REQ_SINK_NAME
+     * @return identifier of the macro, MACRO_UNKNOWN if name is not a supported macro
+     */
+    static gc_Macro_e resolveMacro(const std::string &name);
+
     am_Error_e processTrigger(gc_triggerParams_s &triggerParams);
 
 private:
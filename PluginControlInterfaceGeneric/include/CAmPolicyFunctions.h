@@ -6,7 +6,9 @@
  * 
  * Internally it maintains a map of member functions implementing the available
  * @ref functionTable, which are selected by function name string as given in the
- * policy rule.
+ * policy rule. On configuration load all conditions are compiled into a tree of
+ * resolved function pointers and pre-parsed nested functions, so that per-trigger
+ * evaluation does not need to parse or look up anything by string.
  *
  * @component{AudioManager Generic Controller}
  *
@@ -23,7 +25,10 @@
 #define GC_POLICYFUNCTIONS_H_
 
 #include "CAmTypes.h"
+#include "CAmXmlConfigParser.h"
+#include "CAmPolicyEngine.h"
 #include <map>
+#include <cstdlib>
 
 
 namespace am {
@@ -32,9 +37,45 @@ namespace gc {
 
 class CAmConfigurationReader;
 class IAmPolicyReceive;
-struct gc_triggerParams_s;
-struct gc_ConditionStruct_s;
-struct gc_FunctionElement_s;
+/**
+ * @brief Single result item of a condition function. Functions of integer type
+ *        deliver their numeric value, functions of string type (e.g. name()) the text.
+ */
+struct gc_PolicyValue_s
+{
+    gc_PolicyValue_s()
+        : isInteger(false)
+        , integerValue(0)
+    {
+    }
+
+    gc_PolicyValue_s(const std::string &value)
+        : isInteger(false)
+        , integerValue(0)
+        , stringValue(value)
+    {
+    }
+
+    gc_PolicyValue_s(const int32_t value)
+        : isInteger(true)
+        , integerValue(value)
+    {
+    }
+
+    std::string toString(void) const
+    {
+        return isInteger ? std::to_string(integerValue) : stringValue;
+    }
+
+    int32_t toInteger(void) const
+    {
+        return isInteger ? integerValue : atoi(stringValue.c_str());
+    }
+
+    bool        isInteger;
+    int32_t     integerValue;
+    std::string stringValue;
+};
 
 
 /**************************************************************************//**
@@ -62,22 +103,9 @@ public:
     void evaluateParameter(const gc_triggerParams_s &trigger, std::string &parameter);
 
 private:
-    /**
-     * @brief It is API providing the interface to execute the function as defined in conditions as
-     *        given in policy set of configuration file
-     * @param function: structure defining the function to be executed
-     *        trigger: parameters received in hook from framework side during which this function need to be evaluated
-     *        listOutputs: list in which output of function execution will be stored
-     * @return true on success
-     */
-    bool _executeFunction(gc_FunctionElement_s function, const gc_triggerParams_s &trigger
-        , std::vector<std::string > &listOutputs);
-
-    bool _isConditionTrue(const gc_ConditionStruct_s &Condition, const gc_triggerParams_s &parameters);
-
     // shorthand for parameters of mapped functions
     #define FUNCTION_PARAMS const gc_FunctionElement_s &function, const gc_triggerParams_s &parameters \
-        , std::vector<std::string > &listOutputs 
+        , std::vector<gc_PolicyValue_s > &listOutputs 
 
     /**
      * @brief Prototype for mapped condition functions
@@ -89,6 +117,80 @@ private:
      */
     typedef am_Error_e (CAmPolicyFunctions::*functionPtr)(FUNCTION_PARAMS);
 
+    // origin of a function parameter value, as determined during compilation
+    enum gc_ParameterKind_e
+    {
+        PK_LITERAL,     // used as given in configuration
+        PK_MACRO,       // REQ_xxx macro, substituted from trigger
+        PK_FUNCTION     // nested function, executed on each evaluation
+    };
+
+    // number of parameters (mandatory, optional, optional2) a policy function may have
+    #define GC_FUNCTION_PARAMETER_COUNT 3
+
+    // policy function with function pointer and result type resolved
+    struct gc_CompiledFunction_s
+    {
+        gc_CompiledFunction_s();
+
+        gc_FunctionElement_s                    element;
+        functionPtr                             pFunction;
+        bool                                    isStringResult;
+        bool                                    isConstant;     // all parameters are literals
+        gc_ParameterKind_e                      parameterKind[GC_FUNCTION_PARAMETER_COUNT];
+        gc_Macro_e                              macro[GC_FUNCTION_PARAMETER_COUNT];
+        std::shared_ptr<gc_CompiledFunction_s > pNested[GC_FUNCTION_PARAMETER_COUNT];
+    };
+
+    // condition with both sides compiled. A direct RHS value is pre-converted
+    // to integer if the LHS function is of integer type.
+    struct gc_CompiledCondition_s
+    {
+        gc_CompiledFunction_s leftObject;
+        gc_Operator_e         operation;
+        bool                  isRightValue;
+        gc_CompiledFunction_s rightObject;
+        gc_PolicyValue_s      rightValue;
+    };
+
+    /**
+     * @brief Translate a function as given in the configuration into its compiled form.
+     *        Nested functions in parameters are compiled recursively.
+     * @param function: function as parsed from configuration
+     *        compiled: variable in which the compiled function will be returned
+     * @return none
+     */
+    void _compileFunction(const gc_FunctionElement_s &function, gc_CompiledFunction_s &compiled) const;
+
+    void _compileConditions(const std::vector<gc_ConditionStruct_s > &listConditionSets,
+        std::vector<gc_CompiledCondition_s > &listCompiled) const;
+
+    /**
+     * @brief Compile the conditions of all processes of the current configuration and
+     *        drop previously compiled data. Invoked on construction and whenever the
+     *        configuration reader reports a reload.
+     * @param none
+     * @return none
+     */
+    void _compileConfiguration(void);
+
+    /**
+     * @brief It is API providing the interface to execute the function as defined in conditions as
+     *        given in policy set of configuration file
+     * @param function: compiled function to be executed
+     *        trigger: parameters received in hook from framework side during which this function need to be evaluated
+     *        listOutputs: list in which output of function execution will be stored
+     * @return true on success
+     */
+    bool _executeFunction(const gc_CompiledFunction_s &function, const gc_triggerParams_s &trigger
+        , std::vector<gc_PolicyValue_s > &listOutputs);
+
+    // execute nested function and replace given parameter with its space-separated results
+    void _evaluateNestedFunction(const gc_CompiledFunction_s &nested, const gc_triggerParams_s &trigger,
+        std::string &parameter);
+
+    bool _isConditionTrue(const gc_CompiledCondition_s &condition, const gc_triggerParams_s &parameters);
+
     // implementation of the peek() function
     //   - elementTypeOfType = SOURCEOFCLASS, SINKOFCLASS
     am_Error_e _findPeek(FUNCTION_PARAMS);
@@ -106,7 +208,7 @@ private:
     //                   DOMAINOFSOURCE, DOMAINOFSINK, SOURCEOFCLASS, SINKOFCLASS
     am_Error_e _findName(FUNCTION_PARAMS);
     am_Error_e _findName(const gc_FunctionElement_s &function,
-        std::vector<std::string > &listOutputs, const std::string &name);
+        std::vector<gc_PolicyValue_s > &listOutputs, const std::string &name);
 
     // implementation of the elements() function
     //   - elementType = CLASS, DOMAIN
@@ -118,14 +220,14 @@ private:
     template <typename T>
     am_Error_e _findPriority(const gc_FunctionElement_s &function,
         std::string mandatoryParameter,
-        std::vector<std::string > &listOutputs);
+        std::vector<gc_PolicyValue_s > &listOutputs);
 
     // implementation of the connectionState() function
     //   - elementType = CONNECTIONOFSOURCE, CONNECTIONOFSINK, CONNECTIONOFCLASS, returning list
     //   - elementType = CONNECTION, USER, returning single item
     am_Error_e _findConnectionState(FUNCTION_PARAMS);
     am_Error_e _findConnectionState(const gc_FunctionElement_s &function,
-        std::vector<std::string > &listOutputs,
+        std::vector<gc_PolicyValue_s > &listOutputs,
         std::string mandatoryParameter, const gc_Element_e elementType);
 
     // implementation of the volume() function
@@ -133,14 +235,14 @@ private:
     am_Error_e _findDeviceVolume(FUNCTION_PARAMS);
     am_Error_e _findDeviceVolume(const gc_Element_e elementType,
         const gc_FunctionElement_s &function,
-        std::string elementName, std::vector<std::string > &listOutputs);
+        std::string elementName, std::vector<gc_PolicyValue_s > &listOutputs);
 
     // implementation of the mainVolume() function
     //   - elementType = SOURCE, SINK, USER
     am_Error_e _findMainVolume(FUNCTION_PARAMS);
     am_Error_e _findMainVolume(const gc_Element_e elementType,
         const gc_FunctionElement_s &function,
-        std::string elementName, std::vector<std::string > &listOutputs);
+        std::string elementName, std::vector<gc_PolicyValue_s > &listOutputs);
 
     // implementation of the isMainVolumeStep() function
     //   - elementType = USER
@@ -216,7 +318,7 @@ private:
     am_Error_e _findNTStatus(FUNCTION_PARAMS);
     am_Error_e _findNTParam(FUNCTION_PARAMS);
     am_Error_e _findNTStatusParam(const gc_FunctionElement_s &function,
-        std::vector<std::string > &listOutputs,
+        std::vector<gc_PolicyValue_s > &listOutputs,
         std::string mandatoryParameter, gc_Element_e elementType,
         am_CustomNotificationType_t ntType, const bool isStatusReq);
 
@@ -235,7 +337,7 @@ private:
     am_Error_e _findMainNTStatus(FUNCTION_PARAMS);
     am_Error_e _findMainNTParam(FUNCTION_PARAMS);
     am_Error_e _findMainNTStatusParam(const gc_FunctionElement_s &function,
-        std::vector<std::string > &listOutputs,
+        std::vector<gc_PolicyValue_s > &listOutputs,
         std::string mandatoryParameter, gc_Element_e elementType,
         am_CustomNotificationType_t ntType, const bool isStatusReq);
 
@@ -250,13 +352,13 @@ private:
     // Supporting internal function used to find the name of element from connection list
     am_Error_e _getNameList(const std::string &mandatoryParameter,
         const std::string &optionalParameter,
-        std::vector<std::string > &listOutputs,
+        std::vector<gc_PolicyValue_s > &listOutputs,
         const gc_triggerParams_s &parameters, const bool isSinkRequired);
 
     // Supporting internal template function used to find the domain or class name of element
     template <typename Telement>
     am_Error_e _findDomainOrClassOfElementName(Telement &elementInstance,
-        const gc_FunctionElement_s &function, std::vector<std::string > &listOutputs,
+        const gc_FunctionElement_s &function, std::vector<gc_PolicyValue_s > &listOutputs,
         std::string mandatoryParameter, const bool isClassRequired);
 
     // map to store map of function pointers
@@ -265,9 +367,18 @@ private:
     // map to store function return value type. This are the functions supported in condition of policy
     std::map<std::string, bool >        mMapFunctionReturnValue;
 
+    // compiled conditions, indexed by address of the condition list in configured process
+    std::map<const std::vector<gc_ConditionStruct_s > *, std::vector<gc_CompiledCondition_s > > mMapCompiledConditions;
+
+    // compiled nested functions as used in action parameters, indexed by their text
+    std::map<std::string, gc_CompiledFunction_s > mMapCompiledParameters;
+
     // pointer to store policy receive class instance
     IAmPolicyReceive *mpPolicyReceive;
 
+    // load count of configuration reader at time of last compilation
+    unsigned int      mCompiledLoadCount;
+
 };
 
 
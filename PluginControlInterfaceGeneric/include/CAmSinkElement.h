@@ -195,6 +195,15 @@ public:
      * @return main volume of element
      */
     am_mainVolume_t convertVolumeToMainVolume(const am_volume_t decibelVolume);
+
+    /**
+     * @brief This API is used to obtain the range of main volumes given in configuration file.
+     *        Main volumes beyond are saturated by convertMainVolumeToVolume.
+     * @param minVolume: lowest main volume
+     *        maxVolume: highest main volume
+     * @return true if the range is configured, false otherwise
+     */
+    bool getMainVolumeRange(am_mainVolume_t &minVolume, am_mainVolume_t &maxVolume) const;
     /**@}*/
 
     gc_LimitVolume_s getSinkLimit();
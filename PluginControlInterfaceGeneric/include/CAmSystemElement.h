@@ -48,6 +48,7 @@ public:
     am_Error_e setSystemProperties(const std::vector<am_SystemProperty_s> &listSystemProperties);
     int16_t getDebugLevel(void) const;
     bool isNonTopologyRouteAllowed(void) const;
+    bool isVolumeBatchingEnabled(void) const;
     bool isUnknownElementRegistrationSupported(void) const;
     bool isSystemPropertyReadOnly(void) const;
     std::string getLastSystemPropertiesString();
@@ -4,6 +4,15 @@
  * This file contains the Event Queue. As the name suggest Event Queue will
  * Queue all the triggers which will be forwarded to the Policy engine
  *
+ * Triggers are stored by value as typed records in pre-allocated ring buffers.
+ * Trigger data is moved in on queuing and moved out on dequeuing, so the
+ * queue itself does not allocate memory per trigger.
+ *
+ * If coalescing is enabled, a newly queued volume, mute, main sound property,
+ * system property or notification data trigger is merged into a still pending
+ * trigger of the same type and target element, as long as no trigger of another
+ * type was queued in between.
+ *
  * @component{AudioManager Generic Controller}
  *
  * @authors Toshiaki Isogai <tisogai@jp.adit-jv.com>,\n
@@ -23,147 +32,400 @@
 
 #include "IAmControlCommon.h"
 #include "CAmTypes.h"
-#include <deque>
+#include <vector>
+#include <new>
+#include <utility>
+#include <type_traits>
 
 namespace am {
 
 namespace gc {
 
-struct gc_TriggerElement_s
-{
-    virtual ~gc_TriggerElement_s()
-    {
-    }
-
-};
-
-struct gc_UnRegisterElementTrigger_s : public gc_TriggerElement_s
+struct gc_UnRegisterElementTrigger_s
 {
     std::string elementName;
     am_Error_e unRegisterationStatus;
 };
 
-struct gc_DomainRegisterationCompleteTrigger_s : public gc_TriggerElement_s
+struct gc_DomainRegisterationCompleteTrigger_s
 {
     std::string domainName;
 };
 
-struct gc_AllDomainRegisterationCompleteTrigger_s : public gc_TriggerElement_s
+struct gc_AllDomainRegisterationCompleteTrigger_s
 {
     am_Error_e status;
 };
 
-struct gc_ConnectTrigger_s : public gc_TriggerElement_s
+struct gc_ConnectTrigger_s
 {
     std::string sourceName;
     std::string sinkName;
     std::string className;
 };
 
-struct gc_DisconnectTrigger_s : public gc_TriggerElement_s
+struct gc_DisconnectTrigger_s
 {
     std::string sourceName;
     std::string sinkName;
     std::string className;
 };
 
-struct gc_SinkVolumeChangeTrigger_s : public gc_TriggerElement_s
+struct gc_SinkVolumeChangeTrigger_s
 {
     std::string sinkName;
     am_mainVolume_t volume;
     bool isStep;
 };
 
-struct gc_SinkMuteTrigger_s : public gc_TriggerElement_s
+struct gc_SinkMuteTrigger_s
 {
     std::string sinkName;
     am_MuteState_e muteState;
 };
 
-struct gc_SinkSoundPropertyTrigger_s : public gc_TriggerElement_s
+struct gc_SinkSoundPropertyTrigger_s
 {
     std::string sinkName;
     am_MainSoundProperty_s mainSoundProperty;
 };
 
-struct gc_SinkSoundPropertiesTrigger_s : public gc_TriggerElement_s
+struct gc_SinkSoundPropertiesTrigger_s
 {
     std::string sinkName;
     std::vector<am_MainSoundProperty_s > listMainSoundProperty;
 };
 
-struct gc_SourceSoundPropertyTrigger_s : public gc_TriggerElement_s
+struct gc_SourceSoundPropertyTrigger_s
 {
     std::string sourceName;
     am_MainSoundProperty_s mainSoundProperty;
 };
 
-struct gc_SourceSoundPropertiesTrigger_s : public gc_TriggerElement_s
+struct gc_SourceSoundPropertiesTrigger_s
 {
     std::string sourceName;
     std::vector<am_MainSoundProperty_s > listMainSoundProperty;
 };
 
-struct gc_RegisterElementTrigger_s : public gc_TriggerElement_s
+struct gc_RegisterElementTrigger_s
 {
     std::string elementName;
     am_Error_e RegisterationStatus;
 };
 
-struct gc_AvailabilityChangeTrigger_s : public gc_TriggerElement_s
+struct gc_AvailabilityChangeTrigger_s
 {
     std::string elementName;
     am_Availability_s availability;
 };
 
-struct gc_SourceInterruptChangeTrigger_s : public gc_TriggerElement_s
+struct gc_SourceInterruptChangeTrigger_s
 {
     std::string sourceName;
     am_InterruptState_e interrptstate;
 };
 
-struct gc_SystemPropertyTrigger_s : public gc_TriggerElement_s
+struct gc_SystemPropertyTrigger_s
 {
     am_SystemProperty_s systemProperty;
 };
 
-struct gc_SystemPropertiesTrigger_s : public gc_TriggerElement_s
+struct gc_SystemPropertiesTrigger_s
 {
     std::vector<am_SystemProperty_s> listSystemProperty;
 };
 
-struct gc_ConnectionStateChangeTrigger_s : public gc_TriggerElement_s
+struct gc_ConnectionStateChangeTrigger_s
 {
     std::string connectionName;
     am_ConnectionState_e connectionState;
     am_Error_e status;
 };
 
-struct gc_NotificationConfigurationTrigger_s : public gc_TriggerElement_s
+struct gc_NotificationConfigurationTrigger_s
 {
     std::string name;
     am_NotificationConfiguration_s notificatonConfiguration;
 
 };
 
-struct gc_NotificationDataTrigger_s : public gc_TriggerElement_s
+struct gc_NotificationDataTrigger_s
 {
     std::string name;
     am_NotificationPayload_s notificatonPayload;
 
 };
 
+/**
+ * @brief Helper templates for CAmTriggerVariant, operating on the list of alternative types
+ */
+template <typename T, typename... Ts>
+struct gc_TypeIndex;
+
+template <typename T, typename... Ts>
+struct gc_TypeIndex<T, T, Ts...>
+{
+    static const unsigned int value = 0;
+};
+
+template <typename T, typename U, typename... Ts>
+struct gc_TypeIndex<T, U, Ts...>
+{
+    static const unsigned int value = 1 + gc_TypeIndex<T, Ts...>::value;
+};
+
+template <typename... Ts>
+struct gc_VariantOperations;
+
+template <>
+struct gc_VariantOperations<>
+{
+    static const size_t size      = 1;
+    static const size_t alignment = 1;
+
+    static void destroy(unsigned int, void *)
+    {
+    }
+
+    static void move(unsigned int, void *, void *)
+    {
+    }
+};
+
+template <typename T, typename... Ts>
+struct gc_VariantOperations<T, Ts...>
+{
+    static const size_t size = (sizeof(T) > gc_VariantOperations<Ts...>::size)
+        ? sizeof(T) : gc_VariantOperations<Ts...>::size;
+    static const size_t alignment = (alignof(T) > gc_VariantOperations<Ts...>::alignment)
+        ? alignof(T) : gc_VariantOperations<Ts...>::alignment;
+
+    static void destroy(unsigned int index, void *pStorage)
+    {
+        if (index == 0)
+        {
+            static_cast<T *>(pStorage)->~T();
+        }
+        else
+        {
+            gc_VariantOperations<Ts...>::destroy(index - 1, pStorage);
+        }
+    }
+
+    // move-construct object at pDestination from object at pSource
+    static void move(unsigned int index, void *pSource, void *pDestination)
+    {
+        if (index == 0)
+        {
+            new (pDestination) T(std::move(*static_cast<T *>(pSource)));
+        }
+        else
+        {
+            gc_VariantOperations<Ts...>::move(index - 1, pSource, pDestination);
+        }
+    }
+};
+
+/**
+ * @brief Tagged union holding one object of the given alternative types or nothing.
+ *
+ *        Minimal move-only replacement for std::variant, which is not available
+ *        with the C++11 standard used for this component.
+ */
+template <typename... Ts>
+class CAmTriggerVariant
+{
+public:
+    CAmTriggerVariant()
+        : mIndex(EMPTY)
+    {
+    }
+
+    CAmTriggerVariant(CAmTriggerVariant &&other)
+        : mIndex(EMPTY)
+    {
+        *this = std::move(other);
+    }
+
+    CAmTriggerVariant &operator=(CAmTriggerVariant &&other)
+    {
+        if (this != &other)
+        {
+            reset();
+            if (other.mIndex != EMPTY)
+            {
+                gc_VariantOperations<Ts...>::move(other.mIndex, &other.mStorage, &mStorage);
+                mIndex = other.mIndex;
+                other.reset();
+            }
+        }
+
+        return *this;
+    }
+
+    CAmTriggerVariant(const CAmTriggerVariant &) = delete;
+    CAmTriggerVariant &operator=(const CAmTriggerVariant &) = delete;
+
+    ~CAmTriggerVariant()
+    {
+        reset();
+    }
+
+    /// store given object, replacing any previous content
+    template <typename T>
+    void emplace(T &&value)
+    {
+        typedef typename std::decay<T>::type Tvalue;
+        reset();
+        new (&mStorage) Tvalue(std::forward<T>(value));
+        mIndex = gc_TypeIndex<Tvalue, Ts...>::value;
+    }
+
+    /// @return pointer to contained object if it is of type T, NULL otherwise
+    template <typename T>
+    T *getIf(void)
+    {
+        return (mIndex == gc_TypeIndex<T, Ts...>::value) ? reinterpret_cast<T *>(&mStorage) : NULL;
+    }
+
+    template <typename T>
+    const T *getIf(void) const
+    {
+        return (mIndex == gc_TypeIndex<T, Ts...>::value) ? reinterpret_cast<const T *>(&mStorage) : NULL;
+    }
+
+    bool empty(void) const
+    {
+        return mIndex == EMPTY;
+    }
+
+    void reset(void)
+    {
+        if (mIndex != EMPTY)
+        {
+            gc_VariantOperations<Ts...>::destroy(mIndex, &mStorage);
+            mIndex = EMPTY;
+        }
+    }
+
+private:
+    static const unsigned int EMPTY = static_cast<unsigned int>(-1);
+
+    typename std::aligned_storage<gc_VariantOperations<Ts...>::size,
+        gc_VariantOperations<Ts...>::alignment>::type mStorage;
+    unsigned int mIndex;
+};
+
+/// payload of any queued trigger
+typedef CAmTriggerVariant<gc_UnRegisterElementTrigger_s,
+        gc_DomainRegisterationCompleteTrigger_s,
+        gc_AllDomainRegisterationCompleteTrigger_s,
+        gc_ConnectTrigger_s,
+        gc_DisconnectTrigger_s,
+        gc_SinkVolumeChangeTrigger_s,
+        gc_SinkMuteTrigger_s,
+        gc_SinkSoundPropertyTrigger_s,
+        gc_SinkSoundPropertiesTrigger_s,
+        gc_SourceSoundPropertyTrigger_s,
+        gc_SourceSoundPropertiesTrigger_s,
+        gc_RegisterElementTrigger_s,
+        gc_AvailabilityChangeTrigger_s,
+        gc_SourceInterruptChangeTrigger_s,
+        gc_SystemPropertyTrigger_s,
+        gc_SystemPropertiesTrigger_s,
+        gc_ConnectionStateChangeTrigger_s,
+        gc_NotificationConfigurationTrigger_s,
+        gc_NotificationDataTrigger_s> gc_TriggerData_t;
+
+struct gc_TriggerRecord_s
+{
+    gc_TriggerRecord_s()
+        : triggerType(TRIGGER_UNKNOWN)
+    {
+    }
+
+    gc_Trigger_e     triggerType;
+    gc_TriggerData_t triggerData;
+};
+
+// initial number of slots of each of the trigger ring buffers
+#define GC_TRIGGER_QUEUE_CAPACITY 64
+
 class CAmTriggerQueue
 {
 public:
-    am_Error_e queue(gc_Trigger_e triggerType, gc_TriggerElement_s *triggerData);
-    am_Error_e queueWithPriority(gc_Trigger_e triggerType, gc_TriggerElement_s *triggerData);
-    gc_TriggerElement_s *dequeue(gc_Trigger_e &triggerType);
+    /**
+     * @brief Append trigger to the normal queue. The trigger data is moved into the queue.
+     * @param triggerType: type of the trigger
+     *        triggerData: one of the trigger structures listed in gc_TriggerData_t
+     * @return E_OK
+     */
+    template <typename Ttrigger>
+    am_Error_e queue(gc_Trigger_e triggerType, Ttrigger &&triggerData)
+    {
+        if (mCoalescingEnabled && _coalesce(mlistTrigger, triggerType, triggerData))
+        {
+            mListMergeCount[triggerType]++;
+            return E_OK;
+        }
+
+        gc_TriggerRecord_s &record = _appendSlot(mlistTrigger);
+        record.triggerType = triggerType;
+        record.triggerData.emplace(std::forward<Ttrigger>(triggerData));
+        return E_OK;
+    }
+
+    /**
+     * @brief Append trigger to the high priority queue, which is served before the normal queue.
+     * @param triggerType: type of the trigger
+     *        triggerData: one of the trigger structures listed in gc_TriggerData_t
+     * @return E_OK
+     */
+    template <typename Ttrigger>
+    am_Error_e queueWithPriority(gc_Trigger_e triggerType, Ttrigger &&triggerData)
+    {
+        gc_TriggerRecord_s &record = _appendSlot(mlistPriority);
+        record.triggerType = triggerType;
+        record.triggerData.emplace(std::forward<Ttrigger>(triggerData));
+        return E_OK;
+    }
+
+    /**
+     * @brief Remove oldest trigger, preferably from the high priority queue
+     * @param triggerType: variable in which the type of the trigger will be returned
+     *        triggerData: variable into which the trigger data will be moved
+     * @return E_OK on success
+     *         E_NON_EXISTENT if both queues are empty
+     */
+    am_Error_e dequeue(gc_Trigger_e &triggerType, gc_TriggerData_t &triggerData);
 
     /* copy current queue content to external list to allow checking
-     * whether certain triggers are currently scheduled
+     * whether certain triggers are currently scheduled. The data pointers
+     * stay valid until the queue is modified.
+     */
+    void getSnapShot(std::vector<std::pair<gc_Trigger_e, const gc_TriggerData_t *> > &queueSnapShot) const;
+
+    /**
+     * @brief Enable or disable merging of newly queued triggers into pending ones
+     * @param enabled: true to enable coalescing
      */
-    void getSnapShot(std::vector<std::pair<gc_Trigger_e, const gc_TriggerElement_s *> > &queueSnapShot);
+    void setCoalescing(bool enabled);
+    bool isCoalescingEnabled(void) const;
+
+    /**
+     * @brief Number of triggers which were merged into a pending trigger instead of being queued
+     * @param triggerType: type of the merged triggers
+     * @return merge count for the given trigger type
+     */
+    uint32_t getMergeCount(gc_Trigger_e triggerType) const;
+
+    /**
+     * @brief Total number of merged triggers of all types
+     * @return merge count
+     */
+    uint32_t getMergeCount(void) const;
+    void resetMergeCounters(void);
 
     static CAmTriggerQueue *getInstance();
     static void freeInstance();
@@ -171,10 +433,56 @@ public:
 private:
     CAmTriggerQueue();
 
+    // ring buffer of trigger records, grown only if all slots are occupied
+    struct gc_TriggerRing_s
+    {
+        std::vector<gc_TriggerRecord_s > slots;
+        size_t                           head;
+        size_t                           count;
+    };
+
+    // provide slot behind the last occupied one, enlarging the ring if necessary
+    gc_TriggerRecord_s &_appendSlot(gc_TriggerRing_s &ring);
+    void _takeFront(gc_TriggerRing_s &ring, gc_Trigger_e &triggerType, gc_TriggerData_t &triggerData);
+    void _getSnapShot(const gc_TriggerRing_s &ring,
+        std::vector<std::pair<gc_Trigger_e, const gc_TriggerData_t *> > &queueSnapShot) const;
+
+    /*
+     * Merge given trigger into the latest pending trigger of the same type and target.
+     * Return true if merged, false if the trigger needs to be appended.
+     */
+    template <typename Ttrigger>
+    bool _coalesce(gc_TriggerRing_s &, gc_Trigger_e, const Ttrigger &)
+    {
+        return false;
+    }
+
+    bool _coalesce(gc_TriggerRing_s &ring, gc_Trigger_e triggerType, const gc_SinkVolumeChangeTrigger_s &trigger);
+    bool _coalesce(gc_TriggerRing_s &ring, gc_Trigger_e triggerType, const gc_SinkMuteTrigger_s &trigger);
+    bool _coalesce(gc_TriggerRing_s &ring, gc_Trigger_e triggerType, const gc_SinkSoundPropertyTrigger_s &trigger);
+    bool _coalesce(gc_TriggerRing_s &ring, gc_Trigger_e triggerType, const gc_SourceSoundPropertyTrigger_s &trigger);
+    bool _coalesce(gc_TriggerRing_s &ring, gc_Trigger_e triggerType, const gc_SystemPropertyTrigger_s &trigger);
+    bool _coalesce(gc_TriggerRing_s &ring, gc_Trigger_e triggerType, const gc_NotificationDataTrigger_s &trigger);
+
+    /*
+     * Saturate merged main volume or step to the main volume range of the sink, which limits
+     * each single volume change as well, and to the range of am_mainVolume_t.
+     */
+    static am_mainVolume_t _clampMainVolume(const std::string &sinkName, int32_t volume, bool isStep);
+
+    /*
+     * Search the pending triggers backwards from the newest one while they are of the given
+     * type and return the first one for which isSameTarget returns true. NULL if none.
+     */
+    template <typename Ttrigger, typename Tpredicate>
+    Ttrigger *_findPending(gc_TriggerRing_s &ring, gc_Trigger_e triggerType, Tpredicate isSameTarget);
+
     // Maintain two queues, one for normal and one for high priority triggers.
-    // Can't use std::queue here as it does not support the snapshot
-    std::deque<std::pair<gc_Trigger_e, gc_TriggerElement_s * > > mlistTrigger;
-    std::deque<std::pair<gc_Trigger_e, gc_TriggerElement_s * > > mlistPriority;
+    gc_TriggerRing_s mlistTrigger;
+    gc_TriggerRing_s mlistPriority;
+
+    bool     mCoalescingEnabled;
+    uint32_t mListMergeCount[TRIGGER_MAX];
 
     // singleton instance
     static CAmTriggerQueue *mpTriggerQueue;
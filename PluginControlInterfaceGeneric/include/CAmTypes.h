@@ -83,6 +83,7 @@ namespace gc {
 #define ACTION_PARAM_SET_SOURCE_STATE_DIRECTION        "setSourceStateDirection"
 #define ACTION_PARAM_LIST_PROPERTY                     "listMainSoundProperties"
 #define ACTION_PARAM_LIST_SYSTEM_PROPERTIES            "listSystemProperties"
+#define ACTION_PARAM_PARALLEL                          "parallel"
 
 #define SYSTEM_ELEMENT_NAME "System"
 #define DEFAULT_CLASS_NAME  "default"
@@ -123,12 +124,15 @@ namespace gc {
     RESERVED_PROPERTIES_BASE + (7 << PROPERTY_USE_CASE_ID_SHIFT)
 #define ACTION_PROPERTY_BASE RESERVED_PROPERTIES_BASE + (8 << PROPERTY_USE_CASE_ID_SHIFT)
 static const am_CustomSystemPropertyType_t SYP_GLOBAL_LOG_THRESHOLD               = GLOBAL_PROPERTY_BASE + 0;
+static const am_CustomSystemPropertyType_t SYP_GLOBAL_TRIGGER_COALESCING          = GLOBAL_PROPERTY_BASE + 1;
 static const am_CustomSystemPropertyType_t SYP_REGISTRATION_ALLOW_UNKNOWN_ELEMENT = \
     REGISTRATION_PROPERTY_BASE + 0;
 static const am_CustomSystemPropertyType_t SYP_REGISTRATION_DOMAIN_TIMEOUT = \
     REGISTRATION_PROPERTY_BASE + 1;
 static const am_CustomSystemPropertyType_t SYP_CONNECTION_ALLOW_ONLY_TOPOLOGY_ROUTES = \
     CONNECTION_PROPERTY_BASE + 0;
+static const am_CustomSystemPropertyType_t SYP_VOLUME_BATCHED_REQUESTS = \
+    VOLUME_PROPERTY_BASE + 0;
 
 static const am_CustomClassProperty_t CP_PER_SINK_CLASS_VOLUME_SUPPORT = \
     GLOBAL_PROPERTY_BASE + 0;
@@ -808,6 +812,10 @@ struct gc_Action_s
 {
     gc_Action_e                         actionType;
     std::map<std::string, std::string > mapParameters;
+
+    // names of parameters which contain macros, functions or quotes and thus need to be
+    // evaluated against the trigger. Filled by configuration parser for policy actions.
+    std::vector<std::string >           listDynamicParameters;
 };
 
 // serialize members for logging
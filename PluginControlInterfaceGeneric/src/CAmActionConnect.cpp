@@ -44,6 +44,7 @@ CAmActionConnect::CAmActionConnect()
 
     // optional parameters to pass-on to the implicit CAmMainConnectionActionConnect
     _registerParam(ACTION_PARAM_CONNECTION_FORMAT, &mConnectionFormatParam);
+    _registerParam(ACTION_PARAM_PARALLEL, &mParallelRoutesParam);
     _registerParam(ACTION_PARAM_MAIN_VOLUME, &mMainVolumeParam);
     _registerParam(ACTION_PARAM_MAIN_VOLUME_STEP, &mMainVolumeStepParam);
     _registerParam(ACTION_PARAM_VOLUME, &mVolumeParam);
@@ -87,6 +88,7 @@ int CAmActionConnect::_execute(void)
         if (NULL != pAction)
         {
             pAction->setParam(ACTION_PARAM_CONNECTION_FORMAT, &mConnectionFormatParam);
+            pAction->setParam(ACTION_PARAM_PARALLEL, &mParallelRoutesParam);
             pAction->setUndoRequried(true);
             auto pClassElement = pMainConnectionElement->getClassElement();
             if (pClassElement != nullptr)
@@ -323,6 +325,7 @@ IAmActionCommand *CAmActionConnect::_createActionMainConnectionSetVolume(
     {
         CAmActionParam<std::string > connectionNameParam(pMainConnection->getName());
         pAction->setParam(ACTION_PARAM_CONNECTION_NAME, &connectionNameParam);
+        pAction->setParam(ACTION_PARAM_PARALLEL, &mParallelRoutesParam);
 
         if (mMainVolumeParam.isSet() || mMainVolumeStepParam.isSet()
                 || mVolumeParam.isSet() || mVolumeStepParam.isSet())
@@ -34,6 +34,7 @@ CAmActionContainer::CAmActionContainer(const std::string &name)
     , mTimeout(INFINITE_TIMEOUT)
     , mExecutionTime(0)
     , mUndoTime(0)
+    , mParallel(false)
 {
     mStartTime.tv_nsec = mStartTime.tv_sec = 0;
 
@@ -167,6 +168,11 @@ void CAmActionContainer::_registerParam(const std::string &paramName, IAmActionP
     mMapParameters[paramName] = pParam;
 }
 
+void CAmActionContainer::_registerParallelParam(void)
+{
+    _registerParam(ACTION_PARAM_PARALLEL, &mParallelParam);
+}
+
 int CAmActionContainer::execute(void)
 {
     int index;
@@ -181,6 +187,7 @@ int CAmActionContainer::execute(void)
          * note if down as
          */
         clock_gettime(CLOCK_MONOTONIC, &mStartTime);
+        mParallelParam.getParam(mParallel);
         setError(_execute());
         mExecutionTime = _calculateTimeDifference(mStartTime);
         setStatus(AS_EXECUTING);
@@ -190,7 +197,11 @@ int CAmActionContainer::execute(void)
         }
     }
 
-    if (AS_EXECUTING == getStatus())
+    if ((AS_EXECUTING == getStatus()) && isParallel())
+    {
+        _executeParallel();
+    }
+    else if (AS_EXECUTING == getStatus())
     {
         index = _getIndex();
         while (index < _getNumChildActions())
@@ -321,6 +332,11 @@ int CAmActionContainer::update(const int result)
             , "having", mListChildActions.size(), "sub-actions"
             , "after", _calculateTimeDifference(mStartTime), "ms");
 
+    if (isParallel() && (AS_EXECUTING == getStatus()))
+    {
+        return _updateParallel(result);
+    }
+
     setError(result);
     _update(result, _getIndex());
     ActionState_e state = getStatus();
@@ -355,6 +371,112 @@ int CAmActionContainer::update(const int result)
     return 0;
 }
 
+int CAmActionContainer::_executeParallel(void)
+{
+    int numChildActions = _getNumChildActions();
+    for (int index = 0; index < numChildActions; ++index)
+    {
+        // do not dispatch further children once an error or time-out was detected
+        if ((getStatus() != AS_EXECUTING) || (getError() > 0))
+        {
+            break;
+        }
+
+        IAmActionCommand *child      = mListChildActions[index];
+        ActionState_e     childState = child->getStatus();
+        if (childState == AS_NOT_STARTED)
+        {
+            if (getTimeout() != INFINITE_TIMEOUT)
+            {
+                /*
+                 * children run concurrently, so the remaining time budget is based on the
+                 * wall-clock time since own start instead of the sum of child execution times
+                 */
+                uint32_t elapsedTimeinms = _calculateTimeDifference(mStartTime);
+                if (elapsedTimeinms > getTimeout())
+                {
+                    LOG_FN_ERROR(__FILENAME__, __func__, mName, "TimeOut occurred after", elapsedTimeinms
+                            , "ms before dispatching child #", index, child->getName());
+
+                    // wait for outstanding children, then roll-back
+                    update(E_ABORTED);
+                    break;
+                }
+
+                child->setTimeout(getTimeout() - elapsedTimeinms);
+            }
+        }
+        else if (childState != AS_EXECUTING)
+        {
+            continue;
+        }
+
+        LOG_FN_DEBUG(__FILENAME__, __func__, mStatus, mName, "dispatching child #", index
+                , childState, child->getName(), "with timeout", child->getTimeout());
+        child->execute();
+    }
+
+    // completes immediately if there are no children or all of them finished synchronously
+    if (AS_EXECUTING == getStatus())
+    {
+        update(getError());
+    }
+
+    return 0;
+}
+
+int CAmActionContainer::_updateParallel(const int result)
+{
+    // keep the first error reported by any of the concurrently executing children
+    if (getError() <= 0)
+    {
+        setError(result);
+    }
+
+    _update(result, _getIndex());
+
+    int numExecuting  = 0;
+    int numNotStarted = 0;
+    for (auto pChild : mListChildActions)
+    {
+        if (pChild->getStatus() == AS_EXECUTING)
+        {
+            numExecuting++;
+        }
+        else if (pChild->getStatus() == AS_NOT_STARTED)
+        {
+            numNotStarted++;
+        }
+    }
+
+    if (numExecuting > 0)
+    {
+        // wait for the acknowledgments of all dispatched children
+        return 0;
+    }
+
+    if (getError() > 0)
+    {
+        setStatus(AS_ERROR_STOPPED);
+    }
+    else if (numNotStarted == 0)
+    {
+        setStatus(AS_COMPLETED);
+    }
+    else
+    {
+        // dispatching still in progress
+        return 0;
+    }
+
+    // undo shall start from the last child and walk backwards
+    _setIndex(_getNumChildActions());
+    _update(getError());
+    notify(getError());
+
+    return 0;
+}
+
 int CAmActionContainer::cleanup(void)
 {
     std::vector<IAmActionCommand * >::iterator itListChildActions;
@@ -426,6 +548,16 @@ bool CAmActionContainer::isEmpty(void)
     return mListChildActions.empty();
 }
 
+void CAmActionContainer::setParallel(const bool parallel)
+{
+    mParallel = parallel;
+}
+
+bool CAmActionContainer::isParallel(void) const
+{
+    return mParallel;
+}
+
 bool CAmActionContainer::getUndoRequired(void)
 {
     return mUndoRequired;
@@ -42,6 +42,7 @@ CAmActionDisconnect::CAmActionDisconnect()
     _registerParam(ACTION_PARAM_EXCEPT_SOURCE_NAME, &mlistSourceExceptionsParam);
     _registerParam(ACTION_PARAM_EXCEPT_SINK_NAME, &mListSinkExceptionsParam);
     _registerParam(ACTION_PARAM_CONNECTION_STATE, &mListConnectionStatesParam);
+    _registerParam(ACTION_PARAM_PARALLEL, &mParallelRoutesParam);
 }
 
 CAmActionDisconnect::~CAmActionDisconnect()
@@ -104,6 +105,7 @@ int CAmActionDisconnect::_execute(void)
                 setSourceStateDir.setParam(classTypeToDisconnectDirectionLUT[pClassElement->getClassType()]);
                 pAction->setParam(ACTION_PARAM_SET_SOURCE_STATE_DIRECTION, &setSourceStateDir);
             }
+            pAction->setParam(ACTION_PARAM_PARALLEL, &mParallelRoutesParam);
             append(pAction);
         }
     }
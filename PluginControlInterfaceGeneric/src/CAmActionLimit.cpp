@@ -57,10 +57,7 @@ int CAmActionLimit::_execute(void)
     }
 
     // finally, create the actions to modify the routing-side elements
-    for (auto &settings : mMatrix)
-    {
-        _createActionSetElementVolume(settings.first, settings.second);
-    }
+    _createActionsSetElementVolume();
 
     return E_OK;
 }
@@ -67,10 +67,7 @@ int CAmActionSetVolume::_execute(void)
     }
 
     // finally, create the actions to modify the routing-side elements
-    for (auto & settings : mMatrix)
-    {
-        _createActionSetElementVolume(settings.first, settings.second);
-    }
+    _createActionsSetElementVolume();
 
     return E_OK;
 }
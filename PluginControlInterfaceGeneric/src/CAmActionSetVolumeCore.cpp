@@ -18,6 +18,7 @@
 #include "CAmActionSetVolumeCore.h"
 #include "CAmMainConnectionElement.h"
 #include "CAmHandleStore.h"
+#include "CAmSystemElement.h"
 
 
 namespace am {
@@ -26,6 +27,7 @@ namespace gc {
 
 CAmActionSetVolumeCore::CAmActionSetVolumeCore(const std::string &name)
     : CAmActionContainer(name)
+    , mBatchedRequests(false)
 {
     _registerParam(ACTION_PARAM_CLASS_NAME,      &mClassNameParam);
     _registerParam(ACTION_PARAM_SOURCE_NAME,     &mSourceNameParam);
@@ -34,6 +36,15 @@ CAmActionSetVolumeCore::CAmActionSetVolumeCore(const std::string &name)
 
     _registerParam(ACTION_PARAM_RAMP_TIME,       &mRampTimeParam);
     _registerParam(ACTION_PARAM_RAMP_TYPE,       &mRampTypeParam);
+
+    // element volumes are independent of each other, so they might be changed together
+    _registerParallelParam();
+
+    std::shared_ptr<CAmSystemElement > pSystem = CAmSystemFactory::getElement(SYSTEM_ELEMENT_NAME);
+    if (pSystem != nullptr)
+    {
+        mBatchedRequests = pSystem->isVolumeBatchingEnabled();
+    }
 }
 
 CAmActionSetVolumeCore::~CAmActionSetVolumeCore()
@@ -478,12 +489,54 @@ void CAmActionSetVolumeCore::_createActionSetElementVolume(const std::shared_ptr
         am_CustomRampType_t rampType = DEFAULT_RAMP_TYPE;
         mRampTimeParam.getParam(rampTime);
         mRampTypeParam.getParam(rampType);
-        append(new CAmActionSetElementVolume(pElement, settings.target, rampTime, rampType));
+        if (mBatchedRequests && (pElement != nullptr) && pElement->getVolumeSupport())
+        {
+            // combine with other changes of the same domain into one routing side request
+            CAmActionSetDomainVolumes *&pDomainAction = mMapDomainVolumeActions[pElement->getDomainID()];
+            if (pDomainAction == NULL)
+            {
+                pDomainAction = new CAmActionSetDomainVolumes(pElement->getDomainID(), rampTime, rampType);
+                append(pDomainAction);
+            }
+
+            pDomainAction->addElement(pElement, settings.target);
+        }
+        else
+        {
+            append(new CAmActionSetElementVolume(pElement, settings.target, rampTime, rampType));
+        }
 
         LOG_FN_DEBUG(__FILENAME__, __func__, pElement->getType(), pElement->getName(), settings.target);
     }
 }
 
+void CAmActionSetVolumeCore::_createActionsSetElementVolume(void)
+{
+    for (auto &settings : mMatrix)
+    {
+        _createActionSetElementVolume(settings.first, settings.second);
+    }
+
+    // the appended domain actions are owned by the action list, a later execution creates new ones
+    mMapDomainVolumeActions.clear();
+}
+
+am_volume_t CAmActionSetVolumeCore::_getRoutingSideVolume(const std::shared_ptr<CAmRoutePointElement> &pElement
+        , const VolumeInfo_t &request)
+{
+    am_volume_t volume = request.volume + request.offset;
+    if (request.muteState == MS_MUTED)
+    {
+        volume = AM_MUTE;
+    }
+    else
+    {
+        volume = std::min( pElement->getMaxVolume(), std::max(volume, pElement->getMinVolume()));
+    }
+
+    return pElement->getRoutingSideVolume(volume);
+}
+
 // *****************************************************************************
 //            sub-action    S e t   E l e m e n t - V o l u m e
 //
@@ -604,19 +657,10 @@ int CAmActionSetVolumeCore::CAmActionSetElementVolume::_setRoutingSideVolume(con
     }
 
     // calculate routing-side volume
-    am_volume_t        volume = request.volume + request.offset;
-    if (request.muteState == MS_MUTED)
-    {
-        volume = AM_MUTE;
-    }
-    else
-    {
-        volume = std::min( mpElement->getMaxVolume(), std::max(volume, mpElement->getMinVolume()));
-    }
-    am_volume_t routingVolume = mpElement->getRoutingSideVolume(volume);
+    am_volume_t routingVolume = _getRoutingSideVolume(mpElement, request);
 
-    LOG_FN_INFO(__FILENAME__, getName(), __func__, mpElement->getType(), mpElement->getName(), "sending", volume
-            , "as", routingVolume, "for request {volume", request.volume, "offset", request.offset, request.muteState, "}");
+    LOG_FN_INFO(__FILENAME__, getName(), __func__, mpElement->getType(), mpElement->getName(), "sending"
+            , routingVolume, "for request {volume", request.volume, "offset", request.offset, request.muteState, "}");
 
     am_Error_e         result = E_UNKNOWN;
     if (mpElement->getType() == ET_SINK)
@@ -637,6 +681,189 @@ int CAmActionSetVolumeCore::CAmActionSetElementVolume::_setRoutingSideVolume(con
     return result;
 }
 
+// *****************************************************************************
+//            sub-action    S e t   D o m a i n - V o l u m e s
+//
+
+CAmActionSetVolumeCore::CAmActionSetDomainVolumes::CAmActionSetDomainVolumes(const am_domainID_t domainID
+        , am_time_t rampTime, am_CustomRampType_t rampType)
+    : CAmActionCommand("CAmActionSetDomainVolumes")
+    , mDomainID(domainID)
+    , mHandle({H_UNKNOWN, 0})
+    , mRampTime(rampTime)
+    , mRampType(rampType)
+{
+    // always enable the undo feature
+    setUndoRequried(true);
+}
+
+CAmActionSetVolumeCore::CAmActionSetDomainVolumes::~CAmActionSetDomainVolumes()
+{
+
+}
+
+void CAmActionSetVolumeCore::CAmActionSetDomainVolumes::addElement(const std::shared_ptr<CAmRoutePointElement> &pElement
+        , const VolumeInfo_t &settings)
+{
+    ElementInfo_t info;
+    info.pElement  = pElement;
+    info.requested = settings;
+    mListElements.push_back(info);
+}
+
+int CAmActionSetVolumeCore::CAmActionSetDomainVolumes::_execute(void)
+{
+    // memorize current state for potential request to roll-back
+    for (auto &info : mListElements)
+    {
+        info.recent.volume    = info.pElement->getVolume();
+        info.recent.offset    = info.pElement->getOffsetVolume();
+        info.recent.muteState = info.pElement->getMuteState();
+    }
+
+    return _setRoutingSideVolumes(false);
+}
+
+int CAmActionSetVolumeCore::CAmActionSetDomainVolumes::_update(int result)
+{
+    CAmHandleStore::instance().clearHandle(mHandle);
+
+    if ((E_OK == result) && (AS_COMPLETED == getStatus()))
+    {
+        for (const auto &info : mListElements)
+        {
+            _applyVolume(info, info.requested);
+        }
+    }
+    else if (AS_UNDO_COMPLETE == getStatus())
+    {
+        for (const auto &info : mListElements)
+        {
+            _applyVolume(info, info.recent);
+        }
+    }
+    else
+    {
+        // partial failure - adopt the volumes which the routing side has confirmed nevertheless
+        const std::vector<am_Volumes_s > &listVolumes = CAmHandleStore::instance().getConfirmedVolumes();
+        for (const auto &info : mListElements)
+        {
+            if (_isConfirmed(info, listVolumes))
+            {
+                _applyVolume(info, info.requested);
+            }
+        }
+
+        LOG_FN_WARN(__FILENAME__, __func__, "domain", mDomainID, "unhandled result", (am_Error_e)result
+                , "return code", getStatus(), "with", listVolumes.size(), "of", mListElements.size()
+                , "volumes confirmed");
+    }
+
+    return E_OK;
+}
+
+int CAmActionSetVolumeCore::CAmActionSetDomainVolumes::_undo(void)
+{
+    LOG_FN_WARN(__FILENAME__, getName(), __func__, "reset routing-side volumes for domain", mDomainID);
+
+    return _setRoutingSideVolumes(true);
+}
+
+int CAmActionSetVolumeCore::CAmActionSetDomainVolumes::_setRoutingSideVolumes(const bool rollBack)
+{
+    if (mListElements.empty())
+    {
+        return E_OK;
+    }
+
+    IAmControlReceive *pControlReceive = mListElements.front().pElement->getControlReceive();
+    if (pControlReceive == NULL)
+    {
+        LOG_FN_ERROR(__FILENAME__, getName(), __func__, "pControlReceive is NULL");
+
+        return E_NOT_POSSIBLE;
+    }
+
+    std::vector<am_Volumes_s > listVolumes;
+    for (const auto &info : mListElements)
+    {
+        if (info.recent == info.requested)
+        {
+            continue;
+        }
+
+        const VolumeInfo_t &request = rollBack ? info.recent : info.requested;
+        am_Volumes_s        volume;
+        if (info.pElement->getType() == ET_SINK)
+        {
+            volume.volumeType    = VT_SINK;
+            volume.volumeID.sink = info.pElement->getID();
+        }
+        else
+        {
+            volume.volumeType      = VT_SOURCE;
+            volume.volumeID.source = info.pElement->getID();
+        }
+
+        volume.volume = _getRoutingSideVolume(info.pElement, request);
+        volume.ramp   = mRampType;
+        volume.time   = mRampTime;
+        listVolumes.push_back(volume);
+
+        LOG_FN_DEBUG(__FILENAME__, getName(), __func__, info.pElement->getType(), info.pElement->getName()
+                , "sending", volume.volume, "for request", request);
+    }
+
+    if (listVolumes.empty())
+    {
+        LOG_FN_DEBUG(__FILENAME__, getName(), __func__, "nothing to do for domain", mDomainID);
+
+        return E_OK;
+    }
+
+    LOG_FN_INFO(__FILENAME__, getName(), __func__, "sending", listVolumes.size(), "volumes to domain", mDomainID);
+
+    am_Error_e result = pControlReceive->setVolumes(mHandle, listVolumes);
+    if (result == E_OK)
+    {
+        CAmHandleStore::instance().saveHandle(mHandle, this);
+        return E_WAIT_FOR_CHILD_COMPLETION;
+    }
+
+    return result;
+}
+
+void CAmActionSetVolumeCore::CAmActionSetDomainVolumes::_applyVolume(const ElementInfo_t &info
+        , const VolumeInfo_t &settings)
+{
+    LOG_FN_DEBUG(__FILENAME__, __func__, info.pElement->getType(), info.pElement->getName()
+            , "volume:", settings.volume, "offset:", settings.offset, settings.muteState);
+
+    info.pElement->setMuteState(settings.muteState);
+    info.pElement->setVolume(settings.volume);
+    info.pElement->setOffsetVolume(settings.offset);
+}
+
+bool CAmActionSetVolumeCore::CAmActionSetDomainVolumes::_isConfirmed(const ElementInfo_t &info
+        , const std::vector<am_Volumes_s > &listVolumes)
+{
+    for (const auto &volume : listVolumes)
+    {
+        if ((info.pElement->getType() == ET_SINK) && (volume.volumeType == VT_SINK)
+            && (volume.volumeID.sink == info.pElement->getID()))
+        {
+            return true;
+        }
+        else if ((info.pElement->getType() == ET_SOURCE) && (volume.volumeType == VT_SOURCE)
+                 && (volume.volumeID.source == info.pElement->getID()))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 
 } /* namespace gc */
 } /* namespace am */
@@ -36,11 +36,16 @@ namespace gc {
 
 #define CLASS_LEVEL_SINK "*"
 
+uint32_t CAmClassElement::mRouteCacheCurrentGeneration = 0;
+uint32_t CAmClassElement::mRouteCacheHits              = 0;
+uint32_t CAmClassElement::mRouteCacheMisses            = 0;
+
 CAmClassElement::CAmClassElement(const gc_Class_s &gcClass, IAmControlReceive *pControlReceive)
     : CAmLimitableElement(ET_CLASS, gcClass.name, pControlReceive)
     , mClass(gcClass)
     , mSourceClassID(0)
     , mSinkClassID(0)
+    , mRouteCacheGeneration(mRouteCacheCurrentGeneration)
 {
     mClassLastVolume.className           = gcClass.name;
     mLastMainConnectionsVolume.className = gcClass.name;
@@ -125,46 +130,69 @@ am_Error_e CAmClassElement::createMainConnection(const std::string &sourceName,
         return E_NOT_POSSIBLE;
     }
 
-    pMainConnection = CAmMainConnectionFactory::getElement(sourceName + ":" + sinkName);
+    const std::string connectionName = sourceName + ":" + sinkName;
+    pMainConnection = CAmMainConnectionFactory::getElement(connectionName);
     if (nullptr != pMainConnection)
     {
         result = E_ALREADY_EXISTS;
     }
     else
     {
-        /*
-         * 1. get the route from daemon
-         * 2. get the route from topology
-         * 3. validate if the route from topology exist in the list retrieved from daemon
-         * 4. if the route is present then use that route for connection creation.
-         */
-        result = mpControlReceive->getRoute(false, pSourceElement->getID(), pSinkElement->getID(),
-                listRoutes);
-        if ((E_OK != result) || (true == listRoutes.empty()))
+        if (mRouteCacheGeneration != mRouteCacheCurrentGeneration)
+        {
+            mMapRouteCache.clear();
+            mRouteCacheGeneration = mRouteCacheCurrentGeneration;
+        }
+
+        auto itMapRouteCache = mMapRouteCache.find(connectionName);
+        if (itMapRouteCache != mMapRouteCache.end())
         {
-            LOG_FN_ERROR(__FILENAME__, __func__, "getting route list from daemon failed");
+            mRouteCacheHits++;
+            route  = itMapRouteCache->second;
+            result = E_OK;
         }
         else
         {
-            std::shared_ptr<CAmSystemElement > pSystemElement = nullptr;
-            pSystemElement = CAmSystemFactory::getElement(SYSTEM_ELEMENT_NAME);
-            result         = _getPreferredRoute(sourceName, sinkName, route);
-            if ((result != E_OK) && (pSystemElement->isNonTopologyRouteAllowed() == true))
+            mRouteCacheMisses++;
+            /*
+             * 1. get the route from daemon
+             * 2. get the route from topology
+             * 3. validate if the route from topology exist in the list retrieved from daemon
+             * 4. if the route is present then use that route for connection creation.
+             */
+            result = mpControlReceive->getRoute(false, pSourceElement->getID(), pSinkElement->getID(),
+                    listRoutes);
+            if ((E_OK != result) || (true == listRoutes.empty()))
             {
-                LOG_FN_INFO(__FILENAME__, __func__, getName(), "failed to get route from topology");
-                /*
-                 * Preferred route not found from topology could be unknown source or sink !! select
-                 * the first route from daemon.
-                 */
-                route.sinkID   = listRoutes.begin()->sinkID;
-                route.sourceID = listRoutes.begin()->sourceID;
-                route.route    = listRoutes.begin()->route;
-                route.name     = sourceName + ":" + sinkName;
-                result         = E_OK;
+                LOG_FN_ERROR(__FILENAME__, __func__, "getting route list from daemon failed");
             }
             else
             {
-                result = _validateRouteFromTopology(listRoutes, route);
+                std::shared_ptr<CAmSystemElement > pSystemElement = nullptr;
+                pSystemElement = CAmSystemFactory::getElement(SYSTEM_ELEMENT_NAME);
+                result         = _getPreferredRoute(sourceName, sinkName, route);
+                if ((result != E_OK) && (pSystemElement->isNonTopologyRouteAllowed() == true))
+                {
+                    LOG_FN_INFO(__FILENAME__, __func__, getName(), "failed to get route from topology");
+                    /*
+                     * Preferred route not found from topology could be unknown source or sink !! select
+                     * the first route from daemon.
+                     */
+                    route.sinkID   = listRoutes.begin()->sinkID;
+                    route.sourceID = listRoutes.begin()->sourceID;
+                    route.route    = listRoutes.begin()->route;
+                    route.name     = connectionName;
+                    result         = E_OK;
+                }
+                else
+                {
+                    result = _validateRouteFromTopology(listRoutes, route);
+                }
+            }
+
+            if (E_OK == result)
+            {
+                mMapRouteCache[connectionName] = route;
             }
         }
 
@@ -229,6 +257,18 @@ am_Error_e CAmClassElement::createMainConnection(const std::string &sourceName,
     return result;
 }
 
+void CAmClassElement::invalidateRouteCache(void)
+{
+    // individual caches are dropped lazily on next use
+    mRouteCacheCurrentGeneration++;
+}
+
+void CAmClassElement::getRouteCacheStatistics(uint32_t &hits, uint32_t &misses)
+{
+    hits   = mRouteCacheHits;
+    misses = mRouteCacheMisses;
+}
+
 am_Error_e CAmClassElement::_validateRouteFromTopology(std::vector<am_Route_s > &listRoutes,
     gc_Route_s &topologyRoute) const
 {
@@ -36,6 +36,7 @@ CAmConfigurationReader &CAmConfigurationReader::instance(void)
 }
 
 CAmConfigurationReader::CAmConfigurationReader()
+    : mLoadCount(0)
 {
     reload();
 }
@@ -65,6 +66,14 @@ void CAmConfigurationReader::reload(void)
         mListSystemProperties = configuration.listSystemProperties;
         mMapScaleConversions  = configuration.listTemplateMapScaleConversions;
     }
+
+    _prepareProcessIndex();
+    mLoadCount++;
+}
+
+unsigned int CAmConfigurationReader::getLoadCount(void) const
+{
+    return mLoadCount;
 }
 
 void CAmConfigurationReader::getListSystemProperties(
@@ -139,34 +148,46 @@ am_Error_e CAmConfigurationReader::getElementByName(const std::string &elementNa
     return _getElementByName(elementName, classInstance, mMapClasses);
 }
 
-bool CAmConfigurationReader::_policysorting(gc_Process_s i, gc_Process_s j)
+bool CAmConfigurationReader::_policysorting(const gc_Process_s *pFirst, const gc_Process_s *pSecond)
 {
-    return (i.priority < j.priority);
+    return (pFirst->priority < pSecond->priority);
 }
 
-am_Error_e CAmConfigurationReader::getListProcess(const gc_Trigger_e trigger,
-    std::vector<gc_Process_s > &listProcesses)
+const std::vector<const gc_Process_s * > &CAmConfigurationReader::getListProcess(
+    const gc_Trigger_e trigger) const
 {
-    std::vector<gc_Policy_s >::iterator itListPolicies;
-    std::vector<int >::iterator         itListTriggers;
-    listProcesses.clear();
-    for (itListPolicies = mListPolicies.begin(); itListPolicies != mListPolicies.end();
-         ++itListPolicies)
+    static const std::vector<const gc_Process_s * > emptyList;
+    if (static_cast<unsigned int>(trigger) >= TRIGGER_MAX)
     {
-        for (itListTriggers = itListPolicies->listEvents.begin();
-             itListTriggers != itListPolicies->listEvents.end(); ++itListTriggers)
+        return emptyList;
+    }
+
+    return mListProcessIndex[trigger];
+}
+
+void CAmConfigurationReader::_prepareProcessIndex(void)
+{
+    for (int trigger = TRIGGER_UNKNOWN; trigger < TRIGGER_MAX; ++trigger)
+    {
+        std::vector<const gc_Process_s * > &listProcesses = mListProcessIndex[trigger];
+        listProcesses.clear();
+        for (const auto &policy : mListPolicies)
         {
-            if ((*itListTriggers == trigger) || (*itListTriggers == USER_ALL_TRIGGER))
+            for (const auto event : policy.listEvents)
             {
-                listProcesses.insert(listProcesses.end(), itListPolicies->listProcesses.begin(),
-                    itListPolicies->listProcesses.end());
+                if ((event == trigger) || (event == USER_ALL_TRIGGER))
+                {
+                    for (const auto &process : policy.listProcesses)
+                    {
+                        listProcesses.push_back(&process);
+                    }
+                }
             }
         }
-    }
 
-    // Now sort the policies in ascending order of priority
-    std::stable_sort(listProcesses.begin(), listProcesses.end(), _policysorting);
-    return E_OK;
+        // Now sort the policies in ascending order of priority
+        std::stable_sort(listProcesses.begin(), listProcesses.end(), _policysorting);
+    }
 }
 
 template <typename Telement>
@@ -84,6 +84,8 @@ CAmControllerPlugin::CAmControllerPlugin()
                              write system property etc."), false)
     , mpdomainRegiTimerCallback(this, &CAmControllerPlugin::_domainRegistrationTimeout)
     , mDomainRegistrationTimerHandle(0)
+    , mPendingPersistence(PC_NONE)
+    , mConnectionsRestored(false)
 {
     CAmCommandLineSingleton::instance()->add(mdebugEnable);
     CAmPersistenceWrapper::addCommandLineArgument();
@@ -278,10 +280,10 @@ void CAmControllerPlugin::setControllerReady()
             {
                 LOG_FN_DEBUG(__FILENAME__, __func__, "auto-registering domain #", pDomain->getID(), pDomain->getName());
 
-                gc_RegisterElementTrigger_s *pTrigger = new gc_RegisterElementTrigger_s;
-                pTrigger->elementName         = dom.name;
-                pTrigger->RegisterationStatus = E_OK;
-                CAmTriggerQueue::getInstance()->queue(SYSTEM_REGISTER_DOMAIN, pTrigger);
+                gc_RegisterElementTrigger_s trigger;
+                trigger.elementName         = dom.name;
+                trigger.RegisterationStatus = E_OK;
+                CAmTriggerQueue::getInstance()->queue(SYSTEM_REGISTER_DOMAIN, std::move(trigger));
 
                 iterateActions();
             }
@@ -419,16 +421,11 @@ am_Error_e CAmControllerPlugin::hookUserConnectionRequest(const am_sourceID_t so
     }
 
     result = E_OK;
-    gc_ConnectTrigger_s *pconnectTrigger = new gc_ConnectTrigger_s;
-    if (NULL == pconnectTrigger)
-    {
-        return E_NOT_POSSIBLE;
-    }
-
-    pconnectTrigger->className  = pClassElement->getName();
-    pconnectTrigger->sinkName   = sinkName;
-    pconnectTrigger->sourceName = sourceName;
-    CAmTriggerQueue::getInstance()->queue(USER_CONNECTION_REQUEST, pconnectTrigger);
+    gc_ConnectTrigger_s connectTrigger;
+    connectTrigger.className  = pClassElement->getName();
+    connectTrigger.sinkName   = sinkName;
+    connectTrigger.sourceName = sourceName;
+    CAmTriggerQueue::getInstance()->queue(USER_CONNECTION_REQUEST, std::move(connectTrigger));
     iterateActions();
     return result;
 }
@@ -453,17 +450,11 @@ am_Error_e CAmControllerPlugin::hookUserDisconnectionRequest(const am_mainConnec
     }
 
     // Store the trigger in a Queue
-    gc_DisconnectTrigger_s *triggerData = new gc_DisconnectTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:", connectionID);
-        return E_NOT_POSSIBLE;
-    }
-
-    triggerData->className  = pClassElement->getName();
-    triggerData->sourceName = pMainConnection->getMainSourceName();
-    triggerData->sinkName   = pMainConnection->getMainSinkName();
-    CAmTriggerQueue::getInstance()->queue(USER_DISCONNECTION_REQUEST, triggerData);
+    gc_DisconnectTrigger_s triggerData;
+    triggerData.className  = pClassElement->getName();
+    triggerData.sourceName = pMainConnection->getMainSourceName();
+    triggerData.sinkName   = pMainConnection->getMainSinkName();
+    CAmTriggerQueue::getInstance()->queue(USER_DISCONNECTION_REQUEST, std::move(triggerData));
     iterateActions();
     return E_OK;
 }
@@ -500,17 +491,11 @@ am_Error_e CAmControllerPlugin::hookUserSetMainSinkSoundProperty(
     }
 
     // Store the trigger in a Queue
-    gc_SinkSoundPropertyTrigger_s *triggerData = new gc_SinkSoundPropertyTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return E_NOT_POSSIBLE;
-    }
-
-    triggerData->sinkName                = pElement->getName();
-    triggerData->mainSoundProperty.type  = localMainSoundProperty.type;
-    triggerData->mainSoundProperty.value = localMainSoundProperty.value;
-    CAmTriggerQueue::getInstance()->queue(USER_SET_SINK_MAIN_SOUND_PROPERTY, triggerData);
+    gc_SinkSoundPropertyTrigger_s triggerData;
+    triggerData.sinkName                = pElement->getName();
+    triggerData.mainSoundProperty.type  = localMainSoundProperty.type;
+    triggerData.mainSoundProperty.value = localMainSoundProperty.value;
+    CAmTriggerQueue::getInstance()->queue(USER_SET_SINK_MAIN_SOUND_PROPERTY, std::move(triggerData));
     LOG_FN_EXIT(__FILENAME__, __func__);
     iterateActions();
     return (E_OK);
@@ -548,17 +533,11 @@ am_Error_e CAmControllerPlugin::hookUserSetMainSinkSoundProperties(
     }
 
     // Store the trigger in a Queue
-    gc_SinkSoundPropertiesTrigger_s *triggerData = new gc_SinkSoundPropertiesTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return E_NOT_POSSIBLE;
-    }
-
-    triggerData->sinkName              = pElement->getName();
-    triggerData->listMainSoundProperty = listMainSoundProperty;
+    gc_SinkSoundPropertiesTrigger_s triggerData;
+    triggerData.sinkName              = pElement->getName();
+    triggerData.listMainSoundProperty = listMainSoundProperty;
 
-    CAmTriggerQueue::getInstance()->queue(USER_SET_SINK_MAIN_SOUND_PROPERTIES, triggerData);
+    CAmTriggerQueue::getInstance()->queue(USER_SET_SINK_MAIN_SOUND_PROPERTIES, std::move(triggerData));
     iterateActions();
     return (E_OK);
 }
@@ -595,17 +574,11 @@ am_Error_e CAmControllerPlugin::hookUserSetMainSourceSoundProperty(
     }
 
     // Store the trigger in a Queue
-    gc_SourceSoundPropertyTrigger_s *triggerData = new gc_SourceSoundPropertyTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return E_NOT_POSSIBLE;
-    }
-
-    triggerData->sourceName              = pElement->getName();
-    triggerData->mainSoundProperty.type  = localMainSoundProperty.type;
-    triggerData->mainSoundProperty.value = localMainSoundProperty.value;
-    CAmTriggerQueue::getInstance()->queue(USER_SET_SOURCE_MAIN_SOUND_PROPERTY, triggerData);
+    gc_SourceSoundPropertyTrigger_s triggerData;
+    triggerData.sourceName              = pElement->getName();
+    triggerData.mainSoundProperty.type  = localMainSoundProperty.type;
+    triggerData.mainSoundProperty.value = localMainSoundProperty.value;
+    CAmTriggerQueue::getInstance()->queue(USER_SET_SOURCE_MAIN_SOUND_PROPERTY, std::move(triggerData));
     iterateActions();
     LOG_FN_EXIT(__FILENAME__, __func__);
     return (E_OK);
@@ -643,17 +616,11 @@ am_Error_e CAmControllerPlugin::hookUserSetMainSourceSoundProperties(const am_so
     }
 
     // Store the trigger in a Queue
-    gc_SourceSoundPropertiesTrigger_s *triggerData = new gc_SourceSoundPropertiesTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state: return = ", E_NOT_POSSIBLE);
-        return E_NOT_POSSIBLE;
-    }
-
-    triggerData->sourceName            = pElement->getName();
-    triggerData->listMainSoundProperty = listMainSoundProperty;
+    gc_SourceSoundPropertiesTrigger_s triggerData;
+    triggerData.sourceName            = pElement->getName();
+    triggerData.listMainSoundProperty = listMainSoundProperty;
 
-    CAmTriggerQueue::getInstance()->queue(USER_SET_SOURCE_MAIN_SOUND_PROPERTIES, triggerData);
+    CAmTriggerQueue::getInstance()->queue(USER_SET_SOURCE_MAIN_SOUND_PROPERTIES, std::move(triggerData));
     iterateActions();
     return (E_OK);
 }
@@ -670,15 +637,9 @@ am_Error_e CAmControllerPlugin::hookUserSetSystemProperty(const am_SystemPropert
     }
 
     // Store the trigger in a Queue
-    gc_SystemPropertyTrigger_s *triggerData = new gc_SystemPropertyTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return E_NOT_POSSIBLE;
-    }
-
-    triggerData->systemProperty = property;
-    CAmTriggerQueue::getInstance()->queue(USER_SET_SYSTEM_PROPERTY, triggerData);
+    gc_SystemPropertyTrigger_s triggerData;
+    triggerData.systemProperty = property;
+    CAmTriggerQueue::getInstance()->queue(USER_SET_SYSTEM_PROPERTY, std::move(triggerData));
     iterateActions();
 
     return (E_OK);
@@ -696,15 +657,9 @@ am_Error_e CAmControllerPlugin::hookUserSetSystemProperties(const std::vector<am
     }
 
     // Store the trigger in a Queue
-    gc_SystemPropertiesTrigger_s *triggerData = new gc_SystemPropertiesTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return E_NOT_POSSIBLE;
-    }
-
-    triggerData->listSystemProperty = listSystemProperty;
-    CAmTriggerQueue::getInstance()->queue(USER_SET_SYSTEM_PROPERTIES, triggerData);
+    gc_SystemPropertiesTrigger_s triggerData;
+    triggerData.listSystemProperty = listSystemProperty;
+    CAmTriggerQueue::getInstance()->queue(USER_SET_SYSTEM_PROPERTIES, std::move(triggerData));
     iterateActions();
     return (E_OK);
 }
@@ -722,17 +677,11 @@ am_Error_e CAmControllerPlugin::hookUserVolumeChange(const am_sinkID_t sinkID,
     LOG_FN_INFO(__FILENAME__, __func__, "sink", pElement->getName(), "with ID", sinkID, "mainVolume", mainVolume);
 
     // Store the trigger in a Queue
-    gc_SinkVolumeChangeTrigger_s *triggerData = new gc_SinkVolumeChangeTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return E_NOT_POSSIBLE;
-    }
-
-    triggerData->sinkName = pElement->getName();
-    triggerData->volume   = mainVolume;
-    triggerData->isStep = false;
-    CAmTriggerQueue::getInstance()->queue(USER_SET_VOLUME, triggerData);
+    gc_SinkVolumeChangeTrigger_s triggerData;
+    triggerData.sinkName = pElement->getName();
+    triggerData.volume   = mainVolume;
+    triggerData.isStep = false;
+    CAmTriggerQueue::getInstance()->queue(USER_SET_VOLUME, std::move(triggerData));
     iterateActions();
 
     return E_OK;
@@ -750,17 +699,11 @@ am_Error_e CAmControllerPlugin::hookUserVolumeStep(const am_sinkID_t sinkID, con
     LOG_FN_INFO(__FILENAME__, __func__, "sink", pElement->getName(), "with ID", sinkID, "increment", increment);
 
     // Store the trigger in a Queue
-    gc_SinkVolumeChangeTrigger_s *triggerData = new gc_SinkVolumeChangeTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return E_NOT_POSSIBLE;
-    }
-
-    triggerData->sinkName = pElement->getName();
-    triggerData->volume   = increment;
-    triggerData->isStep   = true;
-    CAmTriggerQueue::getInstance()->queue(USER_SET_VOLUME, triggerData);
+    gc_SinkVolumeChangeTrigger_s triggerData;
+    triggerData.sinkName = pElement->getName();
+    triggerData.volume   = increment;
+    triggerData.isStep   = true;
+    CAmTriggerQueue::getInstance()->queue(USER_SET_VOLUME, std::move(triggerData));
     iterateActions();
 
     return (E_OK);
@@ -788,17 +731,11 @@ am_Error_e CAmControllerPlugin::hookUserSetSinkMuteState(const am_sinkID_t sinkI
     }
 
     // Store the trigger in a Queue
-    gc_SinkMuteTrigger_s *triggerData = new gc_SinkMuteTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return E_NOT_POSSIBLE;
-    }
-
-    triggerData->sinkName  = pElement->getName();
-    triggerData->muteState = muteState;
+    gc_SinkMuteTrigger_s triggerData;
+    triggerData.sinkName  = pElement->getName();
+    triggerData.muteState = muteState;
     // mute state will be taken care at policy send side.
-    CAmTriggerQueue::getInstance()->queue(USER_SET_SINK_MUTE_STATE, triggerData);
+    CAmTriggerQueue::getInstance()->queue(USER_SET_SINK_MUTE_STATE, std::move(triggerData));
     iterateActions();
     LOG_FN_EXIT(__FILENAME__, __func__);
     return (E_OK);
@@ -809,6 +746,8 @@ am_Error_e CAmControllerPlugin::hookSystemRegisterDomain(const am_Domain_s &doma
 {
     gc_Domain_s domainInfo;
 
+    _invalidateRoutes();
+
     am_Error_e  result = CAmConfigurationReader::instance().getElementByName(domainData.name, domainInfo);
     if (E_OK == result)
     {
@@ -844,15 +783,10 @@ am_Error_e CAmControllerPlugin::hookSystemRegisterDomain(const am_Domain_s &doma
         if (nullptr != pElement)
         {
             domainID = pElement->getID();
-            gc_RegisterElementTrigger_s *pregisterdomainTrigger = new gc_RegisterElementTrigger_s;
-            if (NULL == pregisterdomainTrigger)
-            {
-                return E_NOT_POSSIBLE;
-            }
-
-            pregisterdomainTrigger->elementName         = domainData.name;
-            pregisterdomainTrigger->RegisterationStatus = result;
-            CAmTriggerQueue::getInstance()->queue(SYSTEM_REGISTER_DOMAIN, pregisterdomainTrigger);
+            gc_RegisterElementTrigger_s registerDomainTrigger;
+            registerDomainTrigger.elementName         = domainData.name;
+            registerDomainTrigger.RegisterationStatus = result;
+            CAmTriggerQueue::getInstance()->queue(SYSTEM_REGISTER_DOMAIN, std::move(registerDomainTrigger));
             LOG_FN_INFO(__FILENAME__, __func__, "  registering", pElement->getName()
                 , "with ID", pElement->getID(), "result =", result);
             result = E_OK;
@@ -876,6 +810,8 @@ am_Error_e CAmControllerPlugin::hookSystemDeregisterDomain(const am_domainID_t d
     std::vector<am_sinkID_t >    listSinkIDs;
     std::vector<am_gatewayID_t > listGatewaysIDs;
 
+    _invalidateRoutes();
+
     NULL_CHECK_AND_RETURN_ERROR(mpControlReceive);
 
     auto pDomainElement = CAmDomainFactory::getElement(domainID);
@@ -894,15 +830,10 @@ am_Error_e CAmControllerPlugin::hookSystemDeregisterDomain(const am_domainID_t d
         }
 
         // prepare and launch trigger
-        gc_UnRegisterElementTrigger_s *unRegisterTrigger = new gc_UnRegisterElementTrigger_s;
-        if (NULL == unRegisterTrigger)
-        {
-            LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-            return E_NOT_POSSIBLE;
-        }
-        unRegisterTrigger->elementName           = domainInfo.name;
-        unRegisterTrigger->unRegisterationStatus = E_OK;
-        CAmTriggerQueue::getInstance()->queue(SYSTEM_DEREGISTER_DOMAIN, unRegisterTrigger);
+        gc_UnRegisterElementTrigger_s unRegisterTrigger;
+        unRegisterTrigger.elementName           = domainInfo.name;
+        unRegisterTrigger.unRegisterationStatus = E_OK;
+        CAmTriggerQueue::getInstance()->queue(SYSTEM_DEREGISTER_DOMAIN, std::move(unRegisterTrigger));
         result = mpControlReceive->getListSourcesOfDomain(domainID, listSourceIDs);
         if ((E_OK == result) && (false == listSourceIDs.empty()))
         {
@@ -1027,15 +958,10 @@ am_Error_e CAmControllerPlugin::hookSystemRegisterEarlyMainConnection(am_domainI
     auto pConnection = CAmMainConnectionFactory::createElement(gcroute, mpControlReceive);
 
     // append trigger to queue so policy engine can react on this event
-    auto *pTrigger = new gc_RegisterElementTrigger_s;
-    if (nullptr == pTrigger)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return E_NOT_POSSIBLE;
-    }
-    pTrigger->elementName = gcroute.name;
-    pTrigger->RegisterationStatus = E_OK;
-    CAmTriggerQueue::getInstance()->queue(SYSTEM_REGISTER_EARLY_CONNECTION, pTrigger);
+    gc_RegisterElementTrigger_s trigger;
+    trigger.elementName = gcroute.name;
+    trigger.RegisterationStatus = E_OK;
+    CAmTriggerQueue::getInstance()->queue(SYSTEM_REGISTER_EARLY_CONNECTION, std::move(trigger));
 
     iterateActions();
     return E_OK;
@@ -1058,16 +984,10 @@ void CAmControllerPlugin::hookSystemDomainRegistrationComplete(const am_domainID
         domainInfo.domainID = 0;
         mpControlReceive->enterDomainDB(domainInfo, domainInfo.domainID);
         LOG_FN_INFO(__FILENAME__, __func__, domainInfo.name, "with ID", domainInfo.domainID);
-        gc_DomainRegisterationCompleteTrigger_s *registrationCompleteTrigger = new gc_DomainRegisterationCompleteTrigger_s;
-        if (NULL == registrationCompleteTrigger)
-        {
-            LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-            return;
-        }
-
-        registrationCompleteTrigger->domainName = domainInfo.name;
+        gc_DomainRegisterationCompleteTrigger_s registrationCompleteTrigger;
+        registrationCompleteTrigger.domainName = domainInfo.name;
         CAmTriggerQueue::getInstance()->queue(SYSTEM_DOMAIN_REGISTRATION_COMPLETE,
-            registrationCompleteTrigger);
+            std::move(registrationCompleteTrigger));
     }
     else
     {
@@ -1086,23 +1006,18 @@ void CAmControllerPlugin::hookSystemDomainRegistrationComplete(const am_domainID
         }
 
         result = _restoreConnectionsFromPersistency();
-        gc_AllDomainRegisterationCompleteTrigger_s *pdomainRegistrationTrigger = new gc_AllDomainRegisterationCompleteTrigger_s;
-        if (NULL == pdomainRegistrationTrigger)
-        {
-            LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-            return;
-        }
-
+        mConnectionsRestored = true;
+        gc_AllDomainRegisterationCompleteTrigger_s domainRegistrationTrigger;
         if (E_OK == result)
         {
-            pdomainRegistrationTrigger->status = E_OK;
+            domainRegistrationTrigger.status = E_OK;
         }
         else
         {
-            pdomainRegistrationTrigger->status = E_DATABASE_ERROR;
+            domainRegistrationTrigger.status = E_DATABASE_ERROR;
         }
 
-        CAmTriggerQueue::getInstance()->queue(SYSTEM_ALL_DOMAIN_REGISTRATION_COMPLETE, pdomainRegistrationTrigger);
+        CAmTriggerQueue::getInstance()->queue(SYSTEM_ALL_DOMAIN_REGISTRATION_COMPLETE, std::move(domainRegistrationTrigger));
     }
     else
     {
@@ -1119,6 +1034,8 @@ am_Error_e CAmControllerPlugin::hookSystemRegisterSink(const am_Sink_s &sinkData
     gc_Sink_s                         sinkInfo;
     std::shared_ptr<CAmClassElement > pClassElement = nullptr;
 
+    _invalidateRoutes();
+
     // First check with the policy engine if this sink is allowed
     if (E_OK == CAmConfigurationReader::instance().getElementByName(sinkData.name, sinkInfo))
     {
@@ -1217,18 +1134,11 @@ am_Error_e CAmControllerPlugin::hookSystemRegisterSink(const am_Sink_s &sinkData
             result = E_NOT_POSSIBLE;
         }
 
-        gc_RegisterElementTrigger_s *registerTrigger =
-            new gc_RegisterElementTrigger_s;
-        if (NULL == registerTrigger)
-        {
-            LOG_FN_ERROR(__FILENAME__, __func__, "bad memory state:");
-            return E_NOT_POSSIBLE;
-        }
-
-        registerTrigger->elementName         = sinkData.name;
-        registerTrigger->RegisterationStatus = result;
+        gc_RegisterElementTrigger_s registerTrigger;
+        registerTrigger.elementName         = sinkData.name;
+        registerTrigger.RegisterationStatus = result;
         CAmTriggerQueue::getInstance()->queue(SYSTEM_REGISTER_SINK,
-            registerTrigger);
+            std::move(registerTrigger));
 
         LOG_FN_INFO(__FILENAME__, __func__, "registered sink", sinkData.name, sinkData.available.availability, result);
     }
@@ -1243,6 +1153,8 @@ am_Error_e CAmControllerPlugin::hookSystemDeregisterSink(const am_sinkID_t sinkI
     std::string                  name;
     std::shared_ptr<CAmElement > pElement = nullptr;
 
+    _invalidateRoutes();
+
     NULL_CHECK_AND_RETURN_ERROR(mpControlReceive);
 
     pElement = CAmSinkFactory::getElement(sinkID);
@@ -1253,16 +1165,10 @@ am_Error_e CAmControllerPlugin::hookSystemDeregisterSink(const am_sinkID_t sinkI
     }
 
     name = pElement->getName();
-    gc_UnRegisterElementTrigger_s *unRegisterTrigger = new gc_UnRegisterElementTrigger_s;
-    if (NULL == unRegisterTrigger)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return E_NOT_POSSIBLE;
-    }
-
-    unRegisterTrigger->elementName           = name;
-    unRegisterTrigger->unRegisterationStatus = E_OK;
-    CAmTriggerQueue::getInstance()->queue(SYSTEM_DEREGISTER_SINK, unRegisterTrigger);
+    gc_UnRegisterElementTrigger_s unRegisterTrigger;
+    unRegisterTrigger.elementName           = name;
+    unRegisterTrigger.unRegisterationStatus = E_OK;
+    CAmTriggerQueue::getInstance()->queue(SYSTEM_DEREGISTER_SINK, std::move(unRegisterTrigger));
 
     result = mpControlReceive->removeSinkDB(sinkID);
     if (result != E_OK)
@@ -1290,6 +1196,8 @@ am_Error_e CAmControllerPlugin::hookSystemRegisterSource(const am_Source_s &sour
     gc_Source_s                       sourceInfo;
     std::shared_ptr<CAmClassElement > pClassElement = nullptr;
 
+    _invalidateRoutes();
+
     // First check with the policy engine if this source is allowed
     if (E_OK == CAmConfigurationReader::instance().getElementByName(sourceData.name, sourceInfo))
     {
@@ -1377,18 +1285,11 @@ am_Error_e CAmControllerPlugin::hookSystemRegisterSource(const am_Source_s &sour
             result = E_NOT_POSSIBLE;
         }
 
-        gc_RegisterElementTrigger_s *registerTrigger =
-            new gc_RegisterElementTrigger_s;
-        if (NULL == registerTrigger)
-        {
-            LOG_FN_ERROR(__FILENAME__, __func__, "bad memory state:");
-            return E_NOT_POSSIBLE;
-        }
-
-        registerTrigger->elementName         = sourceData.name;
-        registerTrigger->RegisterationStatus = result;
+        gc_RegisterElementTrigger_s registerTrigger;
+        registerTrigger.elementName         = sourceData.name;
+        registerTrigger.RegisterationStatus = result;
         CAmTriggerQueue::getInstance()->queue(SYSTEM_REGISTER_SOURCE,
-            registerTrigger);
+            std::move(registerTrigger));
 
         LOG_FN_INFO(__FILENAME__, __func__, "registered source", sourceData.name
                 , "with ID", sourceID, sourceInfo.available.availability, result);
@@ -1404,6 +1305,8 @@ am_Error_e CAmControllerPlugin::hookSystemDeregisterSource(const am_sourceID_t s
     std::shared_ptr<CAmSourceElement > pSourceElement = nullptr;
     am_Error_e                         result         = E_NOT_POSSIBLE;
 
+    _invalidateRoutes();
+
     NULL_CHECK_AND_RETURN_ERROR(mpControlReceive);
 
     pSourceElement = CAmSourceFactory::getElement(sourceID);
@@ -1415,16 +1318,10 @@ am_Error_e CAmControllerPlugin::hookSystemDeregisterSource(const am_sourceID_t s
 
     LOG_FN_DEBUG(__FILENAME__, __func__, "source shared count ", pSourceElement.use_count());
     name = pSourceElement->getName();
-    gc_UnRegisterElementTrigger_s *unRegisterTrigger = new gc_UnRegisterElementTrigger_s;
-    if (NULL == unRegisterTrigger)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return E_NOT_POSSIBLE;
-    }
-
-    unRegisterTrigger->elementName           = name;
-    unRegisterTrigger->unRegisterationStatus = E_OK;
-    CAmTriggerQueue::getInstance()->queue(SYSTEM_DEREGISTER_SOURCE, unRegisterTrigger);
+    gc_UnRegisterElementTrigger_s unRegisterTrigger;
+    unRegisterTrigger.elementName           = name;
+    unRegisterTrigger.unRegisterationStatus = E_OK;
+    CAmTriggerQueue::getInstance()->queue(SYSTEM_DEREGISTER_SOURCE, std::move(unRegisterTrigger));
     result = mpControlReceive->removeSourceDB(sourceID);
     if (result != E_OK)
     {
@@ -1452,6 +1349,8 @@ am_Error_e CAmControllerPlugin::hookSystemRegisterGateway(const am_Gateway_s &ga
     std::shared_ptr<CAmElement > pElement = nullptr;
     gc_Gateway_s                 gatewayInfo;
 
+    _invalidateRoutes();
+
     if (E_OK == CAmConfigurationReader::instance().getElementByName(gatewayData.name, gatewayInfo))
     {
         gatewayInfo.gatewayID         = gatewayData.gatewayID;
@@ -1477,16 +1376,10 @@ am_Error_e CAmControllerPlugin::hookSystemRegisterGateway(const am_Gateway_s &ga
             result = E_NOT_POSSIBLE;
         }
 
-        gc_RegisterElementTrigger_s *registerTrigger = new gc_RegisterElementTrigger_s;
-        if (NULL == registerTrigger)
-        {
-            LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-            return E_NOT_POSSIBLE;
-        }
-
-        registerTrigger->elementName         = gatewayData.name;
-        registerTrigger->RegisterationStatus = result;
-        CAmTriggerQueue::getInstance()->queue(SYSTEM_REGISTER_GATEWAY, registerTrigger);
+        gc_RegisterElementTrigger_s registerTrigger;
+        registerTrigger.elementName         = gatewayData.name;
+        registerTrigger.RegisterationStatus = result;
+        CAmTriggerQueue::getInstance()->queue(SYSTEM_REGISTER_GATEWAY, std::move(registerTrigger));
         LOG_FN_INFO(__FILENAME__, __func__, "  registered gateway name:result=", gatewayData.name, result);
     }
     else
@@ -1503,6 +1396,8 @@ am_Error_e CAmControllerPlugin::hookSystemDeregisterGateway(const am_gatewayID_t
     am_Error_e  result = E_NOT_POSSIBLE;
     std::string name;
 
+    _invalidateRoutes();
+
     LOG_FN_ENTRY(__FILENAME__, __func__, gatewayID);
 
     NULL_CHECK_AND_RETURN_ERROR(mpControlReceive);
@@ -1515,16 +1410,10 @@ am_Error_e CAmControllerPlugin::hookSystemDeregisterGateway(const am_gatewayID_t
     }
 
     name = pElement->getName();
-    gc_UnRegisterElementTrigger_s *unRegisterTrigger = new gc_UnRegisterElementTrigger_s;
-    if (NULL == unRegisterTrigger)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return E_NOT_POSSIBLE;
-    }
-
-    unRegisterTrigger->elementName           = name;
-    unRegisterTrigger->unRegisterationStatus = E_OK;
-    CAmTriggerQueue::getInstance()->queue(SYSTEM_DEREGISTER_GATEWAY, unRegisterTrigger);
+    gc_UnRegisterElementTrigger_s unRegisterTrigger;
+    unRegisterTrigger.elementName           = name;
+    unRegisterTrigger.unRegisterationStatus = E_OK;
+    CAmTriggerQueue::getInstance()->queue(SYSTEM_DEREGISTER_GATEWAY, std::move(unRegisterTrigger));
     if (E_OK == mpControlReceive->removeGatewayDB(gatewayID))
     {
         LOG_FN_DEBUG(__FILENAME__, __func__, "gateway is remove form AM database gateway name=", name, " gatewayID=", gatewayID);
@@ -1601,16 +1490,10 @@ void CAmControllerPlugin::hookSystemInterruptStateChange(const am_sourceID_t sou
 
     pElement->setInterruptState(interruptState);
     // Store the trigger in a Queue
-    gc_SourceInterruptChangeTrigger_s *triggerData = new gc_SourceInterruptChangeTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return;
-    }
-
-    triggerData->sourceName    = pElement->getName();
-    triggerData->interrptstate = interruptState;
-    CAmTriggerQueue::getInstance()->queue(SYSTEM_INTERRUPT_STATE_CHANGED, triggerData);
+    gc_SourceInterruptChangeTrigger_s triggerData;
+    triggerData.sourceName    = pElement->getName();
+    triggerData.interrptstate = interruptState;
+    CAmTriggerQueue::getInstance()->queue(SYSTEM_INTERRUPT_STATE_CHANGED, std::move(triggerData));
     iterateActions();
     LOG_FN_EXIT(__FILENAME__, __func__);
 }
@@ -1620,6 +1503,8 @@ void CAmControllerPlugin::hookSystemSinkAvailablityStateChange(const am_sinkID_t
 {
     LOG_FN_ENTRY(__FILENAME__, __func__, sinkID, " availability to set", availability.availability);
 
+    _invalidateRoutes();
+
     NULL_CHECK_AND_RETURN(mpControlReceive);
 
     mpControlReceive->changeSinkAvailabilityDB(availability, sinkID);
@@ -1632,17 +1517,11 @@ void CAmControllerPlugin::hookSystemSinkAvailablityStateChange(const am_sinkID_t
     }
 
     // Store the trigger in a Queue
-    gc_AvailabilityChangeTrigger_s *triggerData = new gc_AvailabilityChangeTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return;
-    }
-
-    triggerData->elementName                     = pElement->getName();
-    triggerData->availability.availability       = availability.availability;
-    triggerData->availability.availabilityReason = availability.availabilityReason;
-    CAmTriggerQueue::getInstance()->queue(SYSTEM_SINK_AVAILABILITY_CHANGED, triggerData);
+    gc_AvailabilityChangeTrigger_s triggerData;
+    triggerData.elementName                     = pElement->getName();
+    triggerData.availability.availability       = availability.availability;
+    triggerData.availability.availabilityReason = availability.availabilityReason;
+    CAmTriggerQueue::getInstance()->queue(SYSTEM_SINK_AVAILABILITY_CHANGED, std::move(triggerData));
     iterateActions();
     LOG_FN_EXIT(__FILENAME__, __func__);
 }
@@ -1653,6 +1532,8 @@ void CAmControllerPlugin::hookSystemSourceAvailablityStateChange(
     std::shared_ptr<CAmElement > pElement = nullptr;
     LOG_FN_ENTRY(__FILENAME__, __func__, sourceID, " availability to set", availabilityInstance.availability);
 
+    _invalidateRoutes();
+
     NULL_CHECK_AND_RETURN(mpControlReceive);
 
     mpControlReceive->changeSourceAvailabilityDB(availabilityInstance, sourceID);
@@ -1665,17 +1546,11 @@ void CAmControllerPlugin::hookSystemSourceAvailablityStateChange(
     }
 
     // Store the trigger in a Queue
-    gc_AvailabilityChangeTrigger_s *triggerData = new gc_AvailabilityChangeTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return;
-    }
-
-    triggerData->elementName                     = pElement->getName();
-    triggerData->availability.availability       = availabilityInstance.availability;
-    triggerData->availability.availabilityReason = availabilityInstance.availabilityReason;
-    CAmTriggerQueue::getInstance()->queue(SYSTEM_SOURCE_AVAILABILITY_CHANGED, triggerData);
+    gc_AvailabilityChangeTrigger_s triggerData;
+    triggerData.elementName                     = pElement->getName();
+    triggerData.availability.availability       = availabilityInstance.availability;
+    triggerData.availability.availabilityReason = availabilityInstance.availabilityReason;
+    CAmTriggerQueue::getInstance()->queue(SYSTEM_SOURCE_AVAILABILITY_CHANGED, std::move(triggerData));
     iterateActions();
     LOG_FN_EXIT(__FILENAME__, __func__);
 }
@@ -1890,22 +1765,18 @@ void CAmControllerPlugin::_domainRegistrationTimeout(void *data)
     {
         LOG_FN_WARN(__FILENAME__, __func__, "Restoring Connection from Persistency");
         result = _restoreConnectionsFromPersistency();
-        gc_AllDomainRegisterationCompleteTrigger_s *pdomainRegistrationTrigger = new gc_AllDomainRegisterationCompleteTrigger_s;
-        if (NULL == pdomainRegistrationTrigger)
-        {
-            return;
-        }
-
+        mConnectionsRestored = true;
+        gc_AllDomainRegisterationCompleteTrigger_s domainRegistrationTrigger;
         if (E_DATABASE_ERROR == result)
         {
-            pdomainRegistrationTrigger->status = E_DATABASE_ERROR;
+            domainRegistrationTrigger.status = E_DATABASE_ERROR;
         }
         else
         {
-            pdomainRegistrationTrigger->status = E_NOT_POSSIBLE;
+            domainRegistrationTrigger.status = E_NOT_POSSIBLE;
         }
 
-        CAmTriggerQueue::getInstance()->queue(SYSTEM_ALL_DOMAIN_REGISTRATION_COMPLETE, pdomainRegistrationTrigger);
+        CAmTriggerQueue::getInstance()->queue(SYSTEM_ALL_DOMAIN_REGISTRATION_COMPLETE, std::move(domainRegistrationTrigger));
         iterateActions();
     }
     else
@@ -2159,6 +2030,8 @@ am_Error_e CAmControllerPlugin::hookSystemUpdateSink(
 {
     am_Error_e result(E_NOT_POSSIBLE);
 
+    _invalidateRoutes();
+
     NULL_CHECK_AND_RETURN_ERROR(mpControlReceive);
 
     std::shared_ptr<CAmSinkElement > pSink = CAmSinkFactory::getElement(sinkID);
@@ -2193,6 +2066,8 @@ am_Error_e CAmControllerPlugin::hookSystemUpdateSource(
 {
     am_Error_e result(E_NOT_POSSIBLE);
 
+    _invalidateRoutes();
+
     NULL_CHECK_AND_RETURN_ERROR(mpControlReceive);
 
     std::shared_ptr<CAmSourceElement > pSource = CAmSourceFactory::getElement(sourceID);
@@ -2225,6 +2100,7 @@ am_Error_e CAmControllerPlugin::hookSystemUpdateGateway(
     const std::vector<am_CustomConnectionFormat_t > &listSinkConnectionFormats,
     const std::vector<bool > &listConvertionMatrix)
 {
+    _invalidateRoutes();
 
     NULL_CHECK_AND_RETURN_ERROR(mpControlReceive);
 
@@ -2237,9 +2113,11 @@ void CAmControllerPlugin::cbAckSetVolumes(const am_Handle_s handle,
     const std::vector<am_Volumes_s > &listVolumes,
     const am_Error_e error)
 {
-    (void)handle;
-    (void)listVolumes;
-    (void)error;
+    LOG_FN_INFO(__FILENAME__, __func__, "  IN  handle.Type/Handle=", (int)handle.handleType, " handle.handle=", (int)handle.handle,
+        " confirmed volumes=", listVolumes.size(), " errorID=", error);
+
+    CAmHandleStore::instance().notifyAsyncResult(handle, error, listVolumes);
+    iterateActions();
 }
 
 void CAmControllerPlugin::cbAckSetSinkNotificationConfiguration(const am_Handle_s handle,
@@ -2278,16 +2156,10 @@ void CAmControllerPlugin::hookSinkNotificationDataChanged(const am_sinkID_t sink
 
     pElement->notificationDataUpdate(payload);
     // Store the trigger in a Queue
-    gc_NotificationDataTrigger_s *triggerData = new gc_NotificationDataTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return;
-    }
-
-    triggerData->name               = pElement->getName();
-    triggerData->notificatonPayload = payload;
-    CAmTriggerQueue::getInstance()->queue(SYSTEM_SINK_NOTIFICATION_DATA_CHANGED, triggerData);
+    gc_NotificationDataTrigger_s triggerData;
+    triggerData.name               = pElement->getName();
+    triggerData.notificatonPayload = payload;
+    CAmTriggerQueue::getInstance()->queue(SYSTEM_SINK_NOTIFICATION_DATA_CHANGED, std::move(triggerData));
     iterateActions();
     LOG_FN_EXIT(__FILENAME__, __func__);
     return;
@@ -2309,16 +2181,10 @@ void CAmControllerPlugin::hookSourceNotificationDataChanged(const am_sourceID_t
 
     pElement->notificationDataUpdate(payload);
     // Store the trigger in a Queue
-    gc_NotificationDataTrigger_s *triggerData = new gc_NotificationDataTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return;
-    }
-
-    triggerData->name               = pElement->getName();
-    triggerData->notificatonPayload = payload;
-    CAmTriggerQueue::getInstance()->queue(SYSTEM_SOURCE_NOTIFICATION_DATA_CHANGED, triggerData);
+    gc_NotificationDataTrigger_s triggerData;
+    triggerData.name               = pElement->getName();
+    triggerData.notificatonPayload = payload;
+    CAmTriggerQueue::getInstance()->queue(SYSTEM_SOURCE_NOTIFICATION_DATA_CHANGED, std::move(triggerData));
     iterateActions();
     LOG_FN_EXIT(__FILENAME__, __func__);
     return;
@@ -2341,16 +2207,10 @@ am_Error_e CAmControllerPlugin::hookUserSetMainSinkNotificationConfiguration(
     }
 
     // Store the trigger in a Queue
-    gc_NotificationConfigurationTrigger_s *triggerData = new gc_NotificationConfigurationTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return E_NOT_POSSIBLE;
-    }
-
-    triggerData->name                     = pElement->getName();
-    triggerData->notificatonConfiguration = notificationConfiguration;
-    CAmTriggerQueue::getInstance()->queue(USER_SET_SINK_MAIN_NOTIFICATION_CONFIGURATION, triggerData);
+    gc_NotificationConfigurationTrigger_s triggerData;
+    triggerData.name                     = pElement->getName();
+    triggerData.notificatonConfiguration = notificationConfiguration;
+    CAmTriggerQueue::getInstance()->queue(USER_SET_SINK_MAIN_NOTIFICATION_CONFIGURATION, std::move(triggerData));
     iterateActions();
     LOG_FN_EXIT(__FILENAME__, __func__);
     return E_OK;
@@ -2372,16 +2232,10 @@ am_Error_e CAmControllerPlugin::hookUserSetMainSourceNotificationConfiguration(
     }
 
     // Store the trigger in a Queue
-    gc_NotificationConfigurationTrigger_s *triggerData = new gc_NotificationConfigurationTrigger_s;
-    if (NULL == triggerData)
-    {
-        LOG_FN_ERROR(__FILENAME__, __func__, "  bad memory state:");
-        return E_NOT_POSSIBLE;
-    }
-
-    triggerData->name                     = pElement->getName();
-    triggerData->notificatonConfiguration = notificationConfiguration;
-    CAmTriggerQueue::getInstance()->queue(USER_SET_SOURCE_MAIN_NOTIFICATION_CONFIGURATION, triggerData);
+    gc_NotificationConfigurationTrigger_s triggerData;
+    triggerData.name                     = pElement->getName();
+    triggerData.notificatonConfiguration = notificationConfiguration;
+    CAmTriggerQueue::getInstance()->queue(USER_SET_SOURCE_MAIN_NOTIFICATION_CONFIGURATION, std::move(triggerData));
     iterateActions();
     LOG_FN_EXIT(__FILENAME__, __func__);
     return E_OK;
@@ -2455,6 +2309,13 @@ am_Error_e CAmControllerPlugin::hookSystemUpdateConverter(
 //
 // private functions
 //
+void CAmControllerPlugin::_invalidateRoutes(void)
+{
+    // registration, update and availability changes might alter the routes the
+    // daemon resolves, so any route cached by the class elements becomes stale
+    CAmClassElement::invalidateRouteCache();
+}
+
 void CAmControllerPlugin::_freeMemory(void)
 {
     CAmGatewayFactory::destroyElement();
@@ -2474,9 +2335,9 @@ void CAmControllerPlugin::_freeMemory(void)
 
 void CAmControllerPlugin::iterateActions(void)
 {
-    CAmRootAction       *pRootAction = CAmRootAction::getInstance();
-    gc_Trigger_e         triggerType;
-    gc_TriggerElement_s *triggerData = NULL;
+    CAmRootAction    *pRootAction = CAmRootAction::getInstance();
+    gc_Trigger_e      triggerType;
+    gc_TriggerData_t  triggerData;
     if (NULL == pRootAction)
     {
         LOG_FN_ERROR(__FILENAME__, __func__, " Not able to get Root instance");
@@ -2497,12 +2358,12 @@ void CAmControllerPlugin::iterateActions(void)
         {
             if (true == pRootAction->isEmpty())
             {
-                std::pair<gc_Trigger_e, gc_TriggerElement_s * > triggerPair;
-                triggerData = CAmTriggerQueue::getInstance()->dequeue(triggerType);
-                if (NULL != triggerData)
+                // the previous trigger is completely processed
+                _persistChanges();
+
+                if (E_OK == CAmTriggerQueue::getInstance()->dequeue(triggerType, triggerData))
                 {
                     _forwardTriggertoPolicyEngine(triggerType, triggerData);
-                    delete triggerData;
                 }
                 else
                 {
@@ -2520,7 +2381,7 @@ void CAmControllerPlugin::iterateActions(void)
 }
 
 am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e triggerType,
-    gc_TriggerElement_s *triggerData)
+    const gc_TriggerData_t &triggerData)
 {
     am_Error_e result = E_OK;
     if (NULL == mpPolicySend)
@@ -2528,25 +2389,45 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
         return E_UNKNOWN;
     }
 
+    mPendingPersistence |= _getPersistenceChanges(triggerType);
+
     switch (triggerType)
     {
     case SYSTEM_REGISTER_SINK:
     {
-        gc_RegisterElementTrigger_s *pRegisterElementTrigger_t = (gc_RegisterElementTrigger_s *)triggerData;
+        const gc_RegisterElementTrigger_s *pRegisterElementTrigger_t = triggerData.getIf<gc_RegisterElementTrigger_s >();
+        if (NULL == pRegisterElementTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookRegisterSink(pRegisterElementTrigger_t->elementName,
                 pRegisterElementTrigger_t->RegisterationStatus);
         break;
     }
     case SYSTEM_REGISTER_SOURCE:
     {
-        gc_RegisterElementTrigger_s *pRegisterElementTrigger_t = (gc_RegisterElementTrigger_s *)triggerData;
+        const gc_RegisterElementTrigger_s *pRegisterElementTrigger_t = triggerData.getIf<gc_RegisterElementTrigger_s >();
+        if (NULL == pRegisterElementTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookRegisterSource(pRegisterElementTrigger_t->elementName,
                 pRegisterElementTrigger_t->RegisterationStatus);
         break;
     }
     case SYSTEM_SINK_AVAILABILITY_CHANGED:
     {
-        gc_AvailabilityChangeTrigger_s *pAvailabilityChangeTrigger_t = (gc_AvailabilityChangeTrigger_s *)triggerData;
+        const gc_AvailabilityChangeTrigger_s *pAvailabilityChangeTrigger_t = triggerData.getIf<gc_AvailabilityChangeTrigger_s >();
+        if (NULL == pAvailabilityChangeTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookSinkAvailabilityChange(
                 pAvailabilityChangeTrigger_t->elementName,
                 pAvailabilityChangeTrigger_t->availability);
@@ -2554,7 +2435,13 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case SYSTEM_SOURCE_AVAILABILITY_CHANGED:
     {
-        gc_AvailabilityChangeTrigger_s *pSourceAvailabilityChangeTrigger_t = (gc_AvailabilityChangeTrigger_s *)triggerData;
+        const gc_AvailabilityChangeTrigger_s *pSourceAvailabilityChangeTrigger_t = triggerData.getIf<gc_AvailabilityChangeTrigger_s >();
+        if (NULL == pSourceAvailabilityChangeTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookSourceAvailabilityChange(
                 pSourceAvailabilityChangeTrigger_t->elementName,
                 pSourceAvailabilityChangeTrigger_t->availability);
@@ -2562,7 +2449,13 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case SYSTEM_DEREGISTER_SINK:
     {
-        gc_UnRegisterElementTrigger_s *pUnRegisterElementTrigger_t = (gc_UnRegisterElementTrigger_s *)triggerData;
+        const gc_UnRegisterElementTrigger_s *pUnRegisterElementTrigger_t = triggerData.getIf<gc_UnRegisterElementTrigger_s >();
+        if (NULL == pUnRegisterElementTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookDeregisterSink(
                 pUnRegisterElementTrigger_t->elementName,
                 pUnRegisterElementTrigger_t->unRegisterationStatus);
@@ -2570,7 +2463,13 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case SYSTEM_DEREGISTER_SOURCE:
     {
-        gc_UnRegisterElementTrigger_s *pUnRegisterElementTrigger_t = (gc_UnRegisterElementTrigger_s *)triggerData;
+        const gc_UnRegisterElementTrigger_s *pUnRegisterElementTrigger_t = triggerData.getIf<gc_UnRegisterElementTrigger_s >();
+        if (NULL == pUnRegisterElementTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookDeregisterSource(
                 pUnRegisterElementTrigger_t->elementName,
                 pUnRegisterElementTrigger_t->unRegisterationStatus);
@@ -2578,7 +2477,13 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case USER_CONNECTION_REQUEST:
     {
-        gc_ConnectTrigger_s *pConnectTrigger_t = (gc_ConnectTrigger_s *)triggerData;
+        const gc_ConnectTrigger_s *pConnectTrigger_t = triggerData.getIf<gc_ConnectTrigger_s >();
+        if (NULL == pConnectTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookConnectionRequest(pConnectTrigger_t->className,
                 pConnectTrigger_t->sourceName,
                 pConnectTrigger_t->sinkName);
@@ -2586,7 +2491,13 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case USER_DISCONNECTION_REQUEST:
     {
-        gc_DisconnectTrigger_s *pDisconnectTrigger_t = (gc_DisconnectTrigger_s *)triggerData;
+        const gc_DisconnectTrigger_s *pDisconnectTrigger_t = triggerData.getIf<gc_DisconnectTrigger_s >();
+        if (NULL == pDisconnectTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookDisconnectionRequest(pDisconnectTrigger_t->className,
                 pDisconnectTrigger_t->sourceName,
                 pDisconnectTrigger_t->sinkName);
@@ -2594,21 +2505,39 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case USER_SET_SINK_MUTE_STATE:
     {
-        gc_SinkMuteTrigger_s *pSinkMuteTrigger_t = (gc_SinkMuteTrigger_s *)triggerData;
+        const gc_SinkMuteTrigger_s *pSinkMuteTrigger_t = triggerData.getIf<gc_SinkMuteTrigger_s >();
+        if (NULL == pSinkMuteTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookSetSinkMuteState(pSinkMuteTrigger_t->sinkName,
                 pSinkMuteTrigger_t->muteState);
         break;
     }
     case USER_SET_VOLUME:
     {
-        gc_SinkVolumeChangeTrigger_s *pSinkVolumeChangeTrigger_t = (gc_SinkVolumeChangeTrigger_s *)triggerData;
+        const gc_SinkVolumeChangeTrigger_s *pSinkVolumeChangeTrigger_t = triggerData.getIf<gc_SinkVolumeChangeTrigger_s >();
+        if (NULL == pSinkVolumeChangeTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookVolumeChange(pSinkVolumeChangeTrigger_t->sinkName,
                 pSinkVolumeChangeTrigger_t->volume, pSinkVolumeChangeTrigger_t->isStep);
         break;
     }
     case USER_SET_SINK_MAIN_SOUND_PROPERTY:
     {
-        gc_SinkSoundPropertyTrigger_s *pSinkSoundPropertyTrigger_t = (gc_SinkSoundPropertyTrigger_s *)triggerData;
+        const gc_SinkSoundPropertyTrigger_s *pSinkSoundPropertyTrigger_t = triggerData.getIf<gc_SinkSoundPropertyTrigger_s >();
+        if (NULL == pSinkSoundPropertyTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookSetMainSinkSoundProperty(
                 pSinkSoundPropertyTrigger_t->sinkName,
                 pSinkSoundPropertyTrigger_t->mainSoundProperty);
@@ -2616,7 +2545,13 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case USER_SET_SINK_MAIN_SOUND_PROPERTIES:
     {
-        gc_SinkSoundPropertiesTrigger_s *pSinkSoundPropertiesTrigger_t = (gc_SinkSoundPropertiesTrigger_s *)triggerData;
+        const gc_SinkSoundPropertiesTrigger_s *pSinkSoundPropertiesTrigger_t = triggerData.getIf<gc_SinkSoundPropertiesTrigger_s >();
+        if (NULL == pSinkSoundPropertiesTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookSetMainSinkSoundProperties(
                 pSinkSoundPropertiesTrigger_t->sinkName,
                 pSinkSoundPropertiesTrigger_t->listMainSoundProperty);
@@ -2624,7 +2559,13 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case USER_SET_SOURCE_MAIN_SOUND_PROPERTY:
     {
-        gc_SourceSoundPropertyTrigger_s *pSourceSoundPropertyTrigger_t = (gc_SourceSoundPropertyTrigger_s *)triggerData;
+        const gc_SourceSoundPropertyTrigger_s *pSourceSoundPropertyTrigger_t = triggerData.getIf<gc_SourceSoundPropertyTrigger_s >();
+        if (NULL == pSourceSoundPropertyTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookSetMainSourceSoundProperty(
                 pSourceSoundPropertyTrigger_t->sourceName,
                 pSourceSoundPropertyTrigger_t->mainSoundProperty);
@@ -2632,7 +2573,13 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case USER_SET_SOURCE_MAIN_SOUND_PROPERTIES:
     {
-        gc_SourceSoundPropertiesTrigger_s *pSourceSoundPropertiesTrigger_t = (gc_SourceSoundPropertiesTrigger_s *)triggerData;
+        const gc_SourceSoundPropertiesTrigger_s *pSourceSoundPropertiesTrigger_t = triggerData.getIf<gc_SourceSoundPropertiesTrigger_s >();
+        if (NULL == pSourceSoundPropertiesTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookSetMainSourceSoundProperties(
                 pSourceSoundPropertiesTrigger_t->sourceName,
                 pSourceSoundPropertiesTrigger_t->listMainSoundProperty);
@@ -2640,7 +2587,13 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case SYSTEM_INTERRUPT_STATE_CHANGED:
     {
-        gc_SourceInterruptChangeTrigger_s *pSourceInterruptChangeTrigger_t = (gc_SourceInterruptChangeTrigger_s *)triggerData;
+        const gc_SourceInterruptChangeTrigger_s *pSourceInterruptChangeTrigger_t = triggerData.getIf<gc_SourceInterruptChangeTrigger_s >();
+        if (NULL == pSourceInterruptChangeTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookSourceInterruptStateChange(
                 pSourceInterruptChangeTrigger_t->sourceName,
                 pSourceInterruptChangeTrigger_t->interrptstate);
@@ -2648,14 +2601,26 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case SYSTEM_REGISTER_DOMAIN:
     {
-        gc_RegisterElementTrigger_s *pRegisterElementTrigger_t = (gc_RegisterElementTrigger_s *)triggerData;
+        const gc_RegisterElementTrigger_s *pRegisterElementTrigger_t = triggerData.getIf<gc_RegisterElementTrigger_s >();
+        if (NULL == pRegisterElementTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookRegisterDomain(pRegisterElementTrigger_t->elementName,
                 pRegisterElementTrigger_t->RegisterationStatus);
         break;
     }
     case SYSTEM_DEREGISTER_DOMAIN:
     {
-        gc_UnRegisterElementTrigger_s *pUnRegisterElementTrigger_t = (gc_UnRegisterElementTrigger_s *)triggerData;
+        const gc_UnRegisterElementTrigger_s *pUnRegisterElementTrigger_t = triggerData.getIf<gc_UnRegisterElementTrigger_s >();
+        if (NULL == pUnRegisterElementTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookDeregisterDomain(
                 pUnRegisterElementTrigger_t->elementName,
                 pUnRegisterElementTrigger_t->unRegisterationStatus);
@@ -2663,14 +2628,26 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case SYSTEM_REGISTER_GATEWAY:
     {
-        gc_RegisterElementTrigger_s *pRegisterElementTrigger_t = (gc_RegisterElementTrigger_s *)triggerData;
+        const gc_RegisterElementTrigger_s *pRegisterElementTrigger_t = triggerData.getIf<gc_RegisterElementTrigger_s >();
+        if (NULL == pRegisterElementTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookRegisterGateway(pRegisterElementTrigger_t->elementName,
                 pRegisterElementTrigger_t->RegisterationStatus);
         break;
     }
     case SYSTEM_DEREGISTER_GATEWAY:
     {
-        gc_UnRegisterElementTrigger_s *pUnRegisterElementTrigger_t = (gc_UnRegisterElementTrigger_s *)triggerData;
+        const gc_UnRegisterElementTrigger_s *pUnRegisterElementTrigger_t = triggerData.getIf<gc_UnRegisterElementTrigger_s >();
+        if (NULL == pUnRegisterElementTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookDeregisterGateway(
                 pUnRegisterElementTrigger_t->elementName,
                 pUnRegisterElementTrigger_t->unRegisterationStatus);
@@ -2678,43 +2655,79 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case SYSTEM_DOMAIN_REGISTRATION_COMPLETE:
     {
-        gc_DomainRegisterationCompleteTrigger_s *pRegisterElementTrigger_t = (gc_DomainRegisterationCompleteTrigger_s *)triggerData;
+        const gc_DomainRegisterationCompleteTrigger_s *pRegisterElementTrigger_t = triggerData.getIf<gc_DomainRegisterationCompleteTrigger_s >();
+        if (NULL == pRegisterElementTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookDomainRegistrationComplete(
                 pRegisterElementTrigger_t->domainName);
         break;
     }
     case SYSTEM_ALL_DOMAIN_REGISTRATION_COMPLETE:
     {
-        gc_AllDomainRegisterationCompleteTrigger_s *pRegisterElementTrigger_t = (gc_AllDomainRegisterationCompleteTrigger_s *)triggerData;
+        const gc_AllDomainRegisterationCompleteTrigger_s *pRegisterElementTrigger_t = triggerData.getIf<gc_AllDomainRegisterationCompleteTrigger_s >();
+        if (NULL == pRegisterElementTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookAllDomainRegistrationComplete(
                 pRegisterElementTrigger_t->status);
         break;
     }
     case USER_SET_SYSTEM_PROPERTY:
     {
-        gc_SystemPropertyTrigger_s *pSystemPropertyTrigger_t = (gc_SystemPropertyTrigger_s *)triggerData;
+        const gc_SystemPropertyTrigger_s *pSystemPropertyTrigger_t = triggerData.getIf<gc_SystemPropertyTrigger_s >();
+        if (NULL == pSystemPropertyTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookSetSystemProperty(pSystemPropertyTrigger_t->systemProperty);
         break;
     }
 
     case USER_SET_SYSTEM_PROPERTIES:
     {
-        gc_SystemPropertiesTrigger_s *pSystemPropertiesTrigger_t = (gc_SystemPropertiesTrigger_s *)triggerData;
+        const gc_SystemPropertiesTrigger_s *pSystemPropertiesTrigger_t = triggerData.getIf<gc_SystemPropertiesTrigger_s >();
+        if (NULL == pSystemPropertiesTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookSetSystemProperties(pSystemPropertiesTrigger_t->listSystemProperty);
         break;
     }
 
     case SYSTEM_CONNECTION_STATE_CHANGE:
     {
-        gc_ConnectionStateChangeTrigger_s *pConnectionStateTrigger_t = (gc_ConnectionStateChangeTrigger_s *)triggerData;
+        const gc_ConnectionStateChangeTrigger_s *pConnectionStateTrigger_t = triggerData.getIf<gc_ConnectionStateChangeTrigger_s >();
+        if (NULL == pConnectionStateTrigger_t)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
+        am_Error_e status = pConnectionStateTrigger_t->status;
         result = mpPolicySend->hookConnectionStateChange(pConnectionStateTrigger_t->connectionName,
-                pConnectionStateTrigger_t->connectionState,
-                pConnectionStateTrigger_t->status);
+                pConnectionStateTrigger_t->connectionState, status);
         break;
     }
     case USER_SET_SINK_MAIN_NOTIFICATION_CONFIGURATION:
     {
-        gc_NotificationConfigurationTrigger_s *pNotificationConfiguration = (gc_NotificationConfigurationTrigger_s *)triggerData;
+        const gc_NotificationConfigurationTrigger_s *pNotificationConfiguration = triggerData.getIf<gc_NotificationConfigurationTrigger_s >();
+        if (NULL == pNotificationConfiguration)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookSetMainSinkNotificationConfiguration(
                 pNotificationConfiguration->name,
                 pNotificationConfiguration->notificatonConfiguration);
@@ -2722,7 +2735,13 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case USER_SET_SOURCE_MAIN_NOTIFICATION_CONFIGURATION:
     {
-        gc_NotificationConfigurationTrigger_s *pNotificationConfiguration = (gc_NotificationConfigurationTrigger_s *)triggerData;
+        const gc_NotificationConfigurationTrigger_s *pNotificationConfiguration = triggerData.getIf<gc_NotificationConfigurationTrigger_s >();
+        if (NULL == pNotificationConfiguration)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookSetMainSourceNotificationConfiguration(
                 pNotificationConfiguration->name,
                 pNotificationConfiguration->notificatonConfiguration);
@@ -2730,14 +2749,26 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     }
     case SYSTEM_SINK_NOTIFICATION_DATA_CHANGED:
     {
-        gc_NotificationDataTrigger_s *pNotificationData = (gc_NotificationDataTrigger_s *)triggerData;
+        const gc_NotificationDataTrigger_s *pNotificationData = triggerData.getIf<gc_NotificationDataTrigger_s >();
+        if (NULL == pNotificationData)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookSinkNotificationDataChanged(
                 pNotificationData->name, pNotificationData->notificatonPayload);
         break;
     }
     case SYSTEM_SOURCE_NOTIFICATION_DATA_CHANGED:
     {
-        gc_NotificationDataTrigger_s *pNotificationData = (gc_NotificationDataTrigger_s *)triggerData;
+        const gc_NotificationDataTrigger_s *pNotificationData = triggerData.getIf<gc_NotificationDataTrigger_s >();
+        if (NULL == pNotificationData)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "trigger data does not match trigger type", triggerType);
+            return E_UNKNOWN;
+        }
+
         result = mpPolicySend->hookSourceNotificationDataChanged(
                 pNotificationData->name, pNotificationData->notificatonPayload);
         break;
@@ -2749,6 +2780,63 @@ am_Error_e CAmControllerPlugin::_forwardTriggertoPolicyEngine(gc_Trigger_e trigg
     return result;
 }
 
+uint32_t CAmControllerPlugin::_getPersistenceChanges(const gc_Trigger_e triggerType)
+{
+    switch (triggerType)
+    {
+    case USER_SET_VOLUME:
+    case USER_SET_SINK_MUTE_STATE:
+    case SYSTEM_STORED_SINK_VOLUME:
+        return PC_VOLUME;
+    case USER_CONNECTION_REQUEST:
+    case USER_DISCONNECTION_REQUEST:
+    case SYSTEM_CONNECTION_STATE_CHANGE:
+        // connection policies might adjust volumes as well
+        return PC_MAIN_CONNECTION | PC_VOLUME;
+    case USER_SET_SINK_MAIN_SOUND_PROPERTY:
+    case USER_SET_SINK_MAIN_SOUND_PROPERTIES:
+    case USER_SET_SOURCE_MAIN_SOUND_PROPERTY:
+    case USER_SET_SOURCE_MAIN_SOUND_PROPERTIES:
+        return PC_MAIN_SOUND_PROPERTY;
+    case USER_SET_SYSTEM_PROPERTY:
+    case USER_SET_SYSTEM_PROPERTIES:
+        return PC_SYSTEM_PROPERTY;
+    default:
+        return PC_NONE;
+    }
+}
+
+void CAmControllerPlugin::_persistChanges(void)
+{
+    /*
+     * Write the affected keys right away instead of waiting for the rundown, so they
+     * are journaled by the persistence backend. Unchanged values are not journaled again.
+     */
+    if (mPendingPersistence & PC_VOLUME)
+    {
+        _storeVolumetoPersistency();
+        _storeMainConnectionVolumetoPersistency();
+    }
+
+    // the last main connections must not be overwritten before they are restored
+    if ((mPendingPersistence & PC_MAIN_CONNECTION) && mConnectionsRestored)
+    {
+        _storeMainConnectiontoPersistency();
+    }
+
+    if (mPendingPersistence & PC_MAIN_SOUND_PROPERTY)
+    {
+        _storeMainSoundPropertytoPersistence();
+    }
+
+    if (mPendingPersistence & PC_SYSTEM_PROPERTY)
+    {
+        _storeSystemPropertytoPersistence();
+    }
+
+    mPendingPersistence = PC_NONE;
+}
+
 am_Error_e CAmControllerPlugin::_storeMainConnectiontoPersistency()
 {
     /*write main connection to the persistency*/
@@ -3267,9 +3355,9 @@ am_Error_e CAmControllerPlugin::_restoreSystemPropertyfromPersistence()
                 property.type  = (am_CustomSystemPropertyType_t)type;
                 property.value = val;
 
-                auto *trigger = new gc_SystemPropertyTrigger_s;
-                trigger->systemProperty = property;
-                CAmTriggerQueue::getInstance()->queue(USER_SET_SYSTEM_PROPERTY, trigger);
+                gc_SystemPropertyTrigger_s trigger;
+                trigger.systemProperty = property;
+                CAmTriggerQueue::getInstance()->queue(USER_SET_SYSTEM_PROPERTY, std::move(trigger));
             }
         }
     }
@@ -111,6 +111,20 @@ void CAmHandleStore::notifyAsyncResult(am_Handle_s handle, am_Error_e error)
     }
 }
 
+void CAmHandleStore::notifyAsyncResult(am_Handle_s handle, am_Error_e error
+        , const std::vector<am_Volumes_s> &listVolumes)
+{
+    // keep available for the subscriber only while it is being notified
+    mListConfirmedVolumes = listVolumes;
+    notifyAsyncResult(handle, error);
+    mListConfirmedVolumes.clear();
+}
+
+const std::vector<am_Volumes_s> &CAmHandleStore::getConfirmedVolumes(void) const
+{
+    return mListConfirmedVolumes;
+}
+
 
 }  // namespace gc
 }  // namespace am
@@ -37,6 +37,7 @@ CAmMainConnectionActionConnect::CAmMainConnectionActionConnect(
 {
     this->_registerParam(ACTION_PARAM_CONNECTION_FORMAT, &mConnectionFormatParam);
     this->_registerParam(ACTION_PARAM_SET_SOURCE_STATE_DIRECTION, &mSetSourceStateDirectionParam);
+    this->_registerParam(ACTION_PARAM_PARALLEL, &mParallelRoutesParam);
 
     if (mpMainConnection)
     {
@@ -160,9 +161,23 @@ am_Error_e CAmMainConnectionActionConnect::_createListActionsRouteConnect(
     std::vector<std::shared_ptr<CAmRouteElement > > &listRouteElements)
 {
     am_Error_e error = E_OK;
+
+    /*
+     * The route segments are independent of each other, so they might be connected
+     * together. The source state actions appended afterwards wait for all of them.
+     */
+    CAmActionContainer *pParentAction = this;
+    bool                parallel      = false;
+    mParallelRoutesParam.getParam(parallel);
+    if (parallel && (listRouteElements.size() > 1))
+    {
+        pParentAction = new CAmActionGroup(std::string("CAmActionGroup(route connect)"));
+        append(pParentAction);
+    }
+
     for (auto itListRouteElements : listRouteElements)
     {
-        error = _createActionRouteConnect(itListRouteElements);
+        error = _createActionRouteConnect(itListRouteElements, pParentAction);
         if (error != E_OK)
         {
             break;
@@ -172,7 +187,8 @@ am_Error_e CAmMainConnectionActionConnect::_createListActionsRouteConnect(
     return error;
 }
 
-am_Error_e CAmMainConnectionActionConnect::_createActionRouteConnect(std::shared_ptr<CAmRouteElement > routeElement)
+am_Error_e CAmMainConnectionActionConnect::_createActionRouteConnect(std::shared_ptr<CAmRouteElement > routeElement,
+    CAmActionContainer *pParentAction)
 {
     // create router connect action for each element'
     IAmActionCommand *pAction = new CAmRouteActionConnect(routeElement);
@@ -185,7 +201,7 @@ am_Error_e CAmMainConnectionActionConnect::_createActionRouteConnect(std::shared
         }
 
         pAction->setUndoRequried(getUndoRequired());
-        append(pAction);
+        pParentAction->append(pAction);
     }
 
     return E_OK;
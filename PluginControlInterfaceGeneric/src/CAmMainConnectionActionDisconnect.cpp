@@ -37,6 +37,7 @@ CAmMainConnectionActionDisconnect::CAmMainConnectionActionDisconnect(
     , mActionCompleted(false)
 {
     this->_registerParam(ACTION_PARAM_SET_SOURCE_STATE_DIRECTION, &mSetSourceStateDirectionParam);
+    this->_registerParam(ACTION_PARAM_PARALLEL, &mParallelRoutesParam);
 
     if (mpMainConnection != nullptr)
     {
@@ -198,6 +199,17 @@ am_Error_e CAmMainConnectionActionDisconnect::_createListActionsRouteDisconnect
     (std::vector<std::shared_ptr< CAmRouteElement > > &listRouteElements)
 {
     am_Error_e error = E_OK;
+
+    // the route segments are independent of each other, so they might be disconnected together
+    CAmActionContainer *pParentAction = this;
+    bool                parallel      = false;
+    mParallelRoutesParam.getParam(parallel);
+    if (parallel && (listRouteElements.size() > 1))
+    {
+        pParentAction = new CAmActionGroup(std::string("CAmActionGroup(route disconnect)"));
+        append(pParentAction);
+    }
+
     for (auto itListRouteElements : listRouteElements)
     {
         /*check if domain id is not present then do not create disconnect action*/
@@ -209,7 +221,7 @@ am_Error_e CAmMainConnectionActionDisconnect::_createListActionsRouteDisconnect
             continue;
         }
 
-        error = _createActionRouteDisconnect(itListRouteElements);
+        error = _createActionRouteDisconnect(itListRouteElements, pParentAction);
         if (error != E_OK)
         {
             break;
@@ -220,7 +232,7 @@ am_Error_e CAmMainConnectionActionDisconnect::_createListActionsRouteDisconnect
 }
 
 am_Error_e CAmMainConnectionActionDisconnect::_createActionRouteDisconnect(
-    std::shared_ptr<CAmRouteElement > routeElement)
+    std::shared_ptr<CAmRouteElement > routeElement, CAmActionContainer *pParentAction)
 {
     if (routeElement == nullptr)
     {
@@ -234,7 +246,7 @@ am_Error_e CAmMainConnectionActionDisconnect::_createActionRouteDisconnect(
         {
             // add the newly created route disconnect action to dynamic action
             pAction->setUndoRequried(getUndoRequired());
-            append(pAction);
+            pParentAction->append(pAction);
         }
     }
 
@@ -131,14 +131,14 @@ void CAmMainConnectionElement::unregisterTransitionAction(const IAmActionCommand
 
 void CAmMainConnectionElement::setStateChangeTrigger(am_Error_e actionResult)
 {
-    gc_ConnectionStateChangeTrigger_s *pTrigger = new gc_ConnectionStateChangeTrigger_s;
-    pTrigger->connectionName  = getName();
-    pTrigger->connectionState = getState();
-    pTrigger->status          = actionResult;
-    CAmTriggerQueue::getInstance()->queueWithPriority(SYSTEM_CONNECTION_STATE_CHANGE, pTrigger);
+    gc_ConnectionStateChangeTrigger_s trigger;
+    trigger.connectionName  = getName();
+    trigger.connectionState = getState();
+    trigger.status          = actionResult;
 
-    LOG_FN_INFO(__FILENAME__, __func__, pTrigger->connectionName, "ID =", getID(),
-        pTrigger->connectionState, "SYSTEM_CONNECTION_STATE_CHANGE appended to queue");
+    LOG_FN_INFO(__FILENAME__, __func__, trigger.connectionName, "ID =", getID(),
+        trigger.connectionState, "SYSTEM_CONNECTION_STATE_CHANGE appended to queue");
+    CAmTriggerQueue::getInstance()->queueWithPriority(SYSTEM_CONNECTION_STATE_CHANGE, std::move(trigger));
 }
 
 bool CAmMainConnectionElement::permitsDispose()
@@ -148,13 +148,13 @@ bool CAmMainConnectionElement::permitsDispose()
     am_ConnectionState_e state              = getState();
 
     // check whether another Connect action is latent in the trigger-queue
-    std::vector<std::pair<gc_Trigger_e, const gc_TriggerElement_s *> > queueSnapShot;
+    std::vector<std::pair<gc_Trigger_e, const gc_TriggerData_t *> > queueSnapShot;
     CAmTriggerQueue::getInstance()->getSnapShot(queueSnapShot);
     for (const auto &trigger : queueSnapShot)
     {
-        if ((trigger.first == USER_CONNECTION_REQUEST) && (trigger.second != NULL))
+        auto pTrigger = trigger.second->getIf<gc_ConnectTrigger_s>();
+        if ((trigger.first == USER_CONNECTION_REQUEST) && (pTrigger != NULL))
         {
-            auto pTrigger = static_cast<const gc_ConnectTrigger_s *>(trigger.second);
             if (pTrigger->sinkName == getMainSinkName() && (pTrigger->sourceName == getMainSourceName()))
             {
                 ++ongoingTransitions;
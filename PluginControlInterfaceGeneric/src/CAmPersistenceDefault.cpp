@@ -25,6 +25,11 @@
 #include <libxml/parser.h>
 #include "CAmCommonUtility.h"
 #include <libxml/xmlwriter.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 namespace am {
 namespace gc {
@@ -249,6 +254,11 @@ private:
 
 CAmPersistenceDefault::CAmPersistenceDefault()
     : mFileName(GENERIC_CONTROLLER_PERSISTENCE_FILE)
+    , mJournalFd(-1)
+    , mJournalRecords(0)
+    , mUnsyncedRecords(0)
+    , mSyncInterval(_getEnvValue(PERSISTENCE_SYNC_INTERVAL_ENV_VAR_NAME, GENERIC_CONTROLLER_PERSISTENCE_SYNC_INTERVAL))
+    , mJournalLimit(_getEnvValue(PERSISTENCE_JOURNAL_LIMIT_ENV_VAR_NAME, GENERIC_CONTROLLER_PERSISTENCE_JOURNAL_LIMIT))
 {
     LOG_FN_DEBUG(__FILENAME__, __func__, "is Called");
     return;
@@ -256,8 +266,17 @@ CAmPersistenceDefault::CAmPersistenceDefault()
 
 CAmPersistenceDefault::~CAmPersistenceDefault()
 {
+    // the journal holds all changes, the next open() replays it on top of the snapshot
+    if (mJournalFd >= 0)
+    {
+        fsync(mJournalFd);
+        _closeJournal();
+        return;
+    }
+
+    // without a journal the changes exist in memory only
     _createSubDirectories();
-    if (_writeTOXML())
+    if (_compact())
     {
         LOG_FN_DEBUG(__FILENAME__, __func__, "is called & Write data in the XML file is Fine & filename is ", mFileName);
     }
@@ -269,8 +288,42 @@ CAmPersistenceDefault::~CAmPersistenceDefault()
 
 am_Error_e CAmPersistenceDefault::open(const std::string &/*appName*/)
 {
+    timespec startTime, snapshotTime, endTime;
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
     am_Error_e resRead = _readFromXML();
-    if (E_OK != resRead)
+    clock_gettime(CLOCK_MONOTONIC, &snapshotTime);
+
+    // changes written after the most recent snapshot
+    mJournalName = mFileName + PERSISTENCE_JOURNAL_SUFFIX;
+    size_t   journalSize = 0;
+    uint32_t numRecords  = _replayJournal(journalSize);
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+    struct stat snapshotStat;
+    off_t       snapshotSize = (stat(mFileName.c_str(), &snapshotStat) == 0) ? snapshotStat.st_size : 0;
+    LOG_FN_INFO(__FILENAME__, __func__, "restored snapshot of", snapshotSize, "bytes in"
+            , (snapshotTime.tv_sec - startTime.tv_sec) * 1000000 + (snapshotTime.tv_nsec - startTime.tv_nsec) / 1000
+            , "us and", numRecords, "journal records of", journalSize, "bytes in"
+            , (endTime.tv_sec - snapshotTime.tv_sec) * 1000000 + (endTime.tv_nsec - snapshotTime.tv_nsec) / 1000, "us");
+
+    // compacted here instead of in write(), before any request depends on the persistence
+    if ((mJournalLimit > 0) && (numRecords >= mJournalLimit))
+    {
+        clock_gettime(CLOCK_MONOTONIC, &startTime);
+        _createSubDirectories();
+        bool compacted = _compact();
+        clock_gettime(CLOCK_MONOTONIC, &endTime);
+        LOG_FN_INFO(__FILENAME__, __func__, compacted ? "compacted" : "failed to compact", numRecords
+                , "journal records in", (endTime.tv_sec - startTime.tv_sec) * 1000000
+                + (endTime.tv_nsec - startTime.tv_nsec) / 1000, "us");
+    }
+
+    if (E_OK != _openJournal())
+    {
+        LOG_FN_WARN(__FILENAME__, __func__, "journal NOT available, changes are saved on shutdown only", mJournalName);
+    }
+
+    if ((E_OK != resRead) && (numRecords == 0))
     {
         LOG_FN_WARN(__FILENAME__, __func__, "& _readFromXML is FAILED & file name is ", mFileName);
         return E_NON_EXISTENT;
@@ -305,10 +358,214 @@ am_Error_e CAmPersistenceDefault::write(const std::string &keyName,
 {
 
     LOG_FN_DEBUG(__FILENAME__, __func__, "keyName=", keyName, "Value=", writeData);
+    MapData::iterator itFileData = mFileData.find(keyName);
+    if ((itFileData != mFileData.end()) && (itFileData->second == writeData))
+    {
+        // unchanged, no need to grow the journal
+        return E_OK;
+    }
+
     mFileData[keyName] = writeData;
+    return _appendJournal(keyName, writeData);
+}
+
+am_Error_e CAmPersistenceDefault::_openJournal()
+{
+    if (mJournalFd >= 0)
+    {
+        return E_OK;
+    }
+
+    _createSubDirectories();
+    mJournalFd = ::open(mJournalName.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (mJournalFd < 0)
+    {
+        LOG_FN_ERROR(__FILENAME__, __func__, "failed to open journal", mJournalName, "errno", errno);
+        return E_NOT_POSSIBLE;
+    }
+
+    return E_OK;
+}
+
+void CAmPersistenceDefault::_closeJournal()
+{
+    if (mJournalFd >= 0)
+    {
+        ::close(mJournalFd);
+        mJournalFd = -1;
+    }
+}
+
+am_Error_e CAmPersistenceDefault::_appendJournal(const std::string &keyName, const std::string &writeData)
+{
+    if (mJournalFd < 0)
+    {
+        // not opened yet, data is saved with the snapshot on shutdown
+        return E_OK;
+    }
+
+    /*
+     * record layout: "<key length> <data length> <checksum>\n<key><data>\n"
+     * A record torn by a power loss is detected and dropped during the replay.
+     */
+    char header[64];
+    snprintf(header, sizeof(header), "%zu %zu %08x\n", keyName.size(), writeData.size()
+        , _checksum(keyName, writeData));
+    std::string record = header + keyName + writeData + "\n";
+
+    const char *pData     = record.data();
+    size_t      remaining = record.size();
+    while (remaining > 0)
+    {
+        ssize_t written = ::write(mJournalFd, pData, remaining);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            LOG_FN_ERROR(__FILENAME__, __func__, "failed to append", keyName, "to journal, errno", errno);
+            return E_NOT_POSSIBLE;
+        }
+
+        pData     += written;
+        remaining -= written;
+    }
+
+    mJournalRecords++;
+    mUnsyncedRecords++;
+    if ((mSyncInterval > 0) && (mUnsyncedRecords >= mSyncInterval))
+    {
+        fdatasync(mJournalFd);
+        mUnsyncedRecords = 0;
+    }
+
     return E_OK;
 }
 
+uint32_t CAmPersistenceDefault::_replayJournal(size_t &journalSize)
+{
+    std::ifstream journal(mJournalName.c_str(), std::ios::in | std::ios::binary);
+    if (!journal.is_open())
+    {
+        journalSize = 0;
+        return 0;
+    }
+
+    std::string content((std::istreambuf_iterator<char>(journal)), std::istreambuf_iterator<char>());
+    journal.close();
+    journalSize = content.size();
+
+    uint32_t numRecords = 0;
+    size_t   validEnd   = 0;
+    while (validEnd < content.size())
+    {
+        size_t headerEnd = content.find('\n', validEnd);
+        if (headerEnd == std::string::npos)
+        {
+            break;
+        }
+
+        size_t       keyLength  = 0;
+        size_t       dataLength = 0;
+        unsigned int checksum   = 0;
+        std::string  header     = content.substr(validEnd, headerEnd - validEnd);
+        if (sscanf(header.c_str(), "%zu %zu %x", &keyLength, &dataLength, &checksum) != 3)
+        {
+            break;
+        }
+
+        size_t recordEnd = headerEnd + 1 + keyLength + dataLength;
+        if ((recordEnd >= content.size()) || (content[recordEnd] != '\n'))
+        {
+            break;
+        }
+
+        std::string keyName  = content.substr(headerEnd + 1, keyLength);
+        std::string readData = content.substr(headerEnd + 1 + keyLength, dataLength);
+        if (_checksum(keyName, readData) != checksum)
+        {
+            break;
+        }
+
+        mFileData[keyName] = readData;
+        numRecords++;
+        validEnd = recordEnd + 1;
+    }
+
+    if (validEnd < content.size())
+    {
+        LOG_FN_WARN(__FILENAME__, __func__, "dropping incomplete journal tail of", content.size() - validEnd
+                , "bytes after", numRecords, "records");
+        if (truncate(mJournalName.c_str(), validEnd) != 0)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "failed to truncate journal, errno", errno);
+        }
+    }
+
+    mJournalRecords = numRecords;
+    return numRecords;
+}
+
+bool CAmPersistenceDefault::_compact()
+{
+    if (!_writeTOXML())
+    {
+        return false;
+    }
+
+    // all journal records are covered by the new snapshot now
+    if (mJournalFd >= 0)
+    {
+        if (ftruncate(mJournalFd, 0) != 0)
+        {
+            LOG_FN_ERROR(__FILENAME__, __func__, "failed to truncate journal, errno", errno);
+            return false;
+        }
+
+        fdatasync(mJournalFd);
+    }
+    else if (!mJournalName.empty())
+    {
+        (void)unlink(mJournalName.c_str());
+    }
+
+    LOG_FN_INFO(__FILENAME__, __func__, mJournalRecords, "journal records merged into", mFileName);
+    mJournalRecords  = 0;
+    mUnsyncedRecords = 0;
+    return true;
+}
+
+uint32_t CAmPersistenceDefault::_checksum(const std::string &keyName, const std::string &writeData)
+{
+    // FNV-1a over key and data, separated by a zero byte
+    uint32_t hash = 2166136261u;
+    for (const char c : keyName)
+    {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+
+    hash = (hash ^ 0u) * 16777619u;
+    for (const char c : writeData)
+    {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+
+    return hash;
+}
+
+uint32_t CAmPersistenceDefault::_getEnvValue(const char *envVarName, const uint32_t defaultValue)
+{
+    const char *pValue = getenv(envVarName);
+    if ((pValue == NULL) || (*pValue == '\0'))
+    {
+        return defaultValue;
+    }
+
+    return static_cast<uint32_t>(strtoul(pValue, NULL, 10));
+}
+
 void CAmPersistenceDefault::_updateMainConnectionVolume(std::string className, std::string sourceName, std::string sinkName, int16_t volume, std::vector<gc_persistence_classData_s > &outVClassDataS)
 {
     bool                            classFound = false;
@@ -1120,8 +1377,43 @@ bool CAmPersistenceDefault::_writeTOXML()
 
     CAmPersistenceNode(TAG_ROOT_PERSISTENCE, mvClassDataS, mvSystemPropertyS).write(pDocument, NULL);
 
-    xmlSaveFormatFileEnc(mFileName.c_str(), pDocument, "UTF-8", 1);
+    // write to a temporary file first, so a crash never leaves a truncated snapshot behind
+    std::string tempFileName = mFileName + PERSISTENCE_SNAPSHOT_TEMP_SUFFIX;
+    int         written      = xmlSaveFormatFileEnc(tempFileName.c_str(), pDocument, "UTF-8", 1);
     xmlFreeDoc(pDocument);
+    if (written < 0)
+    {
+        LOG_FN_ERROR(__FILENAME__, __func__, "failed to save", tempFileName);
+        return false;
+    }
+
+    int fd = ::open(tempFileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0)
+    {
+        fsync(fd);
+        ::close(fd);
+    }
+
+    if (rename(tempFileName.c_str(), mFileName.c_str()) != 0)
+    {
+        LOG_FN_ERROR(__FILENAME__, __func__, "failed to replace", mFileName, "errno", errno);
+        return false;
+    }
+
+    // the rename itself is only durable once the directory entry is synchronized
+    size_t      separator = mFileName.find_last_of('/');
+    std::string directory = (separator == std::string::npos) ? "." : mFileName.substr(0, separator + 1);
+    fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0)
+    {
+        fsync(fd);
+        ::close(fd);
+    }
+    else
+    {
+        LOG_FN_WARN(__FILENAME__, __func__, "failed to synchronize directory", directory, "errno", errno);
+    }
+
     return true;
 }
 
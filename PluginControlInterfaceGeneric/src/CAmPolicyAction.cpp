@@ -448,6 +448,7 @@ void CAmPolicyAction::_setActionParameters(std::map<std::string, std::string > &
         am_NotificationStatus_e, pAction);
     checkAndSetNumericParam(mapParams, ACTION_PARAM_NOTIFICATION_CONFIGURATION_PARAM, int16_t,
         pAction);
+    checkAndSetNumericParam(mapParams, ACTION_PARAM_PARALLEL, bool, pAction);
 
 }
 
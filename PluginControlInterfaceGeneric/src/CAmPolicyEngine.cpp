@@ -216,7 +216,7 @@ bool CAmPolicyEngine::_getActionsfromPolicy(const gc_Process_s &process,
     {
         LOG_FN_INFO(__FILENAME__, __func__, "Policy applied with", process.listActions.size()
             , "actions:", process.comment);
-        for (auto processAction : process.listActions)
+        for (const auto &processAction : process.listActions)
         {
             listActions.push_back(processAction);
             gc_Action_s &action = listActions.back();
@@ -256,6 +256,120 @@ void CAmPolicyEngine::_removeDoubleQuotes(std::string &inputString,
     }
 }
 
+gc_Macro_e CAmPolicyEngine::resolveMacro(const std::string &name)
+{
+    // lookup table, populated once on first usage
+    static const std::map<std::string, gc_Macro_e > mapMacros =
+    {
+        { FUNCTION_MACRO_REQ_TRIG_TYPE, MACRO_REQ_TRIG_TYPE },
+        { FUNCTION_MACRO_REQ_SINK_NAME, MACRO_REQ_SINK_NAME },
+        { FUNCTION_MACRO_REQ_SOURCE_NAME, MACRO_REQ_SOURCE_NAME },
+        { FUNCTION_MACRO_REQ_DOMAIN_NAME, MACRO_REQ_DOMAIN_NAME },
+        { FUNCTION_MACRO_REQ_GATEWAY_NAME, MACRO_REQ_GATEWAY_NAME },
+        { FUNCTION_MACRO_REQ_CLASS_NAME, MACRO_REQ_CLASS_NAME },
+        { FUNCTION_MACRO_REQ_CONNECTION_NAME, MACRO_REQ_CONNECTION_NAME },
+        { FUNCTION_MACRO_REQ_CONNECTION_STATE, MACRO_REQ_CONNECTION_STATE },
+        { FUNCTION_MACRO_REQ_STATUS, MACRO_REQ_STATUS },
+        { FUNCTION_MACRO_MAIN_VOLUME, MACRO_MAIN_VOLUME },
+        { FUNCTION_MACRO_MSP_TYPE, MACRO_MSP_TYPE },
+        { FUNCTION_MACRO_MSP_VAL, MACRO_MSP_VAL },
+        { FUNCTION_MACRO_SYP_TYPE, MACRO_SYP_TYPE },
+        { FUNCTION_MACRO_SYP_VAL, MACRO_SYP_VAL },
+        { FUNCTION_MACRO_AVAIL_STATE, MACRO_AVAIL_STATE },
+        { FUNCTION_MACRO_AVAIL_REASON, MACRO_AVAIL_REASON },
+        { FUNCTION_MACRO_MUTE_STATE, MACRO_MUTE_STATE },
+        { FUNCTION_MACRO_INT_STATE, MACRO_INT_STATE },
+        { FUNCTION_MACRO_NP_TYPE, MACRO_NP_TYPE },
+        { FUNCTION_MACRO_NP_VAL, MACRO_NP_VAL },
+        { FUNCTION_MACRO_NC_TYPE, MACRO_NC_TYPE },
+        { FUNCTION_MACRO_NC_STATUS, MACRO_NC_STATUS },
+        { FUNCTION_MACRO_NC_PARAM, MACRO_NC_PARAM }
+    };
+
+    auto itMacro = mapMacros.find(name);
+    return (itMacro != mapMacros.end()) ? itMacro->second : MACRO_UNKNOWN;
+}
+
+void CAmPolicyEngine::evaluateMacro(const gc_triggerParams_s &parameters, const gc_Macro_e macro,
+    std::string &requested)
+{
+    switch (macro)
+    {
+    case MACRO_REQ_TRIG_TYPE:
+        requested = to_string(parameters.triggerType);
+        break;
+    case MACRO_REQ_SINK_NAME:
+        requested = parameters.sinkName;
+        break;
+    case MACRO_REQ_SOURCE_NAME:
+        requested = parameters.sourceName;
+        break;
+    case MACRO_REQ_DOMAIN_NAME:
+        requested = parameters.domainName;
+        break;
+    case MACRO_REQ_GATEWAY_NAME:
+        requested = parameters.gatewayName;
+        break;
+    case MACRO_REQ_CLASS_NAME:
+        requested = parameters.className;
+        break;
+    case MACRO_REQ_CONNECTION_NAME:
+        requested = parameters.connectionName;
+        break;
+    case MACRO_REQ_CONNECTION_STATE:
+        requested = to_string(parameters.connectionState);
+        break;
+    case MACRO_REQ_STATUS:
+        requested = to_string(parameters.status);
+        break;
+    case MACRO_MAIN_VOLUME:
+        requested = to_string(parameters.mainVolume);
+        break;
+    case MACRO_MSP_TYPE:
+        requested = to_string(parameters.mainSoundProperty.type);
+        break;
+    case MACRO_MSP_VAL:
+        requested = to_string(parameters.mainSoundProperty.value);
+        break;
+    case MACRO_SYP_TYPE:
+        requested = to_string(parameters.systemProperty.type);
+        break;
+    case MACRO_SYP_VAL:
+        requested = to_string(parameters.systemProperty.value);
+        break;
+    case MACRO_AVAIL_STATE:
+        requested = to_string(parameters.availability.availability);
+        break;
+    case MACRO_AVAIL_REASON:
+        requested = to_string(parameters.availability.availabilityReason);
+        break;
+    case MACRO_MUTE_STATE:
+        requested = to_string(parameters.muteState);
+        break;
+    case MACRO_INT_STATE:
+        requested = to_string(parameters.interruptState);
+        break;
+    case MACRO_NP_TYPE:
+        requested = to_string(parameters.notificatonPayload.type);
+        break;
+    case MACRO_NP_VAL:
+        requested = to_string(parameters.notificatonPayload.value);
+        break;
+    case MACRO_NC_TYPE:
+        requested = to_string(parameters.notificatonConfiguration.type);
+        break;
+    case MACRO_NC_STATUS:
+        requested = to_string(parameters.notificatonConfiguration.status);
+        break;
+    case MACRO_NC_PARAM:
+        requested = to_string(parameters.notificatonConfiguration.parameter);
+        break;
+    default:
+        LOG_FN_ERROR(__FILENAME__, __func__, "undefined macro", macro, "for trigger", parameters.triggerType);
+        break;
+    }
+}
+
 void CAmPolicyEngine::evaluateMacro(const gc_triggerParams_s &parameters, std::string &requested)
 {
     if (requested.find("REQ_") != 0)
@@ -263,48 +377,32 @@ void CAmPolicyEngine::evaluateMacro(const gc_triggerParams_s &parameters, std::s
         return;   // not a macro handled by this method -> do not touch parameter
     }
 
-    std::map < std::string, std::string > mapRequesting =
-    {
-        { FUNCTION_MACRO_REQ_TRIG_TYPE, to_string(parameters.triggerType)},
-        { FUNCTION_MACRO_REQ_SINK_NAME, parameters.sinkName},
-        { FUNCTION_MACRO_REQ_SOURCE_NAME, parameters.sourceName},
-        { FUNCTION_MACRO_REQ_DOMAIN_NAME, parameters.domainName},
-        { FUNCTION_MACRO_REQ_GATEWAY_NAME, parameters.gatewayName},
-        { FUNCTION_MACRO_REQ_CLASS_NAME, parameters.className},
-        { FUNCTION_MACRO_REQ_CONNECTION_NAME, parameters.connectionName},
-        { FUNCTION_MACRO_REQ_CONNECTION_STATE, to_string(parameters.connectionState)},
-        { FUNCTION_MACRO_REQ_STATUS,  to_string(parameters.status)},
-        { FUNCTION_MACRO_MAIN_VOLUME, to_string(parameters.mainVolume)},
-        { FUNCTION_MACRO_MSP_TYPE, to_string(parameters.mainSoundProperty.type)},
-        { FUNCTION_MACRO_MSP_VAL, to_string(parameters.mainSoundProperty.value)},
-        { FUNCTION_MACRO_SYP_TYPE, to_string(parameters.systemProperty.type)},
-        { FUNCTION_MACRO_SYP_VAL, to_string(parameters.systemProperty.value)},
-        { FUNCTION_MACRO_AVAIL_STATE, to_string(parameters.availability.availability)},
-        { FUNCTION_MACRO_AVAIL_REASON, to_string(parameters.availability.availabilityReason)},
-        { FUNCTION_MACRO_MUTE_STATE, to_string(parameters.muteState)},
-        { FUNCTION_MACRO_INT_STATE, to_string(parameters.interruptState)},
-        { FUNCTION_MACRO_NP_TYPE, to_string(parameters.notificatonPayload.type)},
-        { FUNCTION_MACRO_NP_VAL, to_string(parameters.notificatonPayload.value)},
-        { FUNCTION_MACRO_NC_TYPE, to_string(parameters.notificatonConfiguration.type)},
-        { FUNCTION_MACRO_NC_STATUS, to_string(parameters.notificatonConfiguration.status)},
-        { FUNCTION_MACRO_NC_PARAM, to_string(parameters.notificatonConfiguration.parameter)}
-    };
-    if (mapRequesting.count(requested))
-    {
-        std::string &converted = mapRequesting.at(requested);
-        LOG_FN_DEBUG(__FILENAME__, __func__, requested, "-->", converted, "for trigger", parameters.triggerType);
-        requested = converted;
-    }
-    else
+    gc_Macro_e macro = resolveMacro(requested);
+    if (MACRO_UNKNOWN == macro)
     {
         LOG_FN_ERROR(__FILENAME__, __func__, "undefined macro", requested, "for trigger", parameters.triggerType);
+        return;
     }
+
+    std::string converted;
+    evaluateMacro(parameters, macro, converted);
+    LOG_FN_DEBUG(__FILENAME__, __func__, requested, "-->", converted, "for trigger", parameters.triggerType);
+    requested.swap(converted);
 }
 
 void CAmPolicyEngine::_convertActionParamsToValues(gc_Action_s &action, const gc_triggerParams_s &parameters)
 {
-    for (auto& itMapParameters : action.mapParameters)
+    // only parameters marked by the configuration parser need trigger-dependent conversion
+    for (const auto &parameterName : action.listDynamicParameters)
     {
+        auto itParameter = action.mapParameters.find(parameterName);
+        if (itParameter == action.mapParameters.end())
+        {
+            continue;
+        }
+
+        auto &itMapParameters = *itParameter;
+
         // if parameter is a macro requesting dedicated fields, evaluate it
         evaluateMacro(parameters, itMapParameters.second);
 
@@ -389,20 +487,15 @@ void CAmPolicyEngine::_evaluateParameterFunction(const gc_triggerParams_s &trigg
 am_Error_e CAmPolicyEngine::_getActions(std::vector<gc_Action_s > &listActions,
     const gc_triggerParams_s &parameters)
 {
-    std::vector<gc_Process_s > listProcesses;
     std::vector<gc_Action_s >  listActionSets;
     listActions.clear();
 
-    // evaluate policies
-    if (E_OK != CAmConfigurationReader::instance().getListProcess(parameters.triggerType, listProcesses))
+    // evaluate policies, pre-sorted by priority
+    const std::vector<const gc_Process_s * > &listProcesses =
+        CAmConfigurationReader::instance().getListProcess(parameters.triggerType);
+    for (const auto pProcess : listProcesses)
     {
-        LOG_FN_ERROR(__FILENAME__, __func__, "ERROR finding process for", parameters);
-        return E_NOT_POSSIBLE;
-    }
-
-    for (auto &process : listProcesses)
-    {
-        bool stopEvaluation = _getActionsfromPolicy(process, listActionSets, parameters);
+        bool stopEvaluation = _getActionsfromPolicy(*pProcess, listActionSets, parameters);
         listActions.insert(listActions.end(), listActionSets.begin(), listActionSets.end());
         if (true == stopEvaluation)
         {
@@ -735,23 +828,17 @@ void CAmPolicyEngine::_scheduleSoundPropertyTriggers(std::shared_ptr<CAmRoutePoi
         // Create a trigger for each recovered property and append it to the Queue
         if (pElement->getType()== ET_SINK)
         {
-            auto *trigger = new gc_SinkSoundPropertyTrigger_s;
-            if (trigger)
-            {
-                trigger->sinkName                = pElement->getName();
-                trigger->mainSoundProperty       = lastMainSoundProperty;
-                CAmTriggerQueue::getInstance()->queue(USER_SET_SINK_MAIN_SOUND_PROPERTY, trigger);
-            }
+            gc_SinkSoundPropertyTrigger_s trigger;
+            trigger.sinkName                = pElement->getName();
+            trigger.mainSoundProperty       = lastMainSoundProperty;
+            CAmTriggerQueue::getInstance()->queue(USER_SET_SINK_MAIN_SOUND_PROPERTY, std::move(trigger));
         }
         else if (pElement->getType()== ET_SOURCE)
         {
-            auto *trigger = new gc_SourceSoundPropertyTrigger_s;
-            if (trigger)
-            {
-                trigger->sourceName              = pElement->getName();
-                trigger->mainSoundProperty       = lastMainSoundProperty;
-                CAmTriggerQueue::getInstance()->queue(USER_SET_SOURCE_MAIN_SOUND_PROPERTY, trigger);
-            }
+            gc_SourceSoundPropertyTrigger_s trigger;
+            trigger.sourceName              = pElement->getName();
+            trigger.mainSoundProperty       = lastMainSoundProperty;
+            CAmTriggerQueue::getInstance()->queue(USER_SET_SOURCE_MAIN_SOUND_PROPERTY, std::move(trigger));
         }
     }
 
@@ -762,23 +849,17 @@ void CAmPolicyEngine::_scheduleSoundPropertyTriggers(std::shared_ptr<CAmRoutePoi
     }
     else if (pElement->getType()== ET_SINK)
     {
-        auto *trigger = new gc_SinkSoundPropertiesTrigger_s;
-        if (trigger)
-        {
-            trigger->sinkName                = pElement->getName();
-            trigger->listMainSoundProperty   = listLastMainSoundProperty;
-            CAmTriggerQueue::getInstance()->queue(USER_SET_SINK_MAIN_SOUND_PROPERTIES, trigger);
-        }
+        gc_SinkSoundPropertiesTrigger_s trigger;
+        trigger.sinkName                = pElement->getName();
+        trigger.listMainSoundProperty   = listLastMainSoundProperty;
+        CAmTriggerQueue::getInstance()->queue(USER_SET_SINK_MAIN_SOUND_PROPERTIES, std::move(trigger));
     }
     else if (pElement->getType()== ET_SOURCE)
     {
-        auto *trigger = new gc_SourceSoundPropertiesTrigger_s;
-        if (trigger)
-        {
-            trigger->sourceName              = pElement->getName();
-            trigger->listMainSoundProperty   = listLastMainSoundProperty;
-            CAmTriggerQueue::getInstance()->queue(USER_SET_SOURCE_MAIN_SOUND_PROPERTIES, trigger);
-        }
+        gc_SourceSoundPropertiesTrigger_s trigger;
+        trigger.sourceName              = pElement->getName();
+        trigger.listMainSoundProperty   = listLastMainSoundProperty;
+        CAmTriggerQueue::getInstance()->queue(USER_SET_SOURCE_MAIN_SOUND_PROPERTIES, std::move(trigger));
     }
 }
 
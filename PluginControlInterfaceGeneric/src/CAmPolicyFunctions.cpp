@@ -35,6 +35,7 @@ namespace gc {
 
 CAmPolicyFunctions::CAmPolicyFunctions(IAmPolicyReceive *pPolicyReceive)
     : mpPolicyReceive(pPolicyReceive)
+    , mCompiledLoadCount(0)
 {
     // function (as supported in conditions of policy ) mapping to returns string or integer
     mMapFunctionReturnValue[FUNCTION_NAME]                                   = true;
@@ -103,13 +104,157 @@ CAmPolicyFunctions::CAmPolicyFunctions(IAmPolicyReceive *pPolicyReceive)
     mMapFunctionNameToFunctionMaps[FUNCTION_MAIN_NOTIFICATION_CONFIGURATION_PARAM]  = &CAmPolicyFunctions::_findMainNTParam;
     mMapFunctionNameToFunctionMaps[FUNCTION_SCALE]                                  = &CAmPolicyFunctions::_findScale;
     mMapFunctionNameToFunctionMaps[FUNCTION_COUNT]                                  = &CAmPolicyFunctions::_findCount;
+
+    _compileConfiguration();
+}
+
+// file-local list of parameter members of a policy function, in order mandatory, optional, optional2
+static std::string gc_FunctionElement_s::*const sFunctionParameters[GC_FUNCTION_PARAMETER_COUNT] =
+{
+    &gc_FunctionElement_s::mandatoryParameter,
+    &gc_FunctionElement_s::optionalParameter,
+    &gc_FunctionElement_s::optionalParameter2
+};
+
+CAmPolicyFunctions::gc_CompiledFunction_s::gc_CompiledFunction_s()
+    : pFunction(NULL)
+    , isStringResult(false)
+    , isConstant(true)
+{
+    for (unsigned int index = 0; index < GC_FUNCTION_PARAMETER_COUNT; ++index)
+    {
+        parameterKind[index] = PK_LITERAL;
+        macro[index]         = MACRO_UNKNOWN;
+    }
+}
+
+void CAmPolicyFunctions::_compileFunction(const gc_FunctionElement_s &function,
+    gc_CompiledFunction_s &compiled) const
+{
+    compiled.element = function;
+
+    auto itFunction = mMapFunctionNameToFunctionMaps.find(function.functionName);
+    compiled.pFunction = (itFunction != mMapFunctionNameToFunctionMaps.end()) ? itFunction->second : NULL;
+
+    auto itReturnValue = mMapFunctionReturnValue.find(function.functionName);
+    compiled.isStringResult = (itReturnValue != mMapFunctionReturnValue.end()) && itReturnValue->second;
+
+    compiled.isConstant = true;
+    for (unsigned int index = 0; index < GC_FUNCTION_PARAMETER_COUNT; ++index)
+    {
+        const std::string   &parameter = function.*sFunctionParameters[index];
+        gc_FunctionElement_s nested;
+        unsigned int         position  = 0;
+
+        compiled.parameterKind[index] = PK_LITERAL;
+        compiled.macro[index]         = MACRO_UNKNOWN;
+        compiled.pNested[index].reset();
+        if (parameter.find("REQ_") == 0)
+        {
+            compiled.parameterKind[index] = PK_MACRO;
+            compiled.macro[index]         = CAmPolicyEngine::resolveMacro(parameter);
+            if (MACRO_UNKNOWN == compiled.macro[index])
+            {
+                LOG_FN_ERROR(__FILENAME__, __func__, "undefined macro", parameter, "in", function.functionName);
+                compiled.parameterKind[index] = PK_LITERAL;
+            }
+        }
+        else if ((parameter.find('(') != std::string::npos)
+                 && (E_OK == CAmXmlConfigParser::parsePolicyFunction(parameter.c_str(), position, nested)))
+        {
+            compiled.parameterKind[index] = PK_FUNCTION;
+            compiled.pNested[index]       = std::make_shared<gc_CompiledFunction_s >();
+            _compileFunction(nested, *compiled.pNested[index]);
+        }
+
+        if (compiled.parameterKind[index] != PK_LITERAL)
+        {
+            compiled.isConstant = false;
+        }
+    }
+}
+
+void CAmPolicyFunctions::_compileConditions(const std::vector<gc_ConditionStruct_s > &listConditionSets,
+    std::vector<gc_CompiledCondition_s > &listCompiled) const
+{
+    listCompiled.clear();
+    listCompiled.resize(listConditionSets.size());
+    for (size_t index = 0; index < listConditionSets.size(); ++index)
+    {
+        const gc_ConditionStruct_s &condition = listConditionSets[index];
+        gc_CompiledCondition_s     &compiled  = listCompiled[index];
+
+        _compileFunction(condition.leftObject, compiled.leftObject);
+        compiled.operation    = condition.operation;
+        compiled.isRightValue = condition.rightObject.isValue;
+        if (compiled.isRightValue)
+        {
+            // resolve symbolic constants now if LHS function delivers integers
+            int value;
+            if (!compiled.leftObject.isStringResult
+                && (E_OK == CAmXmlConfigParser::getEnumerationValue(condition.rightObject.directValue, value)))
+            {
+                compiled.rightValue = gc_PolicyValue_s(static_cast<int32_t>(value));
+            }
+            else
+            {
+                compiled.rightValue = gc_PolicyValue_s(condition.rightObject.directValue);
+            }
+        }
+        else
+        {
+            _compileFunction(condition.rightObject.functionObject, compiled.rightObject);
+        }
+    }
+}
+
+void CAmPolicyFunctions::_compileConfiguration(void)
+{
+    CAmConfigurationReader &reader = CAmConfigurationReader::instance();
+
+    mMapCompiledConditions.clear();
+    mMapCompiledParameters.clear();
+    for (int trigger = TRIGGER_UNKNOWN; trigger < TRIGGER_MAX; ++trigger)
+    {
+        for (const auto pProcess : reader.getListProcess(static_cast<gc_Trigger_e>(trigger)))
+        {
+            // processes listening to several triggers need to be compiled only once
+            const std::vector<gc_ConditionStruct_s > *pConditions = &pProcess->listConditions;
+            if (mMapCompiledConditions.count(pConditions) == 0)
+            {
+                _compileConditions(*pConditions, mMapCompiledConditions[pConditions]);
+            }
+        }
+    }
+
+    mCompiledLoadCount = reader.getLoadCount();
+    LOG_FN_DEBUG(__FILENAME__, __func__, "compiled condition sets:", mMapCompiledConditions.size());
 }
 
 bool CAmPolicyFunctions::evaluateConditionSet(
     const std::vector<gc_ConditionStruct_s > &listConditionSets,
     const gc_triggerParams_s &parameters)
 {
-    for (const auto &condition : listConditionSets)
+    if (mCompiledLoadCount != CAmConfigurationReader::instance().getLoadCount())
+    {
+        _compileConfiguration();
+    }
+
+    std::vector<gc_CompiledCondition_s >        listTemporary;
+    const std::vector<gc_CompiledCondition_s > *pCompiled;
+    auto itCompiled = mMapCompiledConditions.find(&listConditionSets);
+    if (itCompiled != mMapCompiledConditions.end())
+    {
+        pCompiled = &itCompiled->second;
+    }
+    else
+    {
+        // not part of configuration - compile on the fly, but do not memorize
+        _compileConditions(listConditionSets, listTemporary);
+        pCompiled = &listTemporary;
+    }
+
+    for (const auto &condition : *pCompiled)
     {
         if (!_isConditionTrue(condition, parameters))
         {
@@ -125,56 +270,91 @@ void CAmPolicyFunctions::evaluateParameter(const gc_triggerParams_s &trigger, st
     CAmPolicyEngine::evaluateMacro(trigger, parameter);
 
     // if parameter is a nested function, resolve it
-    const char *str = parameter.c_str();
-    if (strchr(str, '(') == NULL)
+    if (parameter.find('(') == std::string::npos)
     {
         return;
     }
 
-    std::string orig(parameter);
-    gc_FunctionElement_s      nested;
-    std::vector<std::string > innerList;
-    unsigned int              position = 0;
-    if (E_OK == CAmXmlConfigParser::parsePolicyFunction(str, position, nested))
+    if (mCompiledLoadCount != CAmConfigurationReader::instance().getLoadCount())
     {
+        _compileConfiguration();
+    }
 
-        bool success = _executeFunction(nested, trigger, innerList);
-        if (!success)
+    auto itCompiled = mMapCompiledParameters.find(parameter);
+    if (itCompiled == mMapCompiledParameters.end())
+    {
+        gc_FunctionElement_s nested;
+        unsigned int         position = 0;
+        if (E_OK != CAmXmlConfigParser::parsePolicyFunction(parameter.c_str(), position, nested))
         {
-            LOG_FN_ERROR(__FILENAME__, __func__, "FAILED evaluating:", parameter);
             return;
         }
 
-        parameter.clear();
-        bool first = true;
-        for (const auto &value : innerList)
-        {
-            parameter += (first ? "" : " ") + value;
-            first      = false;
-        }
+        itCompiled = mMapCompiledParameters.emplace(parameter, gc_CompiledFunction_s()).first;
+        _compileFunction(nested, itCompiled->second);
     }
 
+    std::string orig(parameter);
+    _evaluateNestedFunction(itCompiled->second, trigger, parameter);
     if (parameter != orig)
     {
         LOG_FN_DEBUG(__FILENAME__, __func__, trigger.triggerType, orig, "-->", parameter);
     }
 }
 
-bool CAmPolicyFunctions::_executeFunction(gc_FunctionElement_s function
-    , const gc_triggerParams_s &trigger, std::vector<std::string > &listOutputs)
+void CAmPolicyFunctions::_evaluateNestedFunction(const gc_CompiledFunction_s &nested,
+    const gc_triggerParams_s &trigger, std::string &parameter)
 {
-    // resolve nested functions
-    evaluateParameter(trigger, function.mandatoryParameter);
-    evaluateParameter(trigger, function.optionalParameter);
-    evaluateParameter(trigger, function.optionalParameter2);
+    std::vector<gc_PolicyValue_s > innerList;
+    bool success = _executeFunction(nested, trigger, innerList);
+    if (!success)
+    {
+        LOG_FN_ERROR(__FILENAME__, __func__, "FAILED evaluating:", parameter);
+        return;
+    }
 
-    if (mMapFunctionNameToFunctionMaps.count(function.functionName) == 0)
+    parameter.clear();
+    bool first = true;
+    for (const auto &value : innerList)
+    {
+        parameter += (first ? "" : " ") + value.toString();
+        first      = false;
+    }
+}
+
+bool CAmPolicyFunctions::_executeFunction(const gc_CompiledFunction_s &function
+    , const gc_triggerParams_s &trigger, std::vector<gc_PolicyValue_s > &listOutputs)
+{
+    if (function.pFunction == NULL)
     {
-        LOG_FN_ERROR("condition", function.functionName, "(", function.category, ", ...) not allowed");
+        LOG_FN_ERROR("condition", function.element.functionName, "(", function.element.category, ", ...) not allowed");
         return false;
     }
 
-    return (this->*mMapFunctionNameToFunctionMaps.at(function.functionName))(function, trigger, listOutputs) == E_OK;
+    if (function.isConstant)
+    {
+        return (this->*function.pFunction)(function.element, trigger, listOutputs) == E_OK;
+    }
+
+    // resolve macros and nested functions
+    gc_FunctionElement_s resolved(function.element);
+    for (unsigned int index = 0; index < GC_FUNCTION_PARAMETER_COUNT; ++index)
+    {
+        std::string &parameter = resolved.*sFunctionParameters[index];
+        switch (function.parameterKind[index])
+        {
+        case PK_MACRO:
+            CAmPolicyEngine::evaluateMacro(trigger, function.macro[index], parameter);
+            break;
+        case PK_FUNCTION:
+            _evaluateNestedFunction(*function.pNested[index], trigger, parameter);
+            break;
+        default:
+            break;
+        }
+    }
+
+    return (this->*function.pFunction)(resolved, trigger, listOutputs) == E_OK;
 }
 
 // file-local helper function
@@ -215,26 +395,21 @@ bool _conditionResult(Toperand lhsData, gc_Operator_e opType, Toperand rhdData)
     return result;
 }
 
-bool CAmPolicyFunctions::_isConditionTrue(const gc_ConditionStruct_s &condition,
+bool CAmPolicyFunctions::_isConditionTrue(const gc_CompiledCondition_s &condition,
     const gc_triggerParams_s &parameters)
 {
-    std::string                         LHSString, RHSString;
-    int32_t                             LHSInt, RHSInt;
-    std::vector<std::string >           listLHSOutputs;
-    std::vector<std::string >           listRHSOutputs;
-    std::vector<std::string >::iterator itListOutputs;
-    bool                                result;
-    const gc_Operator_e                &operation = condition.operation;
-
-    // main evaluation logic comes here!!!!!!!!
-
-    // convert operator from string to enum type
-    // invoke the function to get the LHS string from condition
+    std::vector<gc_PolicyValue_s > listLHSOutputs;
+    std::vector<gc_PolicyValue_s > listRHSOutputs;
+    const gc_PolicyValue_s        *pRHSValue;
+    bool                           result;
+    const gc_Operator_e           &operation = condition.operation;
+
+    // invoke the function to get the LHS values from condition
     result = _executeFunction(condition.leftObject, parameters, listLHSOutputs);
     if (false == result)
     {
         LOG_FN_DEBUG(__FILENAME__, __func__, " LHS function return error. function->category 1",
-            condition.leftObject.functionName, condition.leftObject.category);
+            condition.leftObject.element.functionName, condition.leftObject.element.category);
         return result;
     }
 
@@ -243,51 +418,79 @@ bool CAmPolicyFunctions::_isConditionTrue(const gc_ConditionStruct_s &condition,
      * the reason is EXC condition would pass for empty list.
      */
 
-    // get the RHS string from condition
-    if (true == condition.rightObject.isValue) // direct value is provided by user
+    // get the RHS value from condition
+    if (true == condition.isRightValue) // direct value is provided by user
     {
-        RHSString = condition.rightObject.directValue;
+        pRHSValue = &condition.rightValue;
     }
     else
     {
-        // invoke the function to get the RHS string from condition
-        result = _executeFunction(condition.rightObject.functionObject, parameters, listRHSOutputs);
+        // invoke the function to get the RHS value from condition
+        const gc_FunctionElement_s &rightFunction = condition.rightObject.element;
+        result = _executeFunction(condition.rightObject, parameters, listRHSOutputs);
         if (false == result)
         {
             LOG_FN_DEBUG(__FILENAME__, __func__, " RHS function return error. function->category 3",
-                condition.rightObject.functionObject.functionName,
-                condition.rightObject.functionObject.category);
+                rightFunction.functionName, rightFunction.category);
             return result;
         }
 
         if (true == listRHSOutputs.empty())
         {
             LOG_FN_DEBUG(__FILENAME__, __func__, " RHS function does not return any value function->category 4",
-                condition.rightObject.functionObject.functionName,
-                condition.rightObject.functionObject.category,
-                condition.rightObject.functionObject.mandatoryParameter,
-                condition.rightObject.functionObject.optionalParameter);
+                rightFunction.functionName, rightFunction.category,
+                rightFunction.mandatoryParameter, rightFunction.optionalParameter);
             return false;
         }
 
-        RHSString = listRHSOutputs[0];
+        pRHSValue = &listRHSOutputs[0];
     }
 
-    if ((INC == operation) || (EXC == operation)) // operator is include or exclude operator
+    if (condition.leftObject.isStringResult)
     {
-        // if LHS function returns integer, convert RHS symbolic constant to numeric value
-        if (!mMapFunctionReturnValue[condition.leftObject.functionName])
+        // function is of type string
+        const std::string RHSString = pRHSValue->toString();
+        if ((INC == operation) || (EXC == operation)) // operator is include or exclude operator
         {
-            int value;
-            CAmXmlConfigParser::getEnumerationValue(RHSString, value);
-            RHSString = to_string(value);
+            result = (INC == operation) ? false : true;
+            for (const auto &value : listLHSOutputs)
+            {
+                if (value.toString() == RHSString)
+                {
+                    result = !result;
+                    break;
+                }
+            }
+        }
+        else if (false == listLHSOutputs.empty())   // mathematical operator
+        {
+            result = _conditionResult(listLHSOutputs[0].toString(), operation, RHSString);
+        }
+        else
+        {
+            result = false;
         }
 
+        return result;
+    }
+
+    // function is of type integer. RHS values from configuration are already converted,
+    // only string results of RHS functions need to be interpreted as numerical here
+    int     enumeratedValue = 0;
+    bool    isRHSNumeric    = true;
+    int32_t RHSInt          = pRHSValue->integerValue;
+    if (!pRHSValue->isInteger)
+    {
+        isRHSNumeric = (E_OK == CAmXmlConfigParser::getEnumerationValue(pRHSValue->stringValue, enumeratedValue));
+        RHSInt       = enumeratedValue;
+    }
+
+    if ((INC == operation) || (EXC == operation)) // operator is include or exclude operator
+    {
         result = (INC == operation) ? false : true;
-        for (itListOutputs = listLHSOutputs.begin(); itListOutputs != listLHSOutputs.end();
-             itListOutputs++)
+        for (const auto &value : listLHSOutputs)
         {
-            if (*itListOutputs == RHSString)
+            if (isRHSNumeric && (value.toInteger() == RHSInt))
             {
                 result = !result;
                 break;
@@ -299,21 +502,14 @@ bool CAmPolicyFunctions::_isConditionTrue(const gc_ConditionStruct_s &condition,
         result = false;
         if (false == listLHSOutputs.empty())
         {
-            if (mMapFunctionReturnValue[condition.leftObject.functionName])
-            {
-                // function if of type string
-                LHSString = listLHSOutputs[0];
-                result    = _conditionResult(LHSString, operation, RHSString);
-            }
-            else if (E_OK == CAmXmlConfigParser::getEnumerationValue(RHSString, RHSInt))
+            if (isRHSNumeric)
             {
-                // function is of type integer and RHS value can be interpreted as numerical
-                LHSInt = atoi(listLHSOutputs[0].data());
-                result = _conditionResult(LHSInt, operation, RHSInt);
+                result = _conditionResult(listLHSOutputs[0].toInteger(), operation, RHSInt);
             }
             else
             {
-                LOG_FN_ERROR(__FILENAME__, __func__, "FAILED comparing", LHSString, operation, RHSString);
+                LOG_FN_ERROR(__FILENAME__, __func__, "FAILED comparing", listLHSOutputs[0].toString(),
+                    operation, pRHSValue->toString());
             }
         }
     }
@@ -356,7 +552,7 @@ bool CAmPolicyFunctions::_isSingleDomainRequest(const gc_FunctionElement_s &func
 
 am_Error_e CAmPolicyFunctions::_getNameList(const std::string &mandatoryParameter,
     const std::string &optionalParameter,
-    std::vector<std::string > &listOutputs,
+    std::vector<gc_PolicyValue_s > &listOutputs,
     const gc_triggerParams_s &parameters,
     const bool isSinkRequired)
 {
@@ -442,7 +638,7 @@ am_Error_e CAmPolicyFunctions::_getConnectionList(
 am_Error_e CAmPolicyFunctions::_findUserNotificationType(FUNCTION_PARAMS)
 {
     (void)function.category;
-    listOutputs.push_back(to_string(parameters.notificatonConfiguration.type));
+    listOutputs.push_back(parameters.notificatonConfiguration.type);
 
     return E_OK;
 }
@@ -450,7 +646,7 @@ am_Error_e CAmPolicyFunctions::_findUserNotificationType(FUNCTION_PARAMS)
 am_Error_e CAmPolicyFunctions::_findNotificationType(FUNCTION_PARAMS)
 {
     (void)function.category;
-    listOutputs.push_back(to_string(parameters.notificatonPayload.type));
+    listOutputs.push_back(parameters.notificatonPayload.type);
 
     return E_OK;
 }
@@ -458,13 +654,13 @@ am_Error_e CAmPolicyFunctions::_findNotificationType(FUNCTION_PARAMS)
 am_Error_e CAmPolicyFunctions::_findUserNotificationValue(FUNCTION_PARAMS)
 {
     (void)function.category;
-    listOutputs.push_back(to_string(parameters.notificatonPayload.value));
+    listOutputs.push_back(parameters.notificatonPayload.value);
 
     return E_OK;
 }
 
 am_Error_e CAmPolicyFunctions::_findMainNTStatusParam(const gc_FunctionElement_s &function,
-    std::vector<std::string > &listOutputs,
+    std::vector<gc_PolicyValue_s > &listOutputs,
     std::string mandatoryParameter, gc_Element_e elementType,
     am_CustomNotificationType_t ntType, const bool isStatusReq)
 {
@@ -487,11 +683,11 @@ am_Error_e CAmPolicyFunctions::_findMainNTStatusParam(const gc_FunctionElement_s
             {
                 if ( true == isStatusReq)
                 {
-                    listOutputs.push_back(to_string((*itListNotificationConfigurations).status));
+                    listOutputs.push_back((*itListNotificationConfigurations).status);
                 }
                 else
                 {
-                    listOutputs.push_back(to_string((*itListNotificationConfigurations).parameter));
+                    listOutputs.push_back((*itListNotificationConfigurations).parameter);
                 }
 
                 result = E_OK;
@@ -534,7 +730,7 @@ am_Error_e CAmPolicyFunctions::_findMainNTParam(FUNCTION_PARAMS)
 }
 
 am_Error_e CAmPolicyFunctions::_findNTStatusParam(const gc_FunctionElement_s &function,
-    std::vector<std::string > &listOutputs,
+    std::vector<gc_PolicyValue_s > &listOutputs,
     std::string mandatoryParameter, gc_Element_e elementType,
     am_CustomNotificationType_t ntType, const bool isStatusReq)
 {
@@ -561,11 +757,11 @@ am_Error_e CAmPolicyFunctions::_findNTStatusParam(const gc_FunctionElement_s &fu
             {
                 if ( true == isStatusReq)
                 {
-                    listOutputs.push_back(to_string((*itListNotificationConfigurations).status));
+                    listOutputs.push_back((*itListNotificationConfigurations).status);
                 }
                 else
                 {
-                    listOutputs.push_back(to_string((*itListNotificationConfigurations).parameter));
+                    listOutputs.push_back((*itListNotificationConfigurations).parameter);
                 }
 
                 result = E_OK;
@@ -588,7 +784,7 @@ am_Error_e CAmPolicyFunctions::_findNTStatus(FUNCTION_PARAMS)
         return _findNTStatusParam(function, listOutputs, parameters.sourceName, ET_SOURCE, parameters.notificatonConfiguration.type, true);
 
     case OT_USER:
-        listOutputs.push_back(to_string(parameters.notificatonConfiguration.status));
+        listOutputs.push_back(parameters.notificatonConfiguration.status);
         return E_OK;
 
     default:
@@ -607,7 +803,7 @@ am_Error_e CAmPolicyFunctions::_findNTParam(FUNCTION_PARAMS)
         return _findNTStatusParam(function, listOutputs, parameters.sourceName, ET_SOURCE, parameters.notificatonConfiguration.type, false);
 
     case OT_USER:
-        listOutputs.push_back(to_string(parameters.notificatonConfiguration.parameter));
+        listOutputs.push_back(parameters.notificatonConfiguration.parameter);
         return E_OK;
 
     default:
@@ -644,7 +840,7 @@ am_Error_e CAmPolicyFunctions::_findDeviceVolume(FUNCTION_PARAMS)
         {
             for (const auto &connection : listConnectionInfo)
             {
-                listOutputs.push_back(to_string(connection.volume));
+                listOutputs.push_back(connection.volume);
             }
 
             return E_OK;
@@ -662,7 +858,7 @@ am_Error_e CAmPolicyFunctions::_findDeviceVolume(FUNCTION_PARAMS)
 am_Error_e CAmPolicyFunctions::_findDeviceVolume(const gc_Element_e elementType,
     const gc_FunctionElement_s &function,
     std::string elementName,
-    std::vector<std::string > &listOutputs)
+    std::vector<gc_PolicyValue_s > &listOutputs)
 {
     am_volume_t deviceVolume;
     am_Error_e  result = E_UNKNOWN;
@@ -671,7 +867,7 @@ am_Error_e CAmPolicyFunctions::_findDeviceVolume(const gc_Element_e elementType,
     if (E_OK == mpPolicyReceive->getVolume(elementType, elementName, deviceVolume))
     {
         // store the volume in std::string format
-        listOutputs.push_back(to_string(deviceVolume));
+        listOutputs.push_back(deviceVolume);
         result = E_OK;
     }
 
@@ -682,7 +878,7 @@ am_Error_e CAmPolicyFunctions::_findDeviceVolume(const gc_Element_e elementType,
 am_Error_e CAmPolicyFunctions::_findMainVolume(const gc_Element_e elementType,
     const gc_FunctionElement_s &function,
     std::string elementName,
-    std::vector<std::string > &listOutputs)
+    std::vector<gc_PolicyValue_s > &listOutputs)
 {
     am_mainVolume_t volume;
     am_Error_e      result = E_UNKNOWN;
@@ -691,7 +887,7 @@ am_Error_e CAmPolicyFunctions::_findMainVolume(const gc_Element_e elementType,
     if (E_OK == mpPolicyReceive->getMainVolume(elementType, elementName, volume))
     {
         // store the volume in std::string format
-        listOutputs.push_back(to_string(volume));
+        listOutputs.push_back(volume);
         result = E_OK;
     }
 
@@ -731,7 +927,7 @@ am_Error_e CAmPolicyFunctions::_findDevicePropertyValue(FUNCTION_PARAMS)
     if (E_OK == mpPolicyReceive->getSoundProperty(elementType, elementName, property, value))
     {
         // store the value in std::string format
-        listOutputs.push_back(to_string(value));
+        listOutputs.push_back(value);
         return E_OK;
     }
 
@@ -756,7 +952,7 @@ am_Error_e CAmPolicyFunctions::_findMainSoundPropertyValue(FUNCTION_PARAMS)
         break;
 
     case OT_USER:
-        listOutputs.push_back(to_string(parameters.mainSoundProperty.value));
+        listOutputs.push_back(parameters.mainSoundProperty.value);
         return E_OK;
 
     default:
@@ -775,7 +971,7 @@ am_Error_e CAmPolicyFunctions::_findMainSoundPropertyValue(FUNCTION_PARAMS)
     if (E_OK == mpPolicyReceive->getMainSoundProperty(elementType, elementName, property, value))
     {
         // store the value in std::string format
-        listOutputs.push_back(to_string(value));
+        listOutputs.push_back(value);
         return E_OK;
     }
 
@@ -889,7 +1085,7 @@ am_Error_e CAmPolicyFunctions::_findName(FUNCTION_PARAMS)
 }
 
 am_Error_e CAmPolicyFunctions::_findName(const gc_FunctionElement_s &function,
-    std::vector<std::string > &listOutputs, const std::string &name)
+    std::vector<gc_PolicyValue_s > &listOutputs, const std::string &name)
 {
     am_Error_e  result = E_UNKNOWN;
     bool        isValueMacro;
@@ -1002,7 +1198,7 @@ am_Error_e CAmPolicyFunctions::_findSubItems(FUNCTION_PARAMS)
 template <typename Telement>
 am_Error_e CAmPolicyFunctions::_findDomainOrClassOfElementName(
     Telement &elementInstance, const gc_FunctionElement_s &function,
-    std::vector<std::string > &listOutputs, std::string mandatoryParameter,
+    std::vector<gc_PolicyValue_s > &listOutputs, std::string mandatoryParameter,
     const bool isClassRequired)
 {
     am_Error_e result = E_UNKNOWN;
@@ -1106,7 +1302,7 @@ am_Error_e CAmPolicyFunctions::_findScale(FUNCTION_PARAMS)
     }
 
     int nearestInt = (rhs >= 0) ? (int)(rhs + 0.5) : (int)(rhs - 0.5);
-    listOutputs.push_back(to_string(nearestInt));
+    listOutputs.push_back(nearestInt);
 
     return retVal;
 }
@@ -1134,7 +1330,7 @@ am_Error_e CAmPolicyFunctions::_findCount(FUNCTION_PARAMS)
         }
     }
 
-    listOutputs.push_back(to_string(wordCount));
+    listOutputs.push_back(wordCount);
 
     return E_OK;
 }
@@ -1142,13 +1338,13 @@ am_Error_e CAmPolicyFunctions::_findCount(FUNCTION_PARAMS)
 // get the priority of sink by sink name
 template <typename Telement>
 am_Error_e CAmPolicyFunctions::_findPriority(const gc_FunctionElement_s &function,
-    std::string mandatoryParameter, std::vector<std::string > &listOutputs)
+    std::string mandatoryParameter, std::vector<gc_PolicyValue_s > &listOutputs)
 {
     Telement elementInstance;
     _getValueOfParameter(function, mandatoryParameter);
     if (E_OK == CAmConfigurationReader::instance().getElementByName(mandatoryParameter, elementInstance))
     {
-        listOutputs.push_back(to_string(elementInstance.priority));
+        listOutputs.push_back(elementInstance.priority);
         return E_OK;
     }
 
@@ -1188,7 +1384,7 @@ am_Error_e CAmPolicyFunctions::_findPriority(FUNCTION_PARAMS)
 
         for (const auto &connection : listConnectionInfo)
         {
-            listOutputs.push_back(to_string(connection.priority));
+            listOutputs.push_back(connection.priority);
         }
 
         return E_OK;
@@ -1205,7 +1401,7 @@ am_Error_e CAmPolicyFunctions::_findPriority(FUNCTION_PARAMS)
         {
             for (const auto &connection : listConnectionInfo)
             {
-                listOutputs.push_back(to_string(connection.priority));
+                listOutputs.push_back(connection.priority);
             }
 
             return E_OK;
@@ -1236,7 +1432,7 @@ am_Error_e CAmPolicyFunctions::_findConnectionState(FUNCTION_PARAMS)
         {
             for (const auto &connection : listConnectionInfo)
             {
-                listOutputs.push_back(to_string(connection.connectionState));
+                listOutputs.push_back(connection.connectionState);
             }
 
             return E_OK;
@@ -1267,7 +1463,7 @@ am_Error_e CAmPolicyFunctions::_findConnectionState(FUNCTION_PARAMS)
 // }
 
     case OT_USER:
-        listOutputs.push_back(to_string(parameters.connectionState));
+        listOutputs.push_back(parameters.connectionState);
         return E_OK;
 
     default:
@@ -1277,7 +1473,7 @@ am_Error_e CAmPolicyFunctions::_findConnectionState(FUNCTION_PARAMS)
 
 am_Error_e CAmPolicyFunctions::_findConnectionState(
     const gc_FunctionElement_s &function,
-    std::vector<std::string > &listOutputs, std::string mandatoryParameter,
+    std::vector<gc_PolicyValue_s > &listOutputs, std::string mandatoryParameter,
     const gc_Element_e elementType)
 {
     _getValueOfParameter(function, mandatoryParameter);
@@ -1310,7 +1506,7 @@ am_Error_e CAmPolicyFunctions::_findConnectionState(
     {
         if (select(current))
         {
-            listOutputs.push_back(to_string(current.connectionState));
+            listOutputs.push_back(current.connectionState);
 
             LOG_FN_INFO(__FILENAME__, __func__, "adding", current.connectionState, "from", current.connectionName);
         }
@@ -1331,7 +1527,7 @@ am_Error_e CAmPolicyFunctions::_findMainVolume(FUNCTION_PARAMS)
         return _findMainVolume(ET_SOURCE, function, parameters.sourceName, listOutputs);
 
     case OT_USER:
-        listOutputs.push_back(to_string(parameters.mainVolume));
+        listOutputs.push_back(parameters.mainVolume);
         return E_OK;
 
     default:
@@ -1342,7 +1538,7 @@ am_Error_e CAmPolicyFunctions::_findMainVolume(FUNCTION_PARAMS)
 am_Error_e CAmPolicyFunctions::_findIsMainVolumeStep(FUNCTION_PARAMS)
 {
     (void)function.category;
-    listOutputs.push_back(to_string(parameters.isVolumeStep));
+    listOutputs.push_back(parameters.isVolumeStep);
 
     return E_OK;
 }
@@ -1357,7 +1553,7 @@ am_Error_e CAmPolicyFunctions::_findLimit(FUNCTION_PARAMS)
         const auto &src = CAmSourceFactory::getElement(function.mandatoryParameter);
         if (src != nullptr)
         {
-            listOutputs.push_back(to_string(src->getOffsetVolume()));
+            listOutputs.push_back(src->getOffsetVolume());
             return E_OK;
         }
 
@@ -1369,7 +1565,7 @@ am_Error_e CAmPolicyFunctions::_findLimit(FUNCTION_PARAMS)
         const auto &snk = CAmSinkFactory::getElement(function.mandatoryParameter);
         if (snk != nullptr)
         {
-            listOutputs.push_back(to_string(snk->getOffsetVolume()));
+            listOutputs.push_back(snk->getOffsetVolume());
             return E_OK;
         }
 
@@ -1381,7 +1577,7 @@ am_Error_e CAmPolicyFunctions::_findLimit(FUNCTION_PARAMS)
         const auto &conn = CAmMainConnectionFactory::getElement(function.mandatoryParameter);
         if (conn != nullptr)
         {
-            listOutputs.push_back(to_string(conn->getOffsetVolume()));
+            listOutputs.push_back(conn->getOffsetVolume());
             return E_OK;
         }
 
@@ -1396,7 +1592,7 @@ am_Error_e CAmPolicyFunctions::_findLimit(FUNCTION_PARAMS)
 am_Error_e CAmPolicyFunctions::_findUserErrorValue(FUNCTION_PARAMS)
 {
     (void)function.category;
-    listOutputs.push_back(to_string(parameters.status));
+    listOutputs.push_back(parameters.status);
 
     return E_OK;
 }
@@ -1404,7 +1600,7 @@ am_Error_e CAmPolicyFunctions::_findUserErrorValue(FUNCTION_PARAMS)
 // find the trigger user property type
 am_Error_e CAmPolicyFunctions::_findMainSoundPropertyType(FUNCTION_PARAMS)
 {
-    listOutputs.push_back(to_string(parameters.mainSoundProperty.type));
+    listOutputs.push_back(parameters.mainSoundProperty.type);
 
     return E_OK;
 }
@@ -1413,7 +1609,7 @@ am_Error_e CAmPolicyFunctions::_findMainSoundPropertyType(FUNCTION_PARAMS)
 am_Error_e CAmPolicyFunctions::_findSystemPropertyType(FUNCTION_PARAMS)
 {
     (void)function.category;
-    listOutputs.push_back(to_string(parameters.systemProperty.type));
+    listOutputs.push_back(parameters.systemProperty.type);
 
     return E_OK;
 }
@@ -1440,7 +1636,7 @@ am_Error_e CAmPolicyFunctions::_findSystemPropertyValue(FUNCTION_PARAMS)
         int16_t value;
         if (E_OK == mpPolicyReceive->getSystemProperty(property, value))
         {
-            listOutputs.push_back(to_string(value));
+            listOutputs.push_back(value);
             result = E_OK;
         }
 
@@ -1448,7 +1644,7 @@ am_Error_e CAmPolicyFunctions::_findSystemPropertyValue(FUNCTION_PARAMS)
     }
 
     case OT_USER:
-        listOutputs.push_back(to_string(parameters.systemProperty.value));
+        listOutputs.push_back(parameters.systemProperty.value);
         return E_OK;
 
     default:
@@ -1478,7 +1674,7 @@ am_Error_e CAmPolicyFunctions::_findMuteState(FUNCTION_PARAMS)
         break;
 
     case OT_USER:
-        listOutputs.push_back(to_string(parameters.muteState));
+        listOutputs.push_back(parameters.muteState);
         return E_OK;
 
     default:
@@ -1490,7 +1686,7 @@ am_Error_e CAmPolicyFunctions::_findMuteState(FUNCTION_PARAMS)
 
     if (E_OK == mpPolicyReceive->getMuteState(elementType, elementName, muteState))
     {
-        listOutputs.push_back(to_string(muteState));
+        listOutputs.push_back(muteState);
         return E_OK;
     }
 
@@ -1505,7 +1701,7 @@ am_Error_e CAmPolicyFunctions::_findAvailability(FUNCTION_PARAMS)
         const auto pConnection = CAmMainConnectionFactory::getElement(function.mandatoryParameter);
         if (pConnection)
         {
-            listOutputs.push_back(to_string(pConnection->getRouteAvailability()));
+            listOutputs.push_back(pConnection->getRouteAvailability());
             return E_OK;
         }
 
@@ -1517,7 +1713,7 @@ am_Error_e CAmPolicyFunctions::_findAvailability(FUNCTION_PARAMS)
     am_Error_e        retVal = _findAvailability(function, parameters, availability);
     if (retVal == E_OK)
     {
-        listOutputs.push_back(to_string(availability.availability));
+        listOutputs.push_back(availability.availability);
     }
 
     return retVal;
@@ -1529,7 +1725,7 @@ am_Error_e CAmPolicyFunctions::_findAvailabilityReason(FUNCTION_PARAMS)
     am_Error_e        retVal = _findAvailability(function, parameters, availability);
     if (retVal == E_OK)
     {
-        listOutputs.push_back(to_string(availability.availabilityReason));
+        listOutputs.push_back(availability.availabilityReason);
     }
 
     return retVal;
@@ -1574,7 +1770,7 @@ am_Error_e CAmPolicyFunctions::_findConnectionFormat(FUNCTION_PARAMS)
     {
     case OT_CONNECTION:
     case OT_CLASS:
-        listOutputs.push_back(to_string(CF_GENIVI_STEREO));
+        listOutputs.push_back(CF_GENIVI_STEREO);
         return E_OK;
 
     default:
@@ -1599,7 +1795,7 @@ am_Error_e CAmPolicyFunctions::_findInterruptState(FUNCTION_PARAMS)
         break;
 
     case OT_USER:
-        listOutputs.push_back(to_string(parameters.interruptState));
+        listOutputs.push_back(parameters.interruptState);
         return E_OK;
 
     default:
@@ -1610,7 +1806,7 @@ am_Error_e CAmPolicyFunctions::_findInterruptState(FUNCTION_PARAMS)
     _getValueOfParameter(function, elementName);
     if (E_OK == mpPolicyReceive->getInterruptState(elementType, elementName, interruptState))
     {
-        listOutputs.push_back(to_string(interruptState));
+        listOutputs.push_back(interruptState);
         return E_OK;
     }
 
@@ -1666,7 +1862,7 @@ am_Error_e CAmPolicyFunctions::_findIsRegistered(FUNCTION_PARAMS)
             }
         }
 
-        listOutputs.push_back(to_string(result));
+        listOutputs.push_back(result);
         return returnValue;
     }
 
@@ -1677,7 +1873,7 @@ am_Error_e CAmPolicyFunctions::_findIsRegistered(FUNCTION_PARAMS)
     // get registration status
     _getValueOfParameter(function, elementName);
     bool result = mpPolicyReceive->isRegistered(elementType, elementName);
-    listOutputs.push_back(to_string(result));
+    listOutputs.push_back(result);
 
     return E_OK;
 }
@@ -1721,7 +1917,7 @@ am_Error_e CAmPolicyFunctions::_findIsDomainRegistrationComplete(FUNCTION_PARAMS
         }
     }
 
-    listOutputs.push_back(to_string(result));
+    listOutputs.push_back(result);
     return returnValue;
 }
 
@@ -1739,7 +1935,7 @@ am_Error_e CAmPolicyFunctions::_findState(FUNCTION_PARAMS)
         if (pSource != nullptr)
         {
             am_SourceState_e sourceState = pSource->getState();
-            listOutputs.push_back(to_string(sourceState));
+            listOutputs.push_back(sourceState);
             return E_OK;
         }
 
@@ -1783,7 +1979,7 @@ am_Error_e CAmPolicyFunctions::_findState(FUNCTION_PARAMS)
                 break;
             }
 
-            listOutputs.push_back(to_string(static_cast<am_DomainState_e>(domainState)));
+            listOutputs.push_back(static_cast<am_DomainState_e>(domainState));
         }
 
         return result;
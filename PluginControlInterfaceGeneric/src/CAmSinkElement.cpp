@@ -432,6 +432,18 @@ am_mainVolume_t CAmSinkElement::getMainVolume() const
     return mSink.mainVolume;
 }
 
+bool CAmSinkElement::getMainVolumeRange(am_mainVolume_t &minVolume, am_mainVolume_t &maxVolume) const
+{
+    if (mSink.mapUserVolumeToNormalizedVolume.empty())
+    {
+        return false;
+    }
+
+    minVolume = (am_mainVolume_t)lroundf(mSink.mapUserVolumeToNormalizedVolume.begin()->first);
+    maxVolume = (am_mainVolume_t)lroundf(mSink.mapUserVolumeToNormalizedVolume.rbegin()->first);
+    return true;
+}
+
 am_volume_t CAmSinkElement::convertMainVolumeToVolume(const am_mainVolume_t mainVolume)
 {
     if (mSink.mapUserVolumeToNormalizedVolume.empty() || mSink.mapNormalizedVolumeToDecibelVolume.empty())
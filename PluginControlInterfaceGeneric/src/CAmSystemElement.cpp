@@ -20,6 +20,8 @@
 
 #include "CAmSystemElement.h"
 #include "CAmLogger.h"
+#include "CAmTriggerQueue.h"
+#include "CAmClassElement.h"
 
 namespace am {
 namespace gc {
@@ -47,6 +49,13 @@ CAmSystemElement::CAmSystemElement(const gc_System_s &systemData, IAmControlRece
         mListSystemProperties.push_back(systemProperty);
     }
 
+    systemProperty.type  = SYP_GLOBAL_TRIGGER_COALESCING;
+    systemProperty.value = 1;
+    if (E_OK != _findSystemProperty(mListSystemProperties, SYP_GLOBAL_TRIGGER_COALESCING, value))
+    {
+        mListSystemProperties.push_back(systemProperty);
+    }
+
     systemProperty.type  = SYP_REGISTRATION_ALLOW_UNKNOWN_ELEMENT;
     systemProperty.value = 0;
     if (E_OK != _findSystemProperty(mListSystemProperties, SYP_REGISTRATION_ALLOW_UNKNOWN_ELEMENT, value))
@@ -62,6 +71,13 @@ CAmSystemElement::CAmSystemElement(const gc_System_s &systemData, IAmControlRece
 
     }
 
+    systemProperty.type  = SYP_VOLUME_BATCHED_REQUESTS;
+    systemProperty.value = 0;
+    if (E_OK != _findSystemProperty(mListSystemProperties, SYP_VOLUME_BATCHED_REQUESTS, value))
+    {
+        mListSystemProperties.push_back(systemProperty);
+    }
+
     systemProperty.type  = SYP_REGISTRATION_DOMAIN_TIMEOUT;
     systemProperty.value = 10000;
     if (E_OK != _findSystemProperty(mListSystemProperties, SYP_REGISTRATION_DOMAIN_TIMEOUT, value))
@@ -110,6 +126,10 @@ am_Error_e CAmSystemElement::_register(void)
     }
 
     LOG_FN_CHANGE_LEVEL(static_cast<am_LogLevel_e>(logThresoldLevel));
+
+    int16_t coalescing = 1;
+    _findSystemProperty(mListSystemProperties, SYP_GLOBAL_TRIGGER_COALESCING, coalescing);
+    CAmTriggerQueue::getInstance()->setCoalescing(coalescing != 0);
     return E_OK;
 }
 
@@ -143,6 +163,14 @@ am_Error_e CAmSystemElement::setSystemProperties(const std::vector<am_SystemProp
         {
             LOG_FN_CHANGE_LEVEL(static_cast<am_LogLevel_e >(itListSystemProperties.value));
         }
+        else if (SYP_GLOBAL_TRIGGER_COALESCING == itListSystemProperties.type)
+        {
+            CAmTriggerQueue::getInstance()->setCoalescing(itListSystemProperties.value != 0);
+        }
+        else if (SYP_CONNECTION_ALLOW_ONLY_TOPOLOGY_ROUTES == itListSystemProperties.type)
+        {
+            CAmClassElement::invalidateRouteCache();
+        }
 
         if (E_OK == result)
         {
@@ -171,6 +199,14 @@ am_Error_e CAmSystemElement::setSystemProperty(const am_CustomSystemPropertyType
     {
         LOG_FN_CHANGE_LEVEL(static_cast<am_LogLevel_e >(systemProperty.value));
     }
+    else if (SYP_GLOBAL_TRIGGER_COALESCING == systemProperty.type)
+    {
+        CAmTriggerQueue::getInstance()->setCoalescing(systemProperty.value != 0);
+    }
+    else if (SYP_CONNECTION_ALLOW_ONLY_TOPOLOGY_ROUTES == systemProperty.type)
+    {
+        CAmClassElement::invalidateRouteCache();
+    }
 
     if (E_OK == result)
     {
@@ -240,6 +276,13 @@ bool CAmSystemElement::isNonTopologyRouteAllowed(void) const
     return ((value == 0) ? true : false);
 }
 
+bool CAmSystemElement::isVolumeBatchingEnabled(void) const
+{
+    int16_t value = 0;
+    getSystemProperty(SYP_VOLUME_BATCHED_REQUESTS, value);
+    return ((value == 0) ? false : true);
+}
+
 std::string CAmSystemElement::getLastSystemPropertiesString()
 {
     std::string systemPropertiesString;
@@ -18,7 +18,11 @@
  *
  *****************************************************************************/
 
+#include <limits>
+#include <algorithm>
 #include "CAmTriggerQueue.h"
+#include "CAmLogger.h"
+#include "CAmSinkElement.h"
 
 namespace am {
 
@@ -26,64 +30,288 @@ namespace gc {
 
 CAmTriggerQueue *CAmTriggerQueue::mpTriggerQueue = NULL;
 CAmTriggerQueue::CAmTriggerQueue()
-    : mlistTrigger()
-    , mlistPriority()
+    : mCoalescingEnabled(true)
 {
+    for (auto pRing : { &mlistTrigger, &mlistPriority })
+    {
+        pRing->slots.resize(GC_TRIGGER_QUEUE_CAPACITY);
+        pRing->head  = 0;
+        pRing->count = 0;
+    }
+
+    resetMergeCounters();
 }
 
-am_Error_e CAmTriggerQueue::queue(gc_Trigger_e triggerType, gc_TriggerElement_s *triggerData)
+template <typename Ttrigger, typename Tpredicate>
+Ttrigger *CAmTriggerQueue::_findPending(gc_TriggerRing_s &ring, gc_Trigger_e triggerType,
+    Tpredicate isSameTarget)
 {
-    mlistTrigger.push_back(std::make_pair(triggerType, triggerData));
-    return E_OK;
+    for (size_t index = ring.count; index > 0; --index)
+    {
+        gc_TriggerRecord_s &slot = ring.slots[(ring.head + index - 1) % ring.slots.size()];
+        if (slot.triggerType != triggerType)
+        {
+            // do not reorder triggers of different type
+            break;
+        }
+
+        Ttrigger *pPending = slot.triggerData.getIf<Ttrigger >();
+        if ((NULL != pPending) && isSameTarget(*pPending))
+        {
+            return pPending;
+        }
+    }
+
+    return NULL;
 }
 
-am_Error_e CAmTriggerQueue::queueWithPriority(gc_Trigger_e triggerType, gc_TriggerElement_s *triggerData)
+bool CAmTriggerQueue::_coalesce(gc_TriggerRing_s &ring, gc_Trigger_e triggerType,
+    const gc_SinkVolumeChangeTrigger_s &trigger)
 {
-    mlistPriority.push_back(std::make_pair(triggerType, triggerData));
-    return E_OK;
+    gc_SinkVolumeChangeTrigger_s *pPending = _findPending<gc_SinkVolumeChangeTrigger_s >(ring, triggerType,
+            [&trigger](const gc_SinkVolumeChangeTrigger_s &pending) {
+            return pending.sinkName == trigger.sinkName;
+        });
+    if (NULL == pPending)
+    {
+        return false;
+    }
+
+    if (false == trigger.isStep)
+    {
+        pPending->volume = trigger.volume;
+        pPending->isStep = false;
+        return true;
+    }
+
+    if (pPending->isStep && ((pPending->volume < 0) != (trigger.volume < 0)))
+    {
+        // each step saturates at the range limits, only steps of the same direction add up
+        return false;
+    }
+
+    // accumulate step on top of pending absolute volume or pending step
+    pPending->volume = _clampMainVolume(pPending->sinkName,
+            static_cast<int32_t>(pPending->volume) + trigger.volume, pPending->isStep);
+    return true;
 }
 
-gc_TriggerElement_s *CAmTriggerQueue::dequeue(gc_Trigger_e &triggerType)
+am_mainVolume_t CAmTriggerQueue::_clampMainVolume(const std::string &sinkName, int32_t volume, bool isStep)
 {
-    gc_TriggerElement_s                           *pTriggerElement = NULL;
-    std::pair<gc_Trigger_e, gc_TriggerElement_s *> triggerpair;
+    int32_t minVolume = std::numeric_limits<am_mainVolume_t>::min();
+    int32_t maxVolume = std::numeric_limits<am_mainVolume_t>::max();
 
-    if (!mlistPriority.empty())  // check priority queue first
+    am_mainVolume_t minMainVolume;
+    am_mainVolume_t maxMainVolume;
+    std::shared_ptr<CAmSinkElement > pSink = CAmSinkFactory::getElement(sinkName);
+    if ((nullptr != pSink) && pSink->getMainVolumeRange(minMainVolume, maxMainVolume))
     {
-        triggerpair     = mlistPriority.front();
-        pTriggerElement = triggerpair.second;
-        triggerType     = triggerpair.first;
-        mlistPriority.pop_front();
+        if (isStep)
+        {
+            // a step larger than the range has no further effect
+            maxVolume = static_cast<int32_t>(maxMainVolume) - minMainVolume;
+            minVolume = -maxVolume;
+        }
+        else
+        {
+            minVolume = minMainVolume;
+            maxVolume = maxMainVolume;
+        }
     }
-    else if (!mlistTrigger.empty())
+
+    return static_cast<am_mainVolume_t>(std::min(std::max(volume, minVolume), maxVolume));
+}
+
+bool CAmTriggerQueue::_coalesce(gc_TriggerRing_s &ring, gc_Trigger_e triggerType,
+    const gc_SinkMuteTrigger_s &trigger)
+{
+    gc_SinkMuteTrigger_s *pPending = _findPending<gc_SinkMuteTrigger_s >(ring, triggerType,
+            [&trigger](const gc_SinkMuteTrigger_s &pending) {
+            return pending.sinkName == trigger.sinkName;
+        });
+    if (NULL == pPending)
     {
-        triggerpair     = mlistTrigger.front();
-        pTriggerElement = triggerpair.second;
-        triggerType     = triggerpair.first;
-        mlistTrigger.pop_front();
+        return false;
     }
 
-    return pTriggerElement;
+    pPending->muteState = trigger.muteState;
+    return true;
 }
 
-void CAmTriggerQueue::getSnapShot(std::vector<std::pair<gc_Trigger_e, const gc_TriggerElement_s *> > &queueSnapShot)
+bool CAmTriggerQueue::_coalesce(gc_TriggerRing_s &ring, gc_Trigger_e triggerType,
+    const gc_SinkSoundPropertyTrigger_s &trigger)
 {
-    queueSnapShot.clear();
-    queueSnapShot.reserve(mlistPriority.size() + mlistTrigger.size());
-    for (const auto &trigger : mlistPriority)
+    gc_SinkSoundPropertyTrigger_s *pPending = _findPending<gc_SinkSoundPropertyTrigger_s >(ring, triggerType,
+            [&trigger](const gc_SinkSoundPropertyTrigger_s &pending) {
+            return (pending.sinkName == trigger.sinkName)
+            && (pending.mainSoundProperty.type == trigger.mainSoundProperty.type);
+        });
+    if (NULL == pPending)
     {
-        // give away trigger data pointer, but prohibit modification outside of this class
-        queueSnapShot.push_back(std::pair<gc_Trigger_e, const gc_TriggerElement_s *>(trigger.first,
-                const_cast<const gc_TriggerElement_s *>(trigger.second)));
+        return false;
+    }
+
+    pPending->mainSoundProperty.value = trigger.mainSoundProperty.value;
+    return true;
+}
+
+bool CAmTriggerQueue::_coalesce(gc_TriggerRing_s &ring, gc_Trigger_e triggerType,
+    const gc_SourceSoundPropertyTrigger_s &trigger)
+{
+    gc_SourceSoundPropertyTrigger_s *pPending = _findPending<gc_SourceSoundPropertyTrigger_s >(ring, triggerType,
+            [&trigger](const gc_SourceSoundPropertyTrigger_s &pending) {
+            return (pending.sourceName == trigger.sourceName)
+            && (pending.mainSoundProperty.type == trigger.mainSoundProperty.type);
+        });
+    if (NULL == pPending)
+    {
+        return false;
+    }
+
+    pPending->mainSoundProperty.value = trigger.mainSoundProperty.value;
+    return true;
+}
+
+bool CAmTriggerQueue::_coalesce(gc_TriggerRing_s &ring, gc_Trigger_e triggerType,
+    const gc_SystemPropertyTrigger_s &trigger)
+{
+    gc_SystemPropertyTrigger_s *pPending = _findPending<gc_SystemPropertyTrigger_s >(ring, triggerType,
+            [&trigger](const gc_SystemPropertyTrigger_s &pending) {
+            return pending.systemProperty.type == trigger.systemProperty.type;
+        });
+    if (NULL == pPending)
+    {
+        return false;
+    }
+
+    pPending->systemProperty.value = trigger.systemProperty.value;
+    return true;
+}
+
+bool CAmTriggerQueue::_coalesce(gc_TriggerRing_s &ring, gc_Trigger_e triggerType,
+    const gc_NotificationDataTrigger_s &trigger)
+{
+    gc_NotificationDataTrigger_s *pPending = _findPending<gc_NotificationDataTrigger_s >(ring, triggerType,
+            [&trigger](const gc_NotificationDataTrigger_s &pending) {
+            return (pending.name == trigger.name)
+            && (pending.notificatonPayload.type == trigger.notificatonPayload.type);
+        });
+    if (NULL == pPending)
+    {
+        return false;
+    }
+
+    pPending->notificatonPayload.value = trigger.notificatonPayload.value;
+    return true;
+}
+
+void CAmTriggerQueue::setCoalescing(bool enabled)
+{
+    LOG_FN_INFO(__FILENAME__, __func__, "trigger coalescing", (enabled ? "enabled" : "disabled"));
+    mCoalescingEnabled = enabled;
+}
+
+bool CAmTriggerQueue::isCoalescingEnabled(void) const
+{
+    return mCoalescingEnabled;
+}
+
+uint32_t CAmTriggerQueue::getMergeCount(gc_Trigger_e triggerType) const
+{
+    return (triggerType < TRIGGER_MAX) ? mListMergeCount[triggerType] : 0;
+}
+
+uint32_t CAmTriggerQueue::getMergeCount(void) const
+{
+    uint32_t total = 0;
+    for (auto count : mListMergeCount)
+    {
+        total += count;
+    }
+
+    return total;
+}
+
+void CAmTriggerQueue::resetMergeCounters(void)
+{
+    for (auto &count : mListMergeCount)
+    {
+        count = 0;
+    }
+}
+
+gc_TriggerRecord_s &CAmTriggerQueue::_appendSlot(gc_TriggerRing_s &ring)
+{
+    if (ring.count == ring.slots.size())
+    {
+        // all slots occupied - double the capacity and unwrap the content
+        std::vector<gc_TriggerRecord_s > enlarged(2 * ring.slots.size());
+        for (size_t index = 0; index < ring.count; ++index)
+        {
+            gc_TriggerRecord_s &source = ring.slots[(ring.head + index) % ring.slots.size()];
+            enlarged[index].triggerType = source.triggerType;
+            enlarged[index].triggerData = std::move(source.triggerData);
+        }
+
+        ring.slots.swap(enlarged);
+        ring.head = 0;
+        LOG_FN_INFO(__FILENAME__, __func__, "trigger queue enlarged to", ring.slots.size(), "slots");
     }
-    for (const auto &trigger : mlistTrigger)
+
+    gc_TriggerRecord_s &slot = ring.slots[(ring.head + ring.count) % ring.slots.size()];
+    ring.count++;
+
+    return slot;
+}
+
+void CAmTriggerQueue::_takeFront(gc_TriggerRing_s &ring, gc_Trigger_e &triggerType,
+    gc_TriggerData_t &triggerData)
+{
+    gc_TriggerRecord_s &slot = ring.slots[ring.head];
+    triggerType = slot.triggerType;
+    triggerData = std::move(slot.triggerData);
+    ring.head   = (ring.head + 1) % ring.slots.size();
+    ring.count--;
+}
+
+am_Error_e CAmTriggerQueue::dequeue(gc_Trigger_e &triggerType, gc_TriggerData_t &triggerData)
+{
+    if (mlistPriority.count > 0)  // check priority queue first
+    {
+        _takeFront(mlistPriority, triggerType, triggerData);
+    }
+    else if (mlistTrigger.count > 0)
+    {
+        _takeFront(mlistTrigger, triggerType, triggerData);
+    }
+    else
+    {
+        triggerData.reset();
+        return E_NON_EXISTENT;
+    }
+
+    return E_OK;
+}
+
+void CAmTriggerQueue::_getSnapShot(const gc_TriggerRing_s &ring,
+    std::vector<std::pair<gc_Trigger_e, const gc_TriggerData_t *> > &queueSnapShot) const
+{
+    for (size_t index = 0; index < ring.count; ++index)
     {
         // give away trigger data pointer, but prohibit modification outside of this class
-        queueSnapShot.push_back(std::pair<gc_Trigger_e, const gc_TriggerElement_s *>(trigger.first,
-                const_cast<const gc_TriggerElement_s *>(trigger.second)));
+        const gc_TriggerRecord_s &slot = ring.slots[(ring.head + index) % ring.slots.size()];
+        queueSnapShot.push_back(std::make_pair(slot.triggerType, &slot.triggerData));
     }
 }
 
+void CAmTriggerQueue::getSnapShot(std::vector<std::pair<gc_Trigger_e, const gc_TriggerData_t *> > &queueSnapShot) const
+{
+    queueSnapShot.clear();
+    queueSnapShot.reserve(mlistPriority.count + mlistTrigger.count);
+    _getSnapShot(mlistPriority, queueSnapShot);
+    _getSnapShot(mlistTrigger, queueSnapShot);
+}
+
 CAmTriggerQueue *CAmTriggerQueue::getInstance()
 {
     if (mpTriggerQueue == NULL)
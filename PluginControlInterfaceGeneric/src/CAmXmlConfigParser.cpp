@@ -1755,9 +1755,11 @@ public:
         , mNotificationConfigurationAttribute(ACTION_PARAM_NOTIFICATION_CONFIGURATION_PARAM, mNotificationParam)
         , mListMainSoundPropertiesAttribute(ACTION_PARAM_LIST_PROPERTY, mListMainSoundProperties)
         , mListSystemPropertiesAttribute(ACTION_PARAM_LIST_SYSTEM_PROPERTIES, mListSystemProperties)
+        , mParallelAttribute(ACTION_PARAM_PARALLEL, mParallel)
     {
         mAction.actionType  = ACTION_UNKNOWN;
         mAction.mapParameters.clear();
+        mAction.listDynamicParameters.clear();
         mRampType           = -1;
         mMuteState          = -1;
         mOrder              = -1;
@@ -1765,6 +1767,7 @@ public:
         mDebugType          = -1;
         mNotificationType   = -1;
         mNotificationStatus = -1;
+        mParallel           = false;
     }
 
     void push_back(std::vector<gc_Action_s > &listAction, gc_Action_s &action)
@@ -1781,7 +1784,8 @@ public:
                                                           &mPropertyValueAtrribute, &mTimeoutAttribute, &mPatternAttribute, &mConnectionStateAttribute,
                                                           &mDebugTypeAttribute, &mDebugValueAttribute, &mConnectionFormatAttribute, &mExceptSourceAttribute,
                                                           &mExceptSinkAttribute, &mExceptClassAttribute, &mNotificationTypeAttribute, &mNotificationStatusAttributes,
-                                                          &mNotificationConfigurationAttribute, &mListMainSoundPropertiesAttribute, &mListSystemPropertiesAttribute });
+                                                          &mNotificationConfigurationAttribute, &mListMainSoundPropertiesAttribute, &mListSystemPropertiesAttribute,
+                                                          &mParallelAttribute });
     }
 
 protected:
@@ -1852,6 +1856,21 @@ protected:
         copyStringInMap(ACTION_PARAM_NOTIFICATION_CONFIGURATION_PARAM, mNotificationParam);
         copyStringInMap(ACTION_PARAM_LIST_PROPERTY, mListMainSoundProperties);
         copyStringInMap(ACTION_PARAM_LIST_SYSTEM_PROPERTIES, mListSystemProperties);
+        if (mParallel)
+        {
+            copyStringInMap(ACTION_PARAM_PARALLEL, to_string(mParallel));
+        }
+
+        // memorize parameters which need conversion in CAmPolicyEngine::_convertActionParamsToValues()
+        mAction.listDynamicParameters.clear();
+        for (const auto &parameter : mAction.mapParameters)
+        {
+            if (_isDynamicParameter(parameter.first, parameter.second))
+            {
+                mAction.listDynamicParameters.push_back(parameter.first);
+            }
+        }
+
         return E_OK;
     }
 
@@ -1864,6 +1883,17 @@ private:
         }
     }
 
+    static bool _isDynamicParameter(const std::string &keyName, const std::string &value)
+    {
+        return (keyName == ACTION_PARAM_EXCEPT_SOURCE_NAME)
+               || (keyName == ACTION_PARAM_EXCEPT_SINK_NAME)
+               || (keyName == ACTION_PARAM_EXCEPT_CLASS_NAME)
+               || (value.find("REQ_") == 0)                     // macro
+               || (value.find('(') != std::string::npos)        // function
+               || (value[0] == '"')                             // quoted string
+               || (value == FUNCTION_MACRO_SUPPORTED_REQUESTING);
+    }
+
 private:
     gc_Action_s                 &mAction;
     std::string                  mClassName;
@@ -1896,6 +1926,7 @@ private:
     int                          mPropertyType;
     int                          mNotificationType;
     int                          mNotificationStatus;
+    bool                         mParallel;
 
     CAmEnumerationAttribute<gc_Action_e> mActionNameAttribute;
     CAmNameAttribute             mClassNameAttribute;
@@ -1927,6 +1958,7 @@ private:
     CAmStringAttribute           mNotificationConfigurationAttribute;
     CAmStringAttribute           mListMainSoundPropertiesAttribute;
     CAmStringAttribute           mListSystemPropertiesAttribute;
+    CAmBoolAttribute             mParallelAttribute;
 };
 
 class CAmProcessNode : public CAmConfigComplexNode
@@ -43,7 +43,13 @@
 #include "CAmSystemElement.h"
 #include "CAmRootAction.h"
 #include "CAmActionCommand.h"
-//#include "CAmActionContainer.h"
+#include "CAmConfigurationReader.h"
+#include "CAmPersistenceDefault.h"
+#include "CAmPolicyEngine.h"
+#include "CAmPolicyFunctions.h"
+#include "CAmPolicyReceive.h"
+#include "CAmActionContainer.h"
+#include "CAmActionSetVolumeCore.h"
 #include "MockIAmControlReceive.h"
 #include "MockIAmPolicySend.h"
 #include "CGmockCommonFunctions.h"
@@ -53,12 +59,58 @@
 #include "CAmTestConfigurations.h"
 
 #include <signal.h>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <limits>
+#include <fstream>
+#include <sys/stat.h>
 
 using namespace std;
 using namespace testing;
 using namespace am;
 using namespace gc;
 
+/*
+ * Global allocation counter used to measure the heap traffic caused by the trigger queue.
+ * Counting is only active while gAllocationCounting is set, so the replacement operators
+ * do not influence any other test.
+ */
+static bool         gAllocationCounting = false;
+static unsigned int gAllocationCount    = 0;
+static unsigned int gDeallocationCount  = 0;
+
+void *operator new(std::size_t size)
+{
+    if (gAllocationCounting)
+    {
+        gAllocationCount++;
+    }
+
+    void *pMemory = malloc(size ? size : 1);
+    if (NULL == pMemory)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pMemory;
+}
+
+void operator delete(void *pMemory) noexcept
+{
+    if (gAllocationCounting && (NULL != pMemory))
+    {
+        gDeallocationCount++;
+    }
+
+    free(pMemory);
+}
+
+void operator delete(void *pMemory, std::size_t) noexcept
+{
+    operator delete(pMemory);
+}
+
 
 /**
  * @class  BlockingAction
@@ -97,6 +149,72 @@ class BlockingAction  : public CAmActionCommand
         const am_Handle_s handle;
 };
 
+/**
+ * @class  AsyncTestAction
+ * @brief  Leaf action which stays in AS_EXECUTING state until its update() is invoked
+ *         from the test body, thus simulating an outstanding routing side acknowledgment.
+ */
+class AsyncTestAction : public CAmActionCommand
+{
+    public:
+        AsyncTestAction()
+            : CAmActionCommand("GC Unit Test Async Action")
+        {
+        }
+
+        int _execute(void) override
+        {
+            return E_WAIT_FOR_CHILD_COMPLETION;
+        }
+};
+
+/**
+ * @class  DomainVolumesAccess
+ * @brief  Grants access to the batching sub-action CAmActionSetDomainVolumes, which is
+ *         only visible to the volume actions derived from CAmActionSetVolumeCore.
+ */
+class DomainVolumesAccess : public CAmActionSetVolumeCore
+{
+    public:
+        typedef CAmActionSetVolumeCore::CAmActionSetDomainVolumes DomainVolumes_t;
+};
+
+/**
+ * @class  BenchmarkElement
+ * @brief  Light-weight element without any daemon interaction, used to populate
+ *         a CAmFactory with a large number of entries.
+ */
+template <typename Tparam>
+class BenchmarkElement : public CAmElement
+{
+    public:
+        BenchmarkElement(const Tparam &param, IAmControlReceive *pControlReceive)
+            : CAmElement(ET_UNKNOWN, param.name, pControlReceive)
+            , mRequestedID(param.ID)
+        {
+        }
+
+    protected:
+        am_Error_e _register(void) override
+        {
+            setID(mRequestedID);
+            return E_OK;
+        }
+
+    private:
+        uint16_t mRequestedID;
+};
+
+struct gc_BenchmarkParam_s
+{
+    std::string name;
+    uint16_t    ID;
+};
+
+class CAmBenchmarkFactory : public CAmFactory<gc_BenchmarkParam_s, BenchmarkElement<gc_BenchmarkParam_s > >
+{
+};
+
 /***************************************************************************//**
  *@Class : CAmControllerPluginTest
  *@brief : This class is used to test the CAmControllerPlugin class functionality.
@@ -143,6 +261,31 @@ void CAmControllerPluginTest::InitializeCommonStruct()
     listDomains.push_back(domain);
 }
 
+/**
+ * @brief  Creates a CAmActionSetDomainVolumes sub-action requesting -300 for the sink and
+ *         the source element, after both elements were reset to an unmuted volume of 0
+ */
+IAmActionCommand *CAmControllerPluginTest::createDomainVolumes()
+{
+    CAmActionSetVolumeCore::VolumeInfo_t request;
+    request.muteState = MS_UNMUTED;
+    request.volume    = -300;
+    request.offset    = 0;
+    for (std::shared_ptr<CAmRoutePointElement> pElement
+            : {std::shared_ptr<CAmRoutePointElement>(mpCAmSinkElement), std::shared_ptr<CAmRoutePointElement>(mpCAmSourceElement)})
+    {
+        pElement->setMuteState(MS_UNMUTED);
+        pElement->setVolume(0);
+        pElement->setOffsetVolume(0);
+    }
+
+    auto *pAction = new DomainVolumesAccess::DomainVolumes_t(domainID, 200, RAMP_GENIVI_DIRECT);
+    pAction->addElement(mpCAmSinkElement, request);
+    pAction->addElement(mpCAmSourceElement, request);
+
+    return pAction;
+}
+
 void CAmControllerPluginTest::SetUp()
 {
     mpMockControlReceiveInterface = new MockIAmControlReceive();
@@ -373,10 +516,11 @@ TEST_F(CAmControllerPluginTest, EarlyConnection)
 
     // validate that the proper trigger has been created
     gc_Trigger_e triggerType = TRIGGER_UNKNOWN;
-    gc_TriggerElement_s *pTrigger = CAmTriggerQueue::getInstance()->dequeue(triggerType);
-    ASSERT_NE(nullptr, pTrigger);
+    gc_TriggerData_t triggerData;
+    ASSERT_EQ(E_OK, CAmTriggerQueue::getInstance()->dequeue(triggerType, triggerData));
     EXPECT_EQ(SYSTEM_REGISTER_EARLY_CONNECTION, triggerType);
-    auto *pRegisterTrigger = static_cast<gc_RegisterElementTrigger_s*>(pTrigger);
+    const auto *pRegisterTrigger = triggerData.getIf<gc_RegisterElementTrigger_s>();
+    ASSERT_NE(nullptr, pRegisterTrigger);
     EXPECT_EQ(E_OK, pRegisterTrigger->RegisterationStatus);
     EXPECT_STREQ("AnySource1:AnySink1", pRegisterTrigger->elementName.c_str());
 
@@ -538,6 +682,790 @@ TEST_F(CAmControllerPluginTest, RundownTransfer)
     mpPlugin->cbAckTransferConnection(handle2, E_OK);
 }
 
+/**
+ * @brief  Benchmark of the policy condition evaluation on the shipped conf/generic.xml
+ *
+ * @test   Evaluate the condition sets of all processes registered for a mix of
+ *         connection, disconnection, volume and mute requests in a loop and report the
+ *         achieved throughput. Run the same test on an older revision to compare.
+ *
+ * @result "Pass" when the configuration could be loaded and all evaluations completed
+ */
+TEST_F(CAmControllerPluginTest, PolicyEvaluationThroughput)
+{
+    const unsigned int iterations = 2000;
+
+    // switch to the example configuration
+    const char *pOuterPath = getenv("GENERIC_CONTROLLER_CONFIGURATION");
+    std::string outerPath(pOuterPath ? pOuterPath : "");
+    setenv("GENERIC_CONTROLLER_CONFIGURATION", GC_UNIT_TEST_CONF_DIR "/generic.xml", true);
+    CAmConfigurationReader::instance().reload();
+
+    std::vector<gc_triggerParams_s > listTriggers;
+    gc_triggerParams_s               trigger;
+    trigger.triggerType = USER_CONNECTION_REQUEST;
+    trigger.sourceName  = "Media";
+    trigger.sinkName    = "AllSpeakers";
+    trigger.className   = "BASE";
+    listTriggers.push_back(trigger);
+    trigger.sourceName  = "Navi";
+    trigger.className   = "INT";
+    listTriggers.push_back(trigger);
+    trigger.sourceName  = "Phone";
+    trigger.className   = "PHONE";
+    listTriggers.push_back(trigger);
+    trigger.triggerType    = USER_DISCONNECTION_REQUEST;
+    trigger.connectionName = "Navi:AllSpeakers";
+    listTriggers.push_back(trigger);
+    trigger.triggerType = USER_SET_VOLUME;
+    trigger.mainVolume  = 10;
+    listTriggers.push_back(trigger);
+    trigger.triggerType = USER_SET_SINK_MUTE_STATE;
+    trigger.muteState   = MS_MUTED;
+    listTriggers.push_back(trigger);
+
+    CAmPolicyReceive   policyReceive(mpMockControlReceiveInterface, mpMockIAmPolicySend);
+    CAmPolicyFunctions policyFunctions(&policyReceive);
+
+    unsigned int numProcesses = 0;
+    for (const auto &params : listTriggers)
+    {
+        numProcesses += CAmConfigurationReader::instance().getListProcess(params.triggerType).size();
+    }
+
+    ASSERT_GT(numProcesses, 0u) << "no policies loaded from " GC_UNIT_TEST_CONF_DIR "/generic.xml";
+
+    unsigned int numMatches = 0;
+    auto         start      = std::chrono::steady_clock::now();
+    for (unsigned int loop = 0; loop < iterations; ++loop)
+    {
+        for (const auto &params : listTriggers)
+        {
+            for (const auto pProcess : CAmConfigurationReader::instance().getListProcess(params.triggerType))
+            {
+                if (policyFunctions.evaluateConditionSet(pProcess->listConditions, params))
+                {
+                    numMatches++;
+                }
+            }
+        }
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    double evaluationsPerSecond = (duration > 0)
+        ? (1e6 * iterations * numProcesses / duration) : 0.0;
+    std::cout << "[ BENCHMARK] " << iterations * numProcesses << " condition sets evaluated in "
+              << duration << " us (" << evaluationsPerSecond << " per second, "
+              << numMatches << " matches)" << std::endl;
+    RecordProperty("ConditionSetsPerSecond", static_cast<int>(evaluationsPerSecond));
+
+    // restore previous configuration
+    if (outerPath.empty())
+    {
+        unsetenv("GENERIC_CONTROLLER_CONFIGURATION");
+    }
+    else
+    {
+        setenv("GENERIC_CONTROLLER_CONFIGURATION", outerPath.c_str(), true);
+    }
+
+    CAmConfigurationReader::instance().reload();
+}
+
+/**
+ * @brief  Measure the heap allocations caused by queuing and dequeuing triggers
+ *
+ * @test   Queue and dequeue a volume change trigger in a loop after a warm-up phase, which
+ *         lets the ring buffers of the trigger queue reach their working size. Short sink names
+ *         fit into the small string buffer, so only the trigger storage itself is measured.
+ *
+ * @result "Pass" when no allocation or deallocation happens per trigger in steady state
+ */
+TEST_F(CAmControllerPluginTest, TriggerQueueAllocations)
+{
+    const unsigned int iterations = 1000;
+    CAmTriggerQueue   *pQueue     = CAmTriggerQueue::getInstance();
+    gc_Trigger_e       triggerType;
+    gc_TriggerData_t   triggerData;
+
+    // warm-up
+    for (unsigned int loop = 0; loop < GC_TRIGGER_QUEUE_CAPACITY; ++loop)
+    {
+        gc_SinkVolumeChangeTrigger_s trigger;
+        trigger.sinkName = "Sink1";
+        pQueue->queue(USER_SET_VOLUME, std::move(trigger));
+    }
+
+    while (E_OK == pQueue->dequeue(triggerType, triggerData))
+    {
+    }
+
+    gAllocationCount    = 0;
+    gDeallocationCount  = 0;
+    gAllocationCounting = true;
+    for (unsigned int loop = 0; loop < iterations; ++loop)
+    {
+        gc_SinkVolumeChangeTrigger_s trigger;
+        trigger.sinkName = "Sink1";
+        trigger.volume   = static_cast<am_mainVolume_t>(loop % 100);
+        pQueue->queue(USER_SET_VOLUME, std::move(trigger));
+        pQueue->dequeue(triggerType, triggerData);
+    }
+
+    gAllocationCounting = false;
+
+    std::cout << "[ BENCHMARK] " << iterations << " triggers queued with "
+              << static_cast<double>(gAllocationCount) / iterations << " allocations and "
+              << static_cast<double>(gDeallocationCount) / iterations << " deallocations per trigger"
+              << std::endl;
+    EXPECT_EQ(0u, gAllocationCount);
+    EXPECT_EQ(0u, gDeallocationCount);
+    const gc_SinkVolumeChangeTrigger_s *pVolumeTrigger = triggerData.getIf<gc_SinkVolumeChangeTrigger_s>();
+    ASSERT_NE(nullptr, pVolumeTrigger);
+    EXPECT_EQ(USER_SET_VOLUME, triggerType);
+    EXPECT_EQ((iterations - 1) % 100, static_cast<unsigned int>(pVolumeTrigger->volume));
+}
+
+/**
+ * @brief  Verify merging of volume triggers while they are pending in the trigger queue
+ *
+ * @test   Queue a sequence of absolute and step volume changes for two sinks, interrupted
+ *         by a mute trigger, and check the remaining queue content and the merge counters.
+ *
+ * @result "Pass" when consecutive triggers for the same sink are merged with accumulated steps
+ */
+TEST_F(CAmControllerPluginTest, TriggerQueueCoalescing)
+{
+    CAmTriggerQueue *pQueue = CAmTriggerQueue::getInstance();
+    gc_Trigger_e     triggerType;
+    gc_TriggerData_t triggerData;
+    while (E_OK == pQueue->dequeue(triggerType, triggerData))
+    {
+    }
+
+    pQueue->setCoalescing(true);
+    pQueue->resetMergeCounters();
+
+    auto queueVolume = [pQueue](const std::string &sinkName, am_mainVolume_t volume, bool isStep)
+        {
+            gc_SinkVolumeChangeTrigger_s trigger;
+            trigger.sinkName = sinkName;
+            trigger.volume   = volume;
+            trigger.isStep   = isStep;
+            pQueue->queue(USER_SET_VOLUME, std::move(trigger));
+        };
+
+    queueVolume("Sink1", 10, false);
+    queueVolume("Sink2", 1, true);
+    queueVolume("Sink1", 2, true);
+    queueVolume("Sink2", 3, true);
+    queueVolume("Sink1", -1, true);
+
+    gc_SinkMuteTrigger_s muteTrigger;
+    muteTrigger.sinkName  = "Sink1";
+    muteTrigger.muteState = MS_MUTED;
+    pQueue->queue(USER_SET_SINK_MUTE_STATE, std::move(muteTrigger));
+
+    // not merged across the mute trigger
+    queueVolume("Sink1", 20, false);
+
+    EXPECT_EQ(3u, pQueue->getMergeCount(USER_SET_VOLUME));
+    EXPECT_EQ(3u, pQueue->getMergeCount());
+
+    std::vector<std::pair<gc_Trigger_e, const gc_TriggerData_t *> > snapShot;
+    pQueue->getSnapShot(snapShot);
+    ASSERT_EQ(4u, snapShot.size());
+
+    const gc_SinkVolumeChangeTrigger_s *pVolume = snapShot[0].second->getIf<gc_SinkVolumeChangeTrigger_s>();
+    ASSERT_NE(nullptr, pVolume);
+    EXPECT_EQ("Sink1", pVolume->sinkName);
+    EXPECT_EQ(11, pVolume->volume);
+    EXPECT_FALSE(pVolume->isStep);
+
+    pVolume = snapShot[1].second->getIf<gc_SinkVolumeChangeTrigger_s>();
+    ASSERT_NE(nullptr, pVolume);
+    EXPECT_EQ("Sink2", pVolume->sinkName);
+    EXPECT_EQ(4, pVolume->volume);
+    EXPECT_TRUE(pVolume->isStep);
+
+    EXPECT_EQ(USER_SET_SINK_MUTE_STATE, snapShot[2].first);
+    pVolume = snapShot[3].second->getIf<gc_SinkVolumeChangeTrigger_s>();
+    ASSERT_NE(nullptr, pVolume);
+    EXPECT_EQ(20, pVolume->volume);
+
+    // disabled coalescing keeps every trigger
+    pQueue->setCoalescing(false);
+    queueVolume("Sink1", 30, false);
+    pQueue->getSnapShot(snapShot);
+    EXPECT_EQ(5u, snapShot.size());
+    EXPECT_EQ(3u, pQueue->getMergeCount());
+
+    pQueue->setCoalescing(true);
+    pQueue->resetMergeCounters();
+    while (E_OK == pQueue->dequeue(triggerType, triggerData))
+    {
+    }
+}
+
+/**
+ * @brief  Verify saturation of merged volume steps in the trigger queue
+ *
+ * @test   Queue steps of opposite direction and steps exceeding the main volume type for sinks
+ *         without configured volume range and check the remaining queue content.
+ *
+ * @result "Pass" when only steps of the same direction are merged and the sums saturate
+ */
+TEST_F(CAmControllerPluginTest, TriggerQueueVolumeStepClamping)
+{
+    CAmTriggerQueue *pQueue = CAmTriggerQueue::getInstance();
+    gc_Trigger_e     triggerType;
+    gc_TriggerData_t triggerData;
+    while (E_OK == pQueue->dequeue(triggerType, triggerData))
+    {
+    }
+
+    pQueue->setCoalescing(true);
+    pQueue->resetMergeCounters();
+
+    auto queueVolume = [pQueue](const std::string &sinkName, am_mainVolume_t volume, bool isStep)
+        {
+            gc_SinkVolumeChangeTrigger_s trigger;
+            trigger.sinkName = sinkName;
+            trigger.volume   = volume;
+            trigger.isStep   = isStep;
+            pQueue->queue(USER_SET_VOLUME, std::move(trigger));
+        };
+
+    // opposite steps saturate differently at the range limits and are kept apart
+    queueVolume("Sink1", 5, true);
+    queueVolume("Sink1", -3, true);
+    queueVolume("Sink1", -4, true);
+
+    // sums beyond the main volume type saturate
+    queueVolume("Sink2", 32000, false);
+    queueVolume("Sink2", 1000, true);
+    queueVolume("Sink2", 1000, true);
+
+    EXPECT_EQ(3u, pQueue->getMergeCount(USER_SET_VOLUME));
+
+    std::vector<std::pair<gc_Trigger_e, const gc_TriggerData_t *> > snapShot;
+    pQueue->getSnapShot(snapShot);
+    ASSERT_EQ(3u, snapShot.size());
+
+    const gc_SinkVolumeChangeTrigger_s *pVolume = snapShot[0].second->getIf<gc_SinkVolumeChangeTrigger_s>();
+    ASSERT_NE(nullptr, pVolume);
+    EXPECT_EQ(5, pVolume->volume);
+    EXPECT_TRUE(pVolume->isStep);
+
+    pVolume = snapShot[1].second->getIf<gc_SinkVolumeChangeTrigger_s>();
+    ASSERT_NE(nullptr, pVolume);
+    EXPECT_EQ(-7, pVolume->volume);
+    EXPECT_TRUE(pVolume->isStep);
+
+    pVolume = snapShot[2].second->getIf<gc_SinkVolumeChangeTrigger_s>();
+    ASSERT_NE(nullptr, pVolume);
+    EXPECT_EQ("Sink2", pVolume->sinkName);
+    EXPECT_EQ(std::numeric_limits<am_mainVolume_t>::max(), pVolume->volume);
+    EXPECT_FALSE(pVolume->isStep);
+
+    pQueue->resetMergeCounters();
+    while (E_OK == pQueue->dequeue(triggerType, triggerData))
+    {
+    }
+}
+
+/**
+ * @brief  Benchmark of element lookups by name and ID in a factory with many elements
+ *
+ * @test   Populate a factory with 600 sources and 600 sinks and look up every element by name,
+ *         by ID and by linear search over the element list for comparison. Change an ID
+ *         afterwards and destroy an element to verify the indices stay consistent.
+ *
+ * @result "Pass" when all lookups return the expected elements
+ */
+TEST_F(CAmControllerPluginTest, FactoryLookupThroughput)
+{
+    const uint16_t     numElements = 600;
+    const unsigned int iterations  = 100;
+
+    gc_BenchmarkParam_s param;
+    for (uint16_t index = 1; index <= numElements; ++index)
+    {
+        param.name = "Source" + std::to_string(index);
+        param.ID   = index;
+        ASSERT_NE(nullptr, CAmBenchmarkFactory::createElement(param, mpMockControlReceiveInterface));
+        param.name = "Sink" + std::to_string(index);
+        param.ID   = static_cast<uint16_t>(index + numElements);
+        ASSERT_NE(nullptr, CAmBenchmarkFactory::createElement(param, mpMockControlReceiveInterface));
+    }
+
+    unsigned int numFound = 0;
+    auto         start    = std::chrono::steady_clock::now();
+    for (unsigned int loop = 0; loop < iterations; ++loop)
+    {
+        for (uint16_t index = 1; index <= numElements; ++index)
+        {
+            std::string connectionName = "Source" + std::to_string(index) + ":" + "Sink" + std::to_string(index);
+            if (CAmBenchmarkFactory::getElement(connectionName.substr(0, connectionName.find(':'))) != nullptr)
+            {
+                numFound++;
+            }
+        }
+    }
+
+    auto nameDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(iterations * numElements, numFound);
+
+    numFound = 0;
+    start    = std::chrono::steady_clock::now();
+    for (unsigned int loop = 0; loop < iterations; ++loop)
+    {
+        for (uint16_t ID = 1; ID <= 2 * numElements; ++ID)
+        {
+            if (CAmBenchmarkFactory::getElement(ID) != nullptr)
+            {
+                numFound++;
+            }
+        }
+    }
+
+    auto IDDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(iterations * 2 * numElements, numFound);
+
+    // reference: linear search as done before introduction of the ID index
+    std::vector<std::shared_ptr<BenchmarkElement<gc_BenchmarkParam_s > > > listElements;
+    CAmBenchmarkFactory::getListElements(listElements);
+    numFound = 0;
+    start    = std::chrono::steady_clock::now();
+    for (unsigned int loop = 0; loop < iterations; ++loop)
+    {
+        for (uint16_t ID = 1; ID <= 2 * numElements; ++ID)
+        {
+            for (const auto &pElement : listElements)
+            {
+                if (pElement->getID() == ID)
+                {
+                    numFound++;
+                    break;
+                }
+            }
+        }
+    }
+
+    auto linearDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(iterations * 2 * numElements, numFound);
+
+    std::cout << "[ BENCHMARK] " << iterations * 2 * numElements << " lookups of "
+              << 2 * numElements << " elements: by name " << nameDuration << " us, by ID "
+              << IDDuration << " us, linear search " << linearDuration << " us" << std::endl;
+
+    // ID changed after creation
+    std::shared_ptr<BenchmarkElement<gc_BenchmarkParam_s > > pElement = CAmBenchmarkFactory::getElement(5);
+    ASSERT_NE(nullptr, pElement);
+    pElement->setID(4000);
+    EXPECT_EQ(nullptr, CAmBenchmarkFactory::getElement(5));
+    EXPECT_EQ(pElement, CAmBenchmarkFactory::getElement(4000));
+
+    // destruction removes the element from all indices
+    std::weak_ptr<BenchmarkElement<gc_BenchmarkParam_s > > pWeak = pElement;
+    pElement = nullptr;
+    listElements.clear();
+    CAmBenchmarkFactory::destroyElement("Source5");
+    EXPECT_EQ(nullptr, CAmBenchmarkFactory::getElement("Source5"));
+    EXPECT_EQ(nullptr, CAmBenchmarkFactory::getElement(4000));
+    EXPECT_TRUE(pWeak.expired());
+
+    CAmBenchmarkFactory::destroyElement();
+    EXPECT_EQ(nullptr, CAmBenchmarkFactory::getElement(6));
+}
+
+/**
+ * @brief  Verify the route cache of the class element
+ *
+ * @test   Create a main connection through a class element twice and verify the route is
+ *         requested from the daemon only for the first one. Then simulate an update of a
+ *         registered gateway, which must drop the cached route, and create the connection
+ *         a third time.
+ *
+ * @result "Pass" when the cache statistics count one hit and two misses and getRoute()
+ *         is called exactly twice
+ */
+TEST_F(CAmControllerPluginTest, RouteCacheInvalidation)
+{
+    // start with default configuration, allowing non-topology routes
+    EXPECT_CALL(*mpMockControlReceiveInterface, enterSystemPropertiesListDB(_))
+        .WillOnce(Return(E_OK));
+    EXPECT_CALL(*mpMockControlReceiveInterface, getSocketHandler(_))
+        .WillRepeatedly(DoAll(SetArgReferee<0>(pSocketHandler), Return(E_OK)));
+    ASSERT_EQ(E_OK, mpPlugin->startupController(mpMockControlReceiveInterface));
+
+    am_SystemProperty_s systemProperty;
+    systemProperty.type  = SYP_CONNECTION_ALLOW_ONLY_TOPOLOGY_ROUTES;
+    systemProperty.value = 0;
+    std::vector<am_SystemProperty_s> listSystemProperties(1, systemProperty);
+    EXPECT_CALL(*mpMockControlReceiveInterface, getListSystemProperties(_))
+        .WillRepeatedly(DoAll(SetArgReferee<0>(listSystemProperties), Return(E_OK)));
+
+    am_RoutingElement_s element;
+    element.sourceID         = sourceID;
+    element.sinkID           = sinkID;
+    element.domainID         = domainID;
+    element.connectionFormat = CF_GENIVI_STEREO;
+    am_Route_s route;
+    route.sourceID = sourceID;
+    route.sinkID   = sinkID;
+    route.route.push_back(element);
+    std::vector<am_Route_s> listDaemonRoutes(1, route);
+    EXPECT_CALL(*mpMockControlReceiveInterface, getRoute(false, sourceID, sinkID, _))
+        .Times(2)
+        .WillRepeatedly(DoAll(SetArgReferee<3>(listDaemonRoutes), Return(E_OK)));
+    EXPECT_CALL(*mpMockControlReceiveInterface, enterMainConnectionDB(_, _))
+        .WillRepeatedly(DoAll(SetArgReferee<1>(7), Return(E_OK)));
+    EXPECT_CALL(*mpMockControlReceiveInterface, removeMainConnectionDB(_))
+        .WillRepeatedly(Return(E_OK));
+
+    std::shared_ptr<CAmClassElement> pClass = CAmClassFactory::getElement("BASE");
+    ASSERT_NE(nullptr, pClass);
+    auto connectAndDispose = [&pClass, this]()
+        {
+            am_mainConnectionID_t mainConnectionID = 0;
+            EXPECT_EQ(E_OK, pClass->createMainConnection(mpCAmSourceElement->getName(),
+                    mpCAmSinkElement->getName(), mainConnectionID));
+            EXPECT_EQ(7, mainConnectionID);
+            pClass->disposeConnection(CAmMainConnectionFactory::getElement(mainConnectionID));
+        };
+
+    uint32_t hitsBefore, missesBefore, hits, misses;
+    CAmClassElement::getRouteCacheStatistics(hitsBefore, missesBefore);
+
+    // first request resolves the route, second one is served from the cache
+    connectAndDispose();
+    connectAndDispose();
+    CAmClassElement::getRouteCacheStatistics(hits, misses);
+    EXPECT_EQ(hitsBefore + 1, hits);
+    EXPECT_EQ(missesBefore + 1, misses);
+
+    // a gateway update drops the cached route
+    std::vector<am_CustomConnectionFormat_t> listFormats;
+    std::vector<bool>                        listConvertionMatrix;
+    mpPlugin->hookSystemUpdateGateway(1, listFormats, listFormats, listConvertionMatrix);
+    connectAndDispose();
+    CAmClassElement::getRouteCacheStatistics(hits, misses);
+    EXPECT_EQ(hitsBefore + 1, hits);
+    EXPECT_EQ(missesBefore + 2, misses);
+}
+
+/**
+ * @brief  Verify the parallel dispatching mode of the action container
+ *
+ * @test   Start a parallel container with three asynchronous children and acknowledge them
+ *         out of order. Repeat with a failing first child and verify the container waits for
+ *         the outstanding children before it stops and that the undo sequence completes.
+ *
+ * @result "Pass" when all children are dispatched at once and the container completes only
+ *         after the last acknowledgment
+ */
+TEST_F(CAmControllerPluginTest, ParallelActionContainer)
+{
+    CAmActionContainer *pContainer = new CAmActionContainer("ParallelTestContainer");
+    pContainer->setParallel(true);
+    AsyncTestAction *pChildren[3];
+    for (auto &pChild : pChildren)
+    {
+        pChild = new AsyncTestAction();
+        pContainer->append(pChild);
+    }
+
+    pContainer->execute();
+    for (auto pChild : pChildren)
+    {
+        EXPECT_EQ(AS_EXECUTING, pChild->getStatus());
+    }
+
+    pChildren[1]->update(E_OK);
+    EXPECT_EQ(AS_EXECUTING, pContainer->getStatus());
+    pChildren[2]->update(E_OK);
+    EXPECT_EQ(AS_EXECUTING, pContainer->getStatus());
+    pChildren[0]->update(E_OK);
+    EXPECT_EQ(AS_COMPLETED, pContainer->getStatus());
+    EXPECT_EQ(E_OK, pContainer->getError());
+
+    pContainer->cleanup();
+    EXPECT_TRUE(pContainer->isEmpty());
+    delete pContainer;
+
+    // error in one of the children
+    pContainer = new CAmActionContainer("ParallelTestContainer");
+    pContainer->setParallel(true);
+    for (auto &pChild : pChildren)
+    {
+        pChild = new AsyncTestAction();
+        pContainer->append(pChild);
+    }
+
+    pContainer->execute();
+    pChildren[0]->update(E_NOT_POSSIBLE);
+    EXPECT_EQ(AS_EXECUTING, pContainer->getStatus());
+    pChildren[1]->update(E_OK);
+    pChildren[2]->update(E_OK);
+    EXPECT_EQ(AS_ERROR_STOPPED, pContainer->getStatus());
+    EXPECT_EQ(E_NOT_POSSIBLE, pContainer->getError());
+
+    pContainer->undo();
+    EXPECT_EQ(AS_UNDO_COMPLETE, pContainer->getStatus());
+    EXPECT_EQ(AS_UNDO_COMPLETE, pChildren[1]->getStatus());
+    EXPECT_EQ(AS_UNDO_COMPLETE, pChildren[2]->getStatus());
+
+    pContainer->cleanup();
+    delete pContainer;
+}
+
+/**
+ * @brief  Verify the batched element volume request of CAmActionSetDomainVolumes
+ *
+ * @test   Add a sink and a source element to the sub-action and execute it. Acknowledge the
+ *         request with both volumes confirmed.
+ *
+ * @result "Pass" when both volumes are sent in one single setVolumes() request and the
+ *         elements adopt their requested volumes only after the acknowledgment
+ */
+TEST_F(CAmControllerPluginTest, DomainVolumesBatching)
+{
+    IAmActionCommand *pAction = createDomainVolumes();
+
+    am_Handle_s                handle({H_SETVOLUMES, 41});
+    std::vector<am_Volumes_s > listSent;
+    EXPECT_CALL(*mpMockControlReceiveInterface, setVolumes(_, _))
+        .WillOnce(DoAll(SetArgReferee<0>(handle), SaveArg<1>(&listSent), Return(E_OK)));
+    pAction->execute();
+    EXPECT_EQ(AS_EXECUTING, pAction->getStatus());
+    ASSERT_EQ(2u, listSent.size());
+    EXPECT_EQ(VT_SINK, listSent[0].volumeType);
+    EXPECT_EQ(sinkID, listSent[0].volumeID.sink);
+    EXPECT_EQ(VT_SOURCE, listSent[1].volumeType);
+    EXPECT_EQ(sourceID, listSent[1].volumeID.source);
+    EXPECT_EQ(200, listSent[1].time);
+    EXPECT_EQ(0, mpCAmSinkElement->getVolume());
+
+    CAmHandleStore::instance().notifyAsyncResult(handle, E_OK, listSent);
+    EXPECT_EQ(AS_COMPLETED, pAction->getStatus());
+    EXPECT_EQ(-300, mpCAmSinkElement->getVolume());
+    EXPECT_EQ(-300, mpCAmSourceElement->getVolume());
+
+    pAction->cleanup();
+    delete pAction;
+}
+
+/**
+ * @brief  Verify the partial failure of a batched element volume request
+ *
+ * @test   Execute a CAmActionSetDomainVolumes sub-action for a sink and a source element and
+ *         acknowledge the request with E_NOT_POSSIBLE, but with the sink volume confirmed.
+ *
+ * @result "Pass" when only the sink element adopts its requested volume, as reported
+ *         through CAmHandleStore::getConfirmedVolumes()
+ */
+TEST_F(CAmControllerPluginTest, DomainVolumesPartialFailure)
+{
+    IAmActionCommand *pAction = createDomainVolumes();
+
+    am_Handle_s                handle({H_SETVOLUMES, 42});
+    std::vector<am_Volumes_s > listSent;
+    EXPECT_CALL(*mpMockControlReceiveInterface, setVolumes(_, _))
+        .WillOnce(DoAll(SetArgReferee<0>(handle), SaveArg<1>(&listSent), Return(E_OK)));
+    pAction->execute();
+    ASSERT_EQ(2u, listSent.size());
+
+    // routing side only managed to apply the sink volume
+    std::vector<am_Volumes_s > listConfirmed(1, listSent[0]);
+    CAmHandleStore::instance().notifyAsyncResult(handle, E_NOT_POSSIBLE, listConfirmed);
+    EXPECT_EQ(E_NOT_POSSIBLE, pAction->getError());
+    EXPECT_EQ(-300, mpCAmSinkElement->getVolume());
+    EXPECT_EQ(0, mpCAmSourceElement->getVolume());
+    EXPECT_TRUE(CAmHandleStore::instance().getConfirmedVolumes().empty());
+
+    pAction->cleanup();
+    delete pAction;
+}
+
+/**
+ * @brief  Verify the roll-back of a batched element volume request
+ *
+ * @test   Execute a CAmActionSetDomainVolumes sub-action for a sink and a source element,
+ *         acknowledge it and undo it afterwards.
+ *
+ * @result "Pass" when the undo sends the recent volumes of both elements in one single
+ *         setVolumes() request and the elements return to their recent volumes
+ */
+TEST_F(CAmControllerPluginTest, DomainVolumesUndo)
+{
+    IAmActionCommand *pAction = createDomainVolumes();
+
+    am_Handle_s                handle({H_SETVOLUMES, 43});
+    am_Handle_s                undoHandle({H_SETVOLUMES, 44});
+    std::vector<am_Volumes_s > listSent;
+    std::vector<am_Volumes_s > listRolledBack;
+    EXPECT_CALL(*mpMockControlReceiveInterface, setVolumes(_, _))
+        .WillOnce(DoAll(SetArgReferee<0>(handle), SaveArg<1>(&listSent), Return(E_OK)))
+        .WillOnce(DoAll(SetArgReferee<0>(undoHandle), SaveArg<1>(&listRolledBack), Return(E_OK)));
+    pAction->execute();
+    CAmHandleStore::instance().notifyAsyncResult(handle, E_OK, listSent);
+    ASSERT_EQ(AS_COMPLETED, pAction->getStatus());
+    EXPECT_EQ(-300, mpCAmSinkElement->getVolume());
+
+    pAction->undo();
+    EXPECT_EQ(AS_UNDOING, pAction->getStatus());
+    ASSERT_EQ(2u, listRolledBack.size());
+    EXPECT_EQ(sinkID, listRolledBack[0].volumeID.sink);
+    EXPECT_EQ(sourceID, listRolledBack[1].volumeID.source);
+
+    CAmHandleStore::instance().notifyAsyncResult(undoHandle, E_OK, listRolledBack);
+    EXPECT_EQ(AS_UNDO_COMPLETE, pAction->getStatus());
+    EXPECT_EQ(0, mpCAmSinkElement->getVolume());
+    EXPECT_EQ(0, mpCAmSourceElement->getVolume());
+
+    pAction->cleanup();
+    delete pAction;
+}
+
+/**
+ * @brief  Verify the replay of a damaged persistence journal
+ *
+ * @test   Write some keys through CAmPersistenceDefault and keep a copy of the resulting
+ *         journal. Remove the snapshot and restore the journal with a torn record appended,
+ *         then with its last record truncated, and open the persistence again each time.
+ *
+ * @result "Pass" when all complete records are restored, the damaged tail is dropped and
+ *         the journal file is cut back to its last complete record
+ */
+TEST_F(CAmControllerPluginTest, PersistenceJournalReplay)
+{
+    const std::string fileName    = "/tmp/gc_utest_persistence.xml";
+    const std::string journalName = fileName + PERSISTENCE_JOURNAL_SUFFIX;
+    auto readFile = [](const std::string &name) -> std::string
+        {
+            std::ifstream file(name.c_str(), std::ios::in | std::ios::binary);
+            return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        };
+    auto writeFile = [](const std::string &name, const std::string &content)
+        {
+            std::ofstream file(name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+            file << content;
+        };
+
+    setenv(PERISTENCE_FILE_PATH_ENV_VAR_NAME, fileName.c_str(), true);
+    setenv(PERSISTENCE_JOURNAL_LIMIT_ENV_VAR_NAME, "0", true);
+    unlink(fileName.c_str());
+    unlink(journalName.c_str());
+
+    // record three changes, whereof the last one overwrites the first one
+    std::string journal;
+    {
+        CAmPersistenceDefault persistence;
+        persistence.open("utest");
+        EXPECT_EQ(E_OK, persistence.write("keyA", "1"));
+        EXPECT_EQ(E_OK, persistence.write("keyB", "22"));
+        EXPECT_EQ(E_OK, persistence.write("keyA", "333"));
+        journal = readFile(journalName);
+
+        // unchanged values are not journaled again
+        EXPECT_EQ(E_OK, persistence.write("keyB", "22"));
+        EXPECT_EQ(journal, readFile(journalName));
+    }
+    ASSERT_FALSE(journal.empty());
+
+    // torn record at the tail
+    unlink(fileName.c_str());
+    writeFile(journalName, journal + "4 3 0badf00d\nkeyC4");
+    {
+        CAmPersistenceDefault persistence;
+        EXPECT_EQ(E_OK, persistence.open("utest"));
+        EXPECT_EQ(journal.size(), readFile(journalName).size());
+
+        std::string value;
+        EXPECT_EQ(E_OK, persistence.read("keyA", value));
+        EXPECT_EQ("333", value);
+        EXPECT_EQ(E_OK, persistence.read("keyB", value));
+        EXPECT_EQ("22", value);
+        EXPECT_EQ(E_DATABASE_ERROR, persistence.read("keyC", value));
+    }
+
+    // last record truncated
+    unlink(fileName.c_str());
+    writeFile(journalName, journal.substr(0, journal.size() - 2));
+    {
+        CAmPersistenceDefault persistence;
+        EXPECT_EQ(E_OK, persistence.open("utest"));
+
+        std::string value;
+        EXPECT_EQ(E_OK, persistence.read("keyA", value));
+        EXPECT_EQ("1", value);
+        EXPECT_EQ(E_OK, persistence.read("keyB", value));
+        EXPECT_EQ("22", value);
+    }
+
+    unsetenv(PERISTENCE_FILE_PATH_ENV_VAR_NAME);
+    unsetenv(PERSISTENCE_JOURNAL_LIMIT_ENV_VAR_NAME);
+    unlink(fileName.c_str());
+    unlink(journalName.c_str());
+}
+
+/**
+ * @brief  Verify that the persistence journal is compacted on startup only
+ *
+ * @test   Configure a journal limit of two records and write three keys, then destroy the
+ *         persistence and open it again.
+ *
+ * @result "Pass" when neither write() nor the destructor writes the snapshot, and open()
+ *         merges the journal into the snapshot and restores all keys
+ */
+TEST_F(CAmControllerPluginTest, PersistenceCompactionOnOpen)
+{
+    const std::string fileName    = "/tmp/gc_utest_persistence.xml";
+    const std::string journalName = fileName + PERSISTENCE_JOURNAL_SUFFIX;
+    struct stat       fileStat;
+
+    setenv(PERISTENCE_FILE_PATH_ENV_VAR_NAME, fileName.c_str(), true);
+    setenv(PERSISTENCE_JOURNAL_LIMIT_ENV_VAR_NAME, "2", true);
+    unlink(fileName.c_str());
+    unlink(journalName.c_str());
+
+    {
+        CAmPersistenceDefault persistence;
+        persistence.open("utest");
+        EXPECT_EQ(E_OK, persistence.write("keyA", "1"));
+        EXPECT_EQ(E_OK, persistence.write("keyB", "22"));
+        EXPECT_EQ(E_OK, persistence.write("keyC", "333"));
+        EXPECT_NE(0, stat(fileName.c_str(), &fileStat));
+    }
+    EXPECT_NE(0, stat(fileName.c_str(), &fileStat));
+    ASSERT_EQ(0, stat(journalName.c_str(), &fileStat));
+    EXPECT_LT(0, fileStat.st_size);
+
+    {
+        CAmPersistenceDefault persistence;
+        EXPECT_EQ(E_OK, persistence.open("utest"));
+        EXPECT_EQ(0, stat(fileName.c_str(), &fileStat));
+        ASSERT_EQ(0, stat(journalName.c_str(), &fileStat));
+        EXPECT_EQ(0, fileStat.st_size);
+
+        std::string value;
+        EXPECT_EQ(E_OK, persistence.read("keyA", value));
+        EXPECT_EQ("1", value);
+        EXPECT_EQ(E_OK, persistence.read("keyC", value));
+        EXPECT_EQ("333", value);
+    }
+
+    unsetenv(PERISTENCE_FILE_PATH_ENV_VAR_NAME);
+    unsetenv(PERSISTENCE_JOURNAL_LIMIT_ENV_VAR_NAME);
+    unlink(fileName.c_str());
+    unlink(journalName.c_str());
+}
+
 int main(int argc, char * *argv)
 {
     // initialize logging environment
@@ -46,6 +46,7 @@ protected:
     void SetUp() final;
     void TearDown() final;
     void InitializeCommonStruct();
+    IAmActionCommand *createDomainVolumes();
 
     MockIAmControlReceive            *mpMockControlReceiveInterface;
     IAmControlReceive                *mpCAmControlReceive;
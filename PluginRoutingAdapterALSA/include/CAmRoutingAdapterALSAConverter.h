@@ -0,0 +1,128 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#ifndef ROUTINGADAPTERALSA_CONVERTER_H_
+#define ROUTINGADAPTERALSA_CONVERTER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace am
+{
+
+/**
+ * Conversion stage between the capture and the playback stream of a proxy.
+ *
+ * The interleaved samples of the capture are converted to float, mixed to the
+ * channels of the playback, resampled with a polyphase FIR filter and
+ * converted to the sample format of the playback. Each step is skipped if
+ * the configuration of both streams is the same.
+ */
+class CAmRoutingAdapterALSAConverter
+{
+public:
+    CAmRoutingAdapterALSAConverter();
+
+    /**
+     * This function prepares the conversion for the given stream configurations.
+     * Formats S16_LE, S32_LE and FLOAT_LE are supported.
+     * @param[in] srcFormat     ALSA sample format of the capture
+     * @param[in] srcChannels   amount of interleaved channels of the capture
+     * @param[in] srcRate       sample rate of the capture in Hz
+     * @param[in] dstFormat     ALSA sample format of the playback
+     * @param[in] dstChannels   amount of interleaved channels of the playback
+     * @param[in] dstRate       sample rate of the playback in Hz
+     * @param[in] frames        maximal amount of frames passed to process()
+     * @returns 0 on success, -EINVAL for unsupported formats and -ERANGE if the
+     *          rates have no small common divisor
+     */
+    int setup(const uint32_t srcFormat, const uint32_t srcChannels, const uint32_t srcRate,
+              const uint32_t dstFormat, const uint32_t dstChannels, const uint32_t dstRate,
+              const size_t frames);
+
+    /**
+     * @returns maximal amount of frames returned by one call of process()
+     */
+    size_t getMaxOutputFrames() const;
+
+    /**
+     * @returns delay of the resampling filter in ms
+     */
+    uint32_t getDelay() const;
+
+    /**
+     * This function converts one block of the capture.
+     * @param[in] input     interleaved samples of the capture
+     * @param[in] frames    amount of frames in input
+     * @param[out] output   interleaved samples of the playback, getMaxOutputFrames() big
+     * @returns amount of frames written to output
+     */
+    size_t process(const void *input, const size_t frames, void *output);
+
+    /**
+     * The sample format kernels, public to be used by the benchmark.
+     * Float samples are in the range -1.0 .. 1.0, bigger values get clipped.
+     * @param[in] input     samples
+     * @param[out] output   samples
+     * @param[in] samples   amount of samples
+     */
+    static void toFloat(const int16_t *input, float *output, const size_t samples);
+    static void toFloat(const int32_t *input, float *output, const size_t samples);
+    static void fromFloat(const float *input, int16_t *output, const size_t samples);
+    static void fromFloat(const float *input, int32_t *output, const size_t samples);
+
+private:
+    void designFilter();
+    void mixChannels(const float *input, const size_t frames);
+    size_t resample(const size_t frames);
+
+    uint32_t mSrcFormat;
+    uint32_t mSrcChannels;
+    uint32_t mSrcRate;
+    uint32_t mDstFormat;
+    uint32_t mDstChannels;
+    uint32_t mDstRate;
+    size_t mFrames;
+
+    std::vector<float> mInput;          // Capture samples as float, interleaved
+    std::vector<float> mMatrix;         // Weight of each capture channel per playback channel
+    std::vector<float> mHistory;        // Planar samples per playback channel, filter history in front
+    std::vector<float> mOutput;         // Playback samples as float, interleaved
+
+    uint32_t mUp;                       // Interpolation factor L
+    uint32_t mDown;                     // Decimation factor M
+    std::vector<float> mCoeffs;         // mUp phases of taps, stored reversed
+    uint32_t mPhase;                    // Phase of next output sample
+    size_t mPos;                        // Input frame of next output sample
+};
+
+} /* namespace am */
+#endif /* ROUTINGADAPTERALSA_CONVERTER_H_ */
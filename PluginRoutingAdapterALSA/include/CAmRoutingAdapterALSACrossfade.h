@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#ifndef ROUTINGADAPTERALSA_CROSSFADE_H_
+#define ROUTINGADAPTERALSA_CROSSFADE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <atomic>
+#include "audiomanagertypes.h"
+
+namespace am
+{
+
+/**
+ * Crossfade between the two sinks of a crossfader mixed into one stream.
+ *
+ * The periods of sink A and sink B are scaled with complementary gains
+ * computed once per period, so both sides follow the same curve sample by
+ * sample. RAMP_GENIVI_LINEAR fades with a constant sum of the gains, all
+ * other ramps with constant power.
+ * setTarget() may be called from any thread, advance() and apply() are meant
+ * for the streaming thread and never block.
+ */
+class CAmRoutingAdapterALSACrossfade
+{
+public:
+    CAmRoutingAdapterALSACrossfade();
+    ~CAmRoutingAdapterALSACrossfade();
+
+    /**
+     * This function prepares the crossfade for the given stream configuration.
+     * @param[in] format    ALSA sample format, S16_LE, S32_LE and FLOAT_LE are supported
+     * @param[in] channels  amount of interleaved channels
+     * @param[in] rate      sample rate in Hz
+     * @param[in] frames    maximal amount of frames passed to advance()
+     * @returns 0 on success otherwise <0
+     */
+    int setup(const uint32_t format, const uint32_t channels, const uint32_t rate, const size_t frames);
+
+    /**
+     * This function requests a new hot sink, the fade starts with the next period.
+     * @param[in] hotSink   HS_SINKA, HS_SINKB or HS_INTERMEDIATE for the middle position
+     * @param[in] ramp      ramp shape
+     * @param[in] time      fade time in ms
+     */
+    void setTarget(const am_HotSink_e hotSink, const am_CustomRampType_t ramp, const am_time_t time);
+
+    /**
+     * This function computes the gains of both sides for the next period.
+     * @param[in] frames    amount of frames of the period
+     */
+    void advance(const size_t frames);
+
+    /**
+     * This function applies the gain of one side on the current period.
+     * @param[in] side          HS_SINKA or HS_SINKB, other buffers are left untouched
+     * @param[in,out] buffer    interleaved samples
+     * @param[in] frames        amount of frames in buffer, as passed to advance()
+     */
+    void apply(const am_HotSink_e side, void *buffer, const size_t frames) const;
+
+    /**
+     * @returns true from setTarget() until the fade has been completed
+     */
+    bool isFading() const;
+
+    /**
+     * @returns hot sink reached by the last fade
+     */
+    am_HotSink_e getHotSink() const;
+
+    /**
+     * This function computes the gains of both sides for a fade position.
+     * @param[in] position  0.0 for sink A up to 1.0 for sink B
+     * @param[in] linear    true for constant sum, false for constant power
+     * @param[out] gainA    linear gain of sink A
+     * @param[out] gainB    linear gain of sink B
+     */
+    static void calcGains(const float position, const bool linear, float & gainA, float & gainB);
+
+private:
+    void startFade();
+    void calcEnvelopes(const size_t frames);
+
+    uint32_t mFormat;
+    uint32_t mChannels;
+    uint32_t mRate;
+    size_t mFrames;
+    float *mpEnvelopeA;                 // Gain per sample of sink A in current period
+    float *mpEnvelopeB;                 // Gain per sample of sink B in current period
+
+    pthread_mutex_t mMtx;               // Protects the requested target
+    bool mPending;
+    am_HotSink_e mTargetHotSink;
+    am_CustomRampType_t mTargetRamp;
+    am_time_t mTargetTime;
+    std::atomic<bool> mFading;
+    std::atomic<int> mHotSink;
+
+    /* streaming thread only */
+    bool mEnvelope;                     // Envelopes valid for current period
+    bool mLinear;
+    float mPosition;                    // Current position, 0.0 sink A .. 1.0 sink B
+    float mBegPos;                      // Begin position of fade
+    float mEndPos;                      // End position of fade
+    size_t mRampFrames;                 // Length of fade
+    size_t mRampPos;                    // Frames of fade already applied
+};
+
+} /* namespace am */
+
+#endif /* ROUTINGADAPTERALSA_CROSSFADE_H_ */
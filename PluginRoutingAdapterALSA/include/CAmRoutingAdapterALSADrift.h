@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#ifndef ROUTINGADAPTERALSA_DRIFT_H_
+#define ROUTINGADAPTERALSA_DRIFT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+namespace am
+{
+
+/**
+ * Estimates the clock drift between the capture and the playback of a proxy.
+ *
+ * The fill level of the stream, i.e. the frames queued in the playback plus
+ * the frames waiting in the capture, is low pass filtered and compared to the
+ * level measured after start. Whenever it deviates by more than a few frames
+ * one frame has to be dropped or inserted by the proxy. The drift in ppm is
+ * calculated from the level change without corrections over a window of ten
+ * seconds. The results are read by other threads for the statistics.
+ */
+class CAmRoutingAdapterALSADrift
+{
+public:
+    CAmRoutingAdapterALSADrift();
+
+    /**
+     * This function prepares the estimation for a new stream.
+     * @param[in] rate      sample rate of the playback in Hz
+     */
+    void setup(const uint32_t rate);
+
+    /**
+     * This function restarts the measurement of the target level, e.g. after
+     * the recovery of a device. The counters are kept.
+     */
+    void reset();
+
+    /**
+     * This function is called once per period before the period is written.
+     * @param[in] level     frames queued in playback and capture
+     * @param[in] frames    frames of the period
+     * @returns 1 if one frame has to be inserted, -1 if one has to be dropped, else 0
+     */
+    int update(const int64_t level, const size_t frames);
+
+    /**
+     * @returns drift of the last complete window in ppm, positive if the capture is faster
+     */
+    int32_t getPpm() const { return mPpm.load(std::memory_order_relaxed); }
+    uint32_t getInserted() const { return mInserted.load(std::memory_order_relaxed); }
+    uint32_t getDropped() const { return mDropped.load(std::memory_order_relaxed); }
+
+private:
+    uint32_t mRate;
+    uint64_t mFrames;                   // Frames since reset
+    double mLevel;                      // Filtered level
+    double mTarget;                     // Level measured after start
+    uint32_t mTargetCnt;                // Periods summed up in mTarget
+    double mWindowStart;                // Level without corrections at window start
+    uint64_t mWindowFrames;             // Frames in current window
+    std::atomic<int32_t> mPpm;
+    std::atomic<uint32_t> mInserted;
+    std::atomic<uint32_t> mDropped;
+};
+
+} /* namespace am */
+#endif /* ROUTINGADAPTERALSA_DRIFT_H_ */
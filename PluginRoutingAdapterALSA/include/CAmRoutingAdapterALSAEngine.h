@@ -0,0 +1,128 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#ifndef ROUTINGADAPTERALSA_ENGINE_H_
+#define ROUTINGADAPTERALSA_ENGINE_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <poll.h>
+#include <pthread.h>
+#include "CAmRoutingAdapterThread.h"
+
+namespace am
+{
+
+class CAmRoutingAdapterALSAProxyDefault;
+
+/**
+ * Streams several default proxies from a single real-time thread.
+ *
+ * The poll descriptors of the capture and playback PCMs of all attached
+ * proxies are gathered into one poll() call. Each proxy only enables the
+ * descriptors of the stream it is waiting for and is serviced when they
+ * become ready, so the period wise forwarding and the prefill and recovery
+ * behavior stay the same as with an own thread per proxy. An eventfd wakes
+ * up the thread when proxies are attached or detached; the descriptor list
+ * is rebuilt by them and only swapped in by the thread.
+ */
+class CAmRoutingAdapterALSAEngine : private CAmRoutingAdapterThread
+{
+public:
+    /**
+     * @param[in] name      name of the thread
+     * @param[in] cpu       CPU the thread is bound to, <0 for no binding
+     */
+    CAmRoutingAdapterALSAEngine(const std::string & name, const int cpu);
+    ~CAmRoutingAdapterALSAEngine();
+
+    /**
+     * This function adds the proxy to the serviced ones. The PCMs of the proxy have
+     * to be started already. The thread is started on first use, or again after it
+     * stopped because of an error, and takes over the highest scheduling priority
+     * of the proxies attached so far.
+     * Returns when the thread services the proxy.
+     * @param[in] proxy     proxy to be serviced
+     * @returns 0 on success otherwise <0
+     */
+    int attach(CAmRoutingAdapterALSAProxyDefault *proxy);
+
+    /**
+     * This function removes the proxy from the serviced ones.
+     * Returns when the thread does not access the proxy any more.
+     * @param[in] proxy     proxy to be removed
+     * @returns true in case the proxy was attached
+     */
+    bool detach(const CAmRoutingAdapterALSAProxyDefault *proxy);
+
+private:
+    /* CAmRoutingAdapterThread */
+    int initThread() override;
+    int workerThread() override;
+    void deinitThread(int errInit) override;
+
+private:
+    struct ra_engineEntry_s
+    {
+        CAmRoutingAdapterALSAProxyDefault *pProxy;
+        uint32_t first;                     // Index of the first descriptor in mFds
+        uint32_t count;
+    };
+
+    std::vector<ra_engineEntry_s>::iterator findProxy(const CAmRoutingAdapterALSAProxyDefault *proxy);
+    uint32_t prepareEntries();
+    void wakeUp();
+    void waitForUpdate(const uint32_t generation);
+    void updateEntries();
+    static uint64_t getTimeUs();
+
+    std::vector<ra_engineEntry_s> mProxies;                    // Attached proxies, guarded by mMtx
+    std::vector<ra_engineEntry_s> mNextEntries;                // Entries to be serviced next, guarded by mMtx
+    std::vector<struct pollfd> mNextFds;                       // Descriptors to be polled next, guarded by mMtx
+    std::vector<ra_engineEntry_s> mEntries;                    // Serviced proxies, owned by the thread
+    std::vector<struct pollfd> mFds;                           // Eventfd followed by the PCM descriptors
+    pthread_mutex_t mMtx;
+    pthread_cond_t mCond;
+    std::atomic<uint32_t> mGeneration;  // Changes of mProxies
+    uint32_t mApplied;                  // Generation serviced by the thread
+    int mEventFd;
+    int mCpu;
+    int32_t mPriority;
+    bool mRunning;                      // Thread is running, guarded by mMtx
+    volatile bool mStop;
+    struct timespec mCpuStart;
+    struct timespec mWallStart;
+};
+
+} /* namespace am */
+
+#endif /* ROUTINGADAPTERALSA_ENGINE_H_ */
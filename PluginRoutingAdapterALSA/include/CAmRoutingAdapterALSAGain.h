@@ -0,0 +1,142 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#ifndef ROUTINGADAPTERALSA_GAIN_H_
+#define ROUTINGADAPTERALSA_GAIN_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "audiomanagertypes.h"
+
+namespace am
+{
+
+/**
+ * Software gain stage applied to the interleaved periods of a proxy.
+ *
+ * The volume follows the GENIVI ramp shapes sample by sample, which avoids
+ * the zipper noise of stepping a mixer control. The multiplication is done
+ * with SSE2, AVX2 or NEON kernels depending on the target the plugin is
+ * compiled for, otherwise with a plain C++ loop.
+ * setTarget() may be called from any thread, apply() is meant for the
+ * streaming thread and never blocks.
+ */
+class CAmRoutingAdapterALSAGain
+{
+public:
+    CAmRoutingAdapterALSAGain();
+    ~CAmRoutingAdapterALSAGain();
+
+    /**
+     * This function prepares the gain stage for the given stream configuration.
+     * @param[in] format    ALSA sample format, S16_LE, S32_LE and FLOAT_LE are supported
+     * @param[in] channels  amount of interleaved channels
+     * @param[in] rate      sample rate in Hz
+     * @param[in] frames    maximal amount of frames passed to apply()
+     * @returns 0 on success otherwise <0
+     */
+    int setup(const uint32_t format, const uint32_t channels, const uint32_t rate, const size_t frames);
+
+    /**
+     * This function requests a new volume, the ramp starts with the next period.
+     * @param[in] volume    target volume in the range of AM_MUTE to 0
+     * @param[in] ramp      ramp shape
+     * @param[in] time      ramp time in ms
+     */
+    void setTarget(const am_volume_t volume, const am_CustomRampType_t ramp, const am_time_t time);
+
+    /**
+     * This function applies the gain on the given period.
+     * @param[in,out] buffer    interleaved samples
+     * @param[in] frames        amount of frames in buffer
+     */
+    void apply(void *buffer, const size_t frames);
+
+    /**
+     * This function converts a volume in 0.1 dB to a linear gain.
+     * @param[in] volume    volume in the range of AM_MUTE to 0
+     * @returns linear gain
+     */
+    static float volumeToGain(const float volume);
+
+    /**
+     * The sample kernels, public to be used by the benchmark.
+     * @param[in,out] buffer    samples
+     * @param[in] gain          gain of all samples or gain per sample
+     * @param[in] samples       amount of samples
+     */
+    static void scale(int16_t *buffer, const float gain, const size_t samples);
+    static void scale(int32_t *buffer, const float gain, const size_t samples);
+    static void scale(float *buffer, const float gain, const size_t samples);
+    static void scale(int16_t *buffer, const float *gain, const size_t samples);
+    static void scale(int32_t *buffer, const float *gain, const size_t samples);
+    static void scale(float *buffer, const float *gain, const size_t samples);
+
+    /**
+     * The mixing kernels, adding the source samples with saturation to the destination.
+     * Float samples are clipped to the range -1.0 .. 1.0
+     * @param[in,out] buffer    accumulated samples
+     * @param[in] source        samples to be added
+     * @param[in] samples       amount of samples
+     */
+    static void mix(int16_t *buffer, const int16_t *source, const size_t samples);
+    static void mix(int32_t *buffer, const int32_t *source, const size_t samples);
+    static void mix(float *buffer, const float *source, const size_t samples);
+
+private:
+    void startRamp();
+    float calcVolume(const float position) const;
+    void calcEnvelope(const size_t frames);
+
+    uint32_t mFormat;
+    uint32_t mChannels;
+    uint32_t mRate;
+    size_t mFrames;
+    float *mpEnvelope;                  // Gain per sample of current period
+
+    pthread_mutex_t mMtx;               // Protects the requested target
+    bool mPending;
+    am_volume_t mTargetVol;
+    am_CustomRampType_t mTargetRamp;
+    am_time_t mTargetTime;
+
+    /* streaming thread only */
+    float mCurVol;                      // Current volume
+    float mBegVol;                      // Begin volume of ramp
+    float mEndVol;                      // End volume of ramp
+    am_CustomRampType_t mRamp;
+    size_t mRampFrames;                 // Length of ramp
+    size_t mRampPos;                    // Frames of ramp already applied
+};
+
+} /* namespace am */
+
+#endif /* ROUTINGADAPTERALSA_GAIN_H_ */
@@ -0,0 +1,168 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+#ifndef ROUTINGADAPTERALSA_LEVEL_H_
+#define ROUTINGADAPTERALSA_LEVEL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "audiomanagertypes.h"
+
+/* channels measured separately, the streams of the proxies have less */
+#define RA_LEVEL_MAX_CHANNELS 8
+
+namespace am
+{
+
+/**
+ * Level meter of an interleaved stream. The streaming thread measures the
+ * peak and the RMS of each channel per period, the highest levels are held
+ * until they are taken by another thread. Levels are given in 0.1 dBFS in
+ * the range of AM_MUTE to 0, as volumes are. No memory is allocated and no
+ * lock is taken by analyze().
+ */
+class CAmRoutingAdapterALSALevel
+{
+public:
+    CAmRoutingAdapterALSALevel();
+
+    /**
+     * This function prepares the meter for the given stream configuration.
+     * @param[in] format    ALSA sample format, S16_LE, S32_LE and FLOAT_LE are supported
+     * @param[in] channels  amount of interleaved channels, at most RA_LEVEL_MAX_CHANNELS
+     * @returns 0 on success otherwise <0
+     */
+    int setup(const uint32_t format, const uint32_t channels);
+
+    /**
+     * This function switches the measurement on or off, the held levels are cleared.
+     * @param[in] enable    true to measure the analyzed periods
+     */
+    void setEnabled(const bool enable);
+
+    bool isEnabled() const
+    {
+        return mEnabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * This function measures one period, called by the streaming thread.
+     * @param[in] buffer    interleaved samples
+     * @param[in] frames    amount of frames in buffer
+     */
+    void analyze(const void *buffer, const size_t frames);
+
+    /**
+     * This function returns the highest levels of all channels since the last call.
+     * @param[out] peak     peak level in 0.1 dBFS
+     * @param[out] rms      highest RMS level of a period in 0.1 dBFS
+     */
+    void take(am_volume_t & peak, am_volume_t & rms);
+
+    /**
+     * This function returns the highest levels of one channel since the last call.
+     * @param[in] channel   channel index
+     * @param[out] peak     peak level in 0.1 dBFS
+     * @param[out] rms      highest RMS level of a period in 0.1 dBFS
+     */
+    void take(const uint32_t channel, am_volume_t & peak, am_volume_t & rms);
+
+    /**
+     * This function converts a linear amplitude relative to full scale into 0.1 dBFS.
+     * @param[in] amplitude linear amplitude, 1.0 is full scale
+     * @returns level in the range of AM_MUTE to 0
+     */
+    static am_volume_t amplitudeToLevel(const float amplitude);
+
+    /**
+     * The measuring kernels, public to be used by the benchmark.
+     * The absolute peak and the sum of squares of each channel are added to
+     * the given arrays, the samples are normalized to full scale.
+     * @param[in] buffer        interleaved samples
+     * @param[in] channels      amount of interleaved channels
+     * @param[in] frames        amount of frames
+     * @param[in,out] peak      peak per channel
+     * @param[in,out] squares   sum of squares per channel
+     */
+    static void measure(const int16_t *buffer, const uint32_t channels, const size_t frames, float *peak, float *squares);
+    static void measure(const int32_t *buffer, const uint32_t channels, const size_t frames, float *peak, float *squares);
+    static void measure(const float *buffer, const uint32_t channels, const size_t frames, float *peak, float *squares);
+
+private:
+    static void hold(std::atomic<int16_t> & held, const am_volume_t level);
+
+    uint32_t mFormat;
+    uint32_t mChannels;
+    std::atomic<bool> mEnabled;
+    std::atomic<int16_t> mPeak[RA_LEVEL_MAX_CHANNELS];     // Held levels, reset by take()
+    std::atomic<int16_t> mRms[RA_LEVEL_MAX_CHANNELS];
+};
+
+/**
+ * Evaluation of a level notification. The levels are taken in intervals,
+ * the highest level is held until the notification fires, so a periodic
+ * notification reports the maximum of its whole period and not only of the
+ * last interval.
+ */
+class CAmRoutingAdapterALSALevelNotification
+{
+public:
+    CAmRoutingAdapterALSALevelNotification();
+
+    /**
+     * This function configures the notification, the held level is cleared.
+     * @param[in] status    NS_PERIODIC notifies each parameter ms, NS_MINIMUM and NS_MAXIMUM when
+     *                      the level falls below or rises above the parameter and NS_CHANGE when the
+     *                      level changed by the parameter in 0.1 dB
+     * @param[in] parameter period, threshold or change of the notification
+     */
+    void configure(const am_NotificationStatus_e status, const int16_t parameter);
+
+    /**
+     * This function checks the notification with the level of one interval.
+     * @param[in] level     highest level measured in the interval
+     * @param[in] interval  length of the interval in ms
+     * @param[out] value    level to be notified
+     * @returns true if the notification is to be sent
+     */
+    bool check(const am_volume_t level, const uint32_t interval, am_volume_t & value);
+
+private:
+    am_NotificationStatus_e mStatus;
+    int16_t mParameter;
+    am_volume_t mValue;         // Last notified level
+    am_volume_t mHeld;          // Highest level since the last notification
+    bool mActive;               // Threshold crossed at the last check
+    uint32_t mElapsed;          // ms since the last periodic notification
+};
+
+} /* namespace am */
+
+#endif /* ROUTINGADAPTERALSA_LEVEL_H_ */
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+#ifndef ROUTINGADAPTERALSAMIXERCACHE_H_
+#define ROUTINGADAPTERALSAMIXERCACHE_H_
+
+#include <string>
+#include <map>
+#include <memory>
+#include "CAmRoutingAdapterALSAMixerCtrl.h"
+
+
+namespace am
+{
+
+/*
+ * Keeps the mixer of each card opened and loaded so that sound property and
+ * volume requests do not attach, register and load the mixer on every call.
+ */
+class CAmRoutingAdapterALSAMixerCache
+{
+public:
+
+    /**
+     * This function returns the loaded mixer of a card and opens it on first use.
+     * @param[in] card      name of the sound card with .ctl interface
+     * @returns shared mixer handle or nullptr in case the mixer could not be loaded
+     */
+    std::shared_ptr<ra_mixerHandle_s> getHandle(const std::string & card);
+
+    /**
+     * This function drops all cached mixers e.g. after a card was added or removed.
+     * Controls still holding a handle keep it until they are destroyed.
+     */
+    void invalidate();
+
+    /**
+     * @returns number of cached mixers
+     */
+    size_t size() const
+    {
+        return mHandles.size();
+    };
+
+private:
+    static void closeHandle(ra_mixerHandle_s * pHandle);
+
+    std::map<std::string, std::shared_ptr<ra_mixerHandle_s>> mHandles;
+};
+
+} /* namespace am */
+
+#endif /* ROUTINGADAPTERALSAMIXERCACHE_H_ */
@@ -31,12 +31,28 @@
 #define ROUTINGADAPTERALSAMIXERCTRL_H_
 
 #include <string>
+#include <map>
+#include <memory>
+#include <pthread.h>
 #include <alsa/asoundlib.h>
 
 
 namespace am
 {
 
+/*
+ * Opened and loaded mixer of one card which is shared by several mixer controls.
+ * The found elements are kept so that a later open is a map lookup only.
+ * The recursive mutex serializes all element accesses, the volume change
+ * callback may call back into the control while it is held.
+ */
+struct ra_mixerHandle_s
+{
+    snd_mixer_t *handle;
+    pthread_mutex_t mutex;
+    std::map<std::string, snd_mixer_elem_t*> elements;
+};
+
 class CAmRoutingAdapterALSAMixerCtrl
 {
 public:
@@ -51,6 +67,7 @@ private:
     snd_mixer_t *mpHandle;
     snd_mixer_selem_id_t *mpSid;
     snd_mixer_elem_t* mpElem;
+    std::shared_ptr<ra_mixerHandle_s> mpShared;
 
     mixer_dir_e mDir;       /* ALSA mixer direction */
     std::string mCard;      /* ALSA PCM card name with .ctl interface */
@@ -59,7 +76,11 @@ private:
     std::string mStrError;
 
 public:
-    CAmRoutingAdapterALSAMixerCtrl();
+    /**
+     * @param[in] shared    already loaded mixer of the card to use, in case of
+     *                      nullptr the control opens a mixer of its own
+     */
+    CAmRoutingAdapterALSAMixerCtrl(std::shared_ptr<ra_mixerHandle_s> shared = nullptr);
     virtual ~CAmRoutingAdapterALSAMixerCtrl();
 
     /**
@@ -112,6 +133,8 @@ public:
 
     /**
      * This function returns current volume of mixer element.
+     * Pending events of the mixer are handled first, so that a cached mixer
+     * reports changes done by other applications or controls.
      * @param[out] volume   current volume
      * @returns 0 on success otherwise <0
      */
@@ -151,6 +174,9 @@ protected:
 
 private:
     int retWithError(const std::string str, const int err);
+    int readVolume(long int & volume);
+    void lock();
+    void unlock();
 };
 
 } /* namespace am */
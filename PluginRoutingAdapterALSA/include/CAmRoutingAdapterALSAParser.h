@@ -61,6 +61,8 @@ private:
     void parseSinkData(ra_sinkInfo_s & info, CAmRoutingAdapterKVPConverter::KVPList & kvpList);
     /*Gateway member map*/
     void parseGatewayData(ra_gatewayInfo_s & info, CAmRoutingAdapterKVPConverter::KVPList & kvpList);
+    /*Crossfader member map*/
+    void parseCrossfaderData(ra_crossfaderInfo_s & info, CAmRoutingAdapterKVPConverter::KVPList & kvpList);
     /*Proxy member map*/
     void parseProxyData(ra_proxyInfo_s & info, CAmRoutingAdapterKVPConverter::KVPList & kvpList);
     /*USB member map*/
@@ -69,6 +71,9 @@ private:
     template <typename S> void parseSoundPropertyData(S & info, CAmRoutingAdapterKVPConverter::KVPList & kvpList);
     /*SoundPropertySpecification member map */
     template <typename S> void parseSoundPropertySpecification(S & info, CAmRoutingAdapterKVPConverter::KVPList & kvpList);
+    /*Announces the configured level notifications, switched off*/
+    void addLevelNotifications(std::vector<am_NotificationConfiguration_s> & list,
+            const am_CustomNotificationType_t peakType, const am_CustomNotificationType_t rmsType) const;
 
     /*Remove space and tab in the string*/
     inline void removeWhiteSpaces(std::string & str) const;
@@ -97,6 +102,8 @@ private:
     template <typename S> void parseInnerChildInfo(const xmlNodePtr devNode, S & info);
     /* updates gateway information inside lGatewayInfo*/
     void updateGatewayInfo(ra_gatewayInfo_s & gatewayInfo, CAmRoutingAdapterKVPConverter::KVPList & keyValPair);
+    /* Adds the Crossfader information into lCrossfaderInfo*/
+    void updateCrossfaderInfo(CAmRoutingAdapterKVPConverter::KVPList & keyValPair);
     /* Adds the Proxy information into lProxyInfo*/
     void updateProxyInfo(CAmRoutingAdapterKVPConverter::KVPList & keyValPair);
     /*Parse the comment line and fill the corresponding structure*/
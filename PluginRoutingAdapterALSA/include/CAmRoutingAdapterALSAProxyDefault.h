@@ -33,11 +33,21 @@
 
 #include "IAmRoutingAdapterALSAProxy.h"
 #include "CAmRoutingAdapterThread.h"
+#include "CAmRoutingAdapterALSAGain.h"
+#include "CAmRoutingAdapterALSAConverter.h"
+#include "CAmRoutingAdapterALSADrift.h"
+#include "CAmRoutingAdapterALSAStats.h"
+#include "CAmRoutingAdapterALSALevel.h"
 #include <alsa/asoundlib.h>
+#include <ctime>
+#include <atomic>
+#include <poll.h>
 
 namespace am
 {
 
+class CAmRoutingAdapterALSAEngine;
+
 class CAmRoutingAdapterALSAProxyDefault : public IAmRoutingAdapterALSAProxy, public CAmRoutingAdapterThread
 {
 public:
@@ -50,10 +60,87 @@ public:
     am_Error_e startStreaming() override;
     am_Error_e stopStreaming() override;
     am_Error_e closeStreaming() override;
+    am_Error_e setVolume(const am_volume_t volume, const am_CustomRampType_t ramp, const am_time_t time) override;
+    am_Error_e getStatistics(std::string & stats) const override;
+    am_Error_e enableLevel(const am_VolumeType_e type, const bool enable) override;
+    am_Error_e getLevel(const am_VolumeType_e type, am_volume_t & peak, am_volume_t & rms) override;
+
+    /**
+     * \brief Opens and configures the PCMs ahead of startStreaming()
+     *
+     * Used for warm proxies: the PCMs and buffers stay set up when the streaming
+     * is closed, so the next start only needs to start the PCMs. They are released
+     * when the proxy is deleted. Must be called after openStreaming() and while
+     * the proxy is not streaming.
+     *
+     * \param[out] E_OK if the PCMs are set up, E_NOT_POSSIBLE otherwise
+     */
+    am_Error_e prepareStreaming();
+    bool isPrepared() const
+    {
+        return mPrepared;
+    }
+    const ra_Proxy_s & getConfiguration() const
+    {
+        return mProxy;
+    }
+
+    /**
+     * \brief Lets the PCMs be serviced by the given engine instead of an own thread
+     *
+     * Must be called while the proxy is not streaming, NULL returns to the own thread.
+     * The engine has to outlive the proxy.
+     *
+     * \param[in] engine servicing the proxy or NULL
+     */
+    void setEngine(CAmRoutingAdapterALSAEngine *engine);
+    CAmRoutingAdapterALSAEngine * getEngine() const
+    {
+        return mpEngine;
+    }
 
+    /**
+     * \brief Provides the amount of poll descriptors of both PCMs, called by the engine
+     */
+    int getPollCount();
+    /**
+     * \brief Fills the poll descriptors of both PCMs, called by the engine before each poll
+     *
+     * Only the descriptors of the stream the proxy waits for are enabled, the others
+     * are set to -1 so that e.g. a playback with free space does not wake up the engine.
+     *
+     * \param[in] pfds space for getPollCount() descriptors
+     */
+    void getPollDescriptors(struct pollfd *pfds);
+    /**
+     * \param[out] monotonic time in us at which the awaited stream is recovered if not ready
+     */
+    uint64_t getDeadline() const
+    {
+        return mDeadline;
+    }
+    /**
+     * \brief Forwards one period if the awaited stream is ready, called by the engine after each poll
+     *
+     * Behaves like one call of workerThread(), but never blocks: a period which does
+     * not fit into the playback is kept until the playback is ready.
+     *
+     * \param[in] pfds descriptors filled by getPollDescriptors() with the returned events
+     * \param[in] now monotonic time in us
+     */
+    void serviceStreaming(struct pollfd *pfds, uint64_t now);
+    /**
+     * \brief Reports that the engine stopped servicing the proxy because of an error
+     *
+     * Called by the engine thread before it exits. The error is shown by getStatistics()
+     * until the proxy is attached again.
+     *
+     * \param[in] err error of the engine thread
+     */
+    void engineFailed(int err);
 
 
-private:
+protected:
     struct ap_data_t
     {
     public:
@@ -61,6 +148,11 @@ private:
         snd_pcm_t *hndl;
         snd_pcm_hw_params_t *hwPar;
         snd_pcm_sw_params_t *swPar;
+        bool mmap;              // Ring buffer is accessed directly through mmap
+        uint32_t format;
+        uint32_t channels;
+        uint32_t rate;
+        uint64_t lastWake;      // Time of the last wake-up in us, 0 after a recovery
     public:
         ap_data_t()
         {
@@ -68,13 +160,19 @@ private:
             hndl = NULL;
             hwPar = NULL;
             swPar = NULL;
+            mmap = false;
+            format = SND_PCM_FORMAT_UNKNOWN;
+            channels = 0;
+            rate = 0;
+            lastWake = 0;
         }
     };
 
     /**
      * \brief Sets Hardware Parameters through ALSA APIs
      *
-     * This method sets Format, Channels and Rate provided by the ra_proxyInfo_s
+     * This method sets Format, Channels and Rate of the given device.
+     * MMAP access is preferred if configured, RW access is used as fallback.
      *
      * \param[in] struct with pointers to ALSA name, sw and hw parameters
      * \param[out] ALSA APIs' errors
@@ -92,6 +190,19 @@ private:
      * \param[out] ALSA APIs' errors
      */
     int setHwBuffSize(ap_data_t & data, bool firstTry = true);
+    /**
+     * \brief Sets Buffer Size through ALSA APIs on the given sizes
+     *
+     * Same as above, but negotiates the given period and buffer size instead of
+     * the ones used by the worker thread.
+     *
+     * \param[in] struct with pointers to ALSA name, sw and hw parameters
+     * \param[in,out] period size in frames
+     * \param[in,out] ring buffer size in frames
+     * \param[in] bool to establish if the function was already invoked before
+     * \param[out] ALSA APIs' errors
+     */
+    int setHwBuffSize(ap_data_t & data, snd_pcm_uframes_t & perSize, snd_pcm_uframes_t & bufSize, bool firstTry);
     /**
      * \brief Sets Software Parameters through ALSA APIs
      *
@@ -103,6 +214,16 @@ private:
      */
     int setSwParams(ap_data_t & data);
 
+    /**
+     * \brief Opens the PCMs, sets the hardware and software parameters and allocates the buffers
+     * \param[out] 0 on success, -EFAULT otherwise
+     */
+    int setupDevices();
+    /**
+     * \brief Closes the PCMs and frees the buffers allocated by setupDevices()
+     */
+    void releaseDevices();
+
     /* CAmRoutingAdapterThread */
     int initThread() override;
     int workerThread() override;
@@ -117,17 +238,70 @@ private:
      */
     int readFromDevice(ap_data_t &device, void *buffer, int sizeOfBuffer);
     /**
-     * Writes a buffer to device using ALSA APIs
+     * Writes a buffer to device using ALSA APIs, waits until the device took all frames
      * \param[in] struct with pointers to ALSA name, sw and hw parameters
      * \param[in] pointer to buffer
      * \param[in] size of buffer (in ALSA Frames Quantity)
      * \param[out] ALSA APIs' errors
      */
     int writeToDevice(ap_data_t &device, void *buffer, int sizeOfBuffer);
+    /**
+     * Reads a buffer from a device which is ready, without waiting
+     * \param[in] struct with pointers to ALSA name, sw and hw parameters
+     * \param[in] pointer to buffer
+     * \param[in] size of buffer (in ALSA Frames Quantity)
+     * \param[out] ALSA APIs' errors
+     */
+    int readReady(ap_data_t &device, void *buffer, int sizeOfBuffer);
+    /**
+     * Writes a buffer to a device which is ready, without waiting
+     * \param[in] struct with pointers to ALSA name, sw and hw parameters
+     * \param[in] pointer to buffer
+     * \param[in] size of buffer (in ALSA Frames Quantity)
+     * \param[out] written frames, may be less than given, or ALSA APIs' errors
+     */
+    int writeReady(ap_data_t &device, void *buffer, int sizeOfBuffer);
+    /**
+     * Applies the level analysis, the software gain, the conversion and the drift
+     * compensation to the period read into the copy buffer.
+     * \param[in] frames read
+     * \param[out] buffer to be written to the playback
+     * \param[out] frames to be written
+     */
+    int processPeriod(int frames, char *&pBuffer);
+    /**
+     * Forwards up to one period from the capture ring buffer directly into the
+     * playback ring buffer. The software gain is applied in place on the
+     * playback ring buffer. Used when both devices are in MMAP access.
+     * \param[in] wait for the devices, otherwise only the frames fitting right now are forwarded
+     * \param[out] forwarded frames or ALSA APIs' errors
+     */
+    int transferMmap(bool wait = true);
+    /**
+     * Stops forwarding directly between the ring buffers after transferMmap() failed
+     * to recover the devices. The following periods are copied like with RW access.
+     * \param[in] error returned by transferMmap()
+     */
+    void fallbackToCopy(int err);
+    /**
+     * Writes the period kept for the playback as far as it fits right now. Used by
+     * serviceStreaming(), which must not block.
+     * \param[out] true if frames are left, they are written when the playback is ready again
+     */
+    bool writePending();
+    /**
+     * Keeps the fill level of the stream on target by dropping or inserting
+     * one frame of the period about to be written.
+     * \param[in] buffer with space for one more frame than given
+     * \param[in] frames in buffer
+     * \param[in] frameSize in bytes
+     * \param[out] frames to be written
+     */
+    int compensateDrift(char *buffer, int frames, size_t frameSize);
     /**
      * Sequence for recovering:
      * 1) Drop/Stop the device
-     * 2) Create Prefill injecting silence for syncing aim on next writing operation
+     * 2) Mark Prefill injecting silence for syncing aim on next writing operation
      * 3) Prepare the device
      * 4) Start the device manually if it's Capture Device
      * \param[in] struct with pointers to ALSA name, sw and hw parameters
@@ -138,6 +312,8 @@ private:
      * Creates PreFill Buffer, that is a 0 filled buffer injected to ALSA Ring Buffer.
      * The size is calculated based on msPrefill specified through XML attribute.
      * Value should be set compatible with the Ring Buffer Size set.
+     * The buffer is kept until destroyPrefill(), so that the recovery in the
+     * streaming thread does not need to allocate memory.
      *
      * \param[out] 0 when successful, -ENOMEM otherwise
      */
@@ -146,20 +322,82 @@ private:
      * Deallocates resources for PreFill Buffer
      */
     void destroyPrefill();
+    /**
+     * Locks a buffer used by the streaming thread into RAM, failures are only logged
+     * since the limit of locked memory depends on the system configuration.
+     * \param[in] pointer to buffer
+     * \param[in] size of buffer in bytes
+     */
+    void lockBuffer(void *buffer, size_t size);
+    /**
+     * Unlocks a buffer locked by lockBuffer() before it is deallocated.
+     * \param[in] pointer to buffer
+     * \param[in] size of buffer in bytes
+     */
+    void unlockBuffer(void *buffer, size_t size);
+    /**
+     * Starts measuring the CPU time of the streaming thread, the load is logged
+     * in deinitThread(). The timing statistics are cleared as well.
+     */
+    void startLoadMeasurement();
+    /**
+     * Adds the deviation of the wake-up of a capture device from the period
+     * time to the statistics.
+     * \param[in] struct with pointers to ALSA name, sw and hw parameters
+     */
+    void recordWakeup(ap_data_t &device);
+    /**
+     * Measures the delay from capture to playback, i.e. the frames waiting in
+     * the capture plus the frames queued in the playback, and stores it in the
+     * statistics.
+     */
+    void measureDelay();
+    /**
+     * \param[out] monotonic time in us
+     */
+    static uint64_t getTimeUs();
 
     struct
     {
         char *mPreFill;
         size_t prefillByteSize;
         snd_pcm_uframes_t mPerSize;
+        bool pending;
     }ra_Prefill_s;
 
     char *mpCopyBuffer;
+    size_t mCopyBufSize;
     snd_pcm_uframes_t mPerSize;
     snd_pcm_uframes_t mBufSize;
+    size_t mFrameSize;
+    bool mConvert;
+    CAmRoutingAdapterALSAConverter mConverter;
+    char *mpConvBuffer;
+    size_t mConvBufSize;
+    size_t mPbFrameSize;
+    CAmRoutingAdapterALSADrift mDrift;
     ap_data_t mPb;
     ap_data_t mCap;
     uint32_t mCnt;
+    CAmRoutingAdapterALSAGain mGain;
+    struct timespec mCpuStart;
+    struct timespec mWallStart;
+    CAmRoutingAdapterALSAStats mStats;
+    CAmRoutingAdapterALSALevel mCapLevel;   // Level of the captured periods
+    CAmRoutingAdapterALSALevel mPbLevel;    // Level of the periods written to the playback
+    bool mPrepared;                     // PCMs set up by prepareStreaming() and kept between streams
+    CAmRoutingAdapterALSAEngine *mpEngine;  // Engine servicing the PCMs instead of the own thread
+    bool mEngineStarted;                // PCMs started for the engine
+    uint32_t mCapFds;                   // Poll descriptors of the capture
+    uint32_t mPbFds;                    // Poll descriptors of the playback
+    bool mWaitPb;                       // Period waits for space in the playback
+    char *mpPending;                    // Period kept until the playback is ready
+    int mPendingFrames;
+    uint64_t mDeadline;                 // Time in us at which the awaited stream is recovered
+    uint64_t mTimeoutUs;
+    bool mMmapTransfer;                 // Periods are forwarded directly between the mmap ring buffers
+    snd_pcm_uframes_t mCapPerSize;      // Period size of the capture, mPerSize is the one of the playback
+    std::atomic<int> mEngineErr;        // Error of the engine servicing the proxy
 };
 
 } /* namespace am */
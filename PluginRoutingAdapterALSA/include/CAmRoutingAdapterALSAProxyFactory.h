@@ -0,0 +1,101 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#ifndef ROUTINGADAPTERALSAPROXYFACTORY_H_
+#define ROUTINGADAPTERALSAPROXYFACTORY_H_
+
+#include <map>
+#include <string>
+#include <stdint.h>
+#include "IAmRoutingAdapterALSAProxy.h"
+
+namespace am
+{
+
+/**
+ * Registry of the proxy libraries configured with pxyNam.
+ *
+ * Each library is opened once and its create function is resolved once.
+ * The library is kept loaded as long as a domain using it is registered or
+ * a proxy created by it exists, so that connecting and disconnecting does
+ * not open and close the library every time.
+ */
+class CAmRoutingAdapterALSAProxyFactory
+{
+public:
+    CAmRoutingAdapterALSAProxyFactory();
+    ~CAmRoutingAdapterALSAProxyFactory();
+
+    /**
+     * This function loads a library in advance and keeps a reference on it.
+     * @param[in] library   absolute path of the proxy library
+     * @returns true if the library is loaded
+     */
+    bool load(const std::string & library);
+
+    /**
+     * This function releases the reference taken by load().
+     * @param[in] library   absolute path of the proxy library
+     */
+    void unload(const std::string & library);
+
+    /**
+     * This function creates a proxy by the library, the library is loaded if needed.
+     * @param[in] library   absolute path of the proxy library
+     * @param[in] proxy     configuration of the proxy
+     * @returns the proxy or NULL if the library or its create function is not available
+     */
+    IAmRoutingAdapterALSAProxy * create(const std::string & library, const ra_Proxy_s & proxy);
+
+    /**
+     * This function deletes a proxy and releases the reference on its library.
+     * Proxies not created by a library are only deleted.
+     * @param[in] proxy     proxy to be deleted
+     */
+    void destroy(IAmRoutingAdapterALSAProxy * proxy);
+
+private:
+    typedef IAmRoutingAdapterALSAProxy *(*ra_createProxy_t)(const ra_Proxy_s &);
+
+    struct ra_proxyLibrary_s
+    {
+        void *handle;
+        ra_createProxy_t create;
+        uint32_t references;
+    };
+
+    ra_proxyLibrary_s * acquire(const std::string & library);
+    void release(std::map<std::string, ra_proxyLibrary_s>::iterator it);
+
+    std::map<std::string, ra_proxyLibrary_s> mLibraries;
+};
+
+} /* namespace am */
+#endif /* ROUTINGADAPTERALSAPROXYFACTORY_H_ */
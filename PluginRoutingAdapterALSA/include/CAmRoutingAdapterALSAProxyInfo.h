@@ -60,6 +60,14 @@ public:
     uint16_t msPrefill;
     uint16_t msInitTimeout;
     ra_cpuSched_s cpuScheduler;
+    bool softVolume;
+    bool mixing;
+    bool mmapAccess;
+    int32_t sinkFormat;
+    uint32_t sinkChannels;
+    uint32_t sinkRate;
+    bool driftCompensation;
+    bool warm;
 };
 
 /**
@@ -0,0 +1,191 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#ifndef ROUTINGADAPTERALSAPROXYMIXER_H_
+#define ROUTINGADAPTERALSAPROXYMIXER_H_
+
+#include <memory>
+#include <vector>
+#include <pthread.h>
+#include "CAmRoutingAdapterALSAProxyDefault.h"
+#include "CAmRoutingAdapterALSACrossfade.h"
+
+namespace am
+{
+
+/**
+ * \brief Proxy mixing several capture PCMs into one playback PCM
+ *
+ * The playback device is opened and started with the first input and keeps
+ * running, writing silence if needed, until the mixer is destroyed together
+ * with its last input. Inputs are added and removed at period boundaries
+ * without restarting the playback. Each input has its own gain stage, the
+ * inputs are summed with saturation. Inputs feeding the sinks of a crossfader
+ * are faded against each other by one crossfade stage of the mixer.
+ */
+class CAmRoutingAdapterALSAProxyMixer : public CAmRoutingAdapterALSAProxyDefault
+{
+public:
+    CAmRoutingAdapterALSAProxyMixer(const ra_Proxy_s & proxy);
+    virtual ~CAmRoutingAdapterALSAProxyMixer();
+
+    /**
+     * This function checks if the input can be mixed into the playback stream.
+     * @param[in] input     proxy configuration of input
+     * @returns true if format, rate and channels match the playback stream
+     */
+    bool isCompatible(const ra_Proxy_s & input) const;
+
+    /**
+     * This function opens the capture device of the input and starts mixing it.
+     * @param[in] input     proxy configuration of input
+     * @returns E_OK on success
+     */
+    am_Error_e addInput(const ra_Proxy_s & input);
+
+    /**
+     * This function stops mixing the input and closes its capture device.
+     * @param[in] input     proxy configuration of input
+     * @returns E_OK on success or E_NON_EXISTENT if input was not mixed
+     */
+    am_Error_e removeInput(const ra_Proxy_s & input);
+
+    /**
+     * This function changes the gain of a single input.
+     * @param[in] input     proxy configuration of input
+     * @returns E_OK on success or E_NON_EXISTENT if input was not mixed
+     */
+    am_Error_e setInputVolume(const ra_Proxy_s & input, const am_volume_t volume,
+                              const am_CustomRampType_t ramp, const am_time_t time);
+
+    /**
+     * This function switches the level measurement of a single input.
+     * @param[in] input     proxy configuration of input
+     * @param[in] enable    true to measure the captured periods
+     * @returns E_OK on success or E_NON_EXISTENT if input was not mixed
+     */
+    am_Error_e enableInputLevel(const ra_Proxy_s & input, const bool enable);
+
+    /**
+     * This function provides the level of a single input since the last call.
+     * @param[in] input     proxy configuration of input
+     * @param[out] peak     peak level in 0.1 dBFS
+     * @param[out] rms      highest RMS level of a period in 0.1 dBFS
+     * @returns E_OK on success or E_NON_EXISTENT if input was not mixed
+     */
+    am_Error_e getInputLevel(const ra_Proxy_s & input, am_volume_t & peak, am_volume_t & rms);
+
+    /**
+     * This function assigns a single input to one side of the crossfade.
+     * @param[in] input     proxy configuration of input
+     * @param[in] side      HS_SINKA or HS_SINKB
+     * @param[in] hotSink   hot sink to be taken over if no fade is running
+     * @returns E_OK on success or E_NON_EXISTENT if input was not mixed
+     */
+    am_Error_e setInputCrossfade(const ra_Proxy_s & input, const am_HotSink_e side, const am_HotSink_e hotSink);
+
+    /* IAmRoutingAdapterALSAProxy, fades between the inputs of sink A and sink B */
+    am_Error_e crossFade(const am_HotSink_e hotSink, const am_CustomRampType_t ramp, const am_time_t time) override;
+    bool isCrossFading() const override;
+    bool canCrossFade() const override;
+    am_HotSink_e getHotSink() const override;
+
+private:
+    /* CAmRoutingAdapterThread */
+    int initThread() override;
+    int workerThread() override;
+    void deinitThread(int errInit) override;
+
+private:
+    struct ra_mixInput_s
+    {
+        const ra_Proxy_s *pProxy;
+        ap_data_t cap;
+        char *pBuffer;
+        int frames;                     // Result of the last read
+        CAmRoutingAdapterALSAGain gain;
+        CAmRoutingAdapterALSALevel level;
+        am_HotSink_e side;              // Side of the crossfade or HS_UNKNOWN
+    };
+
+    std::vector<ra_mixInput_s*>::iterator findInput(const ra_Proxy_s & input);
+    void closeInput(ra_mixInput_s *pInput);
+    void mixInput(ra_mixInput_s *pInput, const int frames, const bool first);
+
+    std::vector<ra_mixInput_s*> mInputs;
+    std::vector<ra_mixInput_s*> mMixInputs; // Inputs of the period being mixed
+    pthread_mutex_t mInputMtx;          // Protects mInputs against the mixing thread
+    pthread_mutex_t mMixMtx;            // Held by the mixing thread while it reads the inputs
+    CAmRoutingAdapterALSACrossfade mCrossfade;
+};
+
+/**
+ * \brief Proxy of a single connection feeding a shared CAmRoutingAdapterALSAProxyMixer
+ */
+class CAmRoutingAdapterALSAProxyMixerInput : public IAmRoutingAdapterALSAProxy
+{
+public:
+    CAmRoutingAdapterALSAProxyMixerInput(const ra_Proxy_s & proxy,
+                                         std::shared_ptr<CAmRoutingAdapterALSAProxyMixer> mixer);
+    virtual ~CAmRoutingAdapterALSAProxyMixerInput();
+
+    /* IAmRoutingAdapterALSAProxy */
+    am_timeSync_t getDelay() const override;
+    am_Error_e openStreaming() override;
+    am_Error_e startStreaming() override;
+    am_Error_e stopStreaming() override;
+    am_Error_e closeStreaming() override;
+    am_Error_e setVolume(const am_volume_t volume, const am_CustomRampType_t ramp, const am_time_t time) override;
+    am_Error_e getStatistics(std::string & stats) const override;
+    am_Error_e enableLevel(const am_VolumeType_e type, const bool enable) override;
+    am_Error_e getLevel(const am_VolumeType_e type, am_volume_t & peak, am_volume_t & rms) override;
+    am_Error_e crossFade(const am_HotSink_e hotSink, const am_CustomRampType_t ramp, const am_time_t time) override;
+    bool isCrossFading() const override;
+    bool canCrossFade() const override;
+    am_HotSink_e getHotSink() const override;
+
+    /**
+     * This function assigns this input to one side of a crossfader.
+     * @param[in] side      HS_SINKA or HS_SINKB
+     * @param[in] hotSink   current hot sink of the crossfader
+     */
+    void setCrossfade(const am_HotSink_e side, const am_HotSink_e hotSink);
+
+private:
+    std::shared_ptr<CAmRoutingAdapterALSAProxyMixer> mpMixer;
+    bool mStreaming;
+    am_volume_t mVolume;                // Last requested volume of this input
+    bool mLevel;                        // Level measurement of this input requested
+    am_HotSink_e mSide;                 // Side of the crossfader fed by this input
+    am_HotSink_e mHotSink;              // Last requested hot sink of the crossfader
+};
+
+} /* namespace am */
+#endif /* ROUTINGADAPTERALSAPROXYMIXER_H_ */
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#ifndef ROUTINGADAPTERALSA_RTLOG_H_
+#define ROUTINGADAPTERALSA_RTLOG_H_
+
+#include <atomic>
+#include <stdint.h>
+#include <stddef.h>
+#include "CAmRoutingAdapterThread.h"
+
+/* amount of messages buffered, a power of two */
+#define RA_RTLOG_ENTRIES 64
+/* maximal length of a message */
+#define RA_RTLOG_TEXT_LEN 128
+
+namespace am
+{
+
+enum ra_rtLogLevel_e
+{
+    RA_RTLOG_ERROR,
+    RA_RTLOG_INFO,
+    RA_RTLOG_DEBUG
+};
+
+/**
+ * Logging for the streaming threads of the proxies.
+ *
+ * The messages are formatted into a fixed size, lock free ring buffer and
+ * forwarded to the logging of the plugin by a thread running with normal
+ * priority. Neither memory is allocated nor a lock is taken by the caller.
+ * If the ring buffer is full the message is dropped and counted.
+ */
+class CAmRoutingAdapterALSARtLog : private CAmRoutingAdapterThread
+{
+public:
+    static CAmRoutingAdapterALSARtLog & getInstance();
+
+    /**
+     * This function starts the thread forwarding the messages, it must be
+     * called from a non real-time context before log() is used.
+     */
+    void start();
+
+    /**
+     * This function queues one message, safe to be called from any thread.
+     * @param[in] level     log level the message is forwarded with
+     * @param[in] format    printf like format of the message
+     */
+    void log(const ra_rtLogLevel_e level, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+private:
+    CAmRoutingAdapterALSARtLog();
+    ~CAmRoutingAdapterALSARtLog();
+
+    /* CAmRoutingAdapterThread */
+    int initThread() override;
+    int workerThread() override;
+    void deinitThread(int errInit) override;
+
+    void drain();
+
+    struct ra_rtLogEntry_s
+    {
+        std::atomic<size_t> seq;        // Position the entry is free or filled for
+        ra_rtLogLevel_e level;
+        char text[RA_RTLOG_TEXT_LEN];
+    };
+
+    ra_rtLogEntry_s mEntries[RA_RTLOG_ENTRIES];
+    std::atomic<size_t> mHead;          // Next position to be filled
+    size_t mTail;                       // Next position to be forwarded
+    std::atomic<uint32_t> mDropped;
+    uint32_t mReported;                 // Dropped messages already reported
+    std::atomic<bool> mStarted;
+    pthread_mutex_t mMtx;               // Serializes start()
+};
+
+} /* namespace am */
+#endif /* ROUTINGADAPTERALSA_RTLOG_H_ */
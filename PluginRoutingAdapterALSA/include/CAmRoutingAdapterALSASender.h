@@ -32,11 +32,16 @@
 #ifndef ROUTINGADAPTERALSASENDER_H_
 #define ROUTINGADAPTERALSASENDER_H_
 
+#include <map>
 #include <memory>
 #include "IAmRouting.h"
 #include "IAmRoutingReceiverShadow.h"
 #include "CAmRoutingAdapterALSAProxyDefault.h"
+#include "CAmRoutingAdapterALSAProxyMixer.h"
+#include "CAmRoutingAdapterALSAProxyFactory.h"
+#include "CAmRoutingAdapterALSAEngine.h"
 #include "CAmRoutingAdapterALSAVolume.h"
+#include "CAmRoutingAdapterALSAVolumeScheduler.h"
 #include "CAmRoutingAdapterALSAdb.h"
 
 #include "CAmCommandLineSingleton.h"
@@ -44,6 +49,16 @@
 #include "CAmRoutingAdapterALSADeviceDetector.h"
 
 #define RA_ALSA_BUSNAME  "ALSARoutingPlugin"
+/* interval the measured delays of the connections are checked in */
+#define RA_TIMING_INTERVAL_MS 1000
+/* change of a measured delay which is reported to the AudioManagerDaemon */
+#define RA_TIMING_THRESHOLD_MS 2
+/* number of timing intervals after which the statistics of all running connections are logged */
+#define RA_STATISTICS_INTERVALS 10
+/* interval the stream levels are checked in for notifications */
+#define RA_LEVEL_INTERVAL_MS 100
+/* interval running crossfades are checked for completion in */
+#define RA_CROSSFADE_INTERVAL_MS 20
 
 namespace am
 {
@@ -116,6 +131,7 @@ public:
     void registerSource(ra_sourceInfo_s & info, am_domainID_t domainID) override;
     void registerSink(ra_sinkInfo_s & info, am_domainID_t domainID) override;
     void registerGateway(ra_gatewayInfo_s & info, am_domainID_t domainID) override;
+    void registerCrossfader(ra_crossfaderInfo_s & info, am_domainID_t domainID) override;
     void hookDomainRegistrationComplete(am_domainID_t domainID) override;
 
     void deregisterDomain(const am_domainID_t &domainID) override;
@@ -129,8 +145,35 @@ public:
     void peekSourceClassID(const std::string& name, am_sourceID_t& sourceID);
     void peekSinkClassID(const std::string& name, am_sinkID_t& sinkID);
 
+    /**
+     * Provides the timing statistics of all connected proxies, one line per connection.
+     * They are also logged every RA_STATISTICS_INTERVALS timing intervals while connections run.
+     */
+    void getStatistics(std::string & stats);
+
 private:
     static bool isNumber(const std::string& value);
+    am_volume_t getSoftVolume(const am_RoutingElement_s & route);
+    void setSoftVolume(const am_sourceID_t sourceID, const am_sinkID_t sinkID,
+                       const am_CustomRampType_t ramp, const am_time_t time);
+    std::shared_ptr<CAmRoutingAdapterALSAProxyMixer> getMixer(const ra_Proxy_s & proxy);
+    CAmRoutingAdapterALSAEngine * getEngine(const ra_domainInfo_s & domain);
+    void publishTiming(sh_timerHandle_t handle, void *userData);
+    am_Error_e setLevelNotification(const am_VolumeType_e elementType, const uint16_t elementID,
+            const am_CustomNotificationType_t peakType, const am_CustomNotificationType_t rmsType,
+            const am_NotificationConfiguration_s & config);
+    void enableLevels(const am_VolumeType_e elementType, const uint16_t elementID, const bool enable);
+    void publishLevels(sh_timerHandle_t handle, void *userData);
+    bool isCrossFading(const ra_crossfaderInfo_s & crossfader);
+    am_HotSink_e getHotSink(const ra_crossfaderInfo_s & crossfader);
+    void publishCrossFades(sh_timerHandle_t handle, void *userData);
+    std::string getProxyLibrary(const std::string & pxyNam);
+    void prepareWarmProxies(ra_domainInfo_s & domain);
+    CAmRoutingAdapterALSAProxyDefault * takeWarmProxy(const ra_Proxy_s & proxy);
+    bool parkWarmProxy(IAmRoutingAdapterALSAProxy * proxy, const ra_domainInfo_s & domain);
+    void evictWarmProxies(const ra_Proxy_s & proxy);
+    void releaseWarmProxies(const am_domainID_t domainID);
+    uint32_t countWarmProxies(const am_domainID_t domainID) const;
 
 private:
     IAmRoutingReceiverShadow  *mpShadow;
@@ -138,6 +181,49 @@ private:
     CAmSocketHandler          *mpSocketHandler;
 
     CAmRoutingAdapterALSAdb   mDataBase;
+    CAmRoutingAdapterALSAVolumeScheduler mVolumeScheduler;
+    std::map<std::string, std::weak_ptr<CAmRoutingAdapterALSAProxyMixer> > mMixers;
+    std::map<am_domainID_t, std::vector<std::shared_ptr<CAmRoutingAdapterALSAEngine> > > mEngines;
+    std::map<am_connectionID_t, am_timeSync_t> mPublishedDelays;
+    CAmRoutingAdapterALSAProxyFactory mProxyFactory;
+    std::map<am_domainID_t, std::vector<std::string> > mPreloadedLibraries;
+
+    struct ra_warmProxy_s
+    {
+        CAmRoutingAdapterALSAProxyDefault *proxy;
+        am_domainID_t domainID;
+        uint32_t format;                // Configuration the PCMs are set up with
+        uint32_t channels;
+        uint32_t rate;
+    };
+    std::vector<ra_warmProxy_s> mWarmProxies;
+    TAmShTimerCallBack<CAmRoutingAdapterALSASender> mTimingCallback;
+    sh_timerHandle_t          mTimingTimer;
+    uint32_t                  mTimingTicks;
+
+    /* Level notification of a sink or source */
+    struct ra_levelNotification_s
+    {
+        am_VolumeType_e elementType;    // VT_SINK or VT_SOURCE
+        uint16_t elementID;
+        am_CustomNotificationType_t type;
+        bool rms;                       // RMS instead of peak level
+        CAmRoutingAdapterALSALevelNotification notification;
+    };
+    std::vector<ra_levelNotification_s> mLevelNotifications;
+    TAmShTimerCallBack<CAmRoutingAdapterALSASender> mLevelCallback;
+    sh_timerHandle_t          mLevelTimer;
+
+    /* Crossfade waiting for the mixers to reach the hot sink */
+    struct ra_crossFade_s
+    {
+        am_Handle_s handle;
+        am_crossfaderID_t crossfaderID;
+        am_HotSink_e hotSink;
+    };
+    std::vector<ra_crossFade_s> mCrossFades;
+    TAmShTimerCallBack<CAmRoutingAdapterALSASender> mCrossFadeCallback;
+    sh_timerHandle_t          mCrossFadeTimer;
     std::string               mBusname;
 
 #ifdef WITH_DEVICE_DETECTOR
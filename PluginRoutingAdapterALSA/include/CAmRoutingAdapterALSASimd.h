@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#ifndef ROUTINGADAPTERALSA_SIMD_H_
+#define ROUTINGADAPTERALSA_SIMD_H_
+
+#include <stdint.h>
+
+/*
+ * Vector helpers shared by the sample processing stages of the proxies.
+ * The instruction set is selected at compile time, VEC_LEN is 0 if none of
+ * AVX2, SSE2 or NEON is available and only the plain C++ loops are used.
+ */
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#elif defined(__SSE2__)
+#  include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#  define RA_SIMD_NEON
+#endif
+
+/* biggest float below 2^31, bigger values would overflow on conversion */
+#define S32_MAX_FLOAT 2147483520.0f
+
+namespace am
+{
+namespace simd
+{
+
+#if defined(__AVX2__)
+
+#define VEC_LEN 8
+typedef __m256 vec_t;
+
+inline vec_t vecSet(const float gain) { return _mm256_set1_ps(gain); }
+inline vec_t vecMul(const vec_t a, const vec_t b) { return _mm256_mul_ps(a, b); }
+inline vec_t vecAdd(const vec_t a, const vec_t b) { return _mm256_add_ps(a, b); }
+inline vec_t vecMin(const vec_t a, const vec_t b) { return _mm256_min_ps(a, b); }
+inline vec_t vecMax(const vec_t a, const vec_t b) { return _mm256_max_ps(a, b); }
+inline float vecSum(const vec_t v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+}
+inline vec_t vecLoad(const float *p) { return _mm256_loadu_ps(p); }
+inline void vecStore(float *p, const vec_t v) { _mm256_storeu_ps(p, v); }
+inline vec_t vecLoad(const int32_t *p)
+{
+    return _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+}
+inline void vecStore(int32_t *p, const vec_t v)
+{
+    __m256i s = _mm256_cvtps_epi32(_mm256_min_ps(v, _mm256_set1_ps(S32_MAX_FLOAT)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), s);
+}
+inline vec_t vecLoad(const int16_t *p)
+{
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(s));
+}
+inline void vecStore(int16_t *p, const vec_t v)
+{
+    /* packs works per 128 bit lane, the permute collects the lower halves */
+    __m256i s = _mm256_cvtps_epi32(v);
+    s = _mm256_permute4x64_epi64(_mm256_packs_epi32(s, s), 0x08);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_castsi256_si128(s));
+}
+
+#elif defined(__SSE2__)
+
+#define VEC_LEN 4
+typedef __m128 vec_t;
+
+inline vec_t vecSet(const float gain) { return _mm_set1_ps(gain); }
+inline vec_t vecMul(const vec_t a, const vec_t b) { return _mm_mul_ps(a, b); }
+inline vec_t vecAdd(const vec_t a, const vec_t b) { return _mm_add_ps(a, b); }
+inline vec_t vecMin(const vec_t a, const vec_t b) { return _mm_min_ps(a, b); }
+inline vec_t vecMax(const vec_t a, const vec_t b) { return _mm_max_ps(a, b); }
+inline float vecSum(const vec_t v)
+{
+    __m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+}
+inline vec_t vecLoad(const float *p) { return _mm_loadu_ps(p); }
+inline void vecStore(float *p, const vec_t v) { _mm_storeu_ps(p, v); }
+inline vec_t vecLoad(const int32_t *p)
+{
+    return _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+inline void vecStore(int32_t *p, const vec_t v)
+{
+    __m128i s = _mm_cvtps_epi32(_mm_min_ps(v, _mm_set1_ps(S32_MAX_FLOAT)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), s);
+}
+inline vec_t vecLoad(const int16_t *p)
+{
+    /* sign extension by shifting the duplicated sample */
+    __m128i s = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16));
+}
+inline void vecStore(int16_t *p, const vec_t v)
+{
+    __m128i s = _mm_cvtps_epi32(v);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(s, s));
+}
+
+#elif defined(RA_SIMD_NEON)
+
+#define VEC_LEN 4
+typedef float32x4_t vec_t;
+
+inline vec_t vecSet(const float gain) { return vdupq_n_f32(gain); }
+inline vec_t vecMul(const vec_t a, const vec_t b) { return vmulq_f32(a, b); }
+inline vec_t vecAdd(const vec_t a, const vec_t b) { return vaddq_f32(a, b); }
+inline vec_t vecMin(const vec_t a, const vec_t b) { return vminq_f32(a, b); }
+inline vec_t vecMax(const vec_t a, const vec_t b) { return vmaxq_f32(a, b); }
+inline float vecSum(const vec_t v)
+{
+    float32x2_t s = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpadd_f32(s, s), 0);
+}
+inline vec_t vecLoad(const float *p) { return vld1q_f32(p); }
+inline void vecStore(float *p, const vec_t v) { vst1q_f32(p, v); }
+inline vec_t vecLoad(const int32_t *p) { return vcvtq_f32_s32(vld1q_s32(p)); }
+inline void vecStore(int32_t *p, const vec_t v) { vst1q_s32(p, vcvtq_s32_f32(v)); }
+inline vec_t vecLoad(const int16_t *p) { return vcvtq_f32_s32(vmovl_s16(vld1_s16(p))); }
+inline void vecStore(int16_t *p, const vec_t v) { vst1_s16(p, vqmovn_s32(vcvtq_s32_f32(v))); }
+
+#else
+
+#define VEC_LEN 0
+
+#endif
+
+} /* namespace simd */
+} /* namespace am */
+#endif /* ROUTINGADAPTERALSA_SIMD_H_ */
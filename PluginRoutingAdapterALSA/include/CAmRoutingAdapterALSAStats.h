@@ -0,0 +1,151 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#ifndef ROUTINGADAPTERALSA_STATS_H_
+#define ROUTINGADAPTERALSA_STATS_H_
+
+#include <atomic>
+#include <string>
+#include <stdint.h>
+
+/* buckets of a histogram, the last one covers everything above 2^(n-2) us */
+#define RA_STATS_BUCKETS 20
+
+namespace am
+{
+
+enum ra_statsHistogram_e
+{
+    RA_STATS_WAKE_JITTER,   // Deviation of the wake-up after snd_pcm_wait from the period time
+    RA_STATS_READ,          // Duration of reading one period
+    RA_STATS_WRITE,         // Duration of writing one period
+    RA_STATS_MAX
+};
+
+/**
+ * Histogram of durations in us with logarithmic buckets, bucket n counts
+ * the values from 2^(n-1) to 2^n - 1 us.
+ *
+ * Only one thread may add values, any thread may read them. No locks are
+ * taken and no memory is allocated by add().
+ */
+class CAmRoutingAdapterALSAHistogram
+{
+public:
+    CAmRoutingAdapterALSAHistogram();
+
+    /**
+     * This function clears the histogram, it must not be called while values are added.
+     */
+    void reset();
+
+    /**
+     * This function counts one value.
+     * @param[in] us    duration in us
+     */
+    void add(const uint32_t us);
+
+    uint32_t getCount() const;
+    uint32_t getMax() const;
+    uint32_t getMean() const;
+
+    /**
+     * @param[in] percent   percentile in the range of 1 to 100
+     * @returns upper bound of the bucket the percentile falls into in us
+     */
+    uint32_t getPercentile(const uint32_t percent) const;
+
+    /**
+     * @returns count, mean, 50th, 99th percentile and maximum as text
+     */
+    std::string toString() const;
+
+private:
+    std::atomic<uint32_t> mBuckets[RA_STATS_BUCKETS];
+    std::atomic<uint32_t> mCount;
+    std::atomic<uint32_t> mMax;
+    std::atomic<uint64_t> mSum;
+};
+
+/**
+ * Timing statistics of one proxy, filled by the streaming thread and read
+ * by the main loop.
+ */
+class CAmRoutingAdapterALSAStats
+{
+public:
+    CAmRoutingAdapterALSAStats();
+
+    /**
+     * This function clears all statistics, it must be called before the streaming thread runs.
+     */
+    void reset();
+
+    void add(const ra_statsHistogram_e histogram, const uint32_t us)
+    {
+        mHistograms[histogram].add(us);
+    }
+    void addXrun();
+    void addRecovery();
+
+    /**
+     * This function stores the last measured delay from capture to playback.
+     * @param[in] us    delay in us
+     */
+    void setDelay(const uint32_t us);
+
+    const CAmRoutingAdapterALSAHistogram & getHistogram(const ra_statsHistogram_e histogram) const
+    {
+        return mHistograms[histogram];
+    }
+    uint32_t getXruns() const { return mXruns.load(std::memory_order_relaxed); }
+    uint32_t getRecoveries() const { return mRecoveries.load(std::memory_order_relaxed); }
+
+    /**
+     * @returns last measured delay in us, 0 if not measured yet
+     */
+    uint32_t getDelay() const { return mDelay.load(std::memory_order_relaxed); }
+    uint32_t getMaxDelay() const { return mMaxDelay.load(std::memory_order_relaxed); }
+
+    /**
+     * @returns all statistics as one line of text
+     */
+    std::string toString() const;
+
+private:
+    CAmRoutingAdapterALSAHistogram mHistograms[RA_STATS_MAX];
+    std::atomic<uint32_t> mXruns;
+    std::atomic<uint32_t> mRecoveries;
+    std::atomic<uint32_t> mDelay;
+    std::atomic<uint32_t> mMaxDelay;
+};
+
+} /* namespace am */
+#endif /* ROUTINGADAPTERALSA_STATS_H_ */
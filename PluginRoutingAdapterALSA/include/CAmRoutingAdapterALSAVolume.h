@@ -33,8 +33,8 @@
 #define ROUTINGADAPTERALSA_VOLUME_H_
 
 #include "IAmRoutingReceiverShadow.h"
-#include "CAmRoutingAdapterThread.h"
 #include "CAmRoutingAdapterALSAMixerCtrl.h"
+#include "CAmRoutingAdapterALSAVolumeScheduler.h"
 #include <climits>
 
 #define VOL_RANGE 3000
@@ -104,23 +104,31 @@ private:
 };
 
 
-class CAmRoutingAdapterALSAVolume : private CAmRoutingAdapterALSAMixerCtrl, private CAmRoutingAdapterThread
+class CAmRoutingAdapterALSAVolume : private CAmRoutingAdapterALSAMixerCtrl, public IAmRoutingAdapterALSARamp
 {
 public:
     CAmRoutingAdapterALSAVolume(am_Handle_s handle, am_Volumes_s volumes,
             std::string pcmName, std::string volName, IAmRoutingReceive* routingInterface,
-            CAmSocketHandler* socketHandler, IAmRoutingReceiverObserver* observer);
+            CAmSocketHandler* socketHandler, IAmRoutingReceiverObserver* observer,
+            CAmRoutingAdapterALSAVolumeScheduler* scheduler,
+            std::shared_ptr<ra_mixerHandle_s> mixer = nullptr);
     ~CAmRoutingAdapterALSAVolume();
 
-    void startFading() {
-        CAmRoutingAdapterThread::startThread();
+    /* the operation is acknowledged with an error in case the ramp cannot be started */
+    int startFading() {
+        return mpScheduler->addRamp(this);
+    };
+
+    const std::string & getElementName() const override {
+        return mElementName;
     };
 
 private:
-    /* CAmRoutingAdapterThread */
-    int initThread() override;
-    int workerThread() override;
-    void deinitThread(int errInit) override;
+    /* IAmRoutingAdapterALSARamp */
+    int prepareRamp() override;
+    int executeStep() override;
+    __useconds_t getStepTime() override;
+    void finishRamp(int err) override;
 
     /* CAmRoutingAdapterALSAMixerCtrl */
     int cbVolumeChange(const long int & volume) override;
@@ -135,7 +143,9 @@ private:
     am_Handle_s mHandle;                // AM request handle
     am_Volumes_s mVolInfo;              // Volume request
     am_volume_t mCurrentVol;            // Current volume
-    IAmRoutingReceiverShadow mShadow;   // Sender class to inform thread exit
+    IAmRoutingReceiverShadow mShadow;   // Sender class to inform ramp end
+    CAmRoutingAdapterALSAVolumeScheduler *mpScheduler; // Executes the ramp steps
+    std::string mElementName;           // PCM and volume name of mixer element
 
     /* ALSA stuff */
     long int mRange;                    // Volume Range of ALSA mixer
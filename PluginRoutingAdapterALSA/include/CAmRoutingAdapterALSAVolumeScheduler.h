@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#ifndef ROUTINGADAPTERALSA_VOLUMESCHEDULER_H_
+#define ROUTINGADAPTERALSA_VOLUMESCHEDULER_H_
+
+#include <stdint.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include <utility>
+#include <pthread.h>
+#include "CAmRoutingAdapterThread.h"
+
+namespace am
+{
+
+/**
+ * Volume operation driven by CAmRoutingAdapterALSAVolumeScheduler.
+ */
+class IAmRoutingAdapterALSARamp
+{
+public:
+    virtual ~IAmRoutingAdapterALSARamp() {}
+
+    /** Name of the mixer element, only one ramp at a time may drive it */
+    virtual const std::string & getElementName() const = 0;
+    /** Calculates the ramp from the current level, returns 0 on success */
+    virtual int prepareRamp() = 0;
+    /** Executes the next step, returns 0 as long as steps are left */
+    virtual int executeStep() = 0;
+    /** Time until the next step */
+    virtual __useconds_t getStepTime() = 0;
+    /** Reports the end of the ramp with the last result, called without any scheduler lock held */
+    virtual void finishRamp(int err) = 0;
+};
+
+/**
+ * Drives the volume ramps of all mixer elements from a single real-time thread.
+ *
+ * The ramp steps of all active volumes are kept in a heap ordered by their
+ * absolute deadline. A timerfd armed on the earliest deadline wakes up the
+ * thread, which takes every step being due from the heap, executes them
+ * without holding the lock and re-arms the timer. Because
+ * the deadlines are absolute, the sleep time is not accumulated from step to
+ * step. A ramp which is started for a mixer element that is still fading
+ * replaces the running one; the new ramp starts from the current level.
+ */
+class CAmRoutingAdapterALSAVolumeScheduler : private CAmRoutingAdapterThread
+{
+public:
+    CAmRoutingAdapterALSAVolumeScheduler();
+    ~CAmRoutingAdapterALSAVolumeScheduler();
+
+    /**
+     * This function calculates the ramp of the given volume and schedules its first step.
+     * A ramp running on the same mixer element will be aborted. The thread is started on first use
+     * and again after it ended on an error, which also ends all ramps it was driving.
+     * If the ramp cannot be prepared or the thread cannot be started, the ramp is finished
+     * with the error before this function returns.
+     * @param[in] volume    volume operation to be executed
+     * @returns 0 on success otherwise <0
+     */
+    int addRamp(IAmRoutingAdapterALSARamp* volume);
+
+    /**
+     * This function removes the ramp of the given volume from the schedule. In case the ramp
+     * is just being finished by the scheduler thread, it waits until finishRamp() returned.
+     * @param[in] volume    volume operation to be removed
+     * @returns true in case the ramp was still running
+     */
+    bool removeRamp(const IAmRoutingAdapterALSARamp* volume);
+
+private:
+    /* CAmRoutingAdapterThread */
+    int initThread() override;
+    int workerThread() override;
+    void deinitThread(int errInit) override;
+
+private:
+    struct ra_rampEntry_s
+    {
+        uint64_t deadline;                  // Absolute time of next step in ns
+        IAmRoutingAdapterALSARamp *pVolume;
+        uint32_t steps;                     // Executed steps
+        uint64_t sumLate;                   // Accumulated wake-up delay in ns
+        uint64_t maxLate;                   // Worst wake-up delay in ns
+        int result;                         // Result of the last step
+
+        bool operator>(const ra_rampEntry_s & other) const
+        {
+            return deadline > other.deadline;
+        }
+    };
+
+    void takeDueSteps();
+    void rescheduleSteps();
+    void finishRamps();
+    size_t getRampCount() const;
+    void armTimer();
+    static uint64_t getTime();
+
+    std::vector<ra_rampEntry_s> mRamps;    // Min heap ordered by deadline
+    std::vector<ra_rampEntry_s> mDue;      // Ramps to be stepped outside the lock
+    std::vector<std::pair<IAmRoutingAdapterALSARamp*, int> > mFinished; // Ramps to be finished outside the lock
+    pthread_mutex_t mMtx;
+    pthread_cond_t mCond;                  // Signals that mDue or mFinished has been processed
+    int mTimerFd;
+    int mEventFd;
+    bool mStarted;                         // Thread running or being started, protected by mMtx
+    volatile bool mStop;
+};
+
+} /* namespace am */
+
+#endif /* ROUTINGADAPTERALSA_VOLUMESCHEDULER_H_ */
@@ -34,11 +34,15 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <tuple>
 #include <sstream>
 #include <algorithm>
 #include "audiomanagertypes.h"
 #include "CAmRoutingAdapterALSAProxyInfo.h"
+#include "CAmRoutingAdapterALSAMixerCache.h"
+#include "CAmRoutingAdapterALSAdbIndex.h"
 
 namespace am
 {
@@ -88,6 +92,12 @@ const std::map<std::string, am_MuteState_e> am_msMap = {
     { "2", MS_UNMUTED},
 };
 
+const std::map<std::string, am_HotSink_e> am_hsMap = {
+    { "1", HS_SINKA },
+    { "2", HS_SINKB },
+    { "3", HS_INTERMEDIATE },
+};
+
 enum SoundPropertyVisibility
 {
     SPV_NONE = 0, /* reads as standard, that is, only listSoundProperty will be filled */
@@ -187,6 +197,8 @@ public:
     std::string domNam;
     std::string pcmNam;
     std::string volNam;
+    am_CustomNotificationType_t peakNtfType = NT_UNKNOWN;  // Notification of the peak level, NT_UNKNOWN if not supported
+    am_CustomNotificationType_t rmsNtfType = NT_UNKNOWN;   // Notification of the RMS level, NT_UNKNOWN if not supported
 
     /**
      * std::map for resource of type Source associating (type, value) of tPROPERTYSPEC XML Child Node against mixer_i, value_i collection
@@ -225,6 +237,8 @@ public:
     std::string domNam;
     std::string pcmNam;
     std::string volNam;
+    am_CustomNotificationType_t peakNtfType = NT_UNKNOWN;  // Notification of the peak level, NT_UNKNOWN if not supported
+    am_CustomNotificationType_t rmsNtfType = NT_UNKNOWN;   // Notification of the RMS level, NT_UNKNOWN if not supported
 
     /**
      * std::map for resource of type Sink associating (type, value) of tPROPERTYSPEC XML Child Node against mixer_i, value_i collection
@@ -280,6 +294,18 @@ public:
     };
 };
 
+/**
+ *  Crossfader specific info, sink A and sink B have to be mixed by the same proxy
+ */
+struct ra_crossfaderInfo_s
+{
+public:
+    am_Crossfader_s amInfo;
+    std::string sinkNamA;
+    std::string sinkNamB;
+    std::string srcNam;
+};
+
 /**
  * Struct providing details on USB management in Audio Manager acception
  */
@@ -302,8 +328,11 @@ public:
     std::vector<ra_sourceInfo_s> lSourceInfo;
     std::vector<ra_sinkInfo_s> lSinkInfo;
     std::vector<ra_gatewayInfo_s> lGatewayInfo;
+    std::vector<ra_crossfaderInfo_s> lCrossfaderInfo;
     std::vector<ra_proxyInfo_s> lProxyInfo;
     std::string pxyNam;
+    uint32_t maxWarmProxies = 0;
+    int32_t engineThreads = 0;      // Engines streaming the default proxies, <0 for one per CPU
 
 public:
     ra_domainInfo_s() {};
@@ -349,6 +378,10 @@ public:
      * Registers Gateway to Audio Manager
      */
     virtual void registerGateway(ra_gatewayInfo_s & info, am_domainID_t domainID) = 0;
+    /**
+     * Registers Crossfader to Audio Manager
+     */
+    virtual void registerCrossfader(ra_crossfaderInfo_s & info, am_domainID_t domainID) = 0;
     /**
      * Sends to AudioManager when a Domain Registration is finished
      */
@@ -391,6 +424,8 @@ public:
                                                     const am_sourceID_t sourceID);
     ra_sinkInfo_s   * findSink(const am_sinkID_t id);
     ra_sourceInfo_s * findSource(const am_sourceID_t id);
+    ra_crossfaderInfo_s * findCrossfader(const am_crossfaderID_t id);
+    ra_crossfaderInfo_s * findCrossfaderOfSink(const am_sinkID_t id);
 
     void setUSBInfo(ra_USBInfo_s &usbInfo)
     {
@@ -447,11 +482,31 @@ public:
                             const am_RoutingElement_s & elements, class IAmRoutingAdapterALSAProxy * proxy);
     class IAmRoutingAdapterALSAProxy * getProxyOfConnection(const am_connectionID_t connectionId);
     void getProxyLists(std::vector<class IAmRoutingAdapterALSAProxy*> & proxies);
+    void getConnectionProxies(std::vector<std::pair<am_connectionID_t, class IAmRoutingAdapterALSAProxy*> > & proxies);
+    void getProxiesOfElement(const am_sourceID_t sourceID, const am_sinkID_t sinkID,
+            std::vector<std::pair<am_RoutingElement_s, class IAmRoutingAdapterALSAProxy*> > & proxies);
+    bool isSoftVolume(const am_sourceID_t sourceID, const am_sinkID_t sinkID);
     void deregisterConnection(const am_connectionID_t connectionId);
 
     void updateProxys(ra_domainInfo_s & data);
     void updateGateways(ra_domainInfo_s & data);
 
+    /* volume ramps change the range of their element, so they keep mixers of their own */
+    CAmRoutingAdapterALSAMixerCache & getPropertyMixers()
+    {
+        return mPropertyMixers;
+    }
+
+    CAmRoutingAdapterALSAMixerCache & getVolumeMixers()
+    {
+        return mVolumeMixers;
+    }
+
+    void invalidateMixers();
+
+    /* has to be called after sources, sinks or proxies were added or removed outside of this class */
+    void invalidateIndices();
+
 private:
     uint32_t maxValue(std::vector<uint32_t>::const_iterator itr, std::vector<uint32_t>::const_iterator end);
 
@@ -468,8 +523,12 @@ private:
     std::map<am_connectionID_t, ra_route_s>                 mMapConnectionIDRoute;
     std::map<uint16_t, std::vector<class CAmRoutingAdapterALSAVolume*> >  mMapAsyncOperations;
     std::vector<ra_domainInfo_s>                            mDomains;
+    CAmRoutingAdapterALSAdbIndex                            mIndex;
+    std::unordered_map<uint32_t, std::set<am_connectionID_t> > mSourceConnections;    // domainID << 16 | sourceID
     IAmRoutingAdapterDbObserver                                           *mpObserver;
     ra_USBInfo_s                                            mUSB;
+    CAmRoutingAdapterALSAMixerCache                         mPropertyMixers;
+    CAmRoutingAdapterALSAMixerCache                         mVolumeMixers;
 };
 
 }/* namespace am */
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#ifndef ROUTINGADAPTERALSA_DBINDEX_H_
+#define ROUTINGADAPTERALSA_DBINDEX_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "audiomanagertypes.h"
+
+namespace am
+{
+
+struct ra_domainInfo_s;
+struct ra_sourceInfo_s;
+struct ra_sinkInfo_s;
+struct ra_proxyInfo_s;
+
+/**
+ * Hash indices over the domains of CAmRoutingAdapterALSAdb.
+ *
+ * The indices point into the element vectors of the domains. They have to be
+ * invalidated whenever a domain, source, sink or proxy is added or removed or
+ * an ID is assigned, and are rebuilt with the next lookup. Like the linear
+ * search they replace, an ID or name configured twice finds the first element.
+ */
+class CAmRoutingAdapterALSAdbIndex
+{
+public:
+    CAmRoutingAdapterALSAdbIndex(std::vector<ra_domainInfo_s> & domains);
+
+    /**
+     * This function marks the indices to be rebuilt with the next lookup.
+     */
+    void invalidate();
+
+    ra_domainInfo_s * findDomain(const am_domainID_t id);
+    ra_domainInfo_s * findDomain(const std::string & name);
+
+    /**
+     * These functions find a source or sink of any domain.
+     * @param[in] id or name    key of the element
+     * @param[out] ppDomain     domain of the element, if not NULL
+     * @returns the element or NULL
+     */
+    ra_sourceInfo_s * findSource(const am_sourceID_t id, ra_domainInfo_s ** ppDomain = NULL);
+    ra_sourceInfo_s * findSource(const std::string & name, ra_domainInfo_s ** ppDomain = NULL);
+    ra_sinkInfo_s * findSink(const am_sinkID_t id, ra_domainInfo_s ** ppDomain = NULL);
+    ra_sinkInfo_s * findSink(const std::string & name, ra_domainInfo_s ** ppDomain = NULL);
+
+    /**
+     * These functions find the proxy of a route in the given domain. A proxy
+     * configured without sink matches all sinks, an empty sink name matches
+     * the first proxy of the source. Of several matching proxies the first
+     * one in configuration order is returned, no matter if it names the sink.
+     * @returns the proxy or NULL
+     */
+    ra_proxyInfo_s * findProxy(const ra_domainInfo_s * pDomain, const am_sourceID_t sourceID,
+                               const am_sinkID_t sinkID);
+    ra_proxyInfo_s * findProxy(const ra_domainInfo_s * pDomain, const std::string & srcNam,
+                               const std::string & sinkNam);
+
+private:
+    template <typename T> struct ra_entry_s
+    {
+        ra_domainInfo_s *pDomain;
+        T *pElement;
+    };
+
+    struct ra_domainIndex_s
+    {
+        std::unordered_map<uint32_t, ra_proxyInfo_s*> proxyByIDs;           // sourceID << 16 | sinkID
+        std::unordered_map<std::string, ra_proxyInfo_s*> proxyBySrcNam;
+        std::unordered_map<std::string, ra_proxyInfo_s*> proxyByNames;     // srcNam '\n' sinkNam
+    };
+
+    void update();
+    ra_domainIndex_s * getDomainIndex(const ra_domainInfo_s * pDomain);
+    template <typename K, typename T>
+    static T * findEntry(const std::unordered_map<K, ra_entry_s<T> > & index, const K & key,
+                         ra_domainInfo_s ** ppDomain);
+
+    std::vector<ra_domainInfo_s> & mDomains;
+    bool mValid;
+    std::unordered_map<am_domainID_t, ra_domainInfo_s*> mDomainByID;
+    std::unordered_map<std::string, ra_domainInfo_s*> mDomainByName;
+    std::unordered_map<am_sourceID_t, ra_entry_s<ra_sourceInfo_s> > mSourceByID;
+    std::unordered_map<std::string, ra_entry_s<ra_sourceInfo_s> > mSourceByName;
+    std::unordered_map<am_sinkID_t, ra_entry_s<ra_sinkInfo_s> > mSinkByID;
+    std::unordered_map<std::string, ra_entry_s<ra_sinkInfo_s> > mSinkByName;
+    std::vector<ra_domainIndex_s> mDomainIndices;   // Same order as mDomains
+};
+
+} /* namespace am */
+
+#endif /* ROUTINGADAPTERALSA_DBINDEX_H_ */
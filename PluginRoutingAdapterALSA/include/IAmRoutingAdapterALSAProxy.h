@@ -32,6 +32,7 @@
 #ifndef ROUTINGADAPTERALSAPROXY_H_
 #define ROUTINGADAPTERALSAPROXY_H_
 
+#include <string>
 #include "audiomanagertypes.h"
 #include "CAmRoutingAdapterALSAProxyInfo.h"
 
@@ -55,6 +56,89 @@ public:
     virtual am_Error_e stopStreaming() = 0;
     virtual am_Error_e closeStreaming() = 0;
 
+    /**
+     * Changes the volume applied in software on the streamed data.
+     * Proxies not supporting this keep the default implementation.
+     */
+    virtual am_Error_e setVolume(const am_volume_t volume, const am_CustomRampType_t ramp, const am_time_t time)
+    {
+        (void)volume;
+        (void)ramp;
+        (void)time;
+        return E_NOT_POSSIBLE;
+    }
+
+    /**
+     * Provides the timing statistics of the streaming as text.
+     * Proxies not supporting this keep the default implementation.
+     */
+    virtual am_Error_e getStatistics(std::string & stats) const
+    {
+        stats.clear();
+        return E_NOT_POSSIBLE;
+    }
+
+    /**
+     * Switches the level measurement of the streamed data on or off. VT_SOURCE
+     * measures the captured data, VT_SINK the data written to the playback.
+     * Proxies not supporting this keep the default implementation.
+     */
+    virtual am_Error_e enableLevel(const am_VolumeType_e type, const bool enable)
+    {
+        (void)type;
+        (void)enable;
+        return E_NOT_POSSIBLE;
+    }
+
+    /**
+     * Provides the highest peak and period RMS level in 0.1 dBFS since the last call.
+     * Proxies not supporting this keep the default implementation.
+     */
+    virtual am_Error_e getLevel(const am_VolumeType_e type, am_volume_t & peak, am_volume_t & rms)
+    {
+        (void)type;
+        peak = AM_MUTE;
+        rms = AM_MUTE;
+        return E_NOT_POSSIBLE;
+    }
+
+    /**
+     * Fades the streamed data of a crossfader sink in or out against the other sink.
+     * Proxies not supporting this keep the default implementation.
+     */
+    virtual am_Error_e crossFade(const am_HotSink_e hotSink, const am_CustomRampType_t ramp, const am_time_t time)
+    {
+        (void)hotSink;
+        (void)ramp;
+        (void)time;
+        return E_NOT_POSSIBLE;
+    }
+
+    /**
+     * Tells if a fade started by crossFade() is still running.
+     */
+    virtual bool isCrossFading() const
+    {
+        return false;
+    }
+
+    /**
+     * Tells if crossFade() would be accepted, so that all proxies of a crossfader
+     * can be checked before any of them starts fading.
+     */
+    virtual bool canCrossFade() const
+    {
+        return false;
+    }
+
+    /**
+     * @returns hot sink reached by the streamed data or HS_UNKNOWN if the proxy does not crossfade
+     */
+    virtual am_HotSink_e getHotSink() const
+    {
+        return HS_UNKNOWN;
+    }
+
     void *getLibHandle()
     {
         return libHandle;
@@ -0,0 +1,370 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#include <math.h>
+#include <string.h>
+#include <errno.h>
+#include <algorithm>
+#include <alsa/asoundlib.h>
+#include "CAmRoutingAdapterALSAConverter.h"
+#include "CAmRoutingAdapterALSASimd.h"
+
+using namespace am;
+using namespace am::simd;
+
+/* taps of each filter phase, a multiple of the vector length */
+#define RA_CONV_TAPS 32
+/* limits the size of the filter for rates without a small common divisor */
+#define RA_CONV_MAX_PHASES 1024
+/* cutoff frequency relative to the Nyquist frequency of the lower rate */
+#define RA_CONV_CUTOFF 0.85
+
+namespace
+{
+
+inline uint32_t gcd(uint32_t a, uint32_t b)
+{
+    while (b != 0)
+    {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+inline bool isSupported(const uint32_t format)
+{
+    return ((format == SND_PCM_FORMAT_S16_LE) || (format == SND_PCM_FORMAT_S32_LE) ||
+            (format == SND_PCM_FORMAT_FLOAT_LE));
+}
+
+inline float dot(const float *a, const float *b, const size_t samples)
+{
+    size_t i = 0;
+    float sum = 0.0f;
+#if VEC_LEN > 0
+    const size_t blocks = samples - samples % VEC_LEN;
+    vec_t acc = vecSet(0.0f);
+    for (; i < blocks; i += VEC_LEN)
+    {
+        acc = vecAdd(acc, vecMul(vecLoad(a + i), vecLoad(b + i)));
+    }
+    sum = vecSum(acc);
+#endif
+    for (; i < samples; ++i)
+    {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+template <typename T>
+inline void convertToFloat(const T *input, float *output, const size_t samples, const float scale)
+{
+    size_t i = 0;
+#if VEC_LEN > 0
+    const vec_t vScale = vecSet(scale);
+    for (; i + VEC_LEN <= samples; i += VEC_LEN)
+    {
+        vecStore(output + i, vecMul(vecLoad(input + i), vScale));
+    }
+#endif
+    for (; i < samples; ++i)
+    {
+        output[i] = input[i] * scale;
+    }
+}
+
+template <typename T>
+inline void convertFromFloat(const float *input, T *output, const size_t samples, const float scale,
+        const float max)
+{
+    size_t i = 0;
+#if VEC_LEN > 0
+    const vec_t vScale = vecSet(scale);
+    const vec_t vMin = vecSet(-1.0f);
+    const vec_t vMax = vecSet(1.0f);
+    for (; i + VEC_LEN <= samples; i += VEC_LEN)
+    {
+        vecStore(output + i, vecMul(vecMin(vecMax(vecLoad(input + i), vMin), vMax), vScale));
+    }
+#endif
+    for (; i < samples; ++i)
+    {
+        float value = roundf(input[i] * scale);
+        output[i] = static_cast<T>(std::max(-scale, std::min(max, value)));
+    }
+}
+
+} /* namespace */
+
+CAmRoutingAdapterALSAConverter::CAmRoutingAdapterALSAConverter()
+    : mSrcFormat(SND_PCM_FORMAT_UNKNOWN)
+    , mSrcChannels(0)
+    , mSrcRate(0)
+    , mDstFormat(SND_PCM_FORMAT_UNKNOWN)
+    , mDstChannels(0)
+    , mDstRate(0)
+    , mFrames(0)
+    , mUp(1)
+    , mDown(1)
+    , mPhase(0)
+    , mPos(0)
+{
+}
+
+int CAmRoutingAdapterALSAConverter::setup(const uint32_t srcFormat, const uint32_t srcChannels, const uint32_t srcRate,
+        const uint32_t dstFormat, const uint32_t dstChannels, const uint32_t dstRate, const size_t frames)
+{
+    if (!isSupported(srcFormat) || !isSupported(dstFormat) || !srcChannels || !dstChannels || !srcRate || !dstRate)
+    {
+        return -EINVAL;
+    }
+
+    uint32_t div = gcd(srcRate, dstRate);
+    if ((dstRate / div) > RA_CONV_MAX_PHASES)
+    {
+        return -ERANGE;
+    }
+
+    mSrcFormat = srcFormat;
+    mSrcChannels = srcChannels;
+    mSrcRate = srcRate;
+    mDstFormat = dstFormat;
+    mDstChannels = dstChannels;
+    mDstRate = dstRate;
+    mFrames = frames;
+    mUp = dstRate / div;
+    mDown = srcRate / div;
+    mPhase = 0;
+    mPos = 0;
+
+    /*
+     * Channel c is mapped to channel c modulo the channels of the other side,
+     * a downmix averages all capture channels ending up in the same channel.
+     */
+    mMatrix.assign(mDstChannels * mSrcChannels, 0.0f);
+    for (uint32_t d = 0; d < mDstChannels; ++d)
+    {
+        uint32_t count = 0;
+        for (uint32_t s = 0; s < mSrcChannels; ++s)
+        {
+            if ((mDstChannels >= mSrcChannels) ? (d % mSrcChannels == s) : (s % mDstChannels == d))
+            {
+                mMatrix[d * mSrcChannels + s] = 1.0f;
+                count++;
+            }
+        }
+        for (uint32_t s = 0; s < mSrcChannels; ++s)
+        {
+            mMatrix[d * mSrcChannels + s] /= count;
+        }
+    }
+
+    mInput.assign(mFrames * mSrcChannels, 0.0f);
+    mOutput.assign(getMaxOutputFrames() * mDstChannels, 0.0f);
+    if (mUp != mDown)
+    {
+        mHistory.assign((RA_CONV_TAPS - 1 + mFrames) * mDstChannels, 0.0f);
+        designFilter();
+    }
+    else
+    {
+        mHistory.clear();
+        mCoeffs.clear();
+    }
+    return 0;
+}
+
+size_t CAmRoutingAdapterALSAConverter::getMaxOutputFrames() const
+{
+    return (mFrames * mUp + mDown - 1) / mDown + 1;
+}
+
+uint32_t CAmRoutingAdapterALSAConverter::getDelay() const
+{
+    if (mUp == mDown)
+    {
+        return 0;
+    }
+    return ((RA_CONV_TAPS / 2) * 1000 + mSrcRate - 1) / mSrcRate;
+}
+
+void CAmRoutingAdapterALSAConverter::designFilter()
+{
+    /*
+     * Blackman windowed sinc at the rate of the interpolated signal,
+     * split into mUp phases of RA_CONV_TAPS coefficients.
+     */
+    const size_t length = mUp * RA_CONV_TAPS;
+    const double center = (length - 1) / 2.0;
+    const double cutoff = RA_CONV_CUTOFF * 0.5 / std::max(mUp, mDown);
+    std::vector<double> proto(length);
+    for (size_t n = 0; n < length; ++n)
+    {
+        double x = 2.0 * cutoff * (n - center);
+        double sinc = (x == 0.0) ? 1.0 : sin(M_PI * x) / (M_PI * x);
+        double window = 0.42 - 0.5 * cos(2.0 * M_PI * n / (length - 1)) + 0.08 * cos(4.0 * M_PI * n / (length - 1));
+        proto[n] = sinc * window;
+    }
+
+    /* coefficients are reversed to run the dot product over the ascending history */
+    mCoeffs.assign(length, 0.0f);
+    for (uint32_t phase = 0; phase < mUp; ++phase)
+    {
+        double sum = 0.0;
+        for (uint32_t k = 0; k < RA_CONV_TAPS; ++k)
+        {
+            sum += proto[phase + k * mUp];
+        }
+        for (uint32_t k = 0; k < RA_CONV_TAPS; ++k)
+        {
+            /* each phase gets a DC gain of one */
+            mCoeffs[phase * RA_CONV_TAPS + (RA_CONV_TAPS - 1 - k)] = static_cast<float>(proto[phase + k * mUp] / sum);
+        }
+    }
+}
+
+void CAmRoutingAdapterALSAConverter::mixChannels(const float *input, const size_t frames)
+{
+    if (mUp == mDown)
+    {
+        for (size_t f = 0; f < frames; ++f)
+        {
+            for (uint32_t d = 0; d < mDstChannels; ++d)
+            {
+                mOutput[f * mDstChannels + d] = dot(&mMatrix[d * mSrcChannels], &input[f * mSrcChannels], mSrcChannels);
+            }
+        }
+        return;
+    }
+
+    /* planar behind the history of each channel for the resampler */
+    const size_t stride = RA_CONV_TAPS - 1 + mFrames;
+    for (uint32_t d = 0; d < mDstChannels; ++d)
+    {
+        float *pHistory = &mHistory[d * stride + RA_CONV_TAPS - 1];
+        const float *pMatrix = &mMatrix[d * mSrcChannels];
+        for (size_t f = 0; f < frames; ++f)
+        {
+            pHistory[f] = dot(pMatrix, &input[f * mSrcChannels], mSrcChannels);
+        }
+    }
+}
+
+size_t CAmRoutingAdapterALSAConverter::resample(const size_t frames)
+{
+    const size_t stride = RA_CONV_TAPS - 1 + mFrames;
+    size_t out = 0;
+    while (mPos < frames)
+    {
+        const float *pCoeffs = &mCoeffs[mPhase * RA_CONV_TAPS];
+        for (uint32_t d = 0; d < mDstChannels; ++d)
+        {
+            mOutput[out * mDstChannels + d] = dot(pCoeffs, &mHistory[d * stride + mPos], RA_CONV_TAPS);
+        }
+        out++;
+        mPhase += mDown;
+        mPos += mPhase / mUp;
+        mPhase %= mUp;
+    }
+    mPos -= frames;
+
+    for (uint32_t d = 0; d < mDstChannels; ++d)
+    {
+        float *pHistory = &mHistory[d * stride];
+        memmove(pHistory, pHistory + frames, (RA_CONV_TAPS - 1) * sizeof(float));
+    }
+    return out;
+}
+
+size_t CAmRoutingAdapterALSAConverter::process(const void *input, const size_t frames, void *output)
+{
+    size_t inFrames = std::min(frames, mFrames);
+    size_t outFrames = inFrames;
+
+    const float *pInput = static_cast<const float*>(input);
+    if (mSrcFormat == SND_PCM_FORMAT_S16_LE)
+    {
+        toFloat(static_cast<const int16_t*>(input), mInput.data(), inFrames * mSrcChannels);
+        pInput = mInput.data();
+    }
+    else if (mSrcFormat == SND_PCM_FORMAT_S32_LE)
+    {
+        toFloat(static_cast<const int32_t*>(input), mInput.data(), inFrames * mSrcChannels);
+        pInput = mInput.data();
+    }
+
+    const float *pOutput = pInput;
+    if ((mUp != mDown) || (mSrcChannels != mDstChannels))
+    {
+        mixChannels(pInput, inFrames);
+        if (mUp != mDown)
+        {
+            outFrames = resample(inFrames);
+        }
+        pOutput = mOutput.data();
+    }
+
+    if (mDstFormat == SND_PCM_FORMAT_S16_LE)
+    {
+        fromFloat(pOutput, static_cast<int16_t*>(output), outFrames * mDstChannels);
+    }
+    else if (mDstFormat == SND_PCM_FORMAT_S32_LE)
+    {
+        fromFloat(pOutput, static_cast<int32_t*>(output), outFrames * mDstChannels);
+    }
+    else if (pOutput != output)
+    {
+        memcpy(output, pOutput, outFrames * mDstChannels * sizeof(float));
+    }
+    return outFrames;
+}
+
+void CAmRoutingAdapterALSAConverter::toFloat(const int16_t *input, float *output, const size_t samples)
+{
+    convertToFloat(input, output, samples, 1.0f / 32768.0f);
+}
+
+void CAmRoutingAdapterALSAConverter::toFloat(const int32_t *input, float *output, const size_t samples)
+{
+    convertToFloat(input, output, samples, 1.0f / 2147483648.0f);
+}
+
+void CAmRoutingAdapterALSAConverter::fromFloat(const float *input, int16_t *output, const size_t samples)
+{
+    convertFromFloat(input, output, samples, 32768.0f, 32767.0f);
+}
+
+void CAmRoutingAdapterALSAConverter::fromFloat(const float *input, int32_t *output, const size_t samples)
+{
+    convertFromFloat(input, output, samples, 2147483648.0f, S32_MAX_FLOAT);
+}
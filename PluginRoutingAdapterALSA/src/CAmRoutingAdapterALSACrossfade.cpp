@@ -0,0 +1,277 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#include <math.h>
+#include <errno.h>
+#include <alsa/asoundlib.h>
+#include "CAmRoutingAdapterALSACrossfade.h"
+#include "CAmRoutingAdapterALSAGain.h"
+
+using namespace am;
+
+namespace
+{
+
+float hotSinkToPosition(const am_HotSink_e hotSink)
+{
+    switch (hotSink)
+    {
+        case HS_SINKB:
+            return 1.0f;
+        case HS_INTERMEDIATE:
+            return 0.5f;
+        default:
+            return 0.0f;
+    }
+}
+
+am_HotSink_e positionToHotSink(const float position)
+{
+    if (position <= 0.0f)
+    {
+        return HS_SINKA;
+    }
+    if (position >= 1.0f)
+    {
+        return HS_SINKB;
+    }
+    return HS_INTERMEDIATE;
+}
+
+template <typename T> void scaleSide(T *buffer, const float *envelope, const float gain, const size_t samples)
+{
+    if (envelope)
+    {
+        CAmRoutingAdapterALSAGain::scale(buffer, envelope, samples);
+    }
+    else if (gain != 1.0f)
+    {
+        CAmRoutingAdapterALSAGain::scale(buffer, gain, samples);
+    }
+}
+
+} /* namespace */
+
+CAmRoutingAdapterALSACrossfade::CAmRoutingAdapterALSACrossfade()
+    : mFormat(SND_PCM_FORMAT_UNKNOWN), mChannels(0), mRate(0), mFrames(0), mpEnvelopeA(NULL), mpEnvelopeB(NULL),
+      mPending(false), mTargetHotSink(HS_SINKA), mTargetRamp(RAMP_GENIVI_DIRECT), mTargetTime(0), mFading(false),
+      mHotSink(HS_SINKA), mEnvelope(false), mLinear(false), mPosition(0.0f), mBegPos(0.0f), mEndPos(0.0f),
+      mRampFrames(0), mRampPos(0)
+{
+    pthread_mutex_init(&mMtx, NULL);
+}
+
+CAmRoutingAdapterALSACrossfade::~CAmRoutingAdapterALSACrossfade()
+{
+    delete[] mpEnvelopeA;
+    delete[] mpEnvelopeB;
+    pthread_mutex_destroy(&mMtx);
+}
+
+int CAmRoutingAdapterALSACrossfade::setup(const uint32_t format, const uint32_t channels, const uint32_t rate,
+        const size_t frames)
+{
+    if ((format != SND_PCM_FORMAT_S16_LE) && (format != SND_PCM_FORMAT_S32_LE) &&
+        (format != SND_PCM_FORMAT_FLOAT_LE))
+    {
+        mFormat = SND_PCM_FORMAT_UNKNOWN;
+        return -EINVAL;
+    }
+
+    delete[] mpEnvelopeA;
+    delete[] mpEnvelopeB;
+    mpEnvelopeA = new float[frames * channels];
+    mpEnvelopeB = new float[frames * channels];
+    mFormat = format;
+    mChannels = channels;
+    mRate = rate;
+    mFrames = frames;
+    return 0;
+}
+
+void CAmRoutingAdapterALSACrossfade::setTarget(const am_HotSink_e hotSink, const am_CustomRampType_t ramp,
+        const am_time_t time)
+{
+    pthread_mutex_lock(&mMtx);
+    mTargetHotSink = hotSink;
+    mTargetRamp = ramp;
+    mTargetTime = time;
+    mPending = true;
+    /* set under the lock, the streaming thread clears it only without a pending target */
+    mFading = true;
+    pthread_mutex_unlock(&mMtx);
+}
+
+void CAmRoutingAdapterALSACrossfade::advance(const size_t frames)
+{
+    mEnvelope = false;
+    if ((mFormat == static_cast<uint32_t>(SND_PCM_FORMAT_UNKNOWN)) || (frames > mFrames))
+    {
+        return;
+    }
+
+    /* take over a new target without ever waiting for the requester */
+    if (pthread_mutex_trylock(&mMtx) == 0)
+    {
+        if (mPending)
+        {
+            startFade();
+            mPending = false;
+        }
+        else if (mFading && (mRampPos >= mRampFrames))
+        {
+            /* the last period of the fade has been applied */
+            mHotSink = positionToHotSink(mPosition);
+            mFading = false;
+        }
+        pthread_mutex_unlock(&mMtx);
+    }
+
+    if (mRampPos < mRampFrames)
+    {
+        calcEnvelopes(frames);
+        mEnvelope = true;
+    }
+}
+
+void CAmRoutingAdapterALSACrossfade::apply(const am_HotSink_e side, void *buffer, const size_t frames) const
+{
+    if ((mFormat == static_cast<uint32_t>(SND_PCM_FORMAT_UNKNOWN)) || (frames > mFrames) ||
+        ((side != HS_SINKA) && (side != HS_SINKB)))
+    {
+        return;
+    }
+
+    const float *pEnvelope = NULL;
+    float gainA = 1.0f;
+    float gainB = 1.0f;
+    if (mEnvelope)
+    {
+        pEnvelope = (side == HS_SINKA) ? mpEnvelopeA : mpEnvelopeB;
+    }
+    else
+    {
+        calcGains(mPosition, mLinear, gainA, gainB);
+    }
+
+    float gain = (side == HS_SINKA) ? gainA : gainB;
+    size_t samples = frames * mChannels;
+    switch (mFormat)
+    {
+        case SND_PCM_FORMAT_S16_LE:
+            scaleSide(static_cast<int16_t*>(buffer), pEnvelope, gain, samples);
+            break;
+        case SND_PCM_FORMAT_S32_LE:
+            scaleSide(static_cast<int32_t*>(buffer), pEnvelope, gain, samples);
+            break;
+        default:
+            scaleSide(static_cast<float*>(buffer), pEnvelope, gain, samples);
+            break;
+    }
+}
+
+bool CAmRoutingAdapterALSACrossfade::isFading() const
+{
+    return mFading;
+}
+
+am_HotSink_e CAmRoutingAdapterALSACrossfade::getHotSink() const
+{
+    return static_cast<am_HotSink_e>(mHotSink.load());
+}
+
+void CAmRoutingAdapterALSACrossfade::calcGains(const float position, const bool linear, float & gainA,
+        float & gainB)
+{
+    if (position <= 0.0f)
+    {
+        gainA = 1.0f;
+        gainB = 0.0f;
+    }
+    else if (position >= 1.0f)
+    {
+        gainA = 0.0f;
+        gainB = 1.0f;
+    }
+    else if (linear)
+    {
+        gainA = 1.0f - position;
+        gainB = position;
+    }
+    else
+    {
+        gainA = cosf(position * static_cast<float>(M_PI_2));
+        gainB = sinf(position * static_cast<float>(M_PI_2));
+    }
+}
+
+void CAmRoutingAdapterALSACrossfade::startFade()
+{
+    /* a running fade is retargeted from the position reached so far */
+    mBegPos = mPosition;
+    mEndPos = hotSinkToPosition(mTargetHotSink);
+    mLinear = (mTargetRamp == RAMP_GENIVI_LINEAR);
+    mRampFrames = (static_cast<size_t>(mTargetTime) * mRate) / 1000;
+    mRampPos = 0;
+    mHotSink = HS_INTERMEDIATE;
+    if ((mTargetRamp == RAMP_GENIVI_DIRECT) || (mRampFrames == 0))
+    {
+        mPosition = mEndPos;
+        mRampFrames = 0;
+    }
+}
+
+void CAmRoutingAdapterALSACrossfade::calcEnvelopes(const size_t frames)
+{
+    float *pEnvelopeA = mpEnvelopeA;
+    float *pEnvelopeB = mpEnvelopeB;
+    for (size_t frame = 0; frame < frames; ++frame)
+    {
+        if (mRampPos < mRampFrames)
+        {
+            mRampPos++;
+            mPosition = mBegPos + (mEndPos - mBegPos) * (static_cast<float>(mRampPos) / mRampFrames);
+        }
+
+        float gainA;
+        float gainB;
+        calcGains(mPosition, mLinear, gainA, gainB);
+        for (uint32_t channel = 0; channel < mChannels; ++channel)
+        {
+            *pEnvelopeA++ = gainA;
+            *pEnvelopeB++ = gainB;
+        }
+    }
+
+    if (mRampPos >= mRampFrames)
+    {
+        mPosition = mEndPos;
+    }
+}
@@ -138,6 +138,7 @@ void CAmRoutingAdapterALSADeviceDetector::registerSink(
          * Add the entry to our db
          */
         domainUSB->lSinkInfo.push_back(sinkInfo);
+        mDatabase.invalidateIndices();
     }
 }
 
@@ -175,6 +176,7 @@ void CAmRoutingAdapterALSADeviceDetector::registerSource(
          * Add the entry to our db
          */
         domainUSB->lSourceInfo.push_back(sourceInfo);
+        mDatabase.invalidateIndices();
     }
 }
 
@@ -245,6 +247,7 @@ void CAmRoutingAdapterALSADeviceDetector::deregisterSource(ra_domainInfo_s *doma
         {
             mpSender->deregisterSource(source->amInfo.sourceID);
             domainUSB->lSourceInfo.erase(static_cast<vector<ra_sourceInfo_s>::iterator>(source));
+            mDatabase.invalidateIndices();
         }
     }
     mDatabase.getUSBInfo()->mapCardToSourceName.erase(cardNumber);
@@ -259,6 +262,7 @@ void CAmRoutingAdapterALSADeviceDetector::deregisterSink(ra_domainInfo_s *domain
         {
             mpSender->deregisterSink(sink->amInfo.sinkID);
             domainUSB->lSinkInfo.erase(static_cast<vector<ra_sinkInfo_s>::iterator>(sink));
+            mDatabase.invalidateIndices();
         }
     }
     mDatabase.getUSBInfo()->mapCardToSinkName.erase(cardNumber);
@@ -292,6 +296,8 @@ void CAmRoutingAdapterALSADeviceDetector::parseSysPath(const char *path, struct
         if (action || !isFromMonitor)
         {
             string actionType = isFromMonitor ? action : "add";
+            /* card numbers may be reused, cached mixers are no longer valid */
+            mDatabase.invalidateMixers();
             if (actionType.compare("add") == 0)
             {
                 /*
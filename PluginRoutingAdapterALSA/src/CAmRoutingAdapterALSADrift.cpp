@@ -0,0 +1,127 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#include "CAmRoutingAdapterALSADrift.h"
+
+using namespace am;
+
+/* the level after start is not stable yet, skipped in seconds */
+#define RA_DRIFT_SETTLE_S 0.5
+/* measuring time of the target level in seconds */
+#define RA_DRIFT_TARGET_S 0.5
+/* window of the ppm calculation in seconds */
+#define RA_DRIFT_WINDOW_S 10
+/* weight of a new measurement in the filtered level */
+#define RA_DRIFT_ALPHA (1.0 / 256)
+/* deviation of the filtered level leading to a correction */
+#define RA_DRIFT_THRESHOLD 2.0
+
+CAmRoutingAdapterALSADrift::CAmRoutingAdapterALSADrift()
+    : mRate(0)
+    , mFrames(0)
+    , mLevel(0.0)
+    , mTarget(0.0)
+    , mTargetCnt(0)
+    , mWindowStart(0.0)
+    , mWindowFrames(0)
+    , mPpm(0)
+    , mInserted(0)
+    , mDropped(0)
+{
+}
+
+void CAmRoutingAdapterALSADrift::setup(const uint32_t rate)
+{
+    mRate = rate;
+    mPpm.store(0, std::memory_order_relaxed);
+    mInserted.store(0, std::memory_order_relaxed);
+    mDropped.store(0, std::memory_order_relaxed);
+    reset();
+}
+
+void CAmRoutingAdapterALSADrift::reset()
+{
+    mFrames = 0;
+    mLevel = 0.0;
+    mTarget = 0.0;
+    mTargetCnt = 0;
+    mWindowFrames = 0;
+}
+
+int CAmRoutingAdapterALSADrift::update(const int64_t level, const size_t frames)
+{
+    mFrames += frames;
+    if (mFrames < mRate * RA_DRIFT_SETTLE_S)
+    {
+        return 0;
+    }
+
+    if (mFrames < mRate * (RA_DRIFT_SETTLE_S + RA_DRIFT_TARGET_S))
+    {
+        mTarget += level;
+        mTargetCnt++;
+        return 0;
+    }
+
+    if (mTargetCnt != 0)
+    {
+        mTarget /= mTargetCnt;
+        mTargetCnt = 0;
+        mLevel = mTarget;
+        mWindowStart = mLevel + getDropped() - getInserted();
+        mWindowFrames = 0;
+    }
+
+    mLevel += (level - mLevel) * RA_DRIFT_ALPHA;
+    mWindowFrames += frames;
+    if (mWindowFrames >= static_cast<uint64_t>(mRate) * RA_DRIFT_WINDOW_S)
+    {
+        /* the corrections are added back to get the drift of the clocks only */
+        double uncorrected = mLevel + getDropped() - getInserted();
+        mPpm.store(static_cast<int32_t>((uncorrected - mWindowStart) * 1e6 / mWindowFrames), std::memory_order_relaxed);
+        mWindowStart = uncorrected;
+        mWindowFrames = 0;
+    }
+
+    /* the filter would need a while to see the effect of the correction */
+    if (mLevel - mTarget > RA_DRIFT_THRESHOLD)
+    {
+        mLevel -= 1.0;
+        mDropped.store(getDropped() + 1, std::memory_order_relaxed);
+        return -1;
+    }
+    if (mTarget - mLevel > RA_DRIFT_THRESHOLD)
+    {
+        mLevel += 1.0;
+        mInserted.store(getInserted() + 1, std::memory_order_relaxed);
+        return 1;
+    }
+    return 0;
+}
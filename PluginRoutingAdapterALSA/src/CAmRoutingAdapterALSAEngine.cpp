@@ -0,0 +1,306 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <string.h>
+#include <algorithm>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include "CAmRoutingAdapterALSAEngine.h"
+#include "CAmRoutingAdapterALSAProxyDefault.h"
+#include "CAmRaAlsaLogging.h"
+
+
+using namespace am;
+using namespace std;
+
+
+CAmRoutingAdapterALSAEngine::CAmRoutingAdapterALSAEngine(const string & name, const int cpu)
+    : CAmRoutingAdapterThread(), mGeneration(0), mApplied(0), mEventFd(-1), mCpu(cpu), mPriority(0),
+      mRunning(false), mStop(false), mCpuStart(), mWallStart()
+{
+    mEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (mEventFd < 0)
+    {
+        string error = string("CRaALSAEngine: eventfd creation failed with ") + strerror(errno);
+        logAmRaError(error);
+        throw runtime_error(error);
+    }
+    pthread_mutex_init(&mMtx, NULL);
+    pthread_cond_init(&mCond, NULL);
+
+    /* the thread only swaps in the descriptors built by attach() and detach() */
+    mFds.resize(1);
+    mFds[0].fd = mEventFd;
+    mFds[0].events = POLLIN;
+    mFds[0].revents = 0;
+
+    CAmRoutingAdapterThread::setThreadName(name);
+}
+
+CAmRoutingAdapterALSAEngine::~CAmRoutingAdapterALSAEngine()
+{
+    /* wake up the worker, so that it notices the stop request */
+    mStop = true;
+    wakeUp();
+
+    CAmRoutingAdapterThread::joinThread();
+    close(mEventFd);
+    pthread_cond_destroy(&mCond);
+    pthread_mutex_destroy(&mMtx);
+}
+
+int CAmRoutingAdapterALSAEngine::attach(CAmRoutingAdapterALSAProxyDefault *proxy)
+{
+    pthread_mutex_lock(&mMtx);
+    if (findProxy(proxy) == mProxies.end())
+    {
+        ra_engineEntry_s entry;
+        entry.pProxy = proxy;
+        entry.first = 0;
+        entry.count = static_cast<uint32_t>(proxy->getPollCount());
+        mProxies.push_back(entry);
+    }
+    uint32_t generation = prepareEntries();
+    bool running = mRunning;
+    pthread_mutex_unlock(&mMtx);
+
+    /* the thread runs with the most urgent scheduling of its proxies */
+    const ra_cpuSched_s & sched = proxy->getConfiguration().cpuScheduler;
+    if ((sched.policy != SCHED_OTHER) && (sched.priority > mPriority))
+    {
+        mPriority = sched.priority;
+        CAmRoutingAdapterThread::setThreadSched(sched.policy, sched.priority);
+    }
+
+    int err = 0;
+    if (!running)
+    {
+        /* a thread which stopped because of an error has to be joined before it is started again */
+        CAmRoutingAdapterThread::joinThread();
+        err = CAmRoutingAdapterThread::startThread();
+        logAmRaInfo("CRaALSAEngine::attach thread started with", err);
+    }
+    else
+    {
+        wakeUp();
+    }
+    waitForUpdate(generation);
+    return err;
+}
+
+bool CAmRoutingAdapterALSAEngine::detach(const CAmRoutingAdapterALSAProxyDefault *proxy)
+{
+    pthread_mutex_lock(&mMtx);
+    vector<ra_engineEntry_s>::iterator itr = findProxy(proxy);
+    bool attached = (itr != mProxies.end());
+    uint32_t generation = mGeneration;
+    if (attached)
+    {
+        mProxies.erase(itr);
+        generation = prepareEntries();
+    }
+    pthread_mutex_unlock(&mMtx);
+
+    if (attached)
+    {
+        wakeUp();
+        waitForUpdate(generation);
+    }
+    return attached;
+}
+
+vector<CAmRoutingAdapterALSAEngine::ra_engineEntry_s>::iterator CAmRoutingAdapterALSAEngine::findProxy(
+        const CAmRoutingAdapterALSAProxyDefault *proxy)
+{
+    return find_if(mProxies.begin(), mProxies.end(),
+            [&](const ra_engineEntry_s & entry)
+            {
+                return entry.pProxy == proxy;
+            });
+}
+
+uint32_t CAmRoutingAdapterALSAEngine::prepareEntries()
+{
+    /* built here, so that the thread does not need to allocate */
+    mNextEntries.clear();
+    mNextFds.resize(1);
+    mNextFds[0].fd = mEventFd;
+    mNextFds[0].events = POLLIN;
+    mNextFds[0].revents = 0;
+    for (ra_engineEntry_s entry : mProxies)
+    {
+        entry.first = static_cast<uint32_t>(mNextFds.size());
+        mNextEntries.push_back(entry);
+        mNextFds.resize(mNextFds.size() + entry.count);
+    }
+    return ++mGeneration;
+}
+
+void CAmRoutingAdapterALSAEngine::wakeUp()
+{
+    uint64_t event = 1;
+    if (write(mEventFd, &event, sizeof(event)) < 0)
+    {
+        logAmRaError("CRaALSAEngine: wake up failed with", strerror(errno));
+    }
+}
+
+void CAmRoutingAdapterALSAEngine::waitForUpdate(const uint32_t generation)
+{
+    /* a thread which is not running does not access any proxy */
+    pthread_mutex_lock(&mMtx);
+    while (mRunning && (static_cast<int32_t>(mApplied - generation) < 0))
+    {
+        pthread_cond_wait(&mCond, &mMtx);
+    }
+    pthread_mutex_unlock(&mMtx);
+}
+
+void CAmRoutingAdapterALSAEngine::updateEntries()
+{
+    /* swapping does not allocate, the previous arrays are reused by the next preparation */
+    pthread_mutex_lock(&mMtx);
+    mEntries.swap(mNextEntries);
+    mFds.swap(mNextFds);
+    mApplied = mGeneration;
+    pthread_cond_broadcast(&mCond);
+    pthread_mutex_unlock(&mMtx);
+}
+
+int CAmRoutingAdapterALSAEngine::initThread()
+{
+    if (mCpu >= 0)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(mCpu, &cpus);
+        int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (err != 0)
+        {
+            logAmRaError("CRaALSAEngine::initThread Unable to bind to CPU", mCpu, ":", strerror(err));
+        }
+    }
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &mCpuStart);
+    clock_gettime(CLOCK_MONOTONIC, &mWallStart);
+
+    pthread_mutex_lock(&mMtx);
+    mRunning = true;
+    pthread_mutex_unlock(&mMtx);
+    return 0;
+}
+
+int CAmRoutingAdapterALSAEngine::workerThread()
+{
+    if (mGeneration != mApplied)
+    {
+        updateEntries();
+    }
+
+    /* the timeout is given by the proxy which has to recover first */
+    uint64_t now = getTimeUs();
+    uint64_t deadline = UINT64_MAX;
+    for (ra_engineEntry_s & entry : mEntries)
+    {
+        entry.pProxy->getPollDescriptors(&mFds[entry.first]);
+        deadline = std::min(deadline, entry.pProxy->getDeadline());
+    }
+    int timeout = -1;
+    if (deadline != UINT64_MAX)
+    {
+        timeout = (deadline > now) ? static_cast<int>((deadline - now + 999) / 1000) : 0;
+    }
+
+    int err = poll(mFds.data(), mFds.size(), timeout);
+    if (err < 0)
+    {
+        return (errno == EINTR) ? 0 : -errno;
+    }
+
+    if (mStop)
+    {
+        return 1;
+    }
+
+    uint64_t events;
+    if (mFds[0].revents & POLLIN)
+    {
+        /* the count is not of interest, changes are taken from the generation */
+        if (read(mEventFd, &events, sizeof(events)) < 0)
+        {
+            /* the event was consumed by an earlier wake-up */
+        }
+    }
+
+    now = getTimeUs();
+    for (ra_engineEntry_s & entry : mEntries)
+    {
+        entry.pProxy->serviceStreaming(&mFds[entry.first], now);
+    }
+
+    return 0;
+}
+
+void CAmRoutingAdapterALSAEngine::deinitThread(int errInit)
+{
+    pthread_mutex_lock(&mMtx);
+    mRunning = false;
+    if (errInit < 0)
+    {
+        /* the proxies are not serviced anymore until the next attach() starts the thread again */
+        logAmRaError("CRaALSAEngine: thread exits with", errInit);
+        for (ra_engineEntry_s & entry : mProxies)
+        {
+            entry.pProxy->engineFailed(errInit);
+        }
+    }
+    pthread_cond_broadcast(&mCond);
+    pthread_mutex_unlock(&mMtx);
+
+    if (mWallStart.tv_sec != 0)
+    {
+        struct timespec cpuEnd, wallEnd;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuEnd);
+        clock_gettime(CLOCK_MONOTONIC, &wallEnd);
+        uint64_t cpuUs = (cpuEnd.tv_sec - mCpuStart.tv_sec) * 1000000ULL + (cpuEnd.tv_nsec - mCpuStart.tv_nsec) / 1000;
+        uint64_t wallUs = (wallEnd.tv_sec - mWallStart.tv_sec) * 1000000ULL + (wallEnd.tv_nsec - mWallStart.tv_nsec) / 1000;
+        logAmRaInfo("CRaALSAEngine::deinitThread CPU load [0.1%]",
+                static_cast<uint32_t>(wallUs ? (cpuUs * 1000) / wallUs : 0), "over", static_cast<uint32_t>(wallUs / 1000), "ms");
+    }
+}
+
+uint64_t CAmRoutingAdapterALSAEngine::getTimeUs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000ULL + now.tv_nsec / 1000;
+}
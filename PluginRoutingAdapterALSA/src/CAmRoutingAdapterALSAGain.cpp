@@ -0,0 +1,476 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#include <math.h>
+#include <string.h>
+#include <errno.h>
+#include <algorithm>
+#include <alsa/asoundlib.h>
+#include "CAmRoutingAdapterALSAGain.h"
+#include "CAmRoutingAdapterALSASimd.h"
+
+using namespace am;
+using namespace am::simd;
+
+namespace
+{
+
+inline int16_t scaleSample(const int16_t sample, const float gain)
+{
+    float value = roundf(sample * gain);
+    return static_cast<int16_t>(std::max(-32768.0f, std::min(32767.0f, value)));
+}
+
+inline int32_t scaleSample(const int32_t sample, const float gain)
+{
+    float value = roundf(sample * gain);
+    return static_cast<int32_t>(std::max(-2147483648.0f, std::min(S32_MAX_FLOAT, value)));
+}
+
+inline float scaleSample(const float sample, const float gain)
+{
+    return sample * gain;
+}
+
+inline int16_t mixSample(const int16_t a, const int16_t b)
+{
+    return static_cast<int16_t>(std::max(-32768, std::min(32767, a + b)));
+}
+
+inline int32_t mixSample(const int32_t a, const int32_t b)
+{
+    int64_t sum = static_cast<int64_t>(a) + b;
+    return static_cast<int32_t>(std::max<int64_t>(INT32_MIN, std::min<int64_t>(INT32_MAX, sum)));
+}
+
+inline float mixSample(const float a, const float b)
+{
+    return std::max(-1.0f, std::min(1.0f, a + b));
+}
+
+#if defined(__AVX2__)
+
+inline size_t mixBlock(int16_t *buffer, const int16_t *source, const size_t samples)
+{
+    size_t i = 0;
+    for (; i + 16 <= samples; i += 16)
+    {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buffer + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(buffer + i), _mm256_adds_epi16(a, b));
+    }
+    return i;
+}
+
+inline size_t mixBlock(int32_t *buffer, const int32_t *source, const size_t samples)
+{
+    size_t i = 0;
+    const __m256i max = _mm256_set1_epi32(INT32_MAX);
+    for (; i + 8 <= samples; i += 8)
+    {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buffer + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+        __m256i sum = _mm256_add_epi32(a, b);
+        /* overflow in case both operands have a sign different to the sum */
+        __m256i ovf = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(a, sum), _mm256_xor_si256(b, sum)), 31);
+        __m256i sat = _mm256_xor_si256(_mm256_srai_epi32(a, 31), max);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(buffer + i), _mm256_blendv_epi8(sum, sat, ovf));
+    }
+    return i;
+}
+
+inline size_t mixBlock(float *buffer, const float *source, const size_t samples)
+{
+    size_t i = 0;
+    const __m256 max = _mm256_set1_ps(1.0f);
+    const __m256 min = _mm256_set1_ps(-1.0f);
+    for (; i + 8 <= samples; i += 8)
+    {
+        __m256 sum = _mm256_add_ps(_mm256_loadu_ps(buffer + i), _mm256_loadu_ps(source + i));
+        _mm256_storeu_ps(buffer + i, _mm256_max_ps(min, _mm256_min_ps(max, sum)));
+    }
+    return i;
+}
+
+#elif defined(__SSE2__)
+
+inline size_t mixBlock(int16_t *buffer, const int16_t *source, const size_t samples)
+{
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + i), _mm_adds_epi16(a, b));
+    }
+    return i;
+}
+
+inline size_t mixBlock(int32_t *buffer, const int32_t *source, const size_t samples)
+{
+    size_t i = 0;
+    const __m128i max = _mm_set1_epi32(INT32_MAX);
+    for (; i + 4 <= samples; i += 4)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        __m128i sum = _mm_add_epi32(a, b);
+        /* overflow in case both operands have a sign different to the sum */
+        __m128i ovf = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(a, sum), _mm_xor_si128(b, sum)), 31);
+        __m128i sat = _mm_xor_si128(_mm_srai_epi32(a, 31), max);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + i),
+                _mm_or_si128(_mm_and_si128(ovf, sat), _mm_andnot_si128(ovf, sum)));
+    }
+    return i;
+}
+
+inline size_t mixBlock(float *buffer, const float *source, const size_t samples)
+{
+    size_t i = 0;
+    const __m128 max = _mm_set1_ps(1.0f);
+    const __m128 min = _mm_set1_ps(-1.0f);
+    for (; i + 4 <= samples; i += 4)
+    {
+        __m128 sum = _mm_add_ps(_mm_loadu_ps(buffer + i), _mm_loadu_ps(source + i));
+        _mm_storeu_ps(buffer + i, _mm_max_ps(min, _mm_min_ps(max, sum)));
+    }
+    return i;
+}
+
+#elif defined(RA_SIMD_NEON)
+
+inline size_t mixBlock(int16_t *buffer, const int16_t *source, const size_t samples)
+{
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8)
+    {
+        vst1q_s16(buffer + i, vqaddq_s16(vld1q_s16(buffer + i), vld1q_s16(source + i)));
+    }
+    return i;
+}
+
+inline size_t mixBlock(int32_t *buffer, const int32_t *source, const size_t samples)
+{
+    size_t i = 0;
+    for (; i + 4 <= samples; i += 4)
+    {
+        vst1q_s32(buffer + i, vqaddq_s32(vld1q_s32(buffer + i), vld1q_s32(source + i)));
+    }
+    return i;
+}
+
+inline size_t mixBlock(float *buffer, const float *source, const size_t samples)
+{
+    size_t i = 0;
+    const float32x4_t max = vdupq_n_f32(1.0f);
+    const float32x4_t min = vdupq_n_f32(-1.0f);
+    for (; i + 4 <= samples; i += 4)
+    {
+        float32x4_t sum = vaddq_f32(vld1q_f32(buffer + i), vld1q_f32(source + i));
+        vst1q_f32(buffer + i, vmaxq_f32(min, vminq_f32(max, sum)));
+    }
+    return i;
+}
+
+#else
+
+template <typename T>
+inline size_t mixBlock(T *buffer, const T *source, const size_t samples)
+{
+    (void)buffer;
+    (void)source;
+    (void)samples;
+    return 0;
+}
+
+#endif
+
+template <typename T>
+void mixSamples(T *buffer, const T *source, const size_t samples)
+{
+    for (size_t i = mixBlock(buffer, source, samples); i < samples; ++i)
+    {
+        buffer[i] = mixSample(buffer[i], source[i]);
+    }
+}
+
+template <typename T>
+void scaleConst(T *buffer, const float gain, const size_t samples)
+{
+    size_t i = 0;
+#if VEC_LEN > 0
+    const vec_t vGain = vecSet(gain);
+    for (; i + VEC_LEN <= samples; i += VEC_LEN)
+    {
+        vecStore(buffer + i, vecMul(vecLoad(buffer + i), vGain));
+    }
+#endif
+    for (; i < samples; ++i)
+    {
+        buffer[i] = scaleSample(buffer[i], gain);
+    }
+}
+
+template <typename T>
+void scaleEnvelope(T *buffer, const float *gain, const size_t samples)
+{
+    size_t i = 0;
+#if VEC_LEN > 0
+    for (; i + VEC_LEN <= samples; i += VEC_LEN)
+    {
+        vecStore(buffer + i, vecMul(vecLoad(buffer + i), vecLoad(gain + i)));
+    }
+#endif
+    for (; i < samples; ++i)
+    {
+        buffer[i] = scaleSample(buffer[i], gain[i]);
+    }
+}
+
+} /* namespace */
+
+
+CAmRoutingAdapterALSAGain::CAmRoutingAdapterALSAGain()
+    : mFormat(SND_PCM_FORMAT_UNKNOWN), mChannels(0), mRate(0), mFrames(0), mpEnvelope(NULL),
+      mPending(false), mTargetVol(0), mTargetRamp(RAMP_GENIVI_DIRECT), mTargetTime(0),
+      mCurVol(0), mBegVol(0), mEndVol(0), mRamp(RAMP_GENIVI_DIRECT), mRampFrames(0), mRampPos(0)
+{
+    pthread_mutex_init(&mMtx, NULL);
+}
+
+CAmRoutingAdapterALSAGain::~CAmRoutingAdapterALSAGain()
+{
+    delete[] mpEnvelope;
+    pthread_mutex_destroy(&mMtx);
+}
+
+int CAmRoutingAdapterALSAGain::setup(const uint32_t format, const uint32_t channels, const uint32_t rate,
+        const size_t frames)
+{
+    if ((format != SND_PCM_FORMAT_S16_LE) && (format != SND_PCM_FORMAT_S32_LE) &&
+        (format != SND_PCM_FORMAT_FLOAT_LE))
+    {
+        mFormat = SND_PCM_FORMAT_UNKNOWN;
+        return -EINVAL;
+    }
+
+    delete[] mpEnvelope;
+    mpEnvelope = new float[frames * channels];
+    mFormat = format;
+    mChannels = channels;
+    mRate = rate;
+    mFrames = frames;
+    return 0;
+}
+
+void CAmRoutingAdapterALSAGain::setTarget(const am_volume_t volume, const am_CustomRampType_t ramp,
+        const am_time_t time)
+{
+    pthread_mutex_lock(&mMtx);
+    mTargetVol = volume;
+    mTargetRamp = ramp;
+    mTargetTime = time;
+    mPending = true;
+    pthread_mutex_unlock(&mMtx);
+}
+
+void CAmRoutingAdapterALSAGain::apply(void *buffer, const size_t frames)
+{
+    if ((mFormat == static_cast<uint32_t>(SND_PCM_FORMAT_UNKNOWN)) || (frames > mFrames))
+    {
+        return;
+    }
+
+    /* take over a new target without ever waiting for the requester */
+    if (pthread_mutex_trylock(&mMtx) == 0)
+    {
+        if (mPending)
+        {
+            startRamp();
+            mPending = false;
+        }
+        pthread_mutex_unlock(&mMtx);
+    }
+
+    size_t samples = frames * mChannels;
+    if (mRampPos < mRampFrames)
+    {
+        calcEnvelope(frames);
+        switch (mFormat)
+        {
+            case SND_PCM_FORMAT_S16_LE:
+                scale(static_cast<int16_t*>(buffer), mpEnvelope, samples);
+                break;
+            case SND_PCM_FORMAT_S32_LE:
+                scale(static_cast<int32_t*>(buffer), mpEnvelope, samples);
+                break;
+            default:
+                scale(static_cast<float*>(buffer), mpEnvelope, samples);
+                break;
+        }
+        return;
+    }
+
+    float gain = volumeToGain(mCurVol);
+    if (gain == 1.0f)
+    {
+        return;
+    }
+
+    switch (mFormat)
+    {
+        case SND_PCM_FORMAT_S16_LE:
+            scale(static_cast<int16_t*>(buffer), gain, samples);
+            break;
+        case SND_PCM_FORMAT_S32_LE:
+            scale(static_cast<int32_t*>(buffer), gain, samples);
+            break;
+        default:
+            scale(static_cast<float*>(buffer), gain, samples);
+            break;
+    }
+}
+
+float CAmRoutingAdapterALSAGain::volumeToGain(const float volume)
+{
+    if (volume <= AM_MUTE)
+    {
+        return 0.0f;
+    }
+    if (volume >= 0)
+    {
+        return 1.0f;
+    }
+
+    /* volume is given in 0.1 dB */
+    return powf(10.0f, volume / 200.0f);
+}
+
+void CAmRoutingAdapterALSAGain::startRamp()
+{
+    /* a running ramp is retargeted from the level reached so far */
+    mBegVol = mCurVol;
+    mEndVol = mTargetVol;
+    mRamp = mTargetRamp;
+    mRampFrames = (static_cast<size_t>(mTargetTime) * mRate) / 1000;
+    mRampPos = 0;
+    if ((mRamp == RAMP_GENIVI_DIRECT) || (mRampFrames == 0))
+    {
+        mCurVol = mEndVol;
+        mRampFrames = 0;
+    }
+}
+
+float CAmRoutingAdapterALSAGain::calcVolume(const float position) const
+{
+    /* same shapes as the ramps of the mixer volume control, but continuous */
+    float delta = mEndVol - mBegVol;
+    float sign = (delta >= 0) ? 1.0f : -1.0f;
+    switch (mRamp)
+    {
+        case RAMP_GENIVI_EXP:
+            return mBegVol + sign * expm1f(position * log1pf(fabsf(delta)));
+        case RAMP_GENIVI_EXP_INV:
+            return mEndVol - sign * expm1f((1.0f - position) * log1pf(fabsf(delta)));
+        case RAMP_GENIVI_LINEAR:
+        case RAMP_GENIVI_NO_PLOP:
+        default:
+            return mBegVol + delta * position;
+    }
+}
+
+void CAmRoutingAdapterALSAGain::calcEnvelope(const size_t frames)
+{
+    float *pEnvelope = mpEnvelope;
+    for (size_t frame = 0; frame < frames; ++frame)
+    {
+        if (mRampPos < mRampFrames)
+        {
+            mRampPos++;
+            mCurVol = calcVolume(static_cast<float>(mRampPos) / mRampFrames);
+        }
+
+        float gain = volumeToGain(mCurVol);
+        for (uint32_t channel = 0; channel < mChannels; ++channel)
+        {
+            *pEnvelope++ = gain;
+        }
+    }
+
+    if (mRampPos >= mRampFrames)
+    {
+        mCurVol = mEndVol;
+    }
+}
+
+void CAmRoutingAdapterALSAGain::scale(int16_t *buffer, const float gain, const size_t samples)
+{
+    scaleConst(buffer, gain, samples);
+}
+
+void CAmRoutingAdapterALSAGain::scale(int32_t *buffer, const float gain, const size_t samples)
+{
+    scaleConst(buffer, gain, samples);
+}
+
+void CAmRoutingAdapterALSAGain::scale(float *buffer, const float gain, const size_t samples)
+{
+    scaleConst(buffer, gain, samples);
+}
+
+void CAmRoutingAdapterALSAGain::scale(int16_t *buffer, const float *gain, const size_t samples)
+{
+    scaleEnvelope(buffer, gain, samples);
+}
+
+void CAmRoutingAdapterALSAGain::scale(int32_t *buffer, const float *gain, const size_t samples)
+{
+    scaleEnvelope(buffer, gain, samples);
+}
+
+void CAmRoutingAdapterALSAGain::scale(float *buffer, const float *gain, const size_t samples)
+{
+    scaleEnvelope(buffer, gain, samples);
+}
+
+void CAmRoutingAdapterALSAGain::mix(int16_t *buffer, const int16_t *source, const size_t samples)
+{
+    mixSamples(buffer, source, samples);
+}
+
+void CAmRoutingAdapterALSAGain::mix(int32_t *buffer, const int32_t *source, const size_t samples)
+{
+    mixSamples(buffer, source, samples);
+}
+
+void CAmRoutingAdapterALSAGain::mix(float *buffer, const float *source, const size_t samples)
+{
+    mixSamples(buffer, source, samples);
+}
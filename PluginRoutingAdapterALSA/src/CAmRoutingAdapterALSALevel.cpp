@@ -0,0 +1,277 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+#include <math.h>
+#include <errno.h>
+#include <algorithm>
+#include <alsa/asoundlib.h>
+#include "CAmRoutingAdapterALSALevel.h"
+#include "CAmRoutingAdapterALSASimd.h"
+
+using namespace am;
+using namespace am::simd;
+
+namespace
+{
+
+template <typename T>
+void measureSamples(const T *buffer, const uint32_t channels, const size_t frames, const float scale,
+        float *peak, float *squares)
+{
+    const size_t samples = frames * channels;
+    size_t i = 0;
+#if VEC_LEN > 0
+    /* as long as the channels fit into a vector each lane always sees the same channel */
+    if ((VEC_LEN % channels) == 0)
+    {
+        const vec_t vNeg = vecSet(-1.0f);
+        vec_t vPeak = vecSet(0.0f);
+        vec_t vSquares = vecSet(0.0f);
+        for (; i + VEC_LEN <= samples; i += VEC_LEN)
+        {
+            vec_t v = vecLoad(buffer + i);
+            vPeak = vecMax(vPeak, vecMax(v, vecMul(v, vNeg)));
+            vSquares = vecAdd(vSquares, vecMul(v, v));
+        }
+        float lanePeak[VEC_LEN];
+        float laneSquares[VEC_LEN];
+        vecStore(lanePeak, vPeak);
+        vecStore(laneSquares, vSquares);
+        for (uint32_t n = 0; n < VEC_LEN; ++n)
+        {
+            peak[n % channels] = std::max(peak[n % channels], lanePeak[n] * scale);
+            squares[n % channels] += laneSquares[n] * scale * scale;
+        }
+    }
+#endif
+    for (uint32_t ch = i % channels; i < samples; ++i)
+    {
+        float value = static_cast<float>(buffer[i]) * scale;
+        peak[ch] = std::max(peak[ch], fabsf(value));
+        squares[ch] += value * value;
+        if (++ch == channels)
+        {
+            ch = 0;
+        }
+    }
+}
+
+} /* namespace */
+
+
+CAmRoutingAdapterALSALevel::CAmRoutingAdapterALSALevel()
+    : mFormat(SND_PCM_FORMAT_UNKNOWN), mChannels(0), mEnabled(false)
+{
+    for (uint32_t ch = 0; ch < RA_LEVEL_MAX_CHANNELS; ++ch)
+    {
+        mPeak[ch].store(AM_MUTE);
+        mRms[ch].store(AM_MUTE);
+    }
+}
+
+int CAmRoutingAdapterALSALevel::setup(const uint32_t format, const uint32_t channels)
+{
+    mFormat = SND_PCM_FORMAT_UNKNOWN;
+    if ((format != SND_PCM_FORMAT_S16_LE) && (format != SND_PCM_FORMAT_S32_LE) &&
+        (format != SND_PCM_FORMAT_FLOAT_LE))
+    {
+        return -EINVAL;
+    }
+    if ((channels == 0) || (channels > RA_LEVEL_MAX_CHANNELS))
+    {
+        return -EINVAL;
+    }
+    mFormat = format;
+    mChannels = channels;
+    return 0;
+}
+
+void CAmRoutingAdapterALSALevel::setEnabled(const bool enable)
+{
+    for (uint32_t ch = 0; ch < RA_LEVEL_MAX_CHANNELS; ++ch)
+    {
+        mPeak[ch].store(AM_MUTE, std::memory_order_relaxed);
+        mRms[ch].store(AM_MUTE, std::memory_order_relaxed);
+    }
+    mEnabled.store(enable, std::memory_order_relaxed);
+}
+
+void CAmRoutingAdapterALSALevel::analyze(const void *buffer, const size_t frames)
+{
+    if (!isEnabled() || (frames == 0))
+    {
+        return;
+    }
+
+    float peak[RA_LEVEL_MAX_CHANNELS] = {};
+    float squares[RA_LEVEL_MAX_CHANNELS] = {};
+    switch (mFormat)
+    {
+        case SND_PCM_FORMAT_S16_LE:
+            measure(static_cast<const int16_t*>(buffer), mChannels, frames, peak, squares);
+            break;
+        case SND_PCM_FORMAT_S32_LE:
+            measure(static_cast<const int32_t*>(buffer), mChannels, frames, peak, squares);
+            break;
+        case SND_PCM_FORMAT_FLOAT_LE:
+            measure(static_cast<const float*>(buffer), mChannels, frames, peak, squares);
+            break;
+        default:
+            return;
+    }
+
+    for (uint32_t ch = 0; ch < mChannels; ++ch)
+    {
+        hold(mPeak[ch], amplitudeToLevel(peak[ch]));
+        hold(mRms[ch], amplitudeToLevel(sqrtf(squares[ch] / frames)));
+    }
+}
+
+void CAmRoutingAdapterALSALevel::take(am_volume_t & peak, am_volume_t & rms)
+{
+    peak = AM_MUTE;
+    rms = AM_MUTE;
+    for (uint32_t ch = 0; ch < mChannels; ++ch)
+    {
+        am_volume_t chPeak, chRms;
+        take(ch, chPeak, chRms);
+        peak = std::max(peak, chPeak);
+        rms = std::max(rms, chRms);
+    }
+}
+
+void CAmRoutingAdapterALSALevel::take(const uint32_t channel, am_volume_t & peak, am_volume_t & rms)
+{
+    if (channel >= RA_LEVEL_MAX_CHANNELS)
+    {
+        peak = AM_MUTE;
+        rms = AM_MUTE;
+        return;
+    }
+    peak = mPeak[channel].exchange(AM_MUTE, std::memory_order_relaxed);
+    rms = mRms[channel].exchange(AM_MUTE, std::memory_order_relaxed);
+}
+
+am_volume_t CAmRoutingAdapterALSALevel::amplitudeToLevel(const float amplitude)
+{
+    if (amplitude <= 0.0f)
+    {
+        return AM_MUTE;
+    }
+    float level = roundf(200.0f * log10f(amplitude));
+    return static_cast<am_volume_t>(std::max(static_cast<float>(AM_MUTE), std::min(0.0f, level)));
+}
+
+void CAmRoutingAdapterALSALevel::measure(const int16_t *buffer, const uint32_t channels, const size_t frames,
+        float *peak, float *squares)
+{
+    measureSamples(buffer, channels, frames, 1.0f / 32768.0f, peak, squares);
+}
+
+void CAmRoutingAdapterALSALevel::measure(const int32_t *buffer, const uint32_t channels, const size_t frames,
+        float *peak, float *squares)
+{
+    measureSamples(buffer, channels, frames, 1.0f / 2147483648.0f, peak, squares);
+}
+
+void CAmRoutingAdapterALSALevel::measure(const float *buffer, const uint32_t channels, const size_t frames,
+        float *peak, float *squares)
+{
+    measureSamples(buffer, channels, frames, 1.0f, peak, squares);
+}
+
+void CAmRoutingAdapterALSALevel::hold(std::atomic<int16_t> & held, const am_volume_t level)
+{
+    int16_t current = held.load(std::memory_order_relaxed);
+    while ((level > current) && !held.compare_exchange_weak(current, level, std::memory_order_relaxed))
+    {
+    }
+}
+
+CAmRoutingAdapterALSALevelNotification::CAmRoutingAdapterALSALevelNotification() :
+        mStatus(NS_OFF), mParameter(0), mValue(AM_MUTE), mHeld(AM_MUTE), mActive(false), mElapsed(0)
+{
+}
+
+void CAmRoutingAdapterALSALevelNotification::configure(const am_NotificationStatus_e status, const int16_t parameter)
+{
+    mStatus = status;
+    mParameter = parameter;
+    mValue = AM_MUTE;
+    mHeld = AM_MUTE;
+    mActive = false;
+    mElapsed = 0;
+}
+
+bool CAmRoutingAdapterALSALevelNotification::check(const am_volume_t level, const uint32_t interval,
+        am_volume_t & value)
+{
+    bool notify = false;
+    mHeld = std::max(mHeld, level);
+    value = mHeld;
+    switch (mStatus)
+    {
+        case NS_PERIODIC:
+            mElapsed += interval;
+            notify = (mElapsed >= std::max(static_cast<uint32_t>(std::max<int16_t>(mParameter, 0)), interval));
+            break;
+        case NS_MINIMUM:
+            /* thresholds are crossed per interval, the held level would hide a drop */
+            value = level;
+            notify = (level < mParameter) && !mActive;
+            mActive = (level < mParameter);
+            break;
+        case NS_MAXIMUM:
+            value = level;
+            notify = (level > mParameter) && !mActive;
+            mActive = (level > mParameter);
+            break;
+        case NS_CHANGE:
+            /* a rise is reported with the held maximum, a drop with the level of the interval */
+            if (level - mValue <= -std::max<int16_t>(mParameter, 1))
+            {
+                value = level;
+                notify = true;
+            }
+            else
+            {
+                notify = (mHeld - mValue >= std::max<int16_t>(mParameter, 1));
+            }
+            break;
+        default:
+            break;
+    }
+    if (notify)
+    {
+        mValue = value;
+        mHeld = AM_MUTE;
+        mElapsed = 0;
+    }
+    return notify;
+}
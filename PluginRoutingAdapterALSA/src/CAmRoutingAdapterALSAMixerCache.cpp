@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+#include "CAmRoutingAdapterALSAMixerCache.h"
+#include "CAmRaAlsaLogging.h"
+
+using namespace am;
+using namespace std;
+
+
+shared_ptr<ra_mixerHandle_s> CAmRoutingAdapterALSAMixerCache::getHandle(const string & card)
+{
+    auto it = mHandles.find(card);
+    if (it != mHandles.end())
+    {
+        return it->second;
+    }
+
+    ra_mixerHandle_s * pHandle = new ra_mixerHandle_s();
+    pHandle->handle = NULL;
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&pHandle->mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    shared_ptr<ra_mixerHandle_s> handle(pHandle, closeHandle);
+
+    int err = snd_mixer_open(&pHandle->handle, 0);
+    if (err == 0)
+    {
+        err = snd_mixer_attach(pHandle->handle, card.c_str());
+    }
+    if (err == 0)
+    {
+        err = snd_mixer_selem_register(pHandle->handle, NULL, NULL);
+    }
+    if (err == 0)
+    {
+        err = snd_mixer_load(pHandle->handle);
+    }
+    if (err < 0)
+    {
+        logAmRaError("CRaALSAMixerCache::getHandle Loading mixer of", card, "failed with:", snd_strerror(err));
+        return nullptr;
+    }
+
+    logAmRaDebug("CRaALSAMixerCache::getHandle Mixer of", card, "cached");
+    mHandles[card] = handle;
+    return handle;
+}
+
+void CAmRoutingAdapterALSAMixerCache::invalidate()
+{
+    if (!mHandles.empty())
+    {
+        logAmRaDebug("CRaALSAMixerCache::invalidate Drop", mHandles.size(), "cached mixers");
+    }
+    mHandles.clear();
+}
+
+void CAmRoutingAdapterALSAMixerCache::closeHandle(ra_mixerHandle_s * pHandle)
+{
+    if (pHandle->handle != NULL)
+    {
+        snd_mixer_close(pHandle->handle);
+    }
+    pthread_mutex_destroy(&pHandle->mutex);
+    delete pHandle;
+}
@@ -55,9 +55,14 @@ int _elemCallback(snd_mixer_elem_t *elem, unsigned int mask)
 }
 
 
-CAmRoutingAdapterALSAMixerCtrl::CAmRoutingAdapterALSAMixerCtrl() : mpHandle(NULL), mpSid(NULL), mpElem(NULL)
+CAmRoutingAdapterALSAMixerCtrl::CAmRoutingAdapterALSAMixerCtrl(std::shared_ptr<ra_mixerHandle_s> shared)
+    : mpHandle(NULL), mpSid(NULL), mpElem(NULL), mpShared(shared)
 {
-    if (snd_mixer_open(&mpHandle, 0))
+    if (mpShared)
+    {
+        mpHandle = mpShared->handle;
+    }
+    else if (snd_mixer_open(&mpHandle, 0))
     {
         throw std::runtime_error("snd_mixer_open() error");
     }
@@ -71,13 +76,20 @@ CAmRoutingAdapterALSAMixerCtrl::~CAmRoutingAdapterALSAMixerCtrl()
 {
     if (mpElem != NULL)
     {
-        snd_mixer_elem_set_callback(mpElem, NULL);
+        /* a shared element may already notify a newer control */
+        lock();
+        if (!mpShared || (snd_mixer_elem_get_callback_private(mpElem) == this))
+        {
+            snd_mixer_elem_set_callback(mpElem, NULL);
+            snd_mixer_elem_set_callback_private(mpElem, NULL);
+        }
+        unlock();
     }
     if (mpSid != NULL)
     {
         snd_mixer_selem_id_free(mpSid);
     }
-    if (mpHandle != NULL)
+    if ((mpHandle != NULL) && !mpShared)
     {
         snd_mixer_close(mpHandle);
     }
@@ -85,6 +97,7 @@ CAmRoutingAdapterALSAMixerCtrl::~CAmRoutingAdapterALSAMixerCtrl()
 int CAmRoutingAdapterALSAMixerCtrl::setEnum(const std::string& value)
 {
     int err;
+    lock();
     if (snd_mixer_selem_is_enumerated(mpElem))
     {
         bool enumFound = false;
@@ -94,18 +107,19 @@ int CAmRoutingAdapterALSAMixerCtrl::setEnum(const std::string& value)
             err = snd_mixer_selem_set_enum_item(mpElem, SND_MIXER_SCHN_FRONT_LEFT, enumIndex);
             if (err < 0)
             {
-                return retWithError("snd_mixer_selem_set_enum_item failed", err);
+                err = retWithError("snd_mixer_selem_set_enum_item failed", err);
             }
         }
         else
         {
-            return retWithError("Enum value not found", -EFAULT);
+            err = retWithError("Enum value not found", -EFAULT);
         }
     }
     else
     {
-        return retWithError("Mixer is not enumerated type", -EFAULT);
+        err = retWithError("Mixer is not enumerated type", -EFAULT);
     }
+    unlock();
     return err;
 }
 
@@ -136,6 +150,33 @@ int CAmRoutingAdapterALSAMixerCtrl::openMixer(const std::string & card, const st
     mCard = card;
     mVolume = volume;
 
+    if (mpShared)
+    {
+        /* the mixer is already loaded, only the element has to be looked up */
+        lock();
+        auto it = mpShared->elements.find(mVolume);
+        if (it != mpShared->elements.end())
+        {
+            mpElem = it->second;
+        }
+        else
+        {
+            snd_mixer_selem_id_set_index(mpSid, 0);
+            snd_mixer_selem_id_set_name(mpSid, mVolume.c_str());
+            mpElem = snd_mixer_find_selem(mpHandle, mpSid);
+            if (mpElem != NULL)
+            {
+                mpShared->elements[mVolume] = mpElem;
+            }
+        }
+        unlock();
+        if (mpElem == NULL)
+        {
+            return retWithError("CALSAMixerCtrl::openMixer Mixer element " + mVolume + " not found ", -ENODEV);
+        }
+        return 0;
+    }
+
     int err = snd_mixer_attach(mpHandle, mCard.c_str());
     if (err < 0)
     {
@@ -167,16 +208,21 @@ int CAmRoutingAdapterALSAMixerCtrl::openMixer(const std::string & card, const st
 
 void CAmRoutingAdapterALSAMixerCtrl::activateVolumeChangeNotification(void)
 {
+    lock();
     snd_mixer_elem_set_callback(mpElem, _elemCallback);
     snd_mixer_elem_set_callback_private(mpElem, this);
+    unlock();
 }
 
 int CAmRoutingAdapterALSAMixerCtrl::elemCallback(snd_mixer_elem_t *elem)
 {
     if (elem == mpElem)
     {
+        /* called while the events are handled, they must not be handled again */
         long int volume;
-        int err = getVolume(volume);
+        lock();
+        int err = readVolume(volume);
+        unlock();
         if (err < 0)
         {
             return err;
@@ -194,7 +240,9 @@ int CAmRoutingAdapterALSAMixerCtrl::setRange(const long int & minVol, const long
         snd_mixer_selem_set_capture_volume_range
     };
 
+    lock();
     int err = snd_mixer_selem_set_volume_range[mDir](mpElem, minVol, maxVol);
+    unlock();
     if (err == 0)
     {
         return err;
@@ -210,7 +258,9 @@ long int CAmRoutingAdapterALSAMixerCtrl::getRange(long int & minVol, long int &
         snd_mixer_selem_get_capture_volume_range
     };
 
+    lock();
     int err = snd_mixer_selem_get_volume_range[mDir](mpElem, &minVol, &maxVol);
+    unlock();
     if (err == 0)
     {
         return std::abs(maxVol - minVol);
@@ -226,15 +276,36 @@ int CAmRoutingAdapterALSAMixerCtrl::setVolume(const long int & volume)
         snd_mixer_selem_set_capture_volume_all
     };
 
+    lock();
     int err = snd_mixer_selem_set_volume[mDir](mpElem, volume);
     if (err == 0)
     {
-        return snd_mixer_handle_events(mpHandle);
+        err = snd_mixer_handle_events(mpHandle);
+        unlock();
+        return err;
     }
+    unlock();
     return retWithError("CALSAMixerCtrl::setVolume Set" + strDir[mDir] + "volume of " + mCard + " failed with: ", err);
 }
 
 int CAmRoutingAdapterALSAMixerCtrl::getVolume(long int & volume)
+{
+    /* the mixer may be loaded long ago, apply the changes of other applications and controls first */
+    lock();
+    int err = snd_mixer_handle_events(mpHandle);
+    if (err >= 0)
+    {
+        err = readVolume(volume);
+    }
+    else
+    {
+        err = retWithError("CALSAMixerCtrl::getVolume Handle events of " + mCard + " failed with: ", err);
+    }
+    unlock();
+    return err;
+}
+
+int CAmRoutingAdapterALSAMixerCtrl::readVolume(long int & volume)
 {
     typedef int (*getVolume_t)(snd_mixer_elem_t*, snd_mixer_selem_channel_id_t, long int*);
     static const getVolume_t snd_mixer_selem_get_volume[DIR_MAX] = {
@@ -261,6 +332,22 @@ int CAmRoutingAdapterALSAMixerCtrl::retWithError(const std::string str, const in
     return err;
 }
 
+void CAmRoutingAdapterALSAMixerCtrl::lock()
+{
+    if (mpShared)
+    {
+        pthread_mutex_lock(&mpShared->mutex);
+    }
+}
+
+void CAmRoutingAdapterALSAMixerCtrl::unlock()
+{
+    if (mpShared)
+    {
+        pthread_mutex_unlock(&mpShared->mutex);
+    }
+}
+
 int CAmRoutingAdapterALSAMixerCtrl::cbVolumeChange(const long int & volume)
 {
     (void)volume;
@@ -64,6 +64,8 @@ void CAmRoutingAdapterALSAParser::parseDomainData(ra_domainInfo_s & domainInfo,
     domainInfo.domain.early = converter.kvpQueryValue("early", false);
     domainInfo.domain.state = converter.kvpQueryValue("state", DS_CONTROLLED, am_dsMap);
     domainInfo.pxyNam = converter.kvpQueryValue("pxyNam", static_cast<string>(""));
+    domainInfo.maxWarmProxies = converter.kvpQueryValue("maxWarmProxies", 2);
+    domainInfo.engineThreads = converter.kvpQueryValue("engineThreads", 0);
 }
 
 void CAmRoutingAdapterALSAParser::parseSourceData(ra_sourceInfo_s & info, CAmRoutingAdapterKVPConverter::KVPList & kvpList)
@@ -90,6 +92,10 @@ void CAmRoutingAdapterALSAParser::parseSourceData(ra_sourceInfo_s & info, CAmRou
     src.available.availabilityReason = converter.kvpQueryValue("availabilityReason", AR_UNKNOWN);
     src.interruptState = converter.kvpQueryValue("interruptState", IS_UNKNOWN, am_isMap);
     src.listConnectionFormats = converter.kvpQueryValue("lstConFrmt", DEF_VEC_CONFMT);
+
+    info.peakNtfType = converter.kvpQueryValue("peakNtfType", NT_UNKNOWN);
+    info.rmsNtfType = converter.kvpQueryValue("rmsNtfType", NT_UNKNOWN);
+    addLevelNotifications(src.listNotificationConfigurations, info.peakNtfType, info.rmsNtfType);
 }
 
 void CAmRoutingAdapterALSAParser::parseSinkData(ra_sinkInfo_s & info, CAmRoutingAdapterKVPConverter::KVPList & kvpList)
@@ -116,6 +122,10 @@ void CAmRoutingAdapterALSAParser::parseSinkData(ra_sinkInfo_s & info, CAmRouting
     sink.muteState  = converter.kvpQueryValue("muteState", MS_MUTED, am_msMap);
     sink.mainVolume = converter.kvpQueryValue("mainVolume", AM_MUTE);
     sink.listConnectionFormats = converter.kvpQueryValue("lstConFrmt", DEF_VEC_CONFMT);
+
+    info.peakNtfType = converter.kvpQueryValue("peakNtfType", NT_UNKNOWN);
+    info.rmsNtfType = converter.kvpQueryValue("rmsNtfType", NT_UNKNOWN);
+    addLevelNotifications(sink.listNotificationConfigurations, info.peakNtfType, info.rmsNtfType);
 }
 
 void CAmRoutingAdapterALSAParser::parseGatewayData(ra_gatewayInfo_s & info, CAmRoutingAdapterKVPConverter::KVPList & kvpList)
@@ -138,6 +148,22 @@ void CAmRoutingAdapterALSAParser::parseGatewayData(ra_gatewayInfo_s & info, CAmR
     gw.convertionMatrix = converter.kvpQueryValue("conversionMatrix", DEF_VEC_MATRIX);
 }
 
+void CAmRoutingAdapterALSAParser::parseCrossfaderData(ra_crossfaderInfo_s & info, CAmRoutingAdapterKVPConverter::KVPList & kvpList)
+{
+    CAmRoutingAdapterKVPConverter converter(kvpList, logAmRaDebug, logAmRaError);
+    info.sinkNamA = converter.kvpQueryValue("sinkNamA", static_cast<string>(""));
+    info.sinkNamB = converter.kvpQueryValue("sinkNamB", static_cast<string>(""));
+    info.srcNam = converter.kvpQueryValue("srcNam", static_cast<string>(""));
+
+    am_Crossfader_s & cf = info.amInfo;
+    cf.name = converter.kvpQueryValue("crossfaderNam", static_cast<string>(""));
+    cf.crossfaderID = converter.kvpQueryValue("crossfaderID", 0);
+    cf.hotSink = converter.kvpQueryValue("hotSink", HS_SINKA, am_hsMap);
+    cf.sinkID_A = 0;
+    cf.sinkID_B = 0;
+    cf.sourceID = 0;
+}
+
 void CAmRoutingAdapterALSAParser::parseProxyData(ra_proxyInfo_s & info, CAmRoutingAdapterKVPConverter::KVPList & kvpList)
 {
     vector<uint32_t> DEF_VEC_MATRIX = { 1 };
@@ -164,6 +190,14 @@ void CAmRoutingAdapterALSAParser::parseProxyData(ra_proxyInfo_s & info, CAmRouti
     alsa.msInitTimeout = converter.kvpQueryValue("msInitTimeout", INIT_TOUT);
     alsa.cpuScheduler.policy = converter.kvpQueryValue("CPUSchedulingPolicy", SCHED_OTHER);
     alsa.cpuScheduler.priority = converter.kvpQueryValue("CPUSchedulingPriority", 0);
+    alsa.softVolume = converter.kvpQueryValue("softVolume", false);
+    alsa.mixing = converter.kvpQueryValue("mixing", false);
+    alsa.mmapAccess = (converter.kvpQueryValue("accessMode", static_cast<string>("rw")) == "mmap");
+    alsa.sinkFormat = converter.kvpQueryValue("sinkFormat", -1);
+    alsa.sinkChannels = converter.kvpQueryValue("sinkChannels", 0);
+    alsa.sinkRate = converter.kvpQueryValue("sinkRate", 0);
+    alsa.driftCompensation = converter.kvpQueryValue("driftCompensation", false);
+    alsa.warm = converter.kvpQueryValue("warm", false);
 }
 
 void CAmRoutingAdapterALSAParser::parseUSBData(ra_USBInfo_s & info, CAmRoutingAdapterKVPConverter::KVPList & kvpList)
@@ -214,6 +248,22 @@ void CAmRoutingAdapterALSAParser::parseSoundPropertySpecification(S & info, CAmR
     }
 }
 
+void CAmRoutingAdapterALSAParser::addLevelNotifications(vector<am_NotificationConfiguration_s> & list,
+        const am_CustomNotificationType_t peakType, const am_CustomNotificationType_t rmsType) const
+{
+    for (am_CustomNotificationType_t type : {peakType, rmsType})
+    {
+        if (type != NT_UNKNOWN)
+        {
+            am_NotificationConfiguration_s config;
+            config.type = type;
+            config.status = NS_OFF;
+            config.parameter = 0;
+            list.push_back(config);
+        }
+    }
+}
+
 string CAmRoutingAdapterALSAParser::extractToken(string & str, const string & delimiter) const
 {
     string token("");
@@ -393,6 +443,13 @@ void CAmRoutingAdapterALSAParser::updateGatewayInfo(ra_gatewayInfo_s & gatewayIn
     mpDomainRef->lGatewayInfo.push_back(gatewayInfo);
 }
 
+void CAmRoutingAdapterALSAParser::updateCrossfaderInfo(CAmRoutingAdapterKVPConverter::KVPList & keyValPair)
+{
+    ra_crossfaderInfo_s crossfaderInfo;
+    parseCrossfaderData(crossfaderInfo, keyValPair);
+    mpDomainRef->lCrossfaderInfo.push_back(crossfaderInfo);
+}
+
 void CAmRoutingAdapterALSAParser::updateProxyInfo(CAmRoutingAdapterKVPConverter::KVPList & keyValPair)
 {
     ra_proxyInfo_s proxyInfo;
@@ -454,6 +511,11 @@ void CAmRoutingAdapterALSAParser::parseXML(xmlNodePtr rootNode)
                     gatewayInfo.ctrlDomNam = domain.domain.name;
                     updateGatewayInfo(gatewayInfo, keyValPair);
                 }
+                else if (!xmlStrcmp(elemNode->name, (const xmlChar *) "tCROSSFADER"))
+                {
+                    logAmRaDebug("CRaALSAParser::parseXML", (const char*)elemNode->name);
+                    updateCrossfaderInfo(keyValPair);
+                }
                 else if (!xmlStrcmp(elemNode->name, (const xmlChar *) "tPROXY"))
                 {
                     logAmRaDebug("CRaALSAParser::parseXML", (const char*)elemNode->name);
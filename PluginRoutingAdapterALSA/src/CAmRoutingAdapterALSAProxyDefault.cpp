@@ -29,16 +29,30 @@
 
 
 #include "CAmRoutingAdapterALSAProxyDefault.h"
+#include "CAmRoutingAdapterALSAEngine.h"
+#include "CAmRoutingAdapterALSARtLog.h"
 #include "CAmRaAlsaLogging.h"
 #include <cerrno>
+#include <cinttypes>
+#include <sys/mman.h>
+#include <algorithm>
 
 using namespace am;
 
+/* periods between two measurements of the delay */
+#define RA_DELAY_INTERVAL 16
+
 CAmRoutingAdapterALSAProxyDefault::CAmRoutingAdapterALSAProxyDefault(const ra_Proxy_s & proxy)
-    : IAmRoutingAdapterALSAProxy(proxy) ,mCnt(0), mpCopyBuffer(NULL), mPb(), mCap()
+    : IAmRoutingAdapterALSAProxy(proxy) ,mCnt(0), mpCopyBuffer(NULL), mCopyBufSize(0), mFrameSize(0), mConvert(false),
+      mpConvBuffer(NULL), mConvBufSize(0), mPbFrameSize(0), mPb(), mCap(), mCpuStart(), mWallStart(), mPrepared(false),
+      mpEngine(NULL), mEngineStarted(false), mCapFds(0), mPbFds(0), mWaitPb(false), mpPending(NULL), mPendingFrames(0),
+      mDeadline(0), mTimeoutUs(0), mMmapTransfer(false), mCapPerSize(0),
+      mEngineErr(0)
 {
     logAmRaInfo("CAmRoutingAdapterALSAProxyDefault::CAmRoutingAdapterALSAProxyDefault - Asynchronous implementation");
     ra_Prefill_s.mPreFill = NULL;
+    ra_Prefill_s.pending = false;
+    CAmRoutingAdapterALSARtLog::getInstance().start();
     CAmRoutingAdapterThread::setThreadName("raa_" + mProxy.pcmSrc);
     CAmRoutingAdapterThread::setThreadSched(mProxy.cpuScheduler.policy, mProxy.cpuScheduler.priority);
 }
@@ -47,6 +61,10 @@ CAmRoutingAdapterALSAProxyDefault::~CAmRoutingAdapterALSAProxyDefault()
 {
     stopStreaming();
     closeStreaming();
+    if (mPrepared)
+    {
+        releaseDevices();
+    }
 }
 
 am_Error_e CAmRoutingAdapterALSAProxyDefault::openStreaming()
@@ -54,20 +72,75 @@ am_Error_e CAmRoutingAdapterALSAProxyDefault::openStreaming()
     logAmRaInfo("CRaALSAProxyDefault::openStreaming from", mProxy.pcmSrc, "to", mProxy.pcmSink, this);
     mPb.name = mProxy.pcmSink.c_str();
     mCap.name = mProxy.pcmSrc.c_str();
+    mCap.format = mProxy.format;
+    mCap.channels = mProxy.channels;
+    mCap.rate = mProxy.rate;
 
+    /* the playback runs with the capture configuration if not given otherwise */
+    mPb.format = (mProxy.sinkFormat < 0) ? mProxy.format : static_cast<uint32_t>(mProxy.sinkFormat);
+    mPb.channels = mProxy.sinkChannels ? mProxy.sinkChannels : mProxy.channels;
+    mPb.rate = mProxy.sinkRate ? mProxy.sinkRate : mProxy.rate;
+
+    return am_Error_e::E_OK;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyDefault::prepareStreaming()
+{
+    logAmRaInfo("CRaALSAProxyDefault::prepareStreaming from", mProxy.pcmSrc, "to", mProxy.pcmSink, this);
+    if (mPrepared)
+    {
+        return am_Error_e::E_OK;
+    }
+    if (setupDevices() < 0)
+    {
+        releaseDevices();
+        return am_Error_e::E_NOT_POSSIBLE;
+    }
+    mPrepared = true;
     return am_Error_e::E_OK;
 }
 
 am_Error_e CAmRoutingAdapterALSAProxyDefault::startStreaming()
 {
     logAmRaInfo("CRaALSAProxyDefault::startStreaming", this);
-    startThread();
+    if (mpEngine == NULL)
+    {
+        startThread();
+        return am_Error_e::E_OK;
+    }
+
+    /* the PCMs are set up here instead of the thread, the engine only forwards the periods */
+    if (!mEngineStarted)
+    {
+        int err = initThread();
+        if (err != 0)
+        {
+            deinitThread(err);
+            return am_Error_e::E_OK;
+        }
+        mEngineStarted = true;
+    }
+    mTimeoutUs = 2 * mPerSize * 1000000ULL / mPb.rate;
+    mDeadline = getTimeUs() + mTimeoutUs;
+    mWaitPb = false;
+    mPendingFrames = 0;
+    mEngineErr = mpEngine->attach(this);
+    if (mEngineErr != 0)
+    {
+        logAmRaError("CRaALSAProxyDefault::startStreaming Engine for", mProxy.pcmSrc, "to", mProxy.pcmSink,
+                "failed with", static_cast<int>(mEngineErr));
+    }
     return am_Error_e::E_OK;
 }
 
 am_Error_e CAmRoutingAdapterALSAProxyDefault::stopStreaming()
 {
     logAmRaInfo("CRaALSAProxyDefault::stopStreaming", this);
+    if (mpEngine != NULL)
+    {
+        mpEngine->detach(this);
+        return am_Error_e::E_OK;
+    }
     CAmRoutingAdapterThread::stopThread();
     return am_Error_e::E_OK;
 }
@@ -75,13 +148,79 @@ am_Error_e CAmRoutingAdapterALSAProxyDefault::stopStreaming()
 am_Error_e CAmRoutingAdapterALSAProxyDefault::closeStreaming()
 {
     logAmRaInfo("CRaALSAProxyDefault::closeStreaming", this);
+    if (mpEngine != NULL)
+    {
+        mpEngine->detach(this);
+        if (mEngineStarted)
+        {
+            mEngineStarted = false;
+            deinitThread(0);
+        }
+        return am_Error_e::E_OK;
+    }
     CAmRoutingAdapterThread::joinThread();
     return am_Error_e::E_OK;
 }
 
+void CAmRoutingAdapterALSAProxyDefault::setEngine(CAmRoutingAdapterALSAEngine *engine)
+{
+    mpEngine = engine;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyDefault::setVolume(const am_volume_t volume,
+        const am_CustomRampType_t ramp, const am_time_t time)
+{
+    if (!mProxy.softVolume)
+    {
+        return am_Error_e::E_NOT_POSSIBLE;
+    }
+
+    logAmRaDebug("CRaALSAProxyDefault::setVolume", volume, "ramp", ramp, "time", time, this);
+    mGain.setTarget(volume, ramp, time);
+    return am_Error_e::E_OK;
+}
+
 int CAmRoutingAdapterALSAProxyDefault::initThread()
 {
     logAmRaInfo("CRaALSAProxyDefault::initThread", this);
+    int err = 0;
+    if (!mPrepared && ((err = setupDevices()) < 0))
+    {
+        return err;
+    }
+    if (mProxy.driftCompensation)
+    {
+        mDrift.setup(mPb.rate);
+    }
+    ra_Prefill_s.pending = true;
+    mCap.lastWake = 0;
+    mMmapTransfer = mCap.mmap && mPb.mmap && !mConvert && !mProxy.driftCompensation;
+    mCapLevel.setup(mCap.format, mCap.channels);
+    mPbLevel.setup(mPb.format, mPb.channels);
+
+    /* start streaming */
+    if ((err = snd_pcm_prepare(mPb.hndl)) < 0)
+    {
+        logAmRaError("CRaALSAProxyDefault::WorkerThread Unable to prepare", mPb.name,
+                            ":", snd_strerror(err));
+        return -EFAULT;
+    }
+
+
+
+    if ((err = snd_pcm_start(mCap.hndl)) < 0)
+    {
+        logAmRaError("CRaALSAProxyDefault::WorkerThread Unable to start", mCap.name,
+                            ":", snd_strerror(err));
+        return -EFAULT;
+    }
+
+    startLoadMeasurement();
+    return 0;
+}
+
+int CAmRoutingAdapterALSAProxyDefault::setupDevices()
+{
     int err = 0;
     if ((err = snd_pcm_open(&mPb.hndl, mPb.name, SND_PCM_STREAM_PLAYBACK, SND_PCM_NONBLOCK)) < 0)
     {
@@ -108,7 +247,10 @@ int CAmRoutingAdapterALSAProxyDefault::initThread()
     {
         return -EFAULT;
     }
-    if ((err = setHwBuffSize(mCap, false)) < 0)
+    /* the capture period lasts as long as the playback period, but in frames of the capture rate */
+    mCapPerSize = mPerSize * mCap.rate / mPb.rate;
+    snd_pcm_uframes_t capBufSize = mBufSize * mCap.rate / mPb.rate;
+    if ((err = setHwBuffSize(mCap, mCapPerSize, capBufSize, false)) < 0)
     {
         return -EFAULT;
     }
@@ -129,14 +271,39 @@ int CAmRoutingAdapterALSAProxyDefault::initThread()
         return -EFAULT;
     }
 
-    /* Allocate buffer to hold single period */
-    err = snd_pcm_format_size((snd_pcm_format_t)mProxy.format, 1);
-    size_t copyBufSize = mPerSize * mProxy.channels * err;
-    mpCopyBuffer = (char*)new char[copyBufSize];
+    mConvert = ((mCap.format != mPb.format) || (mCap.channels != mPb.channels) || (mCap.rate != mPb.rate));
+    if (mProxy.mmapAccess && !(mPb.mmap && mCap.mmap && !mConvert && !mProxy.driftCompensation))
+    {
+        logAmRaInfo("CRaALSAProxyDefault::initThread MMAP access not possible on both devices, samples are copied");
+    }
+
+    /* Allocate buffer to hold single period, plus one frame inserted by the drift compensation */
+    err = snd_pcm_format_size((snd_pcm_format_t)mCap.format, 1);
+    mFrameSize = mCap.channels * err;
+    mCopyBufSize = (mCapPerSize + 1) * mFrameSize;
+    mpCopyBuffer = (char*)new char[mCopyBufSize];
+    lockBuffer(mpCopyBuffer, mCopyBufSize);
+    mPbFrameSize = mPb.channels * snd_pcm_format_size((snd_pcm_format_t)mPb.format, 1);
+
+    /* Allocate buffer to hold the converted period */
+    if (mConvert)
+    {
+        if ((err = mConverter.setup(mCap.format, mCap.channels, mCap.rate,
+                                    mPb.format, mPb.channels, mPb.rate, mCapPerSize)) < 0)
+        {
+            logAmRaError("CRaALSAProxyDefault::initThread Conversion from", mCap.rate, "Hz format", mCap.format,
+                    "to", mPb.rate, "Hz format", mPb.format, "not supported:", strerror(-err));
+            return -EFAULT;
+        }
+        mConvBufSize = (mConverter.getMaxOutputFrames() + 1) * mPbFrameSize;
+        mpConvBuffer = new char[mConvBufSize];
+        lockBuffer(mpConvBuffer, mConvBufSize);
+    }
 
     /* Allocate buffer to hold prefill feature */
-    ra_Prefill_s.mPerSize = (mProxy.rate * mProxy.msPrefill) / 1000;
-    ra_Prefill_s.prefillByteSize = ra_Prefill_s.mPerSize * mProxy.channels * err;
+    err = snd_pcm_format_size((snd_pcm_format_t)mPb.format, 1);
+    ra_Prefill_s.mPerSize = (mPb.rate * mProxy.msPrefill) / 1000;
+    ra_Prefill_s.prefillByteSize = ra_Prefill_s.mPerSize * mPb.channels * err;
     if (0 != createPrefill())
     {
         return -EFAULT;
@@ -148,23 +315,60 @@ int CAmRoutingAdapterALSAProxyDefault::initThread()
         return -EFAULT;
     }
 
-    /* start streaming */
-    if ((err = snd_pcm_prepare(mPb.hndl)) < 0)
+    if (mProxy.softVolume && (mGain.setup(mCap.format, mCap.channels, mCap.rate, mCapPerSize) < 0))
     {
-        logAmRaError("CRaALSAProxyDefault::WorkerThread Unable to prepare", mPb.name,
-                            ":", snd_strerror(err));
-        return -EFAULT;
+        logAmRaError("CRaALSAProxyDefault::WorkerThread Software volume not supported for format", mProxy.format);
     }
 
+    return 0;
+}
+
+void CAmRoutingAdapterALSAProxyDefault::startLoadMeasurement()
+{
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &mCpuStart);
+    clock_gettime(CLOCK_MONOTONIC, &mWallStart);
+    mStats.reset();
+}
 
+uint64_t CAmRoutingAdapterALSAProxyDefault::getTimeUs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000ULL + now.tv_nsec / 1000;
+}
 
-    if ((err = snd_pcm_start(mCap.hndl)) < 0)
+void CAmRoutingAdapterALSAProxyDefault::recordWakeup(ap_data_t &device)
+{
+    uint64_t now = getTimeUs();
+    if (device.lastWake != 0)
     {
-        logAmRaError("CRaALSAProxyDefault::WorkerThread Unable to start", mCap.name,
-                            ":", snd_strerror(err));
-        return -EFAULT;
+        int64_t jitter = static_cast<int64_t>(now - device.lastWake) - mPerSize * 1000000LL / mPb.rate;
+        mStats.add(RA_STATS_WAKE_JITTER, static_cast<uint32_t>(jitter < 0 ? -jitter : jitter));
     }
-    return 0;
+    device.lastWake = now;
+}
+
+void CAmRoutingAdapterALSAProxyDefault::measureDelay()
+{
+    snd_pcm_sframes_t pbDelay = 0;
+    if ((snd_pcm_delay(mPb.hndl, &pbDelay) < 0) || (pbDelay < 0))
+    {
+        return;
+    }
+    uint64_t us = pbDelay * 1000000ULL / mPb.rate;
+    if (mCap.hndl)
+    {
+        snd_pcm_sframes_t capAvail = snd_pcm_avail(mCap.hndl);
+        if (capAvail > 0)
+        {
+            us += capAvail * 1000000ULL / mCap.rate;
+        }
+    }
+    if (mConvert)
+    {
+        us += mConverter.getDelay() * 1000ULL;
+    }
+    mStats.setDelay(static_cast<uint32_t>(us));
 }
 
 int CAmRoutingAdapterALSAProxyDefault::createPrefill()
@@ -180,8 +384,10 @@ int CAmRoutingAdapterALSAProxyDefault::createPrefill()
         else
         {
             memset(ra_Prefill_s.mPreFill, 0, ra_Prefill_s.prefillByteSize);
+            lockBuffer(ra_Prefill_s.mPreFill, ra_Prefill_s.prefillByteSize);
         }
     }
+    ra_Prefill_s.pending = true;
     return 0;
 }
 
@@ -189,24 +395,34 @@ void CAmRoutingAdapterALSAProxyDefault::destroyPrefill()
 {
     if (NULL != ra_Prefill_s.mPreFill)
     {
-        delete ra_Prefill_s.mPreFill;
+        unlockBuffer(ra_Prefill_s.mPreFill, ra_Prefill_s.prefillByteSize);
+        delete[] ra_Prefill_s.mPreFill;
     }
     ra_Prefill_s.mPreFill = NULL;
+    ra_Prefill_s.pending = false;
+}
+
+void CAmRoutingAdapterALSAProxyDefault::lockBuffer(void *buffer, size_t size)
+{
+    if (mlock(buffer, size) != 0)
+    {
+        logAmRaInfo("CRaALSAProxyDefault::lockBuffer Unable to lock", static_cast<uint32_t>(size), "bytes:",
+                strerror(errno));
+    }
+}
+
+void CAmRoutingAdapterALSAProxyDefault::unlockBuffer(void *buffer, size_t size)
+{
+    munlock(buffer, size);
 }
 
 int CAmRoutingAdapterALSAProxyDefault::readFromDevice(ap_data_t &device, void *buffer, int sizeOfBuffer)
 {
-    int err = snd_pcm_wait(device.hndl, 2 * mPerSize * 1000 / mProxy.rate); // timeout should be evaluated in respect of period size, let's say twice for certainty
+    int err = snd_pcm_wait(device.hndl, 2 * mPerSize * 1000 / mPb.rate); // timeout should be evaluated in respect of period size, let's say twice for certainty
     if (err == 1)
     {
-        err = snd_pcm_readi(device.hndl, buffer, sizeOfBuffer);
-        /*
-         * If an error occurs, try and recover the device
-         */
-        if (err < 0)
-        {
-            err = prepareWithPrefill(device);
-        }
+        recordWakeup(device);
+        err = readReady(device, buffer, sizeOfBuffer);
     }
     else if (err <= 0)
     {
@@ -216,23 +432,83 @@ int CAmRoutingAdapterALSAProxyDefault::readFromDevice(ap_data_t &device, void *b
     return err;
 }
 
+int CAmRoutingAdapterALSAProxyDefault::readReady(ap_data_t &device, void *buffer, int sizeOfBuffer)
+{
+    int err;
+    uint64_t start = getTimeUs();
+    if (device.mmap)
+    {
+        err = snd_pcm_mmap_readi(device.hndl, buffer, sizeOfBuffer);
+    }
+    else
+    {
+        err = snd_pcm_readi(device.hndl, buffer, sizeOfBuffer);
+    }
+    mStats.add(RA_STATS_READ, static_cast<uint32_t>(getTimeUs() - start));
+    if (err == -EAGAIN)
+    {
+        /* nothing available yet on the non-blocking device */
+        return 0;
+    }
+    /*
+     * If an error occurs, try and recover the device
+     */
+    if (err < 0)
+    {
+        err = prepareWithPrefill(device);
+    }
+    return err;
+}
+
 int CAmRoutingAdapterALSAProxyDefault::writeToDevice(ap_data_t &device, void *buffer, int sizeOfBuffer)
 {
-    int err = snd_pcm_wait(device.hndl, 2 * mPerSize * 1000 / mProxy.rate); // timeout should be evaluated in respect of period size, let's say twice for certainty
-    if (err == 1)
+    /* the non-blocking device may take less than requested, the rest follows once there is space */
+    char *pFrames = static_cast<char*>(buffer);
+    int written = 0;
+    while (written < sizeOfBuffer)
     {
-        err = snd_pcm_writei(device.hndl, buffer, sizeOfBuffer);
-        /*
-         * If an error occurs, try and recover the device
-         */
-        if (err < 0)
+        int err = snd_pcm_wait(device.hndl, 2 * mPerSize * 1000 / mPb.rate); // timeout should be evaluated in respect of period size, let's say twice for certainty
+        if (err == 1)
         {
+            err = writeReady(device, pFrames + snd_pcm_frames_to_bytes(device.hndl, written), sizeOfBuffer - written);
+        }
+        else if (err <= 0)
+        {
+            /* Restart the PCM to prevent LR channel shift */
             err = prepareWithPrefill(device);
         }
+        if (err <= 0)
+        {
+            return (written > 0) ? written : err;
+        }
+        written += err;
     }
-    else if (err <= 0)
+    return written;
+}
+
+int CAmRoutingAdapterALSAProxyDefault::writeReady(ap_data_t &device, void *buffer, int sizeOfBuffer)
+{
+    int err;
+    uint64_t start = getTimeUs();
+    if (device.mmap)
+    {
+        err = snd_pcm_mmap_writei(device.hndl, buffer, sizeOfBuffer);
+    }
+    else
+    {
+        err = snd_pcm_writei(device.hndl, buffer, sizeOfBuffer);
+    }
+    mStats.add(RA_STATS_WRITE, static_cast<uint32_t>(getTimeUs() - start));
+    if (err == -EAGAIN)
+    {
+        /* no space yet on the non-blocking device */
+        return 0;
+    }
+    /*
+     * If an error occurs, try and recover the device
+     */
+    if (err < 0)
     {
-        /* Restart the PCM to prevent LR channel shift */
         err = prepareWithPrefill(device);
     }
     return err;
@@ -245,52 +521,411 @@ int CAmRoutingAdapterALSAProxyDefault::prepareWithPrefill(ap_data_t &device)
     /*
      * Sequence for recovering:
      * 1) Drop/Stop the device
-     * 2) Create Prefill injecting silence for syncing aim on next writing operation
+     * 2) Mark Prefill injecting silence for syncing aim on next writing operation
      * 3) Prepare the device
      * 4) Start the device manually if it's Capture Device
      */
 
-    snd_pcm_drop(device.hndl);
-    err = createPrefill();
-    if (err < 0)
+    if (snd_pcm_state(device.hndl) == SND_PCM_STATE_XRUN)
     {
-        return err;
+        mStats.addXrun();
     }
+    mStats.addRecovery();
+    device.lastWake = 0;
+    snd_pcm_drop(device.hndl);
+    mDrift.reset();
+    ra_Prefill_s.pending = true;
     err = snd_pcm_prepare(device.hndl);
     /* Start device manually only when is Capture device.
      * Playback device will be started automatically when the start_threshold
      * is reached.
      */
-    if (err == 0 && device.hndl == mCap.hndl)
+    if (err == 0 && snd_pcm_stream(device.hndl) == SND_PCM_STREAM_CAPTURE)
     {
         err = snd_pcm_start(device.hndl);
     }
     return err;
 }
 
+int CAmRoutingAdapterALSAProxyDefault::transferMmap(bool wait)
+{
+    int timeout = 2 * mPerSize * 1000 / mPb.rate;
+    int err;
+    if (wait)
+    {
+        err = snd_pcm_wait(mCap.hndl, timeout);
+        if (err <= 0)
+        {
+            return prepareWithPrefill(mCap);
+        }
+        recordWakeup(mCap);
+    }
+    snd_pcm_sframes_t capAvail = snd_pcm_avail_update(mCap.hndl);
+    if (capAvail < 0)
+    {
+        return prepareWithPrefill(mCap);
+    }
+    snd_pcm_sframes_t pbAvail = snd_pcm_avail_update(mPb.hndl);
+    if (wait && (pbAvail >= 0) && (pbAvail < std::min<snd_pcm_sframes_t>(capAvail, mPerSize)))
+    {
+        if (snd_pcm_wait(mPb.hndl, timeout) <= 0)
+        {
+            return prepareWithPrefill(mPb);
+        }
+        pbAvail = snd_pcm_avail_update(mPb.hndl);
+    }
+    if (pbAvail < 0)
+    {
+        return prepareWithPrefill(mPb);
+    }
+
+    const snd_pcm_channel_area_t *capAreas;
+    const snd_pcm_channel_area_t *pbAreas;
+    snd_pcm_uframes_t capOffset;
+    snd_pcm_uframes_t pbOffset;
+    snd_pcm_uframes_t capFrames = std::min<snd_pcm_uframes_t>(mPerSize, std::min(capAvail, pbAvail));
+    snd_pcm_uframes_t pbFrames = capFrames;
+    if (capFrames == 0)
+    {
+        /* without waiting the playback may have no space yet */
+        return 0;
+    }
+    if ((err = snd_pcm_mmap_begin(mCap.hndl, &capAreas, &capOffset, &capFrames)) < 0)
+    {
+        return prepareWithPrefill(mCap);
+    }
+    if ((err = snd_pcm_mmap_begin(mPb.hndl, &pbAreas, &pbOffset, &pbFrames)) < 0)
+    {
+        snd_pcm_mmap_commit(mCap.hndl, capOffset, 0);
+        return prepareWithPrefill(mPb);
+    }
+
+    /* both areas are interleaved, the wrap around of either ring limits the contiguous part */
+    snd_pcm_uframes_t frames = std::min(capFrames, pbFrames);
+    const char *pSrc = static_cast<const char*>(capAreas[0].addr) + (capAreas[0].first + capOffset * capAreas[0].step) / 8;
+    char *pDst = static_cast<char*>(pbAreas[0].addr) + (pbAreas[0].first + pbOffset * pbAreas[0].step) / 8;
+    mCapLevel.analyze(pSrc, frames);
+    memcpy(pDst, pSrc, frames * mFrameSize);
+    if (mProxy.softVolume)
+    {
+        mGain.apply(pDst, frames);
+    }
+    mPbLevel.analyze(pDst, frames);
+
+    snd_pcm_sframes_t committed = snd_pcm_mmap_commit(mCap.hndl, capOffset, frames);
+    if ((committed < 0) || (static_cast<snd_pcm_uframes_t>(committed) != frames))
+    {
+        snd_pcm_mmap_commit(mPb.hndl, pbOffset, 0);
+        return prepareWithPrefill(mCap);
+    }
+    committed = snd_pcm_mmap_commit(mPb.hndl, pbOffset, frames);
+    if ((committed < 0) || (static_cast<snd_pcm_uframes_t>(committed) != frames))
+    {
+        return prepareWithPrefill(mPb);
+    }
+
+    /* contrary to snd_pcm_writei() committing never starts the playback, check the start threshold */
+    if (snd_pcm_state(mPb.hndl) == SND_PCM_STATE_PREPARED)
+    {
+        pbAvail = snd_pcm_avail_update(mPb.hndl);
+        if ((pbAvail >= 0) && (static_cast<snd_pcm_uframes_t>(pbAvail) <= mPerSize))
+        {
+            snd_pcm_start(mPb.hndl);
+        }
+    }
+    return static_cast<int>(frames);
+}
+
+void CAmRoutingAdapterALSAProxyDefault::fallbackToCopy(int err)
+{
+    /* the copy path reads and writes through the mmap access as well, like RW access does */
+    mMmapTransfer = false;
+    CAmRoutingAdapterALSARtLog::getInstance().log(RA_RTLOG_ERROR,
+            "CRaALSAProxyDefault::transferMmap %s to %s failed: %s, samples are copied from now on",
+            mProxy.pcmSrc.c_str(), mProxy.pcmSink.c_str(), snd_strerror(err));
+}
+
+int CAmRoutingAdapterALSAProxyDefault::compensateDrift(char *buffer, int frames, size_t frameSize)
+{
+    snd_pcm_sframes_t pbDelay = 0;
+    snd_pcm_sframes_t capAvail = snd_pcm_avail(mCap.hndl);
+    if ((capAvail < 0) || (snd_pcm_delay(mPb.hndl, &pbDelay) < 0) || (frames < 2))
+    {
+        /* the devices are recovered by the next read or write */
+        return frames;
+    }
+
+    /* the level is counted in frames of the playback */
+    int64_t level = pbDelay + static_cast<int64_t>(capAvail) * mPb.rate / mCap.rate;
+    if ((mCnt % 1000) == 0)
+    {
+        CAmRoutingAdapterALSARtLog::getInstance().log(RA_RTLOG_DEBUG,
+                "CRaALSAProxyDefault::compensateDrift %s level %" PRId64 " drift %d ppm, frames inserted %u dropped %u",
+                mProxy.pcmSrc.c_str(), level, mDrift.getPpm(), mDrift.getInserted(), mDrift.getDropped());
+    }
+    switch (mDrift.update(level, frames))
+    {
+        case 1:
+            memcpy(buffer + frames * frameSize, buffer + (frames - 1) * frameSize, frameSize);
+            return frames + 1;
+        case -1:
+            return frames - 1;
+        default:
+            return frames;
+    }
+}
+
 int CAmRoutingAdapterALSAProxyDefault::workerThread()
 {
     int err;
 
-    err = readFromDevice(mCap, mpCopyBuffer, mPerSize);
-    if (NULL != ra_Prefill_s.mPreFill)
+    if (mMmapTransfer)
     {
-        writeToDevice(mPb, ra_Prefill_s.mPreFill, (mProxy.rate * mProxy.msPrefill) / 1000);
-        destroyPrefill();
+        if (ra_Prefill_s.pending)
+        {
+            ra_Prefill_s.pending = false;
+            writeToDevice(mPb, ra_Prefill_s.mPreFill, ra_Prefill_s.mPerSize);
+        }
+        err = transferMmap();
+        if (err < 0)
+        {
+            fallbackToCopy(err);
+        }
+        if ((mCnt % RA_DELAY_INTERVAL) == 0)
+        {
+            measureDelay();
+        }
+        mCnt++;
+        return 0;
+    }
+
+    err = readFromDevice(mCap, mpCopyBuffer, mCapPerSize);
+    if (ra_Prefill_s.pending)
+    {
+        ra_Prefill_s.pending = false;
+        writeToDevice(mPb, ra_Prefill_s.mPreFill, ra_Prefill_s.mPerSize);
     }
     if (err > 0)
     {
-        err = writeToDevice(mPb, mpCopyBuffer, err);
+        char *pBuffer;
+        err = processPeriod(err, pBuffer);
+        err = writeToDevice(mPb, pBuffer, err);
+    }
+    if ((mCnt % RA_DELAY_INTERVAL) == 0)
+    {
+        measureDelay();
     }
     mCnt++;
 
     return 0;
 }
 
+int CAmRoutingAdapterALSAProxyDefault::processPeriod(int frames, char *&pBuffer)
+{
+    mCapLevel.analyze(mpCopyBuffer, frames);
+    if (mProxy.softVolume)
+    {
+        mGain.apply(mpCopyBuffer, frames);
+    }
+    pBuffer = mpCopyBuffer;
+    size_t frameSize = mFrameSize;
+    if (mConvert)
+    {
+        frames = mConverter.process(mpCopyBuffer, frames, mpConvBuffer);
+        pBuffer = mpConvBuffer;
+        frameSize = mPbFrameSize;
+    }
+    if (mProxy.driftCompensation)
+    {
+        frames = compensateDrift(pBuffer, frames, frameSize);
+    }
+    mPbLevel.analyze(pBuffer, frames);
+    return frames;
+}
+
+int CAmRoutingAdapterALSAProxyDefault::getPollCount()
+{
+    int capFds = snd_pcm_poll_descriptors_count(mCap.hndl);
+    int pbFds = snd_pcm_poll_descriptors_count(mPb.hndl);
+    mCapFds = (capFds > 0) ? capFds : 0;
+    mPbFds = (pbFds > 0) ? pbFds : 0;
+    return static_cast<int>(mCapFds + mPbFds);
+}
+
+void CAmRoutingAdapterALSAProxyDefault::getPollDescriptors(struct pollfd *pfds)
+{
+    snd_pcm_poll_descriptors(mCap.hndl, pfds, mCapFds);
+    snd_pcm_poll_descriptors(mPb.hndl, pfds + mCapFds, mPbFds);
+
+    /* negative descriptors are ignored by poll, even for errors */
+    struct pollfd *pIdle = mWaitPb ? pfds : pfds + mCapFds;
+    uint32_t idle = mWaitPb ? mCapFds : mPbFds;
+    for (uint32_t i = 0; i < idle; i++)
+    {
+        pIdle[i].fd = -1;
+        pIdle[i].revents = 0;
+    }
+}
+
+void CAmRoutingAdapterALSAProxyDefault::serviceStreaming(struct pollfd *pfds, uint64_t now)
+{
+    unsigned short revents = 0;
+
+    if (mWaitPb)
+    {
+        snd_pcm_poll_descriptors_revents(mPb.hndl, pfds + mCapFds, mPbFds, &revents);
+        if (revents == 0)
+        {
+            if (now >= mDeadline)
+            {
+                /* Restart the PCM to prevent LR channel shift */
+                mWaitPb = false;
+                mPendingFrames = 0;
+                mDeadline = now + mTimeoutUs;
+                prepareWithPrefill(mPb);
+            }
+            return;
+        }
+        mWaitPb = false;
+        mDeadline = now + mTimeoutUs;
+        if (mMmapTransfer)
+        {
+            int err = transferMmap(false);
+            if (err < 0)
+            {
+                fallbackToCopy(err);
+            }
+            mWaitPb = (err == 0) &&
+                    (snd_pcm_avail_update(mPb.hndl) < static_cast<snd_pcm_sframes_t>(mPerSize));
+        }
+        else
+        {
+            mWaitPb = writePending();
+        }
+        return;
+    }
+
+    snd_pcm_poll_descriptors_revents(mCap.hndl, pfds, mCapFds, &revents);
+    if (revents == 0)
+    {
+        if (now >= mDeadline)
+        {
+            mDeadline = now + mTimeoutUs;
+            prepareWithPrefill(mCap);
+        }
+        return;
+    }
+    mDeadline = now + mTimeoutUs;
+    recordWakeup(mCap);
+
+    int err = 0;
+    bool mmap = mMmapTransfer;
+    if (!mmap)
+    {
+        err = readReady(mCap, mpCopyBuffer, mCapPerSize);
+    }
+    if (ra_Prefill_s.pending)
+    {
+        /* the playback was just prepared and has space for the prefill */
+        ra_Prefill_s.pending = false;
+        writeReady(mPb, ra_Prefill_s.mPreFill, ra_Prefill_s.mPerSize);
+    }
+    if (mmap)
+    {
+        /* frames which do not fit stay in the capture ring */
+        err = transferMmap(false);
+        if (err < 0)
+        {
+            fallbackToCopy(err);
+        }
+        mWaitPb = (err == 0) &&
+                (snd_pcm_avail_update(mPb.hndl) < static_cast<snd_pcm_sframes_t>(mPerSize));
+    }
+    else if (err > 0)
+    {
+        char *pBuffer;
+        err = processPeriod(err, pBuffer);
+
+        /* like snd_pcm_wait() the playback is ready once avail_min is reached */
+        snd_pcm_sframes_t pbAvail = snd_pcm_avail_update(mPb.hndl);
+        mpPending = pBuffer;
+        mPendingFrames = err;
+        if ((pbAvail >= 0) && (static_cast<snd_pcm_uframes_t>(pbAvail) < mPerSize))
+        {
+            mWaitPb = true;
+        }
+        else
+        {
+            mWaitPb = writePending();
+        }
+    }
+    if ((mCnt % RA_DELAY_INTERVAL) == 0)
+    {
+        measureDelay();
+    }
+    mCnt++;
+}
+
+void CAmRoutingAdapterALSAProxyDefault::engineFailed(int err)
+{
+    logAmRaError("CRaALSAProxyDefault::engineFailed", mProxy.pcmSrc, "to", mProxy.pcmSink,
+            "is not streamed anymore:", strerror(-err));
+    mEngineErr = err;
+}
+
+bool CAmRoutingAdapterALSAProxyDefault::writePending()
+{
+    int err = writeReady(mPb, mpPending, mPendingFrames);
+    if ((err >= 0) && (err < mPendingFrames))
+    {
+        /* a short write, the rest is kept until the playback has space again */
+        mpPending += snd_pcm_frames_to_bytes(mPb.hndl, err);
+        mPendingFrames -= err;
+        return true;
+    }
+    mPendingFrames = 0;
+    return false;
+}
+
 void CAmRoutingAdapterALSAProxyDefault::deinitThread(int errInit)
 {
     logAmRaInfo("CRaALSAProxyDefault::deinitThread", this);
-    (void)errInit;
+    if ((errInit == 0) && (mWallStart.tv_sec != 0))
+    {
+        /* the CPU time of an engine is shared by its proxies, the engine logs it */
+        if (mpEngine == NULL)
+        {
+            struct timespec cpuEnd, wallEnd;
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuEnd);
+            clock_gettime(CLOCK_MONOTONIC, &wallEnd);
+            uint64_t cpuUs = (cpuEnd.tv_sec - mCpuStart.tv_sec) * 1000000ULL + (cpuEnd.tv_nsec - mCpuStart.tv_nsec) / 1000;
+            uint64_t wallUs = (wallEnd.tv_sec - mWallStart.tv_sec) * 1000000ULL + (wallEnd.tv_nsec - mWallStart.tv_nsec) / 1000;
+            logAmRaInfo("CRaALSAProxyDefault::deinitThread", mProxy.pcmSrc, "to", mProxy.pcmSink,
+                    (mCap.mmap && mPb.mmap) ? "mmap" : "rw", "CPU load [0.1%]",
+                    static_cast<uint32_t>(wallUs ? (cpuUs * 1000) / wallUs : 0), "over", static_cast<uint32_t>(wallUs / 1000), "ms");
+        }
+        logAmRaInfo("CRaALSAProxyDefault::deinitThread", mStats.toString());
+        if (mProxy.driftCompensation)
+        {
+            logAmRaInfo("CRaALSAProxyDefault::deinitThread Drift", mDrift.getPpm(), "ppm, frames inserted",
+                    mDrift.getInserted(), "dropped", mDrift.getDropped());
+        }
+    }
+    mWallStart.tv_sec = 0;
+    if (mPrepared)
+    {
+        /* warm proxy, the devices stay configured and prepared for the next start */
+        snd_pcm_drop(mPb.hndl);
+        snd_pcm_drop(mCap.hndl);
+        snd_pcm_prepare(mPb.hndl);
+        snd_pcm_prepare(mCap.hndl);
+        return;
+    }
+    releaseDevices();
+}
+
+void CAmRoutingAdapterALSAProxyDefault::releaseDevices()
+{
     if (mPb.hndl)
     {
         snd_pcm_drop(mPb.hndl);
@@ -309,18 +944,31 @@ void CAmRoutingAdapterALSAProxyDefault::deinitThread(int errInit)
     {
         snd_pcm_hw_params_free(mCap.hwPar);
     }
+    mPb.hndl = NULL;
+    mCap.hndl = NULL;
+    mPb.hwPar = NULL;
+    mCap.hwPar = NULL;
     if (mpCopyBuffer)
     {
-        delete(mpCopyBuffer);
+        unlockBuffer(mpCopyBuffer, mCopyBufSize);
+        delete[] mpCopyBuffer;
     }
+    if (mpConvBuffer)
+    {
+        unlockBuffer(mpConvBuffer, mConvBufSize);
+        delete[] mpConvBuffer;
+    }
+    mpCopyBuffer = NULL;
+    mpConvBuffer = NULL;
     destroyPrefill();
+    mPrepared = false;
 }
 
 int CAmRoutingAdapterALSAProxyDefault::setHwParams(ap_data_t & data)
 {
     int err;
     unsigned int rrate;
-    snd_pcm_format_t format = static_cast<snd_pcm_format_t>(mProxy.format);
+    snd_pcm_format_t format = static_cast<snd_pcm_format_t>(data.format);
     snd_pcm_hw_params_malloc(&data.hwPar);
     err = snd_pcm_hw_params_any(data.hndl, data.hwPar);
     if (err < 0)
@@ -329,12 +977,29 @@ int CAmRoutingAdapterALSAProxyDefault::setHwParams(ap_data_t & data)
                             data.name, ":", snd_strerror(err));
         return err;
     }
-    err = snd_pcm_hw_params_set_access(data.hndl, data.hwPar, SND_PCM_ACCESS_RW_INTERLEAVED);
-    if (err < 0)
+    data.mmap = false;
+    if (mProxy.mmapAccess)
     {
-        logAmRaError("CRaALSAProxyDefault::setHwParams Access type not available for",
-                            data.name,":", snd_strerror(err));
-        return err;
+        err = snd_pcm_hw_params_set_access(data.hndl, data.hwPar, SND_PCM_ACCESS_MMAP_INTERLEAVED);
+        if (err < 0)
+        {
+            logAmRaInfo("CRaALSAProxyDefault::setHwParams MMAP access not available for",
+                                data.name, ", fall back to RW:", snd_strerror(err));
+        }
+        else
+        {
+            data.mmap = true;
+        }
+    }
+    if (!data.mmap)
+    {
+        err = snd_pcm_hw_params_set_access(data.hndl, data.hwPar, SND_PCM_ACCESS_RW_INTERLEAVED);
+        if (err < 0)
+        {
+            logAmRaError("CRaALSAProxyDefault::setHwParams Access type not available for",
+                                data.name,":", snd_strerror(err));
+            return err;
+        }
     }
     err = snd_pcm_hw_params_set_format(data.hndl, data.hwPar, format);
     if (err < 0)
@@ -343,7 +1008,7 @@ int CAmRoutingAdapterALSAProxyDefault::setHwParams(ap_data_t & data)
                             data.name, ":", snd_strerror(err));
         return err;
     }
-    int channels = mProxy.channels;
+    int channels = data.channels;
     err = snd_pcm_hw_params_set_channels(data.hndl, data.hwPar, channels);
     if (err < 0)
     {
@@ -351,7 +1016,7 @@ int CAmRoutingAdapterALSAProxyDefault::setHwParams(ap_data_t & data)
                             data.name, ":", snd_strerror(err));
         return err;
     }
-    rrate = mProxy.rate;
+    rrate = data.rate;
     err = snd_pcm_hw_params_set_rate_near(data.hndl, data.hwPar, &rrate, 0);
     if (err < 0)
     {
@@ -359,10 +1024,10 @@ int CAmRoutingAdapterALSAProxyDefault::setHwParams(ap_data_t & data)
                             data.name, ":", snd_strerror(err));
         return err;
     }
-    if (rrate != mProxy.rate)
+    if (rrate != data.rate)
     {
         logAmRaError("CRaALSAProxyDefault::setHwParams Rate doesn't match (requested",
-                            mProxy.rate, "Hz, got", rrate, "Hz)");
+                            data.rate, "Hz, got", rrate, "Hz)");
         return -EINVAL;
     }
     return 0;
@@ -399,6 +1064,12 @@ bool getNearest(snd_pcm_uframes_t & val, snd_pcm_uframes_t min, snd_pcm_uframes_
 }
 
 int CAmRoutingAdapterALSAProxyDefault::setHwBuffSize(ap_data_t & data, bool firstTry)
+{
+    return setHwBuffSize(data, mPerSize, mBufSize, firstTry);
+}
+
+int CAmRoutingAdapterALSAProxyDefault::setHwBuffSize(ap_data_t & data, snd_pcm_uframes_t & perSize,
+        snd_pcm_uframes_t & bufSize, bool firstTry)
 {
     int err;
     snd_pcm_uframes_t perSizeMin;
@@ -437,29 +1108,29 @@ int CAmRoutingAdapterALSAProxyDefault::setHwBuffSize(ap_data_t & data, bool firs
 
     if (firstTry)
     {
-        err = snd_pcm_format_size((snd_pcm_format_t)mProxy.format, 1);
+        err = snd_pcm_format_size((snd_pcm_format_t)data.format, 1);
         if (err < 0)
         {
-            logAmRaError("CRaALSAProxyDefault::setHwBuffSize Format", mProxy.format, "for", data.name,
+            logAmRaError("CRaALSAProxyDefault::setHwBuffSize Format", data.format, "for", data.name,
                                 "is unsupported");
             return err;
         }
 
-        snd_pcm_uframes_t perSize = (mProxy.rate * mProxy.msBuffersize) / 1000;
-        mPerSize = perSize;
-        if (getNearest(mPerSize, perSizeMin, perSizeMax))
+        snd_pcm_uframes_t wanted = (data.rate * mProxy.msBuffersize) / 1000;
+        perSize = wanted;
+        if (getNearest(perSize, perSizeMin, perSizeMax))
         {
             logAmRaInfo("CRaALSAProxyDefault::setHwBuffSize Period size for", data.name,
-                                "changed from", (uint32_t)perSize, "to", (uint32_t)mPerSize);
+                                "changed from", (uint32_t)wanted, "to", (uint32_t)perSize);
         }
 
-        mBufSize = mPerSize * 3;
-        if (getNearest(mBufSize, bufSizeMin, bufSizeMax))
+        bufSize = perSize * 3;
+        if (getNearest(bufSize, bufSizeMin, bufSizeMax))
         {
             logAmRaInfo("CRaALSAProxyDefault::setHwBuffSize Buffer size for", data.name,
-                                "changed to", (uint32_t)mBufSize);
+                                "changed to", (uint32_t)bufSize);
         }
-        if (mBufSize < (mPerSize * 2))
+        if (bufSize < (perSize * 2))
         {
             logAmRaError("CRaALSAProxyDefault::setHwBuffSize Buffer of device", data.name,
                                 "is too small");
@@ -468,24 +1139,24 @@ int CAmRoutingAdapterALSAProxyDefault::setHwBuffSize(ap_data_t & data, bool firs
     }
     else
     {
-        if (getNearest(mPerSize, perSizeMin, perSizeMax) ||
-            getNearest(mBufSize, bufSizeMin, bufSizeMax))
+        if (getNearest(perSize, perSizeMin, perSizeMax) ||
+            getNearest(bufSize, bufSizeMin, bufSizeMax))
         {
             logAmRaError("CRaALSAProxyDefault::setHwBuffSize Hardware configurations incompatible");
             return -EINVAL;
         }
     }
-    err = snd_pcm_hw_params_set_buffer_size_near(data.hndl, data.hwPar, &mBufSize);
+    err = snd_pcm_hw_params_set_buffer_size_near(data.hndl, data.hwPar, &bufSize);
     if (err < 0)
     {
-        logAmRaError("CRaALSAProxyDefault::setHwBuffSize Unable to set buffer size", (uint32_t)mBufSize,
+        logAmRaError("CRaALSAProxyDefault::setHwBuffSize Unable to set buffer size", (uint32_t)bufSize,
                             "for", data.name, ":", snd_strerror(err));
         return err;
     }
-    err = snd_pcm_hw_params_set_period_size_near(data.hndl, data.hwPar, &mPerSize, NULL);
+    err = snd_pcm_hw_params_set_period_size_near(data.hndl, data.hwPar, &perSize, NULL);
     if (err < 0)
     {
-        logAmRaError("CRaALSAProxyDefault::setHwBuffSize Unable to set period size", (uint32_t)mPerSize,
+        logAmRaError("CRaALSAProxyDefault::setHwBuffSize Unable to set period size", (uint32_t)perSize,
                             "for", data.name, ":", snd_strerror(err));
         return err;
     }
@@ -532,5 +1203,51 @@ int CAmRoutingAdapterALSAProxyDefault::setSwParams(ap_data_t & data)
 
 am_timeSync_t CAmRoutingAdapterALSAProxyDefault::getDelay() const
 {
-    return static_cast<am_timeSync_t>(mProxy.msPrefill + mProxy.msBuffersize);
+    /* until the streaming thread measured the delay the configured one is reported */
+    uint32_t us = mStats.getDelay();
+    if (us != 0)
+    {
+        return static_cast<am_timeSync_t>((us + 500) / 1000);
+    }
+    return static_cast<am_timeSync_t>(mProxy.msPrefill + mProxy.msBuffersize + mConverter.getDelay());
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyDefault::getStatistics(std::string & stats) const
+{
+    stats = mStats.toString();
+    if (mProxy.driftCompensation)
+    {
+        stats += ", drift[ppm] " + std::to_string(mDrift.getPpm()) + " inserted " +
+                 std::to_string(mDrift.getInserted()) + " dropped " + std::to_string(mDrift.getDropped());
+    }
+    if (mEngineErr != 0)
+    {
+        stats += ", engine error " + std::to_string(mEngineErr);
+    }
+    return E_OK;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyDefault::enableLevel(const am_VolumeType_e type, const bool enable)
+{
+    if ((type != VT_SOURCE) && (type != VT_SINK))
+    {
+        return E_NOT_POSSIBLE;
+    }
+    CAmRoutingAdapterALSALevel & level = (type == VT_SOURCE) ? mCapLevel : mPbLevel;
+    if (level.isEnabled() != enable)
+    {
+        level.setEnabled(enable);
+    }
+    return E_OK;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyDefault::getLevel(const am_VolumeType_e type, am_volume_t & peak, am_volume_t & rms)
+{
+    if ((type != VT_SOURCE) && (type != VT_SINK))
+    {
+        return E_NOT_POSSIBLE;
+    }
+    CAmRoutingAdapterALSALevel & level = (type == VT_SOURCE) ? mCapLevel : mPbLevel;
+    level.take(peak, rms);
+    return E_OK;
 }
@@ -0,0 +1,148 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#include <dlfcn.h>
+#include "CAmRoutingAdapterALSAProxyFactory.h"
+#include "TAmPluginTemplate.h"
+#include "CAmRaAlsaLogging.h"
+
+using namespace std;
+using namespace am;
+
+CAmRoutingAdapterALSAProxyFactory::CAmRoutingAdapterALSAProxyFactory()
+{
+}
+
+CAmRoutingAdapterALSAProxyFactory::~CAmRoutingAdapterALSAProxyFactory()
+{
+    for (pair<const string, ra_proxyLibrary_s> & library : mLibraries)
+    {
+        if (library.second.references != 0)
+        {
+            logAmRaInfo("CRaALSAProxyFactory::~CRaALSAProxyFactory", library.first, "still referenced",
+                    library.second.references, "times");
+        }
+        dlclose(library.second.handle);
+    }
+}
+
+bool CAmRoutingAdapterALSAProxyFactory::load(const string & library)
+{
+    return acquire(library) != NULL;
+}
+
+void CAmRoutingAdapterALSAProxyFactory::unload(const string & library)
+{
+    map<string, ra_proxyLibrary_s>::iterator it = mLibraries.find(library);
+    if (it != mLibraries.end())
+    {
+        release(it);
+    }
+}
+
+IAmRoutingAdapterALSAProxy * CAmRoutingAdapterALSAProxyFactory::create(const string & library, const ra_Proxy_s & proxy)
+{
+    ra_proxyLibrary_s *pLibrary = acquire(library);
+    if (pLibrary == NULL)
+    {
+        return NULL;
+    }
+
+    IAmRoutingAdapterALSAProxy *pProxy = pLibrary->create(proxy);
+    if (pProxy == NULL)
+    {
+        logAmRaError("CRaALSAProxyFactory::create", library, "did not create a proxy");
+        unload(library);
+        return NULL;
+    }
+    pProxy->setLibHandle(pLibrary->handle);
+    return pProxy;
+}
+
+void CAmRoutingAdapterALSAProxyFactory::destroy(IAmRoutingAdapterALSAProxy * proxy)
+{
+    if (proxy == NULL)
+    {
+        return;
+    }
+
+    /* the code of the proxy has to stay loaded until it is deleted */
+    void *handle = proxy->getLibHandle();
+    delete proxy;
+    if (handle == NULL)
+    {
+        return;
+    }
+    for (map<string, ra_proxyLibrary_s>::iterator it = mLibraries.begin(); it != mLibraries.end(); ++it)
+    {
+        if (it->second.handle == handle)
+        {
+            release(it);
+            return;
+        }
+    }
+    dlclose(handle);
+}
+
+CAmRoutingAdapterALSAProxyFactory::ra_proxyLibrary_s * CAmRoutingAdapterALSAProxyFactory::acquire(const string & library)
+{
+    map<string, ra_proxyLibrary_s>::iterator it = mLibraries.find(library);
+    if (it != mLibraries.end())
+    {
+        it->second.references++;
+        return &it->second;
+    }
+
+    ra_proxyLibrary_s entry;
+    entry.handle = NULL;
+    entry.create = getCreateFunction<IAmRoutingAdapterALSAProxy*(const ra_Proxy_s &)>(library.c_str(), entry.handle);
+    if (entry.create == NULL)
+    {
+        logAmRaError("CRaALSAProxyFactory::acquire Unable to load", library);
+        if (entry.handle != NULL)
+        {
+            dlclose(entry.handle);
+        }
+        return NULL;
+    }
+    entry.references = 1;
+    logAmRaInfo("CRaALSAProxyFactory::acquire", library, "loaded");
+    return &mLibraries.insert(make_pair(library, entry)).first->second;
+}
+
+void CAmRoutingAdapterALSAProxyFactory::release(map<string, ra_proxyLibrary_s>::iterator it)
+{
+    if (--it->second.references == 0)
+    {
+        logAmRaInfo("CRaALSAProxyFactory::release", it->first, "unloaded");
+        dlclose(it->second.handle);
+        mLibraries.erase(it);
+    }
+}
@@ -0,0 +1,633 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#include <cerrno>
+#include <algorithm>
+#include "CAmRoutingAdapterALSAProxyMixer.h"
+#include "CAmRoutingAdapterALSARtLog.h"
+#include "CAmRaAlsaLogging.h"
+
+using namespace am;
+using namespace std;
+
+/* periods between two measurements of the delay */
+#define RA_MIXER_DELAY_INTERVAL 16
+
+
+CAmRoutingAdapterALSAProxyMixer::CAmRoutingAdapterALSAProxyMixer(const ra_Proxy_s & proxy)
+    : CAmRoutingAdapterALSAProxyDefault(proxy)
+{
+    logAmRaInfo("CRaALSAProxyMixer::CRaALSAProxyMixer for", mProxy.pcmSink);
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+    pthread_mutex_init(&mInputMtx, &attr);
+    pthread_mutex_init(&mMixMtx, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    /* all inputs share the configuration of the playback, there is no conversion */
+    mPb.name = mProxy.pcmSink.c_str();
+    mPb.format = mProxy.format;
+    mPb.channels = mProxy.channels;
+    mPb.rate = mProxy.rate;
+    CAmRoutingAdapterThread::setThreadName("raa_mix_" + mProxy.pcmSink);
+}
+
+CAmRoutingAdapterALSAProxyMixer::~CAmRoutingAdapterALSAProxyMixer()
+{
+    /* join here, the base class can not call the deinitThread() of this class anymore */
+    CAmRoutingAdapterThread::joinThread();
+    for (ra_mixInput_s *pInput : mInputs)
+    {
+        closeInput(pInput);
+    }
+    mInputs.clear();
+    pthread_mutex_destroy(&mMixMtx);
+    pthread_mutex_destroy(&mInputMtx);
+}
+
+bool CAmRoutingAdapterALSAProxyMixer::isCompatible(const ra_Proxy_s & input) const
+{
+    return ((input.format == mProxy.format) && (input.rate == mProxy.rate) && (input.channels == mProxy.channels));
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixer::addInput(const ra_Proxy_s & input)
+{
+    logAmRaInfo("CRaALSAProxyMixer::addInput", input.pcmSrc, "to", mProxy.pcmSink);
+    if (!isCompatible(input))
+    {
+        logAmRaError("CRaALSAProxyMixer::addInput Format, rate or channels of", input.pcmSrc, "differ from", mProxy.pcmSink);
+        return E_WRONG_FORMAT;
+    }
+
+    pthread_mutex_lock(&mInputMtx);
+    bool exists = (findInput(input) != mInputs.end());
+    pthread_mutex_unlock(&mInputMtx);
+    if (exists)
+    {
+        return E_ALREADY_EXISTS;
+    }
+
+    /* the playback defines the period size, start it with the first input */
+    if (CAmRoutingAdapterThread::startThread() != 0)
+    {
+        logAmRaError("CRaALSAProxyMixer::addInput Playback of", mProxy.pcmSink, "can't be started");
+        return E_NOT_POSSIBLE;
+    }
+
+    ra_mixInput_s *pInput = new ra_mixInput_s();
+    pInput->pProxy = &input;
+    pInput->cap.name = input.pcmSrc.c_str();
+    pInput->cap.format = input.format;
+    pInput->cap.channels = input.channels;
+    pInput->cap.rate = input.rate;
+    pInput->pBuffer = NULL;
+    pInput->frames = 0;
+    pInput->side = HS_UNKNOWN;
+
+    /*
+     * The capture has to follow the period and buffer size of the running playback.
+     * They are negotiated on copies, the mixing thread keeps using the sizes of the playback.
+     */
+    snd_pcm_uframes_t perSize = mPerSize;
+    snd_pcm_uframes_t bufSize = mBufSize;
+    int err = snd_pcm_open(&pInput->cap.hndl, pInput->cap.name, SND_PCM_STREAM_CAPTURE, SND_PCM_NONBLOCK);
+    if (err < 0)
+    {
+        logAmRaError("Can't open", pInput->cap.name, "capture device.", snd_strerror(err));
+    }
+    else if ((err = setHwParams(pInput->cap)) < 0)
+    {
+    }
+    else if ((err = setHwBuffSize(pInput->cap, perSize, bufSize, false)) < 0)
+    {
+    }
+    else if (perSize != mPerSize)
+    {
+        logAmRaError("CRaALSAProxyMixer::addInput Period size", (uint32_t)perSize, "of", pInput->cap.name,
+                "differs from", (uint32_t)mPerSize, "of", mProxy.pcmSink);
+        err = -EINVAL;
+    }
+    else if ((err = snd_pcm_hw_params(pInput->cap.hndl, pInput->cap.hwPar)) < 0)
+    {
+        logAmRaError("CRaALSAProxyMixer::addInput Unable to set hw params for", pInput->cap.name,
+                ":", snd_strerror(err));
+    }
+    else if ((err = snd_pcm_start(pInput->cap.hndl)) < 0)
+    {
+        logAmRaError("CRaALSAProxyMixer::addInput Unable to start", pInput->cap.name,
+                ":", snd_strerror(err));
+    }
+
+    if (err < 0)
+    {
+        closeInput(pInput);
+        return E_NOT_POSSIBLE;
+    }
+
+    pInput->pBuffer = new char[mPerSize * mFrameSize];
+    lockBuffer(pInput->pBuffer, mPerSize * mFrameSize);
+    pInput->gain.setup(mProxy.format, mProxy.channels, mProxy.rate, mPerSize);
+    pInput->level.setup(mProxy.format, mProxy.channels);
+
+    /* the mixing thread walks its copy of the inputs without any lock, it must not move */
+    pthread_mutex_lock(&mMixMtx);
+    pthread_mutex_lock(&mInputMtx);
+    mInputs.push_back(pInput);
+    mMixInputs.reserve(mInputs.size());
+    pthread_mutex_unlock(&mInputMtx);
+    pthread_mutex_unlock(&mMixMtx);
+    return E_OK;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixer::removeInput(const ra_Proxy_s & input)
+{
+    logAmRaInfo("CRaALSAProxyMixer::removeInput", input.pcmSrc, "from", mProxy.pcmSink);
+
+    pthread_mutex_lock(&mInputMtx);
+    ra_mixInput_s *pInput = NULL;
+    vector<ra_mixInput_s*>::iterator itr = findInput(input);
+    if (itr != mInputs.end())
+    {
+        pInput = *itr;
+        mInputs.erase(itr);
+    }
+    pthread_mutex_unlock(&mInputMtx);
+
+    if (pInput == NULL)
+    {
+        return E_NON_EXISTENT;
+    }
+
+    /* waits at most for the capture of the period being read right now */
+    pthread_mutex_lock(&mMixMtx);
+    pthread_mutex_unlock(&mMixMtx);
+    closeInput(pInput);
+    return E_OK;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixer::setInputVolume(const ra_Proxy_s & input, const am_volume_t volume,
+        const am_CustomRampType_t ramp, const am_time_t time)
+{
+    am_Error_e error = E_NON_EXISTENT;
+    pthread_mutex_lock(&mInputMtx);
+    vector<ra_mixInput_s*>::iterator itr = findInput(input);
+    if (itr != mInputs.end())
+    {
+        (*itr)->gain.setTarget(volume, ramp, time);
+        error = E_OK;
+    }
+    pthread_mutex_unlock(&mInputMtx);
+    return error;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixer::enableInputLevel(const ra_Proxy_s & input, const bool enable)
+{
+    am_Error_e error = E_NON_EXISTENT;
+    pthread_mutex_lock(&mInputMtx);
+    vector<ra_mixInput_s*>::iterator itr = findInput(input);
+    if (itr != mInputs.end())
+    {
+        if ((*itr)->level.isEnabled() != enable)
+        {
+            (*itr)->level.setEnabled(enable);
+        }
+        error = E_OK;
+    }
+    pthread_mutex_unlock(&mInputMtx);
+    return error;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixer::getInputLevel(const ra_Proxy_s & input, am_volume_t & peak, am_volume_t & rms)
+{
+    am_Error_e error = E_NON_EXISTENT;
+    peak = AM_MUTE;
+    rms = AM_MUTE;
+    pthread_mutex_lock(&mInputMtx);
+    vector<ra_mixInput_s*>::iterator itr = findInput(input);
+    if (itr != mInputs.end())
+    {
+        (*itr)->level.take(peak, rms);
+        error = E_OK;
+    }
+    pthread_mutex_unlock(&mInputMtx);
+    return error;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixer::setInputCrossfade(const ra_Proxy_s & input, const am_HotSink_e side,
+        const am_HotSink_e hotSink)
+{
+    am_Error_e error = E_NON_EXISTENT;
+    pthread_mutex_lock(&mInputMtx);
+    vector<ra_mixInput_s*>::iterator itr = findInput(input);
+    if (itr != mInputs.end())
+    {
+        (*itr)->side = side;
+        error = E_OK;
+    }
+    pthread_mutex_unlock(&mInputMtx);
+
+    /* a running fade already knows better */
+    if ((error == E_OK) && !mCrossfade.isFading())
+    {
+        mCrossfade.setTarget(hotSink, RAMP_GENIVI_DIRECT, 0);
+    }
+    return error;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixer::crossFade(const am_HotSink_e hotSink, const am_CustomRampType_t ramp,
+        const am_time_t time)
+{
+    logAmRaInfo("CRaALSAProxyMixer::crossFade", mProxy.pcmSink, "to", static_cast<int>(hotSink), "in", time, "ms");
+    mCrossfade.setTarget(hotSink, ramp, time);
+    return E_OK;
+}
+
+bool CAmRoutingAdapterALSAProxyMixer::isCrossFading() const
+{
+    return mCrossfade.isFading();
+}
+
+bool CAmRoutingAdapterALSAProxyMixer::canCrossFade() const
+{
+    return true;
+}
+
+am_HotSink_e CAmRoutingAdapterALSAProxyMixer::getHotSink() const
+{
+    return mCrossfade.getHotSink();
+}
+
+int CAmRoutingAdapterALSAProxyMixer::initThread()
+{
+    logAmRaInfo("CRaALSAProxyMixer::initThread", this);
+    int err = snd_pcm_open(&mPb.hndl, mPb.name, SND_PCM_STREAM_PLAYBACK, SND_PCM_NONBLOCK);
+    if (err < 0)
+    {
+        logAmRaError("Can't open", mPb.name, "playback device.", snd_strerror(err));
+        return -EFAULT;
+    }
+
+    if ((setHwParams(mPb) < 0) || (setHwBuffSize(mPb) < 0))
+    {
+        return -EFAULT;
+    }
+    if ((err = snd_pcm_hw_params(mPb.hndl, mPb.hwPar)) < 0)
+    {
+        logAmRaError("CRaALSAProxyMixer::initThread Unable to set hw params for", mPb.name,
+                ":", snd_strerror(err));
+        return -EFAULT;
+    }
+    if (setSwParams(mPb) < 0)
+    {
+        return -EFAULT;
+    }
+
+    /* Allocate buffer to hold the mixed period */
+    err = snd_pcm_format_size((snd_pcm_format_t)mProxy.format, 1);
+    mFrameSize = mProxy.channels * err;
+    mCopyBufSize = mPerSize * mFrameSize;
+    mpCopyBuffer = new char[mCopyBufSize];
+    lockBuffer(mpCopyBuffer, mCopyBufSize);
+    mPbLevel.setup(mProxy.format, mProxy.channels);
+    mCrossfade.setup(mProxy.format, mProxy.channels, mProxy.rate, mPerSize);
+
+    ra_Prefill_s.mPerSize = (mProxy.rate * mProxy.msPrefill) / 1000;
+    ra_Prefill_s.prefillByteSize = ra_Prefill_s.mPerSize * mFrameSize;
+    if (0 != createPrefill())
+    {
+        return -EFAULT;
+    }
+
+    if ((err = snd_pcm_prepare(mPb.hndl)) < 0)
+    {
+        logAmRaError("CRaALSAProxyMixer::initThread Unable to prepare", mPb.name,
+                ":", snd_strerror(err));
+        return -EFAULT;
+    }
+
+    startLoadMeasurement();
+    return 0;
+}
+
+int CAmRoutingAdapterALSAProxyMixer::workerThread()
+{
+    if (ra_Prefill_s.pending)
+    {
+        ra_Prefill_s.pending = false;
+        writeToDevice(mPb, ra_Prefill_s.mPreFill, ra_Prefill_s.mPerSize);
+    }
+
+    /* both sides of the crossfade use the gains of the same period */
+    mCrossfade.advance(mPerSize);
+
+    /*
+     * The captures are read without holding mInputMtx, so that the control thread is not
+     * blocked for a period. Removed inputs are closed only after mMixMtx has been released.
+     */
+    bool first = true;
+    pthread_mutex_lock(&mMixMtx);
+    pthread_mutex_lock(&mInputMtx);
+    mMixInputs.assign(mInputs.begin(), mInputs.end());
+    pthread_mutex_unlock(&mInputMtx);
+
+    for (ra_mixInput_s *pInput : mMixInputs)
+    {
+        pInput->frames = readFromDevice(pInput->cap, pInput->pBuffer, mPerSize);
+    }
+
+    /* gain, level and side of the inputs are changed by the control thread */
+    pthread_mutex_lock(&mInputMtx);
+    for (ra_mixInput_s *pInput : mMixInputs)
+    {
+        if ((pInput->frames > 0) && (find(mInputs.begin(), mInputs.end(), pInput) != mInputs.end()))
+        {
+            pInput->level.analyze(pInput->pBuffer, pInput->frames);
+            mixInput(pInput, pInput->frames, first);
+            first = false;
+        }
+    }
+    pthread_mutex_unlock(&mInputMtx);
+    pthread_mutex_unlock(&mMixMtx);
+
+    /* keep the playback running even without any input */
+    if (first)
+    {
+        memset(mpCopyBuffer, 0, mPerSize * mFrameSize);
+    }
+    mPbLevel.analyze(mpCopyBuffer, mPerSize);
+    writeToDevice(mPb, mpCopyBuffer, mPerSize);
+    if ((mCnt % RA_MIXER_DELAY_INTERVAL) == 0)
+    {
+        measureDelay();
+    }
+    mCnt++;
+
+    return 0;
+}
+
+void CAmRoutingAdapterALSAProxyMixer::deinitThread(int errInit)
+{
+    CAmRoutingAdapterALSAProxyDefault::deinitThread(errInit);
+    mpCopyBuffer = NULL;
+    mPb.hndl = NULL;
+    mPb.hwPar = NULL;
+}
+
+vector<CAmRoutingAdapterALSAProxyMixer::ra_mixInput_s*>::iterator CAmRoutingAdapterALSAProxyMixer::findInput(
+        const ra_Proxy_s & input)
+{
+    return find_if(mInputs.begin(), mInputs.end(),
+            [&](const ra_mixInput_s *pInput)
+            {
+                return pInput->pProxy == &input;
+            });
+}
+
+void CAmRoutingAdapterALSAProxyMixer::closeInput(ra_mixInput_s *pInput)
+{
+    if (pInput->cap.hndl)
+    {
+        snd_pcm_drop(pInput->cap.hndl);
+        snd_pcm_close(pInput->cap.hndl);
+    }
+    if (pInput->cap.hwPar)
+    {
+        snd_pcm_hw_params_free(pInput->cap.hwPar);
+    }
+    if (pInput->pBuffer)
+    {
+        unlockBuffer(pInput->pBuffer, mPerSize * mFrameSize);
+        delete[] pInput->pBuffer;
+    }
+    delete pInput;
+}
+
+void CAmRoutingAdapterALSAProxyMixer::mixInput(ra_mixInput_s *pInput, const int frames, const bool first)
+{
+    /* a short read is filled up with silence to keep all inputs aligned */
+    if (static_cast<snd_pcm_uframes_t>(frames) < mPerSize)
+    {
+        memset(pInput->pBuffer + frames * mFrameSize, 0, (mPerSize - frames) * mFrameSize);
+    }
+
+    pInput->gain.apply(pInput->pBuffer, mPerSize);
+    mCrossfade.apply(pInput->side, pInput->pBuffer, mPerSize);
+    if (first)
+    {
+        memcpy(mpCopyBuffer, pInput->pBuffer, mPerSize * mFrameSize);
+        return;
+    }
+
+    size_t samples = mPerSize * mProxy.channels;
+    switch (mProxy.format)
+    {
+        case SND_PCM_FORMAT_S16_LE:
+            CAmRoutingAdapterALSAGain::mix(reinterpret_cast<int16_t*>(mpCopyBuffer),
+                    reinterpret_cast<const int16_t*>(pInput->pBuffer), samples);
+            break;
+        case SND_PCM_FORMAT_S32_LE:
+            CAmRoutingAdapterALSAGain::mix(reinterpret_cast<int32_t*>(mpCopyBuffer),
+                    reinterpret_cast<const int32_t*>(pInput->pBuffer), samples);
+            break;
+        case SND_PCM_FORMAT_FLOAT_LE:
+            CAmRoutingAdapterALSAGain::mix(reinterpret_cast<float*>(mpCopyBuffer),
+                    reinterpret_cast<const float*>(pInput->pBuffer), samples);
+            break;
+        default:
+            CAmRoutingAdapterALSARtLog::getInstance().log(RA_RTLOG_ERROR,
+                    "CRaALSAProxyMixer::mixInput Format %u can't be mixed", mProxy.format);
+            break;
+    }
+}
+
+
+CAmRoutingAdapterALSAProxyMixerInput::CAmRoutingAdapterALSAProxyMixerInput(const ra_Proxy_s & proxy,
+        shared_ptr<CAmRoutingAdapterALSAProxyMixer> mixer)
+    : IAmRoutingAdapterALSAProxy(proxy), mpMixer(mixer), mStreaming(false), mVolume(0), mLevel(false),
+      mSide(HS_UNKNOWN), mHotSink(HS_UNKNOWN)
+{
+}
+
+CAmRoutingAdapterALSAProxyMixerInput::~CAmRoutingAdapterALSAProxyMixerInput()
+{
+    stopStreaming();
+}
+
+am_timeSync_t CAmRoutingAdapterALSAProxyMixerInput::getDelay() const
+{
+    return mpMixer->getDelay();
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixerInput::getStatistics(std::string & stats) const
+{
+    return mpMixer->getStatistics(stats);
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixerInput::enableLevel(const am_VolumeType_e type, const bool enable)
+{
+    if (type == VT_SINK)
+    {
+        /* all inputs feed the same sink */
+        return mpMixer->enableLevel(type, enable);
+    }
+    if (type != VT_SOURCE)
+    {
+        return E_NOT_POSSIBLE;
+    }
+
+    /* kept for the next start of streaming */
+    mLevel = enable;
+    if (mStreaming)
+    {
+        return mpMixer->enableInputLevel(mProxy, enable);
+    }
+    return E_OK;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixerInput::getLevel(const am_VolumeType_e type, am_volume_t & peak, am_volume_t & rms)
+{
+    if (type == VT_SINK)
+    {
+        return mpMixer->getLevel(type, peak, rms);
+    }
+    if ((type != VT_SOURCE) || !mStreaming)
+    {
+        peak = AM_MUTE;
+        rms = AM_MUTE;
+        return (type == VT_SOURCE) ? E_OK : E_NOT_POSSIBLE;
+    }
+    return mpMixer->getInputLevel(mProxy, peak, rms);
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixerInput::openStreaming()
+{
+    logAmRaInfo("CRaALSAProxyMixerInput::openStreaming from", mProxy.pcmSrc, "to", mProxy.pcmSink, this);
+    return mpMixer->isCompatible(mProxy) ? E_OK : E_WRONG_FORMAT;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixerInput::startStreaming()
+{
+    if (mStreaming)
+    {
+        return E_OK;
+    }
+
+    am_Error_e error = mpMixer->addInput(mProxy);
+    mStreaming = (error == E_OK);
+    if (mStreaming && mProxy.softVolume)
+    {
+        mpMixer->setInputVolume(mProxy, mVolume, RAMP_GENIVI_DIRECT, 0);
+    }
+    if (mStreaming && mLevel)
+    {
+        mpMixer->enableInputLevel(mProxy, true);
+    }
+    if (mStreaming && (mSide != HS_UNKNOWN))
+    {
+        mpMixer->setInputCrossfade(mProxy, mSide, mHotSink);
+    }
+    return error;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixerInput::stopStreaming()
+{
+    if (mStreaming)
+    {
+        mpMixer->removeInput(mProxy);
+        mStreaming = false;
+    }
+    return E_OK;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixerInput::closeStreaming()
+{
+    return stopStreaming();
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixerInput::setVolume(const am_volume_t volume,
+        const am_CustomRampType_t ramp, const am_time_t time)
+{
+    if (!mProxy.softVolume)
+    {
+        return E_NOT_POSSIBLE;
+    }
+
+    /* kept for the next start of streaming */
+    mVolume = volume;
+    if (mStreaming)
+    {
+        return mpMixer->setInputVolume(mProxy, volume, ramp, time);
+    }
+    return E_OK;
+}
+
+void CAmRoutingAdapterALSAProxyMixerInput::setCrossfade(const am_HotSink_e side, const am_HotSink_e hotSink)
+{
+    mSide = side;
+    mHotSink = hotSink;
+}
+
+am_Error_e CAmRoutingAdapterALSAProxyMixerInput::crossFade(const am_HotSink_e hotSink,
+        const am_CustomRampType_t ramp, const am_time_t time)
+{
+    if (mSide == HS_UNKNOWN)
+    {
+        return E_NOT_POSSIBLE;
+    }
+
+    /* kept for the next start of streaming */
+    mHotSink = hotSink;
+    if (mStreaming)
+    {
+        return mpMixer->crossFade(hotSink, ramp, time);
+    }
+    return E_OK;
+}
+
+bool CAmRoutingAdapterALSAProxyMixerInput::isCrossFading() const
+{
+    return mStreaming && mpMixer->isCrossFading();
+}
+
+bool CAmRoutingAdapterALSAProxyMixerInput::canCrossFade() const
+{
+    return mSide != HS_UNKNOWN;
+}
+
+am_HotSink_e CAmRoutingAdapterALSAProxyMixerInput::getHotSink() const
+{
+    if (mSide == HS_UNKNOWN)
+    {
+        return HS_UNKNOWN;
+    }
+    return mStreaming ? mpMixer->getHotSink() : mHotSink;
+}
@@ -0,0 +1,164 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <time.h>
+#include "CAmRoutingAdapterALSARtLog.h"
+#include "CAmRaAlsaLogging.h"
+
+using namespace am;
+
+/* interval the messages are forwarded in */
+#define RA_RTLOG_INTERVAL_MS 100
+
+CAmRoutingAdapterALSARtLog & CAmRoutingAdapterALSARtLog::getInstance()
+{
+    static CAmRoutingAdapterALSARtLog instance;
+    return instance;
+}
+
+CAmRoutingAdapterALSARtLog::CAmRoutingAdapterALSARtLog()
+    : mHead(0)
+    , mTail(0)
+    , mDropped(0)
+    , mReported(0)
+    , mStarted(false)
+{
+    for (size_t i = 0; i < RA_RTLOG_ENTRIES; ++i)
+    {
+        mEntries[i].seq.store(i, std::memory_order_relaxed);
+    }
+    pthread_mutex_init(&mMtx, NULL);
+    CAmRoutingAdapterThread::setThreadName("raa_rt_log");
+}
+
+CAmRoutingAdapterALSARtLog::~CAmRoutingAdapterALSARtLog()
+{
+    CAmRoutingAdapterThread::joinThread();
+    pthread_mutex_destroy(&mMtx);
+}
+
+void CAmRoutingAdapterALSARtLog::start()
+{
+    pthread_mutex_lock(&mMtx);
+    if (!mStarted.load())
+    {
+        mStarted = (CAmRoutingAdapterThread::startThread() == 0);
+    }
+    pthread_mutex_unlock(&mMtx);
+}
+
+void CAmRoutingAdapterALSARtLog::log(const ra_rtLogLevel_e level, const char *format, ...)
+{
+    /* bounded multi producer queue, the sequence of an entry tells if it is free */
+    size_t pos = mHead.load(std::memory_order_relaxed);
+    ra_rtLogEntry_s *pEntry;
+    for (;;)
+    {
+        pEntry = &mEntries[pos & (RA_RTLOG_ENTRIES - 1)];
+        size_t seq = pEntry->seq.load(std::memory_order_acquire);
+        if (seq == pos)
+        {
+            if (mHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (seq < pos)
+        {
+            mDropped++;
+            return;
+        }
+        else
+        {
+            pos = mHead.load(std::memory_order_relaxed);
+        }
+    }
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(pEntry->text, RA_RTLOG_TEXT_LEN, format, args);
+    va_end(args);
+    pEntry->level = level;
+    pEntry->seq.store(pos + 1, std::memory_order_release);
+}
+
+int CAmRoutingAdapterALSARtLog::initThread()
+{
+    return 0;
+}
+
+int CAmRoutingAdapterALSARtLog::workerThread()
+{
+    struct timespec interval = {0, RA_RTLOG_INTERVAL_MS * 1000000L};
+    nanosleep(&interval, NULL);
+    drain();
+    return 0;
+}
+
+void CAmRoutingAdapterALSARtLog::deinitThread(int errInit)
+{
+    (void)errInit;
+}
+
+void CAmRoutingAdapterALSARtLog::drain()
+{
+    for (;;)
+    {
+        ra_rtLogEntry_s & entry = mEntries[mTail & (RA_RTLOG_ENTRIES - 1)];
+        if (entry.seq.load(std::memory_order_acquire) != mTail + 1)
+        {
+            break;
+        }
+
+        switch (entry.level)
+        {
+            case RA_RTLOG_ERROR:
+                logAmRaError(static_cast<const char*>(entry.text));
+                break;
+            case RA_RTLOG_INFO:
+                logAmRaInfo(static_cast<const char*>(entry.text));
+                break;
+            default:
+                logAmRaDebug(static_cast<const char*>(entry.text));
+                break;
+        }
+        entry.seq.store(mTail + RA_RTLOG_ENTRIES, std::memory_order_release);
+        mTail++;
+    }
+
+    uint32_t dropped = mDropped.load();
+    if (dropped != mReported)
+    {
+        logAmRaError("CRaALSARtLog:", dropped - mReported, "messages of streaming threads dropped");
+        mReported = dropped;
+    }
+}
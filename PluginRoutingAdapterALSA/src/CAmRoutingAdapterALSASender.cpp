@@ -31,6 +31,7 @@
 
 #include <sstream>
 #include <algorithm>
+#include <unistd.h>
 #include "CAmRoutingAdapterALSAMixerCtrl.h"
 #include "CAmRoutingAdapterALSASender.h"
 #include "CAmRoutingAdapterALSAParser.h"
@@ -58,7 +59,11 @@ extern "C" void destroyPluginRoutingAdapterALSA(IAmRoutingSend* routingSendInter
 
 CAmRoutingAdapterALSASender::CAmRoutingAdapterALSASender() :
         mpShadow(NULL), mpReceiveInterface(NULL), mpSocketHandler(NULL),
-        mDataBase(this), mBusname(RA_ALSA_BUSNAME),
+        mDataBase(this), mTimingCallback(this, &CAmRoutingAdapterALSASender::publishTiming), mTimingTimer(0),
+        mTimingTicks(0),
+        mLevelCallback(this, &CAmRoutingAdapterALSASender::publishLevels), mLevelTimer(0),
+        mCrossFadeCallback(this, &CAmRoutingAdapterALSASender::publishCrossFades), mCrossFadeTimer(0),
+        mBusname(RA_ALSA_BUSNAME),
         mCommandLineArg("P", "routingAdapterProxyFolder",
                         "Routing Adapter Proxy Folder for Backend Selection. \
                          Please note that the library, configured on XML file, \
@@ -81,18 +86,13 @@ CAmRoutingAdapterALSASender::~CAmRoutingAdapterALSASender()
     mDataBase.getProxyLists(proxies);
     for (IAmRoutingAdapterALSAProxy * proxy : proxies)
     {
-        if (!proxy)
-        {
-            continue;
-        }
-
-        void *dlhandle = proxy->getLibHandle();
-        delete proxy;
-        if (dlhandle)
-        {
-            dlclose(dlhandle);
-        }
+        mProxyFactory.destroy(proxy);
     }
+    for (ra_warmProxy_s & warm : mWarmProxies)
+    {
+        delete warm.proxy;
+    }
+    mWarmProxies.clear();
 
     /* stop all asynchronous operating volumes */
     vector<CAmRoutingAdapterALSAVolume*> volumes;
@@ -288,8 +288,55 @@ void CAmRoutingAdapterALSASender::registerGateway(ra_gatewayInfo_s & info, am_do
     }
 }
 
+void CAmRoutingAdapterALSASender::registerCrossfader(ra_crossfaderInfo_s & info, am_domainID_t domainID)
+{
+    (void) domainID;
+    am_Error_e error = E_OK;
+    am_Crossfader_s & crossfader = info.amInfo;
+
+    /* validate Crossfader Information*/
+    if ((crossfader.name.length() == 0) || (info.sinkNamA.length() == 0) ||
+        (info.sinkNamB.length() == 0) || (info.srcNam.length() == 0))
+    {
+        logAmRaError("CRaALSASender::registerCrossfader Error in Crossfader configuration",
+                         "crossfader or sink or source name not configured!");
+        return;
+    }
+    if (((error = mpReceiveInterface->peekSink(info.sinkNamA, crossfader.sinkID_A)) != E_OK) ||
+        ((error = mpReceiveInterface->peekSink(info.sinkNamB, crossfader.sinkID_B)) != E_OK) ||
+        ((error = mpReceiveInterface->peekSource(info.srcNam, crossfader.sourceID)) != E_OK))
+    {
+        logAmRaError("CRaALSASender::registerCrossfader Error on peek Sink or SourceInformation:", error);
+        return;
+    }
+
+    if ((error = mpShadow->registerCrossfader(crossfader, crossfader.crossfaderID)) != E_OK)
+    {
+        logAmRaError("CRaALSASender::registerCrossfader", "Error on registering crossfader,", crossfader.name, error);
+    }
+}
+
 void CAmRoutingAdapterALSASender::hookDomainRegistrationComplete(am_domainID_t domainID)
 {
+    /* load the proxy libraries of the domain now instead of on each connect */
+    ra_domainInfo_s *pDomain = mDataBase.findDomain(domainID);
+    if (pDomain != NULL)
+    {
+        vector<string> & libraries = mPreloadedLibraries[domainID];
+        for (ra_proxyInfo_s & proxy : pDomain->lProxyInfo)
+        {
+            if (!proxy.pxyNam.empty())
+            {
+                string library = getProxyLibrary(proxy.pxyNam);
+                if (mProxyFactory.load(library))
+                {
+                    libraries.push_back(library);
+                }
+            }
+        }
+        prepareWarmProxies(*pDomain);
+    }
+
     mpShadow->hookDomainRegistrationComplete(domainID);
 }
 
@@ -303,6 +350,12 @@ void CAmRoutingAdapterALSASender::deregisterDomain(const am_domainID_t &domainID
         logAmRaError("Domain with ID =", domainID, " not found");
         return;
     }
+    for (const string & library : mPreloadedLibraries[domainID])
+    {
+        mProxyFactory.unload(library);
+    }
+    mPreloadedLibraries.erase(domainID);
+    releaseWarmProxies(domainID);
     /*
      * Deregister all gateways first
      */
@@ -388,12 +441,36 @@ void CAmRoutingAdapterALSASender::setRoutingReady(const uint16_t handle)
     mpDeviceDetector->enumerateAndRegister();
 #endif /* WITH_DEVICE_DETECTOR */
 
+    timespec interval = {RA_TIMING_INTERVAL_MS / 1000, (RA_TIMING_INTERVAL_MS % 1000) * 1000000L};
+    if (mpSocketHandler->addTimer(interval, &mTimingCallback, mTimingTimer, NULL, true) != E_OK)
+    {
+        logAmRaError("CRaALSASender::setRoutingReady Unable to add the timer publishing the delays");
+        mTimingTimer = 0;
+    }
+
     mpShadow->confirmRoutingReady(handle, E_OK);
 }
 
 void CAmRoutingAdapterALSASender::setRoutingRundown(const uint16_t handle)
 {
     assert(mpReceiveInterface);
+    if (mTimingTimer != 0)
+    {
+        mpSocketHandler->removeTimer(mTimingTimer);
+        mTimingTimer = 0;
+    }
+    if (mLevelTimer != 0)
+    {
+        mpSocketHandler->removeTimer(mLevelTimer);
+        mLevelTimer = 0;
+    }
+    mLevelNotifications.clear();
+    if (mCrossFadeTimer != 0)
+    {
+        mpSocketHandler->removeTimer(mCrossFadeTimer);
+        mCrossFadeTimer = 0;
+    }
+    mCrossFades.clear();
     mDataBase.deregisterDomains();
     mpShadow->confirmRoutingRundown(handle, E_OK);
 }
@@ -413,6 +490,20 @@ am_Error_e CAmRoutingAdapterALSASender::asyncAbort(const am_Handle_s handle)
     assert(mpReceiveInterface);
     assert(handle.handle);
 
+    /* a crossfade is not rolled back, it is only not waited for anymore */
+    vector<ra_crossFade_s>::iterator itCrossFade = find_if(mCrossFades.begin(), mCrossFades.end(),
+            [&](const ra_crossFade_s & crossFade)
+            {
+                return crossFade.handle.handle == handle.handle;
+            });
+    if (itCrossFade != mCrossFades.end())
+    {
+        ra_crossfaderInfo_s *pCrossfader = mDataBase.findCrossfader(itCrossFade->crossfaderID);
+        am_HotSink_e hotSink = (pCrossfader != NULL) ? getHotSink(*pCrossfader) : HS_UNKNOWN;
+        mpShadow->ackCrossFading(handle, hotSink, E_ABORTED);
+        mCrossFades.erase(itCrossFade);
+    }
+
     /* check in list if there is an asynchronous operation in progress */
     vector<CAmRoutingAdapterALSAVolume*> volumes = mDataBase.getVolumeOpList(handle);
     if (!volumes.empty())
@@ -515,27 +606,58 @@ am_Error_e CAmRoutingAdapterALSASender::asyncConnect(const am_Handle_s handle, c
 
             /* Now we are ready to pick up the desired Backend */
 
-            void* tempLibHandle = NULL;
-
+            struct timespec start, end;
+            clock_gettime(CLOCK_MONOTONIC, &start);
             try
             {
-                if (pProxy->pxyNam.empty())
+                /* a warm proxy of this configuration is taken, the others must release shared PCMs */
+                CAmRoutingAdapterALSAProxyDefault *pWarm = NULL;
+                if (pProxy->pxyNam.empty() && !pProxy->alsa.mixing)
+                {
+                    pWarm = takeWarmProxy(pProxy->alsa);
+                }
+                evictWarmProxies(pProxy->alsa);
+
+                if (pWarm != NULL)
+                {
+                    logAmRaInfo("ProxyDefault taken from warm proxies");
+                    pWarm->setEngine(getEngine(*pDomain));
+                    proxy = pWarm;
+                }
+                else if (pProxy->pxyNam.empty() && pProxy->alsa.mixing)
+                {
+                    logAmRaInfo("ProxyMixer input creation");
+                    CAmRoutingAdapterALSAProxyMixerInput *pInput =
+                            new CAmRoutingAdapterALSAProxyMixerInput(pProxy->alsa, getMixer(pProxy->alsa));
+                    ra_crossfaderInfo_s *pCrossfader = mDataBase.findCrossfaderOfSink(sinkID);
+                    if (pCrossfader != NULL)
+                    {
+                        pInput->setCrossfade((pCrossfader->amInfo.sinkID_A == sinkID) ? HS_SINKA : HS_SINKB,
+                                pCrossfader->amInfo.hotSink);
+                    }
+                    proxy = pInput;
+                }
+                else if (pProxy->pxyNam.empty())
                 {
                     logAmRaInfo("ProxyDefault creation");
-                    proxy = new CAmRoutingAdapterALSAProxyDefault(pProxy->alsa);
+                    CAmRoutingAdapterALSAProxyDefault *pDefault = new CAmRoutingAdapterALSAProxyDefault(pProxy->alsa);
+                    pDefault->setEngine(getEngine(*pDomain));
+                    proxy = pDefault;
                 }
                 else
                 {
-                    std::string routingAdapterProxyAbsPath = mCommandLineArg.getValue() + "/lib" + pProxy->pxyNam + ".so";
-                    IAmRoutingAdapterALSAProxy *(*createFunc)(const ra_Proxy_s &);
-                    createFunc = getCreateFunction<IAmRoutingAdapterALSAProxy*(const ra_Proxy_s &)>(routingAdapterProxyAbsPath.c_str(), tempLibHandle);
-                    proxy = createFunc(pProxy->alsa);
-                    proxy->setLibHandle(tempLibHandle);
+                    proxy = mProxyFactory.create(getProxyLibrary(pProxy->pxyNam), pProxy->alsa);
+                    if (proxy == NULL)
+                    {
+                        mpShadow->ackConnect(handle, connectionID, E_NOT_POSSIBLE);
+                        return E_OK;
+                    }
                 }
                 am_Error_e error = proxy->openStreaming();
                 if (error != E_OK)
                 {
                     logAmRaError("CRaALSASender::connect Error in openStreaming", error);
+                    mProxyFactory.destroy(proxy);
                     mpShadow->ackConnect(handle, connectionID, error);
                     return E_OK;
                 }
@@ -546,6 +668,9 @@ am_Error_e CAmRoutingAdapterALSASender::asyncConnect(const am_Handle_s handle, c
                 mpShadow->ackConnect(handle, connectionID, E_NOT_POSSIBLE);
                 return E_OK;
             }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            logAmRaInfo("CRaALSASender::connect Proxy of connection", connectionID, "created and opened in",
+                    static_cast<uint32_t>((end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000), "us");
         }
         else
         {
@@ -566,7 +691,9 @@ am_Error_e CAmRoutingAdapterALSASender::asyncConnect(const am_Handle_s handle, c
             source.amInfo.name, "to", sink.amInfo.name, "registered.");
     if (proxy != NULL)
     {
-        mpShadow->hookTimingInformationChanged(connectionID, proxy->getDelay());
+        proxy->setVolume(getSoftVolume(route), RAMP_GENIVI_DIRECT, 0);
+        mPublishedDelays[connectionID] = proxy->getDelay();
+        mpShadow->hookTimingInformationChanged(connectionID, mPublishedDelays[connectionID]);
     }
 
     /* Domain with source and sink not found */
@@ -583,17 +710,21 @@ am_Error_e CAmRoutingAdapterALSASender::asyncDisconnect(const am_Handle_s handle
     assert(handle.handleType == H_DISCONNECT);
     assert(connectionID);
 
-    if (!mDataBase.findDomainByConnection(connectionID))
+    ra_domainInfo_s *pDomain = mDataBase.findDomainByConnection(connectionID);
+    if (!pDomain)
     {
         mpShadow->ackDisconnect(handle, connectionID, E_NON_EXISTENT);
         return E_OK;
     }
 
     IAmRoutingAdapterALSAProxy * pProxy = mDataBase.getProxyOfConnection(connectionID);
-    void *tempLibHandle = NULL;
     if (pProxy)
     {
-        tempLibHandle = pProxy->getLibHandle();
+        string stats;
+        if (pProxy->getStatistics(stats) == E_OK)
+        {
+            logAmRaInfo("CRaALSASender::asyncDisconnect Connection", connectionID, stats);
+        }
 
         am_Error_e error = pProxy->closeStreaming();
         if (error != E_OK)
@@ -603,12 +734,12 @@ am_Error_e CAmRoutingAdapterALSASender::asyncDisconnect(const am_Handle_s handle
             return E_OK;
         }
     }
-    delete pProxy;
-    if (tempLibHandle)
+    if ((pProxy == NULL) || !parkWarmProxy(pProxy, *pDomain))
     {
-        dlclose(tempLibHandle);
+        mProxyFactory.destroy(pProxy);
     }
     mDataBase.deregisterConnection(connectionID);
+    mPublishedDelays.erase(connectionID);
 
     logAmRaInfo("CRaALSASender::asyncDisconnect Connection", connectionID, "disconnected");
     mpShadow->ackDisconnect(handle, connectionID, E_OK);
@@ -646,7 +777,13 @@ am_Error_e CAmRoutingAdapterALSASender::asyncSetSinkVolume(const am_Handle_s han
         return E_OK;
     }
 
-    if (volume != pSink->amInfo.volume)
+    if ((volume != pSink->amInfo.volume) && pSink->volNam.empty() && mDataBase.isSoftVolume(0, sinkID))
+    {
+        pSink->amInfo.volume = volume;
+        setSoftVolume(0, sinkID, ramp, rampTime);
+        mpShadow->ackSetSinkVolumeChange(handle, volume, E_OK);
+    }
+    else if (volume != pSink->amInfo.volume)
     {
         try
         {
@@ -658,10 +795,15 @@ am_Error_e CAmRoutingAdapterALSASender::asyncSetSinkVolume(const am_Handle_s han
             volumes.time = rampTime;
 
             CAmRoutingAdapterALSAVolume* pVolume = new CAmRoutingAdapterALSAVolume(handle, volumes,
-                    pSink->pcmNam, pSink->volNam, mpReceiveInterface, mpSocketHandler, this);
-            pVolume->startFading();
+                    pSink->pcmNam, pSink->volNam, mpReceiveInterface, mpSocketHandler, this, &mVolumeScheduler,
+                    mDataBase.getVolumeMixers().getHandle(pSink->pcmNam));
+            /* a failed start is acknowledged by the volume, it gets deleted like a finished one */
+            int err = pVolume->startFading();
             mDataBase.registerVolumeOp(handle, pVolume);
-            pSink->amInfo.volume = volume;
+            if (err == 0)
+            {
+                pSink->amInfo.volume = volume;
+            }
         }
         catch (exception& exc)
         {
@@ -708,7 +850,13 @@ am_Error_e CAmRoutingAdapterALSASender::asyncSetSourceVolume(const am_Handle_s h
         return E_OK;
     }
 
-    if (volume != pSrc->amInfo.volume)
+    if ((volume != pSrc->amInfo.volume) && pSrc->volNam.empty() && mDataBase.isSoftVolume(sourceID, 0))
+    {
+        pSrc->amInfo.volume = volume;
+        setSoftVolume(sourceID, 0, ramp, rampTime);
+        mpShadow->ackSetSourceVolumeChange(handle, volume, E_OK);
+    }
+    else if (volume != pSrc->amInfo.volume)
     {
         try
         {
@@ -720,10 +868,15 @@ am_Error_e CAmRoutingAdapterALSASender::asyncSetSourceVolume(const am_Handle_s h
             volumes.time = rampTime;
 
             CAmRoutingAdapterALSAVolume* pVolume = new CAmRoutingAdapterALSAVolume(handle, volumes,
-                    pSrc->pcmNam, pSrc->volNam, mpReceiveInterface, mpSocketHandler, this);
-            pVolume->startFading();
+                    pSrc->pcmNam, pSrc->volNam, mpReceiveInterface, mpSocketHandler, this, &mVolumeScheduler,
+                    mDataBase.getVolumeMixers().getHandle(pSrc->pcmNam));
+            /* a failed start is acknowledged by the volume, it gets deleted like a finished one */
+            int err = pVolume->startFading();
             mDataBase.registerVolumeOp(handle, pVolume);
-            pSrc->amInfo.volume = volume;
+            if (err == 0)
+            {
+                pSrc->amInfo.volume = volume;
+            }
         }
         catch (exception& exc)
         {
@@ -804,9 +957,11 @@ am_Error_e CAmRoutingAdapterALSASender::asyncSetSinkSoundProperty(const am_Handl
     am_SoundPropertyMapping_s soundPropertyMapping;
     soundPropertyMapping.type = soundProperty.type;
     soundPropertyMapping.value = soundProperty.value;
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
     for (auto it = pSink->mapSoundPropertiesToMixer[soundPropertyMapping].begin(); it != pSink->mapSoundPropertiesToMixer[soundPropertyMapping].end(); it++)
     {
-        CAmRoutingAdapterALSAMixerCtrl mixer;
+        CAmRoutingAdapterALSAMixerCtrl mixer(mDataBase.getPropertyMixers().getHandle(pSink->pcmNam));
         int err = mixer.openMixer(pSink->pcmNam, it->mixerName);
         if (err < 0)
         {
@@ -849,6 +1004,9 @@ am_Error_e CAmRoutingAdapterALSASender::asyncSetSinkSoundProperty(const am_Handl
             }
         }
     }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    logAmRaDebug("CRaALSASender::asyncSetSinkSoundProperty Property", soundProperty.type, "of sink", sinkID, "set in",
+            static_cast<uint32_t>((end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000), "us");
 
     mpShadow->ackSetSinkSoundProperty(handle, E_OK);
     return E_OK;
@@ -889,9 +1047,11 @@ am_Error_e CAmRoutingAdapterALSASender::asyncSetSourceSoundProperty(const am_Han
     am_SoundPropertyMapping_s soundPropertyMapping;
     soundPropertyMapping.type = soundProperty.type;
     soundPropertyMapping.value = soundProperty.value;
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
     for (auto it = pSrc->mapSoundPropertiesToMixer[soundPropertyMapping].begin(); it != pSrc->mapSoundPropertiesToMixer[soundPropertyMapping].end(); it++)
     {
-        CAmRoutingAdapterALSAMixerCtrl mixer;
+        CAmRoutingAdapterALSAMixerCtrl mixer(mDataBase.getPropertyMixers().getHandle(pSrc->pcmNam));
         int err = mixer.openMixer(pSrc->pcmNam, it->mixerName);
         if (err < 0)
         {
@@ -934,6 +1094,9 @@ am_Error_e CAmRoutingAdapterALSASender::asyncSetSourceSoundProperty(const am_Han
             }
         }
     }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    logAmRaDebug("CRaALSASender::asyncSetSourceSoundProperty Property", soundProperty.type, "of source", sourceID, "set in",
+            static_cast<uint32_t>((end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000), "us");
     mpShadow->ackSetSourceSoundProperty(handle, E_OK);
     return E_OK;
 }
@@ -952,6 +1115,92 @@ bool CAmRoutingAdapterALSASender::isNumber(const std::string& value)
     }
 }
 
+am_volume_t CAmRoutingAdapterALSASender::getSoftVolume(const am_RoutingElement_s & route)
+{
+    /* elements without mixer control get their volume applied in software */
+    int32_t volume = 0;
+    ra_sourceInfo_s * pSrc = mDataBase.findSource(route.sourceID);
+    if ((pSrc != NULL) && pSrc->volNam.empty())
+    {
+        volume += pSrc->amInfo.volume;
+    }
+    ra_sinkInfo_s * pSink = mDataBase.findSink(route.sinkID);
+    if ((pSink != NULL) && pSink->volNam.empty())
+    {
+        volume += pSink->amInfo.volume;
+    }
+    return static_cast<am_volume_t>(std::max<int32_t>(volume, AM_MUTE));
+}
+
+void CAmRoutingAdapterALSASender::setSoftVolume(const am_sourceID_t sourceID, const am_sinkID_t sinkID,
+                                                const am_CustomRampType_t ramp, const am_time_t time)
+{
+    vector<pair<am_RoutingElement_s, IAmRoutingAdapterALSAProxy*> > proxies;
+    mDataBase.getProxiesOfElement(sourceID, sinkID, proxies);
+    for (pair<am_RoutingElement_s, IAmRoutingAdapterALSAProxy*> & proxy : proxies)
+    {
+        proxy.second->setVolume(getSoftVolume(proxy.first), ramp, time);
+    }
+}
+
+shared_ptr<CAmRoutingAdapterALSAProxyMixer> CAmRoutingAdapterALSASender::getMixer(const ra_Proxy_s & proxy)
+{
+    /* the mixer lives as long as one of its inputs */
+    shared_ptr<CAmRoutingAdapterALSAProxyMixer> mixer = mMixers[proxy.pcmSink].lock();
+    if (!mixer)
+    {
+        mixer = make_shared<CAmRoutingAdapterALSAProxyMixer>(proxy);
+        mMixers[proxy.pcmSink] = mixer;
+    }
+    return mixer;
+}
+
+CAmRoutingAdapterALSAEngine * CAmRoutingAdapterALSASender::getEngine(const ra_domainInfo_s & domain)
+{
+    if (domain.engineThreads == 0)
+    {
+        return NULL;
+    }
+
+    /* the engines live as long as the sender, a negative count binds one engine to each CPU */
+    vector<shared_ptr<CAmRoutingAdapterALSAEngine> > & engines = mEngines[domain.domain.domainID];
+    if (engines.empty())
+    {
+        bool perCpu = (domain.engineThreads < 0);
+        long count = perCpu ? sysconf(_SC_NPROCESSORS_ONLN) : domain.engineThreads;
+        for (long i = 0; i < std::max(count, 1L); i++)
+        {
+            ostringstream name;
+            name << "raa_eng_" << domain.domain.domainID << "_" << i;
+            engines.push_back(make_shared<CAmRoutingAdapterALSAEngine>(name.str(), perCpu ? static_cast<int>(i) : -1));
+        }
+        logAmRaInfo("CRaALSASender::getEngine Domain", domain.domain.name, "streams with", engines.size(), "engines");
+    }
+
+    /* the connected proxies are distributed evenly */
+    map<CAmRoutingAdapterALSAEngine*, uint32_t> load;
+    for (shared_ptr<CAmRoutingAdapterALSAEngine> & engine : engines)
+    {
+        load[engine.get()] = 0;
+    }
+    vector<IAmRoutingAdapterALSAProxy*> proxies;
+    mDataBase.getProxyLists(proxies);
+    for (IAmRoutingAdapterALSAProxy * proxy : proxies)
+    {
+        CAmRoutingAdapterALSAProxyDefault *pDefault = dynamic_cast<CAmRoutingAdapterALSAProxyDefault*>(proxy);
+        if ((pDefault != NULL) && (load.find(pDefault->getEngine()) != load.end()))
+        {
+            load[pDefault->getEngine()]++;
+        }
+    }
+    return min_element(load.begin(), load.end(),
+            [](const pair<CAmRoutingAdapterALSAEngine* const, uint32_t> & a,
+               const pair<CAmRoutingAdapterALSAEngine* const, uint32_t> & b)
+            {
+                return a.second < b.second;
+            })->first;
+}
+
 
 am_Error_e CAmRoutingAdapterALSASender::asyncSetSourceSoundProperties(const am_Handle_s handle, const am_sourceID_t sourceID,
                                                         const vector<am_SoundProperty_s>& listSoundProperties)
@@ -977,13 +1226,136 @@ am_Error_e CAmRoutingAdapterALSASender::asyncCrossFade(const am_Handle_s handle,
     assert(handle.handleType == H_CROSSFADE);
     assert(crossfaderID);
     assert(hotSink);
-    assert(rampType);
-    assert(rampTime);
 
-    mpShadow->ackCrossFading(handle, hotSink, E_NON_EXISTENT);
+    ra_crossfaderInfo_s *pCrossfader = mDataBase.findCrossfader(crossfaderID);
+    if (pCrossfader == NULL)
+    {
+        logAmRaError("CRaALSASender::asyncCrossFade Crossfader", crossfaderID, "is not configured");
+        mpShadow->ackCrossFading(handle, hotSink, E_NON_EXISTENT);
+        return E_OK;
+    }
+    am_Crossfader_s & crossfader = pCrossfader->amInfo;
+    if ((hotSink != HS_SINKA) && (hotSink != HS_SINKB) && (hotSink != HS_INTERMEDIATE))
+    {
+        mpShadow->ackCrossFading(handle, crossfader.hotSink, E_OUT_OF_RANGE);
+        return E_OK;
+    }
+
+    /* the inputs of both sinks are faded by the mixer they are connected to, all have to accept it before any fades */
+    vector<pair<am_RoutingElement_s, IAmRoutingAdapterALSAProxy*> > proxies;
+    mDataBase.getProxiesOfElement(0, crossfader.sinkID_A, proxies);
+    mDataBase.getProxiesOfElement(0, crossfader.sinkID_B, proxies);
+    for (pair<am_RoutingElement_s, IAmRoutingAdapterALSAProxy*> & proxy : proxies)
+    {
+        if (!proxy.second->canCrossFade())
+        {
+            logAmRaError("CRaALSASender::asyncCrossFade Connection of", crossfader.name, "is not mixed");
+            mpShadow->ackCrossFading(handle, getHotSink(*pCrossfader), E_NOT_POSSIBLE);
+            return E_OK;
+        }
+    }
+    for (pair<am_RoutingElement_s, IAmRoutingAdapterALSAProxy*> & proxy : proxies)
+    {
+        if (proxy.second->crossFade(hotSink, rampType, rampTime) != E_OK)
+        {
+            logAmRaError("CRaALSASender::asyncCrossFade Crossfade of", crossfader.name, "failed");
+        }
+    }
+
+    logAmRaInfo("CRaALSASender::asyncCrossFade", crossfader.name, "to", static_cast<int>(hotSink),
+            "in", rampTime, "ms");
+    crossfader.hotSink = hotSink;
+    if (proxies.empty())
+    {
+        /* nothing streaming, the next connection starts at the hot sink */
+        mpShadow->ackCrossFading(handle, hotSink, E_OK);
+        return E_OK;
+    }
+
+    ra_crossFade_s crossFade = {handle, crossfaderID, hotSink};
+    mCrossFades.push_back(crossFade);
+    if (mCrossFadeTimer == 0)
+    {
+        timespec interval = {RA_CROSSFADE_INTERVAL_MS / 1000, (RA_CROSSFADE_INTERVAL_MS % 1000) * 1000000L};
+        if (mpSocketHandler->addTimer(interval, &mCrossFadeCallback, mCrossFadeTimer, NULL, true) != E_OK)
+        {
+            logAmRaError("CRaALSASender::asyncCrossFade Unable to add the timer checking the crossfades");
+            mCrossFadeTimer = 0;
+            mCrossFades.pop_back();
+            mpShadow->ackCrossFading(handle, hotSink, E_NOT_POSSIBLE);
+        }
+    }
     return E_OK;
 }
 
+bool CAmRoutingAdapterALSASender::isCrossFading(const ra_crossfaderInfo_s & crossfader)
+{
+    vector<pair<am_RoutingElement_s, IAmRoutingAdapterALSAProxy*> > proxies;
+    mDataBase.getProxiesOfElement(0, crossfader.amInfo.sinkID_A, proxies);
+    mDataBase.getProxiesOfElement(0, crossfader.amInfo.sinkID_B, proxies);
+    for (pair<am_RoutingElement_s, IAmRoutingAdapterALSAProxy*> & proxy : proxies)
+    {
+        if (proxy.second->isCrossFading())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+am_HotSink_e CAmRoutingAdapterALSASender::getHotSink(const ra_crossfaderInfo_s & crossfader)
+{
+    /* the mixers of both sinks fade on their own, while they disagree the crossfader is in between */
+    vector<pair<am_RoutingElement_s, IAmRoutingAdapterALSAProxy*> > proxies;
+    mDataBase.getProxiesOfElement(0, crossfader.amInfo.sinkID_A, proxies);
+    mDataBase.getProxiesOfElement(0, crossfader.amInfo.sinkID_B, proxies);
+    am_HotSink_e hotSink = HS_UNKNOWN;
+    for (pair<am_RoutingElement_s, IAmRoutingAdapterALSAProxy*> & proxy : proxies)
+    {
+        am_HotSink_e proxyHotSink = proxy.second->getHotSink();
+        if ((proxyHotSink == HS_UNKNOWN) || (proxyHotSink == hotSink))
+        {
+            continue;
+        }
+        if (hotSink != HS_UNKNOWN)
+        {
+            return HS_INTERMEDIATE;
+        }
+        hotSink = proxyHotSink;
+    }
+
+    /* nothing streaming, the last requested hot sink is taken by the next connection */
+    return (hotSink == HS_UNKNOWN) ? crossfader.amInfo.hotSink : hotSink;
+}
+
+void CAmRoutingAdapterALSASender::publishCrossFades(sh_timerHandle_t handle, void *userData)
+{
+    (void) handle;
+    (void) userData;
+
+    /* a disconnected input does not fade anymore, that also completes the crossfade */
+    for (vector<ra_crossFade_s>::iterator itr = mCrossFades.begin(); itr != mCrossFades.end(); )
+    {
+        ra_crossfaderInfo_s *pCrossfader = mDataBase.findCrossfader(itr->crossfaderID);
+        if ((pCrossfader != NULL) && isCrossFading(*pCrossfader))
+        {
+            ++itr;
+            continue;
+        }
+
+        logAmRaDebug("CRaALSASender::publishCrossFades Crossfader", itr->crossfaderID, "reached",
+                static_cast<int>(itr->hotSink));
+        mpShadow->ackCrossFading(itr->handle, itr->hotSink, E_OK);
+        itr = mCrossFades.erase(itr);
+    }
+
+    if (mCrossFades.empty())
+    {
+        mpSocketHandler->removeTimer(mCrossFadeTimer);
+        mCrossFadeTimer = 0;
+    }
+}
+
 am_Error_e CAmRoutingAdapterALSASender::asyncSetVolumes(const am_Handle_s handle, const vector<am_Volumes_s> & volumes)
 {
     assert(mpReceiveInterface);
@@ -1016,9 +1388,26 @@ am_Error_e CAmRoutingAdapterALSASender::asyncSetSinkNotificationConfiguration(
     assert(handle.handleType == H_SETSINKNOTIFICATION);
     assert(sinkID);
 
-    (void)notificationConfiguration;
+    ra_sinkInfo_s * pSink = mDataBase.findSink(sinkID);
+    if (pSink == NULL)
+    {
+        mpShadow->ackSinkNotificationConfiguration(handle, E_NON_EXISTENT);
+        return E_OK;
+    }
 
-    mpShadow->ackSinkNotificationConfiguration(handle, E_NON_EXISTENT);
+    am_Error_e error = setLevelNotification(VT_SINK, sinkID, pSink->peakNtfType, pSink->rmsNtfType,
+            notificationConfiguration);
+    if (error == E_OK)
+    {
+        for (am_NotificationConfiguration_s & config : pSink->amInfo.listNotificationConfigurations)
+        {
+            if (config.type == notificationConfiguration.type)
+            {
+                config = notificationConfiguration;
+            }
+        }
+    }
+    mpShadow->ackSinkNotificationConfiguration(handle, error);
     return E_OK;
 }
 
@@ -1030,9 +1419,26 @@ am_Error_e CAmRoutingAdapterALSASender::asyncSetSourceNotificationConfiguration(
     assert(handle.handleType == H_SETSOURCENOTIFICATION);
     assert(sourceID);
 
-    (void)notificationConfiguration;
+    ra_sourceInfo_s * pSrc = mDataBase.findSource(sourceID);
+    if (pSrc == NULL)
+    {
+        mpShadow->ackSourceNotificationConfiguration(handle, E_NON_EXISTENT);
+        return E_OK;
+    }
 
-    mpShadow->ackSourceNotificationConfiguration(handle, E_NON_EXISTENT);
+    am_Error_e error = setLevelNotification(VT_SOURCE, sourceID, pSrc->peakNtfType, pSrc->rmsNtfType,
+            notificationConfiguration);
+    if (error == E_OK)
+    {
+        for (am_NotificationConfiguration_s & config : pSrc->amInfo.listNotificationConfigurations)
+        {
+            if (config.type == notificationConfiguration.type)
+            {
+                config = notificationConfiguration;
+            }
+        }
+    }
+    mpShadow->ackSourceNotificationConfiguration(handle, error);
     return E_OK;
 }
 
@@ -1041,3 +1447,324 @@ am_Error_e CAmRoutingAdapterALSASender::resyncConnectionState(const am_domainID_
     return E_OK;
 }
 
+void CAmRoutingAdapterALSASender::getStatistics(std::string & stats)
+{
+    vector<pair<am_connectionID_t, IAmRoutingAdapterALSAProxy*> > proxies;
+    mDataBase.getConnectionProxies(proxies);
+    ostringstream text;
+    for (pair<am_connectionID_t, IAmRoutingAdapterALSAProxy*> & proxy : proxies)
+    {
+        string proxyStats;
+        if (proxy.second->getStatistics(proxyStats) == E_OK)
+        {
+            text << "connection " << proxy.first << ": " << proxyStats << "\n";
+        }
+    }
+    stats = text.str();
+}
+
+void CAmRoutingAdapterALSASender::publishTiming(sh_timerHandle_t handle, void *userData)
+{
+    (void)handle;
+    (void)userData;
+
+    /* the proxies measure the delay while streaming, changes are reported to the daemon */
+    vector<pair<am_connectionID_t, IAmRoutingAdapterALSAProxy*> > proxies;
+    mDataBase.getConnectionProxies(proxies);
+    for (pair<am_connectionID_t, IAmRoutingAdapterALSAProxy*> & proxy : proxies)
+    {
+        am_timeSync_t delay = proxy.second->getDelay();
+        am_timeSync_t & published = mPublishedDelays[proxy.first];
+        if (abs(delay - published) >= RA_TIMING_THRESHOLD_MS)
+        {
+            logAmRaDebug("CRaALSASender::publishTiming Connection", proxy.first, "delay", delay, "ms");
+            published = delay;
+            mpShadow->hookTimingInformationChanged(proxy.first, delay);
+        }
+    }
+
+    /* shows how close the running proxies get to an xrun, not only after they are disconnected */
+    if (!proxies.empty() && (++mTimingTicks % RA_STATISTICS_INTERVALS == 0))
+    {
+        string stats;
+        getStatistics(stats);
+        logAmRaInfo("CRaALSASender::publishTiming Statistics\n", stats);
+    }
+}
+
+am_Error_e CAmRoutingAdapterALSASender::setLevelNotification(const am_VolumeType_e elementType, const uint16_t elementID,
+        const am_CustomNotificationType_t peakType, const am_CustomNotificationType_t rmsType,
+        const am_NotificationConfiguration_s & config)
+{
+    if ((config.type == NT_UNKNOWN) || ((config.type != peakType) && (config.type != rmsType)))
+    {
+        return E_NON_EXISTENT;
+    }
+    if ((config.status == NS_UNKNOWN) || (config.status >= NS_MAX))
+    {
+        return E_OUT_OF_RANGE;
+    }
+
+    logAmRaDebug("CRaALSASender::setLevelNotification", (elementType == VT_SINK) ? "sink" : "source", elementID,
+            "type", config.type, "status", config.status, "parameter", config.parameter);
+    auto itr = find_if(mLevelNotifications.begin(), mLevelNotifications.end(),
+            [&](const ra_levelNotification_s & ntf)
+            {
+                return (ntf.elementType == elementType) && (ntf.elementID == elementID) && (ntf.type == config.type);
+            });
+    if (config.status == NS_OFF)
+    {
+        if (itr != mLevelNotifications.end())
+        {
+            mLevelNotifications.erase(itr);
+        }
+        bool used = any_of(mLevelNotifications.begin(), mLevelNotifications.end(),
+                [&](const ra_levelNotification_s & ntf)
+                {
+                    return (ntf.elementType == elementType) && (ntf.elementID == elementID);
+                });
+        if (!used)
+        {
+            enableLevels(elementType, elementID, false);
+        }
+    }
+    else
+    {
+        if (itr == mLevelNotifications.end())
+        {
+            itr = mLevelNotifications.insert(mLevelNotifications.end(), ra_levelNotification_s());
+            itr->elementType = elementType;
+            itr->elementID = elementID;
+            itr->type = config.type;
+            itr->rms = (config.type == rmsType);
+        }
+        itr->notification.configure(config.status, config.parameter);
+        enableLevels(elementType, elementID, true);
+    }
+
+    /* the levels are only polled while a notification is configured */
+    if (!mLevelNotifications.empty() && (mLevelTimer == 0))
+    {
+        timespec interval = {RA_LEVEL_INTERVAL_MS / 1000, (RA_LEVEL_INTERVAL_MS % 1000) * 1000000L};
+        if (mpSocketHandler->addTimer(interval, &mLevelCallback, mLevelTimer, NULL, true) != E_OK)
+        {
+            logAmRaError("CRaALSASender::setLevelNotification Unable to add the timer publishing the levels");
+            mLevelTimer = 0;
+            return E_NOT_POSSIBLE;
+        }
+    }
+    else if (mLevelNotifications.empty() && (mLevelTimer != 0))
+    {
+        mpSocketHandler->removeTimer(mLevelTimer);
+        mLevelTimer = 0;
+    }
+    return E_OK;
+}
+
+void CAmRoutingAdapterALSASender::enableLevels(const am_VolumeType_e elementType, const uint16_t elementID,
+        const bool enable)
+{
+    vector<pair<am_RoutingElement_s, IAmRoutingAdapterALSAProxy*> > proxies;
+    mDataBase.getProxiesOfElement((elementType == VT_SOURCE) ? elementID : 0,
+            (elementType == VT_SINK) ? elementID : 0, proxies);
+    for (pair<am_RoutingElement_s, IAmRoutingAdapterALSAProxy*> & proxy : proxies)
+    {
+        proxy.second->enableLevel(elementType, enable);
+    }
+}
+
+void CAmRoutingAdapterALSASender::publishLevels(sh_timerHandle_t handle, void *userData)
+{
+    (void)handle;
+    (void)userData;
+
+    /* taking a level resets it, peak and RMS notifications of an element share one reading */
+    map<pair<am_VolumeType_e, uint16_t>, pair<am_volume_t, am_volume_t> > levels;
+    for (ra_levelNotification_s & ntf : mLevelNotifications)
+    {
+        pair<am_VolumeType_e, uint16_t> key(ntf.elementType, ntf.elementID);
+        auto level = levels.find(key);
+        if (level == levels.end())
+        {
+            am_volume_t peak = AM_MUTE;
+            am_volume_t rms = AM_MUTE;
+            vector<pair<am_RoutingElement_s, IAmRoutingAdapterALSAProxy*> > proxies;
+            mDataBase.getProxiesOfElement((ntf.elementType == VT_SOURCE) ? ntf.elementID : 0,
+                    (ntf.elementType == VT_SINK) ? ntf.elementID : 0, proxies);
+            for (pair<am_RoutingElement_s, IAmRoutingAdapterALSAProxy*> & proxy : proxies)
+            {
+                /* connections made after the configuration start measuring now */
+                am_volume_t proxyPeak, proxyRms;
+                proxy.second->enableLevel(ntf.elementType, true);
+                if (proxy.second->getLevel(ntf.elementType, proxyPeak, proxyRms) == E_OK)
+                {
+                    peak = max(peak, proxyPeak);
+                    rms = max(rms, proxyRms);
+                }
+            }
+            level = levels.insert(make_pair(key, make_pair(peak, rms))).first;
+        }
+
+        am_volume_t value;
+        am_volume_t measured = ntf.rms ? level->second.second : level->second.first;
+        if (!ntf.notification.check(measured, RA_LEVEL_INTERVAL_MS, value))
+        {
+            continue;
+        }
+
+        am_NotificationPayload_s payload;
+        payload.type = ntf.type;
+        payload.value = value;
+        if (ntf.elementType == VT_SINK)
+        {
+            mpShadow->hookSinkNotificationDataChange(ntf.elementID, payload);
+        }
+        else
+        {
+            mpShadow->hookSourceNotificationDataChange(ntf.elementID, payload);
+        }
+    }
+}
+
+string CAmRoutingAdapterALSASender::getProxyLibrary(const string & pxyNam)
+{
+    return mCommandLineArg.getValue() + "/lib" + pxyNam + ".so";
+}
+
+void CAmRoutingAdapterALSASender::prepareWarmProxies(ra_domainInfo_s & domain)
+{
+    for (ra_proxyInfo_s & info : domain.lProxyInfo)
+    {
+        if (!info.alsa.warm)
+        {
+            continue;
+        }
+        if (!info.pxyNam.empty() || info.alsa.mixing)
+        {
+            logAmRaInfo("CRaALSASender::prepareWarmProxies Proxy from", info.srcNam, "to", info.sinkNam,
+                    "can't be warm, only available for the default proxy");
+            continue;
+        }
+        if (countWarmProxies(domain.domain.domainID) >= domain.maxWarmProxies)
+        {
+            logAmRaInfo("CRaALSASender::prepareWarmProxies Domain", domain.domain.name, "has no budget left for",
+                    info.srcNam, "to", info.sinkNam);
+            break;
+        }
+
+        /* the PCMs are set up with the first configuration of the conversion matrix */
+        vector<uint32_t>::const_iterator pos = find_if(info.convertionMatrix.begin(), info.convertionMatrix.end(),
+                [](const uint32_t conv) { return conv > 0; });
+        if (pos == info.convertionMatrix.end())
+        {
+            continue;
+        }
+        uint32_t conv = *pos - 1;
+        if ((conv >= info.listPcmFormats.size()) || (conv >= info.listRates.size()) || (conv >= info.listChannels.size()))
+        {
+            continue;
+        }
+        info.alsa.format = info.listPcmFormats[conv];
+        info.alsa.rate = info.listRates[conv];
+        info.alsa.channels = info.listChannels[conv];
+
+        CAmRoutingAdapterALSAProxyDefault *pProxy = new CAmRoutingAdapterALSAProxyDefault(info.alsa);
+        if ((pProxy->openStreaming() != E_OK) || (pProxy->prepareStreaming() != E_OK))
+        {
+            logAmRaError("CRaALSASender::prepareWarmProxies Unable to prepare", info.alsa.pcmSrc, "to", info.alsa.pcmSink);
+            delete pProxy;
+            continue;
+        }
+        ra_warmProxy_s warm = {pProxy, domain.domain.domainID, info.alsa.format, info.alsa.channels, info.alsa.rate};
+        mWarmProxies.push_back(warm);
+    }
+}
+
+CAmRoutingAdapterALSAProxyDefault * CAmRoutingAdapterALSASender::takeWarmProxy(const ra_Proxy_s & proxy)
+{
+    for (vector<ra_warmProxy_s>::iterator it = mWarmProxies.begin(); it != mWarmProxies.end(); ++it)
+    {
+        if (&it->proxy->getConfiguration() != &proxy)
+        {
+            continue;
+        }
+
+        CAmRoutingAdapterALSAProxyDefault *pProxy = it->proxy;
+        bool match = (it->format == proxy.format) && (it->channels == proxy.channels) && (it->rate == proxy.rate);
+        mWarmProxies.erase(it);
+        if (!match)
+        {
+            /* set up for another connection format, the PCMs are needed for the new configuration */
+            delete pProxy;
+            return NULL;
+        }
+        return pProxy;
+    }
+    return NULL;
+}
+
+bool CAmRoutingAdapterALSASender::parkWarmProxy(IAmRoutingAdapterALSAProxy * proxy, const ra_domainInfo_s & domain)
+{
+    CAmRoutingAdapterALSAProxyDefault *pProxy = dynamic_cast<CAmRoutingAdapterALSAProxyDefault*>(proxy);
+    if ((pProxy == NULL) || (pProxy->getLibHandle() != NULL) || !pProxy->getConfiguration().warm ||
+        pProxy->getConfiguration().mixing)
+    {
+        return false;
+    }
+    if (countWarmProxies(domain.domain.domainID) >= domain.maxWarmProxies)
+    {
+        return false;
+    }
+    if (pProxy->prepareStreaming() != E_OK)
+    {
+        return false;
+    }
+
+    const ra_Proxy_s & config = pProxy->getConfiguration();
+    ra_warmProxy_s warm = {pProxy, domain.domain.domainID, config.format, config.channels, config.rate};
+    mWarmProxies.push_back(warm);
+    logAmRaInfo("CRaALSASender::parkWarmProxy Proxy from", config.pcmSrc, "to", config.pcmSink, "parked");
+    return true;
+}
+
+void CAmRoutingAdapterALSASender::evictWarmProxies(const ra_Proxy_s & proxy)
+{
+    vector<ra_warmProxy_s>::iterator it = mWarmProxies.begin();
+    while (it != mWarmProxies.end())
+    {
+        const ra_Proxy_s & config = it->proxy->getConfiguration();
+        if ((config.pcmSrc == proxy.pcmSrc) || (config.pcmSink == proxy.pcmSink))
+        {
+            logAmRaInfo("CRaALSASender::evictWarmProxies Proxy from", config.pcmSrc, "to", config.pcmSink, "released");
+            delete it->proxy;
+            it = mWarmProxies.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void CAmRoutingAdapterALSASender::releaseWarmProxies(const am_domainID_t domainID)
+{
+    vector<ra_warmProxy_s>::iterator it = mWarmProxies.begin();
+    while (it != mWarmProxies.end())
+    {
+        if (it->domainID == domainID)
+        {
+            delete it->proxy;
+            it = mWarmProxies.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+uint32_t CAmRoutingAdapterALSASender::countWarmProxies(const am_domainID_t domainID) const
+{
+    return static_cast<uint32_t>(count_if(mWarmProxies.begin(), mWarmProxies.end(),
+            [domainID](const ra_warmProxy_s & warm) { return warm.domainID == domainID; }));
+}
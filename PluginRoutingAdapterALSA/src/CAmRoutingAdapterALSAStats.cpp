@@ -0,0 +1,175 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#include <sstream>
+#include "CAmRoutingAdapterALSAStats.h"
+
+using namespace std;
+using namespace am;
+
+/*
+ * The values are only written by the streaming thread, so the counters are
+ * incremented by a plain load and store instead of a locked read-modify-write.
+ */
+static inline void increment(atomic<uint32_t> & value)
+{
+    value.store(value.load(memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+CAmRoutingAdapterALSAHistogram::CAmRoutingAdapterALSAHistogram()
+{
+    reset();
+}
+
+void CAmRoutingAdapterALSAHistogram::reset()
+{
+    for (atomic<uint32_t> & bucket : mBuckets)
+    {
+        bucket.store(0, memory_order_relaxed);
+    }
+    mCount.store(0, memory_order_relaxed);
+    mMax.store(0, memory_order_relaxed);
+    mSum.store(0, memory_order_relaxed);
+}
+
+void CAmRoutingAdapterALSAHistogram::add(const uint32_t us)
+{
+    uint32_t bucket = (us == 0) ? 0 : 32 - __builtin_clz(us);
+    if (bucket >= RA_STATS_BUCKETS)
+    {
+        bucket = RA_STATS_BUCKETS - 1;
+    }
+    increment(mBuckets[bucket]);
+    if (us > mMax.load(memory_order_relaxed))
+    {
+        mMax.store(us, memory_order_relaxed);
+    }
+    mSum.store(mSum.load(memory_order_relaxed) + us, memory_order_relaxed);
+    /* the count is written last, a reader never sees more values counted than summed */
+    mCount.store(mCount.load(memory_order_relaxed) + 1, memory_order_release);
+}
+
+uint32_t CAmRoutingAdapterALSAHistogram::getCount() const
+{
+    return mCount.load(memory_order_acquire);
+}
+
+uint32_t CAmRoutingAdapterALSAHistogram::getMax() const
+{
+    return mMax.load(memory_order_relaxed);
+}
+
+uint32_t CAmRoutingAdapterALSAHistogram::getMean() const
+{
+    uint32_t count = getCount();
+    return count ? static_cast<uint32_t>(mSum.load(memory_order_relaxed) / count) : 0;
+}
+
+uint32_t CAmRoutingAdapterALSAHistogram::getPercentile(const uint32_t percent) const
+{
+    uint32_t counts[RA_STATS_BUCKETS];
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < RA_STATS_BUCKETS; i++)
+    {
+        counts[i] = mBuckets[i].load(memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    uint64_t rank = (total * percent + 99) / 100;
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < RA_STATS_BUCKETS - 1; i++)
+    {
+        sum += counts[i];
+        if (sum >= rank)
+        {
+            return (1u << i) - 1;
+        }
+    }
+    return getMax();
+}
+
+string CAmRoutingAdapterALSAHistogram::toString() const
+{
+    ostringstream text;
+    text << "n=" << getCount() << " mean=" << getMean() << " p50<=" << getPercentile(50)
+         << " p99<=" << getPercentile(99) << " max=" << getMax();
+    return text.str();
+}
+
+CAmRoutingAdapterALSAStats::CAmRoutingAdapterALSAStats()
+{
+    reset();
+}
+
+void CAmRoutingAdapterALSAStats::reset()
+{
+    for (CAmRoutingAdapterALSAHistogram & histogram : mHistograms)
+    {
+        histogram.reset();
+    }
+    mXruns.store(0, memory_order_relaxed);
+    mRecoveries.store(0, memory_order_relaxed);
+    mDelay.store(0, memory_order_relaxed);
+    mMaxDelay.store(0, memory_order_relaxed);
+}
+
+void CAmRoutingAdapterALSAStats::addXrun()
+{
+    increment(mXruns);
+}
+
+void CAmRoutingAdapterALSAStats::addRecovery()
+{
+    increment(mRecoveries);
+}
+
+void CAmRoutingAdapterALSAStats::setDelay(const uint32_t us)
+{
+    mDelay.store(us, memory_order_relaxed);
+    if (us > mMaxDelay.load(memory_order_relaxed))
+    {
+        mMaxDelay.store(us, memory_order_relaxed);
+    }
+}
+
+string CAmRoutingAdapterALSAStats::toString() const
+{
+    ostringstream text;
+    text << "jitter[us] " << mHistograms[RA_STATS_WAKE_JITTER].toString()
+         << ", read[us] " << mHistograms[RA_STATS_READ].toString()
+         << ", write[us] " << mHistograms[RA_STATS_WRITE].toString()
+         << ", xruns " << getXruns() << ", recoveries " << getRecoveries()
+         << ", delay[us] " << getDelay() << " max " << getMaxDelay();
+    return text.str();
+}
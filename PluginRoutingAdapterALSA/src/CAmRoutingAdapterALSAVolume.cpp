@@ -51,8 +51,10 @@ T calc_exp(T i, long int &sign, long int &steps, long int logArgument)
 
 CAmRoutingAdapterALSAVolume::CAmRoutingAdapterALSAVolume(am_Handle_s handle, am_Volumes_s volumes,
         std::string pcmName, std::string volName, IAmRoutingReceive* routingInterface,
-        CAmSocketHandler* socketHandler, IAmRoutingReceiverObserver* observer)
-    : CAmRoutingAdapterThread(), mHandle(handle), mVolInfo(volumes), mShadow(routingInterface, socketHandler, observer)
+        CAmSocketHandler* socketHandler, IAmRoutingReceiverObserver* observer,
+        CAmRoutingAdapterALSAVolumeScheduler* scheduler, std::shared_ptr<ra_mixerHandle_s> mixer)
+    : CAmRoutingAdapterALSAMixerCtrl(mixer), mHandle(handle), mVolInfo(volumes), mShadow(routingInterface, socketHandler, observer),
+      mpScheduler(scheduler), mElementName(pcmName + ":" + volName)
 {
     int err = CAmRoutingAdapterALSAMixerCtrl::openMixer(pcmName, volName);
     if (err < 0)
@@ -62,15 +64,19 @@ CAmRoutingAdapterALSAVolume::CAmRoutingAdapterALSAVolume(am_Handle_s handle, am_
         throw runtime_error(CAmRoutingAdapterALSAMixerCtrl::getStrError());
     }
     CAmRoutingAdapterALSAMixerCtrl::activateVolumeChangeNotification();
-    CAmRoutingAdapterThread::setThreadSched(SCHED_FIFO, 80);
-    CAmRoutingAdapterThread::setThreadName("raa_vol_" + volName);
+    mRampItr = mRamp.end();
 }
 
 CAmRoutingAdapterALSAVolume::~CAmRoutingAdapterALSAVolume()
 {
+    /* a ramp still running is aborted */
+    if (mpScheduler->removeRamp(this))
+    {
+        sendAcknowledge(0);
+    }
 }
 
-int CAmRoutingAdapterALSAVolume::initThread()
+int CAmRoutingAdapterALSAVolume::prepareRamp()
 {
     /* this call prepares the member values to calculate the requested ramp */
     int err = prepareRampCalc();
@@ -97,27 +103,35 @@ int CAmRoutingAdapterALSAVolume::initThread()
     return err;
 }
 
-int CAmRoutingAdapterALSAVolume::workerThread()
+int CAmRoutingAdapterALSAVolume::executeStep()
 {
-    /* force an ABORT of workerThread() in case ramp is fully executed */
+    /* report the end of ramp in case it is fully executed */
     int err = mRamp.size();
 
     if (mRampItr != mRamp.end())
     {
-        usleep(mRampItr->time);
         err = std::min(0, CAmRoutingAdapterALSAMixerCtrl::setVolume(mRampItr->alsaVolume));
         if (err == 0)
         {
             mRampItr++;
+            if (mRampItr == mRamp.end())
+            {
+                err = mRamp.size();
+            }
         }
     }
 
     return err;
 }
 
-void CAmRoutingAdapterALSAVolume::deinitThread(int errInit)
+__useconds_t CAmRoutingAdapterALSAVolume::getStepTime()
+{
+    return (mRampItr != mRamp.end()) ? mRampItr->time : 0;
+}
+
+void CAmRoutingAdapterALSAVolume::finishRamp(int err)
 {
-    sendAcknowledge(errInit);
+    sendAcknowledge(err);
 }
 
 int CAmRoutingAdapterALSAVolume::prepareRampCalc()
@@ -0,0 +1,410 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#include <poll.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <string.h>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+#include "CAmRoutingAdapterALSAVolumeScheduler.h"
+#include "CAmRaAlsaLogging.h"
+
+
+using namespace am;
+using namespace std;
+
+#define NS_PER_US 1000ULL
+#define NS_PER_SEC 1000000000ULL
+
+
+CAmRoutingAdapterALSAVolumeScheduler::CAmRoutingAdapterALSAVolumeScheduler()
+    : CAmRoutingAdapterThread(), mTimerFd(-1), mEventFd(-1), mStarted(false), mStop(false)
+{
+    pthread_mutex_init(&mMtx, NULL);
+    pthread_cond_init(&mCond, NULL);
+
+    mTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    mEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ((mTimerFd < 0) || (mEventFd < 0))
+    {
+        string error = string("CRaALSAVolumeScheduler: timer creation failed with ") + strerror(errno);
+        logAmRaError(error);
+        if (mTimerFd >= 0)
+        {
+            close(mTimerFd);
+        }
+        if (mEventFd >= 0)
+        {
+            close(mEventFd);
+        }
+        pthread_cond_destroy(&mCond);
+        pthread_mutex_destroy(&mMtx);
+        throw runtime_error(error);
+    }
+
+    CAmRoutingAdapterThread::setThreadSched(SCHED_FIFO, 80);
+    CAmRoutingAdapterThread::setThreadName("raa_vol_sched");
+}
+
+CAmRoutingAdapterALSAVolumeScheduler::~CAmRoutingAdapterALSAVolumeScheduler()
+{
+    /* wake up the worker, so that it notices the stop request */
+    mStop = true;
+    uint64_t event = 1;
+    if (write(mEventFd, &event, sizeof(event)) < 0)
+    {
+        logAmRaError("CRaALSAVolumeScheduler: wake up failed with", strerror(errno));
+    }
+
+    CAmRoutingAdapterThread::joinThread();
+    close(mTimerFd);
+    close(mEventFd);
+    pthread_cond_destroy(&mCond);
+    pthread_mutex_destroy(&mMtx);
+}
+
+int CAmRoutingAdapterALSAVolumeScheduler::addRamp(IAmRoutingAdapterALSARamp* volume)
+{
+    IAmRoutingAdapterALSARamp *pOldVolume = NULL;
+
+    pthread_mutex_lock(&mMtx);
+
+    /*
+     * The scheduler thread reads the due and finished ramps without the lock, they must not move.
+     * A ramp of the same element being stepped right now is replaced after its step.
+     */
+    while ((!mFinished.empty() && (mFinished.capacity() < getRampCount()))
+            || (!mDue.empty() && (mDue.capacity() < getRampCount()))
+            || (find_if(mDue.begin(), mDue.end(),
+                    [&](const ra_rampEntry_s & entry)
+                    {
+                        return entry.pVolume->getElementName() == volume->getElementName();
+                    }) != mDue.end()))
+    {
+        pthread_cond_wait(&mCond, &mMtx);
+    }
+
+    /* only one ramp may drive a mixer element, the new target replaces the running one */
+    vector<ra_rampEntry_s>::iterator itr = find_if(mRamps.begin(), mRamps.end(),
+            [&](const ra_rampEntry_s & entry)
+            {
+                return entry.pVolume->getElementName() == volume->getElementName();
+            });
+    if (itr != mRamps.end())
+    {
+        logAmRaInfo("CRaALSAVolumeScheduler::addRamp retarget running ramp of", volume->getElementName());
+        pOldVolume = itr->pVolume;
+        mRamps.erase(itr);
+        make_heap(mRamps.begin(), mRamps.end(), greater<ra_rampEntry_s>());
+    }
+
+    /* the ramp starts from the level the mixer element has right now */
+    int err = volume->prepareRamp();
+    if (err == 0)
+    {
+        ra_rampEntry_s entry;
+        entry.deadline = getTime() + volume->getStepTime() * NS_PER_US;
+        entry.pVolume = volume;
+        entry.steps = 0;
+        entry.sumLate = 0;
+        entry.maxLate = 0;
+        entry.result = 0;
+        mRamps.push_back(entry);
+        push_heap(mRamps.begin(), mRamps.end(), greater<ra_rampEntry_s>());
+
+        /* the scheduler thread must not allocate when it collects the due and finished ramps */
+        if (mDue.empty())
+        {
+            mDue.reserve(2 * getRampCount());
+        }
+        if (mFinished.empty())
+        {
+            mFinished.reserve(2 * getRampCount());
+        }
+        armTimer();
+    }
+
+    /* the thread is started on first use and again after it ended on an error */
+    bool start = (err == 0) && !mStarted;
+    if (start)
+    {
+        mStarted = true;
+    }
+    pthread_mutex_unlock(&mMtx);
+
+    if (pOldVolume != NULL)
+    {
+        pOldVolume->finishRamp(0);
+    }
+
+    if (err != 0)
+    {
+        volume->finishRamp(err);
+        return err;
+    }
+
+    if (start)
+    {
+        uint64_t startTime = getTime();
+        try
+        {
+            CAmRoutingAdapterThread::joinThread();
+            err = CAmRoutingAdapterThread::startThread();
+        }
+        catch (exception & exc)
+        {
+            logAmRaError("CRaALSAVolumeScheduler::addRamp thread creation failed with", exc.what());
+            err = -EAGAIN;
+        }
+
+        logAmRaInfo("CRaALSAVolumeScheduler::addRamp thread started in",
+                (getTime() - startTime) / NS_PER_US, "us with", err);
+
+        if (err != 0)
+        {
+            pthread_mutex_lock(&mMtx);
+            mStarted = false;
+            pthread_mutex_unlock(&mMtx);
+
+            /* without the thread the ramp would never end */
+            err = (err > 0) ? -err : err;
+            if (removeRamp(volume))
+            {
+                volume->finishRamp(err);
+            }
+        }
+    }
+
+    return err;
+}
+
+bool CAmRoutingAdapterALSAVolumeScheduler::removeRamp(const IAmRoutingAdapterALSARamp* volume)
+{
+    pthread_mutex_lock(&mMtx);
+
+    /* the ramp might just be stepped or reported as finished, the volume has to stay valid until then */
+    while ((find_if(mFinished.begin(), mFinished.end(),
+            [&](const pair<IAmRoutingAdapterALSARamp*, int> & finished)
+            {
+                return finished.first == volume;
+            }) != mFinished.end())
+            || (find_if(mDue.begin(), mDue.end(),
+            [&](const ra_rampEntry_s & entry)
+            {
+                return entry.pVolume == volume;
+            }) != mDue.end()))
+    {
+        pthread_cond_wait(&mCond, &mMtx);
+    }
+
+    size_t size = mRamps.size();
+    mRamps.erase(remove_if(mRamps.begin(), mRamps.end(),
+            [&](const ra_rampEntry_s & entry)
+            {
+                return entry.pVolume == volume;
+            }), mRamps.end());
+    bool removed = (size != mRamps.size());
+    if (removed)
+    {
+        make_heap(mRamps.begin(), mRamps.end(), greater<ra_rampEntry_s>());
+        armTimer();
+    }
+
+    pthread_mutex_unlock(&mMtx);
+    return removed;
+}
+
+int CAmRoutingAdapterALSAVolumeScheduler::initThread()
+{
+    return 0;
+}
+
+int CAmRoutingAdapterALSAVolumeScheduler::workerThread()
+{
+    struct pollfd fds[2] = {
+        { mTimerFd, POLLIN, 0 },
+        { mEventFd, POLLIN, 0 }
+    };
+
+    int err = poll(fds, 2, -1);
+    if (err < 0)
+    {
+        return (errno == EINTR) ? 0 : -errno;
+    }
+
+    if (mStop)
+    {
+        return 1;
+    }
+
+    uint64_t expirations;
+    if (fds[0].revents & POLLIN)
+    {
+        /* the count is not of interest, due steps are taken from the heap */
+        if (read(mTimerFd, &expirations, sizeof(expirations)) < 0)
+        {
+            logAmRaDebug("CRaALSAVolumeScheduler: timer read failed with", strerror(errno));
+        }
+    }
+
+    pthread_mutex_lock(&mMtx);
+    takeDueSteps();
+    pthread_mutex_unlock(&mMtx);
+
+    /* the mixers are written without the lock, only requests for the same ramps wait for it */
+    for (ra_rampEntry_s & entry : mDue)
+    {
+        entry.result = entry.pVolume->executeStep();
+    }
+
+    pthread_mutex_lock(&mMtx);
+    rescheduleSteps();
+    armTimer();
+    pthread_cond_broadcast(&mCond);
+    pthread_mutex_unlock(&mMtx);
+
+    finishRamps();
+    return 0;
+}
+
+void CAmRoutingAdapterALSAVolumeScheduler::deinitThread(int errInit)
+{
+    if (errInit >= 0)
+    {
+        return;
+    }
+    logAmRaError("CRaALSAVolumeScheduler: thread exits with", errInit);
+
+    /* nothing steps the ramps anymore, they end with the error and the next addRamp() starts a new thread */
+    pthread_mutex_lock(&mMtx);
+    mStarted = false;
+    for (ra_rampEntry_s & entry : mRamps)
+    {
+        mFinished.push_back(make_pair(entry.pVolume, errInit));
+    }
+    mRamps.clear();
+    armTimer();
+    pthread_mutex_unlock(&mMtx);
+
+    finishRamps();
+}
+
+void CAmRoutingAdapterALSAVolumeScheduler::takeDueSteps()
+{
+    uint64_t now = getTime();
+    while (!mRamps.empty() && (mRamps.front().deadline <= now))
+    {
+        pop_heap(mRamps.begin(), mRamps.end(), greater<ra_rampEntry_s>());
+        ra_rampEntry_s & entry = mRamps.back();
+
+        uint64_t late = now - entry.deadline;
+        entry.sumLate += late;
+        entry.maxLate = std::max(entry.maxLate, late);
+        entry.steps++;
+        mDue.push_back(entry);
+        mRamps.pop_back();
+    }
+}
+
+void CAmRoutingAdapterALSAVolumeScheduler::rescheduleSteps()
+{
+    for (ra_rampEntry_s & entry : mDue)
+    {
+        if (entry.result != 0)
+        {
+            logAmRaDebug("CRaALSAVolumeScheduler: ramp of", entry.pVolume->getElementName(), "done after",
+                    entry.steps, "steps, wake-up delay avg", entry.sumLate / entry.steps / NS_PER_US,
+                    "us max", entry.maxLate / NS_PER_US, "us");
+            mFinished.push_back(make_pair(entry.pVolume, entry.result));
+            continue;
+        }
+
+        /* next deadline is based on the planned one to avoid drift */
+        entry.deadline += entry.pVolume->getStepTime() * NS_PER_US;
+        mRamps.push_back(entry);
+        push_heap(mRamps.begin(), mRamps.end(), greater<ra_rampEntry_s>());
+    }
+    mDue.clear();
+}
+
+void CAmRoutingAdapterALSAVolumeScheduler::finishRamps()
+{
+    /* report finished ramps without holding the lock, only this thread fills the list */
+    if (mFinished.empty())
+    {
+        return;
+    }
+    for (vector<pair<IAmRoutingAdapterALSARamp*, int> >::iterator itr = mFinished.begin();
+            itr != mFinished.end(); ++itr)
+    {
+        itr->first->finishRamp(itr->second);
+    }
+
+    pthread_mutex_lock(&mMtx);
+    mFinished.clear();
+    pthread_cond_broadcast(&mCond);
+    pthread_mutex_unlock(&mMtx);
+}
+
+size_t CAmRoutingAdapterALSAVolumeScheduler::getRampCount() const
+{
+    /* including a ramp to be added */
+    return mRamps.size() + mDue.size() + 1;
+}
+
+void CAmRoutingAdapterALSAVolumeScheduler::armTimer()
+{
+    struct itimerspec timeout;
+    memset(&timeout, 0, sizeof(timeout));
+    if (!mRamps.empty())
+    {
+        /* a zero value would disarm the timer */
+        uint64_t deadline = std::max<uint64_t>(mRamps.front().deadline, 1);
+        timeout.it_value.tv_sec = deadline / NS_PER_SEC;
+        timeout.it_value.tv_nsec = deadline % NS_PER_SEC;
+    }
+
+    if (timerfd_settime(mTimerFd, TFD_TIMER_ABSTIME, &timeout, NULL) < 0)
+    {
+        logAmRaError("CRaALSAVolumeScheduler: arm timer failed with", strerror(errno));
+    }
+}
+
+uint64_t CAmRoutingAdapterALSAVolumeScheduler::getTime()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * NS_PER_SEC + now.tv_nsec;
+}
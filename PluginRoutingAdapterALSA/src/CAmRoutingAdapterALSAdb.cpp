@@ -36,8 +36,19 @@ using namespace std;
 using namespace am;
 
 
+namespace
+{
+
+inline uint32_t sourceKey(const am_domainID_t domainID, const am_sourceID_t sourceID)
+{
+    return (static_cast<uint32_t>(domainID) << 16) | sourceID;
+}
+
+} /* namespace */
+
+
 CAmRoutingAdapterALSAdb::CAmRoutingAdapterALSAdb(IAmRoutingAdapterDbObserver * observer)
-    : mpObserver(observer)
+    : mIndex(mDomains), mpObserver(observer)
 {
 }
 
@@ -48,46 +59,37 @@ CAmRoutingAdapterALSAdb::~CAmRoutingAdapterALSAdb()
 ra_domainInfo_s * CAmRoutingAdapterALSAdb::createDomain(ra_domainInfo_s & domain)
 {
     mDomains.push_back(domain);
+    mIndex.invalidate();
     return &mDomains.back();
 }
 
 ra_domainInfo_s * CAmRoutingAdapterALSAdb::findDomain(const am_domainID_t id)
 {
-    vector<ra_domainInfo_s>::iterator it =
-            find_if(mDomains.begin(), mDomains.end(), ra_domainInfo_s(id));
-    return ((it != mDomains.end()) ? it.base() : NULL);
+    return mIndex.findDomain(id);
 }
 
 ra_domainInfo_s * CAmRoutingAdapterALSAdb::findDomain(const string &domNam)
 {
-    vector<ra_domainInfo_s>::iterator it =
-            find_if(mDomains.begin(), mDomains.end(), ra_domainInfo_s(domNam));
-    return ((it != mDomains.end()) ? it.base() : NULL);
+    return mIndex.findDomain(domNam);
 }
 
 ra_domainInfo_s * CAmRoutingAdapterALSAdb::findDomain(ra_sourceInfo_s & source, ra_sinkInfo_s & sink)
 {
-    for (ra_domainInfo_s & domain : mDomains)
+    ra_domainInfo_s *pSrcDomain = NULL;
+    ra_domainInfo_s *pSinkDomain = NULL;
+    ra_sourceInfo_s *pSource = source.amInfo.name.empty() ? mIndex.findSource(source.amInfo.sourceID, &pSrcDomain)
+                                                          : mIndex.findSource(source.amInfo.name, &pSrcDomain);
+    ra_sinkInfo_s *pSink = sink.amInfo.name.empty() ? mIndex.findSink(sink.amInfo.sinkID, &pSinkDomain)
+                                                    : mIndex.findSink(sink.amInfo.name, &pSinkDomain);
+
+    /* source and sink have to be in the same domain */
+    if ((pSource == NULL) || (pSink == NULL) || (pSrcDomain != pSinkDomain))
     {
-        /* find source id */
-        vector<ra_sourceInfo_s>::iterator itSource =
-                find_if(domain.lSourceInfo.begin(), domain.lSourceInfo.end(), source);
-        if (itSource == domain.lSourceInfo.end())
-        {
-            continue; /* in case the sink id is not in domain search in other domain */
-        }
-
-        /* find sink id and check for causality */
-        vector<ra_sinkInfo_s>::iterator itSink =
-                find_if(domain.lSinkInfo.begin(),domain.lSinkInfo.end(), sink);
-        if (itSink != domain.lSinkInfo.end())
-        {
-            source = *itSource;
-            sink = *itSink;
-            return &domain;
-        }
+        return NULL;
     }
-    return NULL;
+    source = *pSource;
+    sink = *pSink;
+    return pSrcDomain;
 }
 
 ra_domainInfo_s * CAmRoutingAdapterALSAdb::findDomainByConnection(const am_connectionID_t id)
@@ -105,70 +107,66 @@ ra_domainInfo_s * CAmRoutingAdapterALSAdb::findDomainByConnection(const am_conne
 ra_proxyInfo_s * CAmRoutingAdapterALSAdb::findProxyInDomain(
         ra_domainInfo_s * pDomain, const am_sourceID_t sourceID, const am_sinkID_t sinkID)
 {
-    std::vector<ra_proxyInfo_s>::iterator itr =
-            find_if(pDomain->lProxyInfo.begin(), pDomain->lProxyInfo.end(), ra_proxyInfo_s(sourceID, sinkID));
-    if (itr != pDomain->lProxyInfo.end())
-    {
-        return &(*itr);
-    }
-    // This is a valid behavior. NO error log here!!!
-    return NULL;
+    // This is a valid behavior to return NULL. NO error log here!!!
+    return mIndex.findProxy(pDomain, sourceID, sinkID);
 }
 
 ra_proxyInfo_s * CAmRoutingAdapterALSAdb::findProxyInDomain(
         const am_domainID_t domainID, const std::string & sourceName, const std::string & sinkName)
 {
-    ra_domainInfo_s * pDomain = findDomain(domainID);
-    std::vector<ra_proxyInfo_s>::iterator itr =
-            find_if(pDomain->lProxyInfo.begin(), pDomain->lProxyInfo.end(), ra_proxyInfo_s(sourceName, sinkName));
-    if (itr != pDomain->lProxyInfo.end())
-    {
-        return &(*itr);
-    }
-    // This is a valid behavior. NO error log here!!!
-    return NULL;
+    // This is a valid behavior to return NULL. NO error log here!!!
+    return mIndex.findProxy(findDomain(domainID), sourceName, sinkName);
 }
 
 
 am_connectionID_t CAmRoutingAdapterALSAdb::findConnectionFromSource(const am_domainID_t domainId,
                                                     const am_sourceID_t sourceID)
 {
-    for (auto && it : mMapConnectionIDRoute)
+    unordered_map<uint32_t, set<am_connectionID_t> >::const_iterator itr =
+            mSourceConnections.find(sourceKey(domainId, sourceID));
+    if ((itr == mSourceConnections.end()) || itr->second.empty())
     {
-        if (it.second.domainID == domainId && it.second.sourceID == sourceID)
-        {
-            return it.first;
-        }
+        return 0;
     }
-    return 0;
+    return *itr->second.begin();
 }
 
 ra_sinkInfo_s * CAmRoutingAdapterALSAdb::findSink(const am_sinkID_t id)
+{
+    return mIndex.findSink(id);
+}
+
+ra_sourceInfo_s * CAmRoutingAdapterALSAdb::findSource(const am_sourceID_t id)
+{
+    return mIndex.findSource(id);
+}
+
+ra_crossfaderInfo_s * CAmRoutingAdapterALSAdb::findCrossfader(const am_crossfaderID_t id)
 {
     for (ra_domainInfo_s & domain : mDomains)
     {
-        /* find sink id */
-        vector<ra_sinkInfo_s>::iterator itr =
-                find_if(domain.lSinkInfo.begin(), domain.lSinkInfo.end(), ra_sinkInfo_s(id));
-        if (itr != domain.lSinkInfo.end())
+        for (ra_crossfaderInfo_s & crossfader : domain.lCrossfaderInfo)
         {
-            return &(*itr);
+            if (crossfader.amInfo.crossfaderID == id)
+            {
+                return &crossfader;
+            }
         }
     }
 
     return NULL;
 }
 
-ra_sourceInfo_s * CAmRoutingAdapterALSAdb::findSource(const am_sourceID_t id)
+ra_crossfaderInfo_s * CAmRoutingAdapterALSAdb::findCrossfaderOfSink(const am_sinkID_t id)
 {
     for (ra_domainInfo_s & domain : mDomains)
     {
-        /* find source id */
-        vector<ra_sourceInfo_s>::iterator itr =
-                find_if(domain.lSourceInfo.begin(), domain.lSourceInfo.end(), ra_sourceInfo_s(id));
-        if (itr != domain.lSourceInfo.end())
+        for (ra_crossfaderInfo_s & crossfader : domain.lCrossfaderInfo)
         {
-            return &(*itr);
+            if ((crossfader.amInfo.sinkID_A == id) || (crossfader.amInfo.sinkID_B == id))
+            {
+                return &crossfader;
+            }
         }
     }
 
@@ -183,17 +181,34 @@ void CAmRoutingAdapterALSAdb::cleanup()
         domain.lSinkInfo.clear();
         domain.lProxyInfo.clear();
         domain.lGatewayInfo.clear();
+        domain.lCrossfaderInfo.clear();
     }
+    mIndex.invalidate();
 
     mMapAsyncOperations.clear();
     mMapConnectionIDRoute.clear();
+    mSourceConnections.clear();
+    invalidateMixers();
+}
+
+void CAmRoutingAdapterALSAdb::invalidateMixers()
+{
+    mPropertyMixers.invalidate();
+    mVolumeMixers.invalidate();
+}
+
+void CAmRoutingAdapterALSAdb::invalidateIndices()
+{
+    mIndex.invalidate();
 }
 
 void CAmRoutingAdapterALSAdb::registerDomains()
 {
     for (ra_domainInfo_s & domain : mDomains)
     {
-        if (mpObserver->registerDomain(domain.domain) != E_OK)
+        am_Error_e error = mpObserver->registerDomain(domain.domain);
+        mIndex.invalidate();
+        if (error != E_OK)
         {
             continue;
         }
@@ -212,11 +227,12 @@ void CAmRoutingAdapterALSAdb::registerDomains()
 
         /* Update database for proxy */
         updateProxys(domain);
+        mIndex.invalidate();
 
         domain.domain.complete = true;
     }
 
-    /* Gateway registration needs to be done at the end
+    /* Gateway and crossfader registration needs to be done at the end
      * because only then all sources and sinks are registered */
     for (ra_domainInfo_s & domain : mDomains)
     {
@@ -225,6 +241,10 @@ void CAmRoutingAdapterALSAdb::registerDomains()
         {
             mpObserver->registerGateway(gateway, domain.domain.domainID);
         }
+        for (ra_crossfaderInfo_s & crossfader : domain.lCrossfaderInfo)
+        {
+            mpObserver->registerCrossfader(crossfader, domain.domain.domainID);
+        }
     }
 
     /* Only when also all Gateways have been registered we send the notification
@@ -274,7 +294,13 @@ void CAmRoutingAdapterALSAdb::cleanVolumeOpList(const am_Handle_s handle)
 
 void CAmRoutingAdapterALSAdb::registerConnection(const am_connectionID_t connectionId, const am_RoutingElement_s & elements, class IAmRoutingAdapterALSAProxy * proxy)
 {
+    map<am_connectionID_t, ra_route_s>::iterator itr = mMapConnectionIDRoute.find(connectionId);
+    if (itr != mMapConnectionIDRoute.end())
+    {
+        mSourceConnections[sourceKey(itr->second.domainID, itr->second.sourceID)].erase(connectionId);
+    }
     mMapConnectionIDRoute[connectionId] = ra_route_s(elements, proxy);
+    mSourceConnections[sourceKey(elements.domainID, elements.sourceID)].insert(connectionId);
 }
 
 class IAmRoutingAdapterALSAProxy * CAmRoutingAdapterALSAdb::getProxyOfConnection(const am_connectionID_t connectionId)
@@ -299,9 +325,64 @@ void CAmRoutingAdapterALSAdb::getProxyLists(vector<class IAmRoutingAdapterALSAPr
     }
 }
 
+void CAmRoutingAdapterALSAdb::getConnectionProxies(
+        vector<pair<am_connectionID_t, class IAmRoutingAdapterALSAProxy*> > & proxies)
+{
+    for (pair<const uint16_t, ra_route_s> & pair : mMapConnectionIDRoute)
+    {
+        if (pair.second.proxy != NULL)
+        {
+            proxies.push_back(make_pair(pair.first, pair.second.proxy));
+        }
+    }
+}
+
+void CAmRoutingAdapterALSAdb::getProxiesOfElement(const am_sourceID_t sourceID, const am_sinkID_t sinkID,
+        vector<pair<am_RoutingElement_s, class IAmRoutingAdapterALSAProxy*> > & proxies)
+{
+    for (pair<const uint16_t, ra_route_s> & pair : mMapConnectionIDRoute)
+    {
+        if ((pair.second.proxy != NULL) &&
+            (((sourceID != 0) && (pair.second.sourceID == sourceID)) ||
+             ((sinkID != 0) && (pair.second.sinkID == sinkID))))
+        {
+            proxies.push_back(make_pair(static_cast<am_RoutingElement_s>(pair.second), pair.second.proxy));
+        }
+    }
+}
+
+bool CAmRoutingAdapterALSAdb::isSoftVolume(const am_sourceID_t sourceID, const am_sinkID_t sinkID)
+{
+    for (ra_domainInfo_s & domain : mDomains)
+    {
+        for (ra_proxyInfo_s & proxy : domain.lProxyInfo)
+        {
+            if (proxy.alsa.softVolume &&
+                (((sourceID != 0) && (proxy.route.sourceID == sourceID)) ||
+                 ((sinkID != 0) && (proxy.route.sinkID == sinkID))))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 void CAmRoutingAdapterALSAdb::deregisterConnection(const am_connectionID_t connectionId)
 {
-    mMapConnectionIDRoute.erase(connectionId);
+    map<am_connectionID_t, ra_route_s>::iterator itr = mMapConnectionIDRoute.find(connectionId);
+    if (itr == mMapConnectionIDRoute.end())
+    {
+        return;
+    }
+
+    uint32_t key = sourceKey(itr->second.domainID, itr->second.sourceID);
+    mSourceConnections[key].erase(connectionId);
+    if (mSourceConnections[key].empty())
+    {
+        mSourceConnections.erase(key);
+    }
+    mMapConnectionIDRoute.erase(itr);
 }
 
 
@@ -0,0 +1,207 @@
+/*******************************************************************************
+ *  \copyright (c) 2016 Advanced Driver Information Technology.
+ *                   ADIT is a joint venture company of
+ *   Robert Bosch GmbH/Robert Bosch Car Multimedia GmbH and DENSO Corporation
+ *
+ *  \author: Jens Lorenz, jlorenz@de.adit-jv.com 2015-2016
+ *           Mattia Guerra, mguerra@de.adit-jv.com 2016
+ *
+ *
+ *  \copyright The MIT License (MIT)
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ *  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ *  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ *  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+ *  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  For further information see http://www.genivi.org/.
+ ******************************************************************************/
+
+
+#include "CAmRoutingAdapterALSAdbIndex.h"
+#include "CAmRoutingAdapterALSAdb.h"
+
+using namespace std;
+using namespace am;
+
+namespace
+{
+
+inline uint32_t routeKey(const am_sourceID_t sourceID, const am_sinkID_t sinkID)
+{
+    return (static_cast<uint32_t>(sourceID) << 16) | sinkID;
+}
+
+inline string namesKey(const string & srcNam, const string & sinkNam)
+{
+    return srcNam + '\n' + sinkNam;
+}
+
+} /* namespace */
+
+CAmRoutingAdapterALSAdbIndex::CAmRoutingAdapterALSAdbIndex(vector<ra_domainInfo_s> & domains)
+    : mDomains(domains), mValid(false)
+{
+}
+
+void CAmRoutingAdapterALSAdbIndex::invalidate()
+{
+    mValid = false;
+}
+
+ra_domainInfo_s * CAmRoutingAdapterALSAdbIndex::findDomain(const am_domainID_t id)
+{
+    update();
+    unordered_map<am_domainID_t, ra_domainInfo_s*>::const_iterator itr = mDomainByID.find(id);
+    return (itr != mDomainByID.end()) ? itr->second : NULL;
+}
+
+ra_domainInfo_s * CAmRoutingAdapterALSAdbIndex::findDomain(const string & name)
+{
+    update();
+    unordered_map<string, ra_domainInfo_s*>::const_iterator itr = mDomainByName.find(name);
+    return (itr != mDomainByName.end()) ? itr->second : NULL;
+}
+
+ra_sourceInfo_s * CAmRoutingAdapterALSAdbIndex::findSource(const am_sourceID_t id, ra_domainInfo_s ** ppDomain)
+{
+    update();
+    return findEntry(mSourceByID, id, ppDomain);
+}
+
+ra_sourceInfo_s * CAmRoutingAdapterALSAdbIndex::findSource(const string & name, ra_domainInfo_s ** ppDomain)
+{
+    update();
+    return findEntry(mSourceByName, name, ppDomain);
+}
+
+ra_sinkInfo_s * CAmRoutingAdapterALSAdbIndex::findSink(const am_sinkID_t id, ra_domainInfo_s ** ppDomain)
+{
+    update();
+    return findEntry(mSinkByID, id, ppDomain);
+}
+
+ra_sinkInfo_s * CAmRoutingAdapterALSAdbIndex::findSink(const string & name, ra_domainInfo_s ** ppDomain)
+{
+    update();
+    return findEntry(mSinkByName, name, ppDomain);
+}
+
+ra_proxyInfo_s * CAmRoutingAdapterALSAdbIndex::findProxy(const ra_domainInfo_s * pDomain,
+        const am_sourceID_t sourceID, const am_sinkID_t sinkID)
+{
+    update();
+    ra_domainIndex_s *pIndex = getDomainIndex(pDomain);
+    if (pIndex == NULL)
+    {
+        return NULL;
+    }
+
+    /* a proxy without sink serves all sinks of the source, the one configured first wins like in the linear search */
+    ra_proxyInfo_s *pProxy = NULL;
+    for (uint32_t key : {routeKey(sourceID, sinkID), routeKey(sourceID, 0)})
+    {
+        unordered_map<uint32_t, ra_proxyInfo_s*>::const_iterator itr = pIndex->proxyByIDs.find(key);
+        if ((itr != pIndex->proxyByIDs.end()) && ((pProxy == NULL) || (itr->second < pProxy)))
+        {
+            pProxy = itr->second;
+        }
+    }
+    return pProxy;
+}
+
+ra_proxyInfo_s * CAmRoutingAdapterALSAdbIndex::findProxy(const ra_domainInfo_s * pDomain,
+        const string & srcNam, const string & sinkNam)
+{
+    update();
+    ra_domainIndex_s *pIndex = getDomainIndex(pDomain);
+    if (pIndex == NULL)
+    {
+        return NULL;
+    }
+
+    const unordered_map<string, ra_proxyInfo_s*> & index = sinkNam.empty() ? pIndex->proxyBySrcNam : pIndex->proxyByNames;
+    unordered_map<string, ra_proxyInfo_s*>::const_iterator itr = index.find(sinkNam.empty() ? srcNam : namesKey(srcNam, sinkNam));
+    return (itr != index.end()) ? itr->second : NULL;
+}
+
+void CAmRoutingAdapterALSAdbIndex::update()
+{
+    if (mValid)
+    {
+        return;
+    }
+
+    mDomainByID.clear();
+    mDomainByName.clear();
+    mSourceByID.clear();
+    mSourceByName.clear();
+    mSinkByID.clear();
+    mSinkByName.clear();
+    mDomainIndices.assign(mDomains.size(), ra_domainIndex_s());
+
+    /* emplace keeps the first element of a key, as the linear search did */
+    for (size_t pos = 0; pos < mDomains.size(); ++pos)
+    {
+        ra_domainInfo_s & domain = mDomains[pos];
+        mDomainByID.emplace(domain.domain.domainID, &domain);
+        mDomainByName.emplace(domain.domain.name, &domain);
+        for (ra_sourceInfo_s & source : domain.lSourceInfo)
+        {
+            ra_entry_s<ra_sourceInfo_s> entry = {&domain, &source};
+            mSourceByID.emplace(source.amInfo.sourceID, entry);
+            mSourceByName.emplace(source.amInfo.name, entry);
+        }
+        for (ra_sinkInfo_s & sink : domain.lSinkInfo)
+        {
+            ra_entry_s<ra_sinkInfo_s> entry = {&domain, &sink};
+            mSinkByID.emplace(sink.amInfo.sinkID, entry);
+            mSinkByName.emplace(sink.amInfo.name, entry);
+        }
+
+        ra_domainIndex_s & index = mDomainIndices[pos];
+        for (ra_proxyInfo_s & proxy : domain.lProxyInfo)
+        {
+            index.proxyByIDs.emplace(routeKey(proxy.route.sourceID, proxy.route.sinkID), &proxy);
+            index.proxyBySrcNam.emplace(proxy.srcNam, &proxy);
+            index.proxyByNames.emplace(namesKey(proxy.srcNam, proxy.sinkNam), &proxy);
+        }
+    }
+    mValid = true;
+}
+
+CAmRoutingAdapterALSAdbIndex::ra_domainIndex_s * CAmRoutingAdapterALSAdbIndex::getDomainIndex(
+        const ra_domainInfo_s * pDomain)
+{
+    if ((pDomain == NULL) || mDomains.empty() || (pDomain < &mDomains.front()) || (pDomain > &mDomains.back()))
+    {
+        return NULL;
+    }
+    return &mDomainIndices[pDomain - &mDomains.front()];
+}
+
+template <typename K, typename T>
+T * CAmRoutingAdapterALSAdbIndex::findEntry(const unordered_map<K, ra_entry_s<T> > & index, const K & key,
+        ra_domainInfo_s ** ppDomain)
+{
+    typename unordered_map<K, ra_entry_s<T> >::const_iterator itr = index.find(key);
+    if (itr == index.end())
+    {
+        return NULL;
+    }
+    if (ppDomain != NULL)
+    {
+        *ppDomain = itr->second.pDomain;
+    }
+    return itr->second.pElement;
+}
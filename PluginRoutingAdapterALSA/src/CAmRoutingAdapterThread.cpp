@@ -188,13 +188,19 @@ int CAmRoutingAdapterThread::startWorkerThread(void)
 
     /* start thread */
     setState(STATE_FORKING);
-    THROW_ASSERT_NEQ(pthread_create(&mId, &attr, &CAmRoutingAdapterThread::_WorkerThread, this), 0);
-    THROW_ASSERT_NEQ(pthread_attr_destroy(&attr), 0);
+    int err = pthread_create(&mId, &attr, &CAmRoutingAdapterThread::_WorkerThread, this);
+    pthread_attr_destroy(&attr);
+    if (err != 0)
+    {
+        /* e.g. EPERM for a real-time policy, stay joinable for the next attempt */
+        setState(STATE_JOINED);
+        return -err;
+    }
 
     waitForStateChange(STATE_FORKING);
     if (getState() != STATE_RUNNING)
     {
-        int err = pthread_join(mId, NULL);
+        err = pthread_join(mId, NULL);
         if ((err != 0) && (mThreadErr == 0))
         {
             mThreadErr = err;
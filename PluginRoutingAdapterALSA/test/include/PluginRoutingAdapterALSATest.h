@@ -31,6 +31,18 @@
 
 #include "gtest/gtest.h"
 #include "CAmRoutingAdapterKVPConverter.h"
+#include "CAmRoutingAdapterALSAGain.h"
+#include "CAmRoutingAdapterALSAConverter.h"
+#include "CAmRoutingAdapterALSADrift.h"
+#include "CAmRoutingAdapterALSAStats.h"
+#include "CAmRoutingAdapterALSALevel.h"
+#include "CAmRoutingAdapterALSACrossfade.h"
+#include "CAmRoutingAdapterALSAdb.h"
+#include "CAmRoutingAdapterALSAVolumeScheduler.h"
+#include "CAmRoutingAdapterALSAProxyDefault.h"
+#include "CAmRoutingAdapterALSAProxyMixer.h"
+#include "CAmRoutingAdapterALSAEngine.h"
+#include "CAmRoutingAdapterALSAMixerCache.h"
 #include <vector>
 #include <string>
 #include <map>
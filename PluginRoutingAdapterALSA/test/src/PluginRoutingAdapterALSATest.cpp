@@ -27,10 +27,173 @@
  ******************************************************************************/
 
 #include "PluginRoutingAdapterALSATest.h"
+#include <alsa/asoundlib.h>
+#include <time.h>
+#include <math.h>
+#include <atomic>
+#include <climits>
+#include <cerrno>
+#include <unistd.h>
+#include <dlfcn.h>
+#include <poll.h>
+#include <cstring>
+#include <sys/prctl.h>
 
 using namespace testing;
 using namespace std;
 
+/* counts the heap allocations while a streaming loop is simulated */
+static atomic<bool> gCountAllocations(false);
+static atomic<uint32_t> gAllocations(0);
+
+/* counts the heap allocations of each streaming thread, the threads of the plugin are named raa_ */
+#define MAX_COUNTED_THREADS 16
+struct ra_threadAllocations_s
+{
+    char name[16];
+    atomic<uint32_t> count;
+};
+static atomic<bool> gCountThreads(false);
+static atomic<uint32_t> gCountedThreads(0);
+static ra_threadAllocations_s gThreadAllocations[MAX_COUNTED_THREADS];
+static thread_local int tThreadSlot = -1;
+
+static void countThreadAllocation()
+{
+    if (tThreadSlot == -1)
+    {
+        /* the logger formats its messages outside the streaming threads */
+        char name[16] = "";
+        prctl(PR_GET_NAME, name);
+        tThreadSlot = -2;
+        if ((strncmp(name, "raa_", 4) == 0) && (strcmp(name, "raa_rt_log") != 0))
+        {
+            uint32_t slot = gCountedThreads++;
+            if (slot < MAX_COUNTED_THREADS)
+            {
+                memcpy(gThreadAllocations[slot].name, name, sizeof(name));
+                tThreadSlot = static_cast<int>(slot);
+            }
+        }
+    }
+    if (tThreadSlot >= 0)
+    {
+        ++gThreadAllocations[tThreadSlot].count;
+    }
+}
+
+static void countAllocation()
+{
+    if (gCountAllocations)
+    {
+        ++gAllocations;
+    }
+    if (gCountThreads)
+    {
+        countThreadAllocation();
+    }
+}
+
+/*
+ * Counts the C allocations as well as operator new, which allocates through malloc().
+ * dlsym() may allocate itself, those calls are served by glibc directly.
+ */
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t nmemb, size_t size);
+static thread_local bool tResolving = false;
+
+extern "C" void *malloc(size_t size)
+{
+    typedef void *(*malloc_t)(size_t);
+    static malloc_t pMalloc = NULL;
+    if (pMalloc == NULL)
+    {
+        if (tResolving)
+        {
+            return __libc_malloc(size);
+        }
+        tResolving = true;
+        pMalloc = reinterpret_cast<malloc_t>(dlsym(RTLD_NEXT, "malloc"));
+        tResolving = false;
+    }
+    countAllocation();
+    return pMalloc(size);
+}
+
+extern "C" void *calloc(size_t nmemb, size_t size)
+{
+    typedef void *(*calloc_t)(size_t, size_t);
+    static calloc_t pCalloc = NULL;
+    if (pCalloc == NULL)
+    {
+        if (tResolving)
+        {
+            return __libc_calloc(nmemb, size);
+        }
+        tResolving = true;
+        pCalloc = reinterpret_cast<calloc_t>(dlsym(RTLD_NEXT, "calloc"));
+        tResolving = false;
+    }
+    countAllocation();
+    return pCalloc(nmemb, size);
+}
+
+/* rejects the mmap access of all PCMs to check the fallback of the proxies */
+static atomic<bool> gRejectMmap(false);
+
+extern "C" int snd_pcm_hw_params_set_access(snd_pcm_t *pcm, snd_pcm_hw_params_t *params, snd_pcm_access_t access)
+{
+    typedef int (*setAccess_t)(snd_pcm_t*, snd_pcm_hw_params_t*, snd_pcm_access_t);
+    static setAccess_t pSetAccess = reinterpret_cast<setAccess_t>(dlsym(RTLD_NEXT, "snd_pcm_hw_params_set_access"));
+    if (gRejectMmap && (access == SND_PCM_ACCESS_MMAP_INTERLEAVED))
+    {
+        return -EINVAL;
+    }
+    return pSetAccess(pcm, params, access);
+}
+
+/* lets all PCMs time out to run the recovery of the proxies */
+static atomic<bool> gTimeout(false);
+
+extern "C" int snd_pcm_wait(snd_pcm_t *pcm, int timeout)
+{
+    typedef int (*wait_t)(snd_pcm_t*, int);
+    static wait_t pWait = reinterpret_cast<wait_t>(dlsym(RTLD_NEXT, "snd_pcm_wait"));
+    if (gTimeout)
+    {
+        usleep(1000);
+        return 0;
+    }
+    return pWait(pcm, timeout);
+}
+
+extern "C" int snd_pcm_poll_descriptors_revents(snd_pcm_t *pcm, struct pollfd *pfds, unsigned int nfds,
+        unsigned short *revents)
+{
+    typedef int (*revents_t)(snd_pcm_t*, struct pollfd*, unsigned int, unsigned short*);
+    static revents_t pRevents = reinterpret_cast<revents_t>(dlsym(RTLD_NEXT, "snd_pcm_poll_descriptors_revents"));
+    if (gTimeout)
+    {
+        *revents = 0;
+        return 0;
+    }
+    return pRevents(pcm, pfds, nfds, revents);
+}
+
+/* counts the playback devices opened, a restarted proxy thread opens its playback again */
+static atomic<uint32_t> gPlaybackOpens(0);
+
+extern "C" int snd_pcm_open(snd_pcm_t **pcm, const char *name, snd_pcm_stream_t stream, int mode)
+{
+    typedef int (*open_t)(snd_pcm_t**, const char*, snd_pcm_stream_t, int);
+    static open_t pOpen = reinterpret_cast<open_t>(dlsym(RTLD_NEXT, "snd_pcm_open"));
+    if (stream == SND_PCM_STREAM_PLAYBACK)
+    {
+        gPlaybackOpens++;
+    }
+    return pOpen(pcm, name, stream, mode);
+}
+
 namespace am
 {
 
@@ -149,6 +312,1345 @@ TEST(testKVP, nonSpecializedDouble)
     }
 }
 
+TEST(testGain, rampReachesTarget)
+{
+    const size_t frames = 480;
+    CAmRoutingAdapterALSAGain gain;
+    ASSERT_EQ(0, gain.setup(SND_PCM_FORMAT_S16_LE, 2, 48000, frames));
+
+    /* unity gain leaves the samples untouched */
+    vector<int16_t> buffer(frames * 2, 10000);
+    gain.apply(buffer.data(), frames);
+    ASSERT_EQ(10000, buffer.back());
+
+    /* -20 dB within 20 ms, i.e. two periods */
+    gain.setTarget(-200, RAMP_GENIVI_LINEAR, 20);
+    gain.apply(buffer.data(), frames);
+    ASSERT_GT(buffer.front(), buffer.back());
+    ASSERT_GT(buffer.back(), 1000);
+    fill(buffer.begin(), buffer.end(), 10000);
+    gain.apply(buffer.data(), frames);
+    ASSERT_EQ(1000, buffer.back());
+
+    /* direct change to mute */
+    gain.setTarget(AM_MUTE, RAMP_GENIVI_DIRECT, 0);
+    gain.apply(buffer.data(), frames);
+    ASSERT_EQ(0, buffer.front());
+}
+
+TEST(testGain, mixSaturates)
+{
+    /* odd length to cover the scalar tail as well */
+    vector<int16_t> s16(37, 30000);
+    vector<int16_t> in16(37, 5000);
+    in16[1] = -5000;
+    CAmRoutingAdapterALSAGain::mix(s16.data(), in16.data(), s16.size());
+    ASSERT_EQ(INT16_MAX, s16[0]);
+    ASSERT_EQ(25000, s16[1]);
+    ASSERT_EQ(INT16_MAX, s16.back());
+
+    vector<int32_t> s32(37, INT32_MIN + 10);
+    vector<int32_t> in32(37, -20);
+    in32[1] = 20;
+    CAmRoutingAdapterALSAGain::mix(s32.data(), in32.data(), s32.size());
+    ASSERT_EQ(INT32_MIN, s32[0]);
+    ASSERT_EQ(INT32_MIN + 30, s32[1]);
+    ASSERT_EQ(INT32_MIN, s32.back());
+
+    vector<float> flt(37, 0.75f);
+    vector<float> inFlt(37, 0.5f);
+    inFlt[1] = -0.5f;
+    CAmRoutingAdapterALSAGain::mix(flt.data(), inFlt.data(), flt.size());
+    ASSERT_FLOAT_EQ(1.0f, flt[0]);
+    ASSERT_FLOAT_EQ(0.25f, flt[1]);
+    ASSERT_FLOAT_EQ(1.0f, flt.back());
+}
+
+template <typename T>
+static double benchmarkGain(const uint32_t channels, const bool ramp)
+{
+    const size_t frames = 1024;
+    const int periods = 2000;
+    vector<T> buffer(frames * channels, static_cast<T>(1000));
+    vector<float> envelope(frames * channels, 0.5f);
+
+    timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < periods; ++i)
+    {
+        if (ramp)
+        {
+            CAmRoutingAdapterALSAGain::scale(buffer.data(), envelope.data(), buffer.size());
+        }
+        else
+        {
+            CAmRoutingAdapterALSAGain::scale(buffer.data(), 0.99f, buffer.size());
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    return (static_cast<double>(frames) * periods) / seconds;
+}
+
+TEST(testGain, benchmark)
+{
+    /* frames per second on a single core, printed for comparison between targets */
+    for (uint32_t channels : {1, 2, 6, 8})
+    {
+        for (bool ramp : {false, true})
+        {
+            double s16 = benchmarkGain<int16_t>(channels, ramp);
+            double s32 = benchmarkGain<int32_t>(channels, ramp);
+            double flt = benchmarkGain<float>(channels, ramp);
+            cout << "gain " << (ramp ? "ramp " : "const") << " channels " << channels
+                 << " frames/s S16 " << s16 << " S32 " << s32 << " FLOAT " << flt << endl;
+            ASSERT_GT(s16, 0);
+            ASSERT_GT(s32, 0);
+            ASSERT_GT(flt, 0);
+        }
+    }
+}
+
+TEST(testConverter, formatRoundTrip)
+{
+    vector<int16_t> s16 = {0, 1, -1, 16384, -16384, 32767, -32768};
+    vector<float> flt(s16.size());
+    vector<int16_t> back(s16.size());
+    CAmRoutingAdapterALSAConverter::toFloat(s16.data(), flt.data(), s16.size());
+    CAmRoutingAdapterALSAConverter::fromFloat(flt.data(), back.data(), flt.size());
+    ASSERT_EQ(s16, back);
+    ASSERT_FLOAT_EQ(-1.0f, flt.back());
+
+    /* out of range floats are clipped */
+    vector<float> loud(9, 1.5f);
+    vector<int32_t> s32(loud.size());
+    CAmRoutingAdapterALSAConverter::fromFloat(loud.data(), s32.data(), loud.size());
+    ASSERT_GT(s32.front(), INT32_MAX - 256);
+    ASSERT_GT(s32.back(), INT32_MAX - 256);
+}
+
+TEST(testConverter, channelMix)
+{
+    const size_t frames = 16;
+    CAmRoutingAdapterALSAConverter converter;
+    ASSERT_EQ(0, converter.setup(SND_PCM_FORMAT_S16_LE, 2, 48000, SND_PCM_FORMAT_S16_LE, 1, 48000, frames));
+    vector<int16_t> stereo(frames * 2);
+    for (size_t f = 0; f < frames; ++f)
+    {
+        stereo[f * 2] = 1000;
+        stereo[f * 2 + 1] = 3000;
+    }
+    vector<int16_t> mono(converter.getMaxOutputFrames());
+    ASSERT_EQ(frames, converter.process(stereo.data(), frames, mono.data()));
+    ASSERT_EQ(2000, mono[0]);
+    ASSERT_EQ(2000, mono[frames - 1]);
+
+    ASSERT_EQ(0, converter.setup(SND_PCM_FORMAT_S16_LE, 1, 48000, SND_PCM_FORMAT_FLOAT_LE, 2, 48000, frames));
+    vector<float> upmix(converter.getMaxOutputFrames() * 2);
+    ASSERT_EQ(frames, converter.process(mono.data(), frames, upmix.data()));
+    ASSERT_FLOAT_EQ(upmix[0], upmix[1]);
+}
+
+TEST(testConverter, resampleSine)
+{
+    /* 1 kHz from 48 kHz to 44.1 kHz in periods of 10 ms */
+    const size_t frames = 480;
+    const int periods = 50;
+    CAmRoutingAdapterALSAConverter converter;
+    ASSERT_EQ(0, converter.setup(SND_PCM_FORMAT_FLOAT_LE, 1, 48000, SND_PCM_FORMAT_FLOAT_LE, 1, 44100, frames));
+    ASSERT_EQ(-ERANGE, converter.setup(SND_PCM_FORMAT_FLOAT_LE, 1, 48000, SND_PCM_FORMAT_FLOAT_LE, 1, 44099, frames));
+    ASSERT_EQ(0, converter.setup(SND_PCM_FORMAT_FLOAT_LE, 1, 48000, SND_PCM_FORMAT_FLOAT_LE, 1, 44100, frames));
+
+    vector<float> input(frames);
+    vector<float> output(converter.getMaxOutputFrames());
+    size_t total = 0;
+    float peak = 0.0f;
+    for (int p = 0; p < periods; ++p)
+    {
+        for (size_t f = 0; f < frames; ++f)
+        {
+            input[f] = 0.5f * sinf(2.0f * M_PI * 1000.0f * (p * frames + f) / 48000.0f);
+        }
+        size_t out = converter.process(input.data(), frames, output.data());
+        ASSERT_LE(out, converter.getMaxOutputFrames());
+        total += out;
+        if (p > 0)
+        {
+            peak = max(peak, *max_element(output.begin(), output.begin() + out));
+        }
+    }
+    ASSERT_NEAR(periods * 441, total, 1);
+    ASSERT_NEAR(0.5f, peak, 0.01f);
+}
+
+static double benchmarkConverter(const uint32_t srcFormat, const uint32_t srcRate,
+                                 const uint32_t dstFormat, const uint32_t dstRate, const uint32_t channels)
+{
+    const size_t frames = 1024;
+    const int periods = 500;
+    CAmRoutingAdapterALSAConverter converter;
+    converter.setup(srcFormat, channels, srcRate, dstFormat, channels, dstRate, frames);
+    vector<int32_t> input(frames * channels, 1000);
+    vector<int32_t> output(converter.getMaxOutputFrames() * channels);
+
+    timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < periods; ++i)
+    {
+        converter.process(input.data(), frames, output.data());
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    return (static_cast<double>(frames) * periods) / seconds;
+}
+
+TEST(testConverter, benchmark)
+{
+    /* frames per second on a single core, testProxy.benchmarkAgainstPlug compares the proxy with plug */
+    for (uint32_t channels : {2, 6})
+    {
+        double fmt = benchmarkConverter(SND_PCM_FORMAT_S16_LE, 48000, SND_PCM_FORMAT_S32_LE, 48000, channels);
+        double src = benchmarkConverter(SND_PCM_FORMAT_S16_LE, 44100, SND_PCM_FORMAT_S16_LE, 48000, channels);
+        cout << "converter channels " << channels << " frames/s S16->S32 " << fmt
+             << " 44.1->48 kHz " << src << endl;
+        ASSERT_GT(fmt, 0);
+        ASSERT_GT(src, 0);
+    }
+}
+
+TEST(testDrift, followsClock)
+{
+    /* capture 200 ppm faster than the playback, periods of 10 ms over one minute */
+    const size_t frames = 480;
+    CAmRoutingAdapterALSADrift drift;
+    drift.setup(48000);
+    double level = 960.0;
+    double minLevel = 2 * level;
+    double maxLevel = 0.0;
+    for (int p = 0; p < 6000; ++p)
+    {
+        level += frames * 200e-6;
+        /* the measured level jitters by one frame, checked once the filter settled */
+        level += drift.update(static_cast<int64_t>(level) + (p % 3) - 1, frames);
+        if (p > 3000)
+        {
+            minLevel = min(minLevel, level);
+            maxLevel = max(maxLevel, level);
+        }
+    }
+    ASSERT_LT(maxLevel - minLevel, 6.0);
+    ASSERT_NEAR(200, drift.getPpm(), 20);
+    /* less than the drift, the level settles a few frames above the target */
+    ASSERT_NEAR(6000 * frames * 200e-6, drift.getDropped(), 50);
+    ASSERT_EQ(0u, drift.getInserted());
+
+    /* slower capture leads to inserted frames */
+    drift.setup(48000);
+    for (int p = 0; p < 2500; ++p)
+    {
+        level -= frames * 100e-6;
+        level += drift.update(static_cast<int64_t>(level), frames);
+    }
+    ASSERT_NEAR(-100, drift.getPpm(), 20);
+    ASSERT_GT(drift.getInserted(), 0u);
+    ASSERT_EQ(0u, drift.getDropped());
+}
+
+TEST(testStats, histogram)
+{
+    CAmRoutingAdapterALSAHistogram histogram;
+    ASSERT_EQ(0u, histogram.getPercentile(50));
+
+    /* 90 values around 100 us, 10 values around 5 ms */
+    for (uint32_t i = 0; i < 90; i++)
+    {
+        histogram.add(80 + i % 40);
+    }
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        histogram.add(5000 + i);
+    }
+    ASSERT_EQ(100u, histogram.getCount());
+    ASSERT_EQ(5009u, histogram.getMax());
+    ASSERT_NEAR(590, histogram.getMean(), 10);
+    ASSERT_EQ(127u, histogram.getPercentile(50));
+    ASSERT_EQ(127u, histogram.getPercentile(90));
+    ASSERT_EQ(8191u, histogram.getPercentile(99));
+
+    /* values beyond the last bucket are reported as maximum */
+    histogram.reset();
+    histogram.add(0);
+    histogram.add(UINT32_MAX);
+    ASSERT_EQ(0u, histogram.getPercentile(50));
+    ASSERT_EQ(UINT32_MAX, histogram.getPercentile(100));
+
+    CAmRoutingAdapterALSAStats stats;
+    stats.addXrun();
+    stats.addRecovery();
+    stats.addRecovery();
+    stats.setDelay(42000);
+    stats.setDelay(40000);
+    ASSERT_EQ(1u, stats.getXruns());
+    ASSERT_EQ(2u, stats.getRecoveries());
+    ASSERT_EQ(40000u, stats.getDelay());
+    ASSERT_EQ(42000u, stats.getMaxDelay());
+    stats.reset();
+    ASSERT_EQ(0u, stats.getXruns());
+    ASSERT_EQ(0u, stats.getDelay());
+}
+
+TEST(testLevel, periodicNotificationHoldsMaximum)
+{
+    CAmRoutingAdapterALSALevelNotification notification;
+    notification.configure(NS_PERIODIC, 1000);
+
+    /* a peak in the first interval is reported at the end of the period */
+    am_volume_t value;
+    ASSERT_FALSE(notification.check(-30, 100, value));
+    for (int i = 0; i < 8; i++)
+    {
+        ASSERT_FALSE(notification.check(-600, 100, value));
+    }
+    ASSERT_TRUE(notification.check(-600, 100, value));
+    ASSERT_EQ(-30, value);
+
+    /* the held level is reset by the notification */
+    for (int i = 0; i < 9; i++)
+    {
+        ASSERT_FALSE(notification.check(-600, 100, value));
+    }
+    ASSERT_TRUE(notification.check(-500, 100, value));
+    ASSERT_EQ(-500, value);
+
+    /* a change builds up over several intervals and drops are reported at once */
+    notification.configure(NS_CHANGE, 60);
+    ASSERT_TRUE(notification.check(-600, 100, value));
+    ASSERT_FALSE(notification.check(-570, 100, value));
+    ASSERT_FALSE(notification.check(-590, 100, value));
+    ASSERT_TRUE(notification.check(-540, 100, value));
+    ASSERT_EQ(-540, value);
+    ASSERT_FALSE(notification.check(-580, 100, value));
+    ASSERT_TRUE(notification.check(-700, 100, value));
+    ASSERT_EQ(-700, value);
+}
+
+TEST(testLevel, peakAndRms)
+{
+    const size_t frames = 480;
+    CAmRoutingAdapterALSALevel level;
+    ASSERT_GT(0, level.setup(SND_PCM_FORMAT_S16_LE, RA_LEVEL_MAX_CHANNELS + 1));
+    ASSERT_EQ(0, level.setup(SND_PCM_FORMAT_S16_LE, 2));
+
+    /* full scale sine left, half scale right */
+    vector<int16_t> buffer(frames * 2);
+    for (size_t i = 0; i < frames; i++)
+    {
+        float sine = sinf(2 * M_PI * 1000 * i / 48000);
+        buffer[i * 2] = static_cast<int16_t>(32767 * sine);
+        buffer[i * 2 + 1] = static_cast<int16_t>(16384 * sine);
+    }
+
+    /* nothing is measured while disabled */
+    am_volume_t peak, rms;
+    level.analyze(buffer.data(), frames);
+    level.take(peak, rms);
+    ASSERT_EQ(AM_MUTE, peak);
+    ASSERT_EQ(AM_MUTE, rms);
+
+    level.setEnabled(true);
+    level.analyze(buffer.data(), frames);
+    level.take(0, peak, rms);
+    ASSERT_NEAR(0, peak, 1);
+    ASSERT_NEAR(-30, rms, 1);
+    level.take(1, peak, rms);
+    ASSERT_NEAR(-60, peak, 1);
+    ASSERT_NEAR(-90, rms, 1);
+
+    /* levels are held until taken */
+    vector<int16_t> silence(frames * 2, 0);
+    level.analyze(buffer.data(), frames);
+    level.analyze(silence.data(), frames);
+    level.take(peak, rms);
+    ASSERT_NEAR(0, peak, 1);
+    level.take(peak, rms);
+    ASSERT_EQ(AM_MUTE, peak);
+
+    /* channel counts not fitting into a vector are measured by the scalar loop */
+    vector<float> floats(frames * 3, 0.0f);
+    for (size_t i = 0; i < frames; i++)
+    {
+        floats[i * 3 + 2] = (i % 2) ? -0.1f : 0.1f;
+    }
+    ASSERT_EQ(0, level.setup(SND_PCM_FORMAT_FLOAT_LE, 3));
+    level.analyze(floats.data(), frames);
+    level.take(0, peak, rms);
+    ASSERT_EQ(AM_MUTE, peak);
+    level.take(2, peak, rms);
+    ASSERT_EQ(-200, peak);
+    ASSERT_EQ(-200, rms);
+}
+
+TEST(testCrossfade, complementaryGains)
+{
+    const size_t frames = 480;
+    CAmRoutingAdapterALSACrossfade crossfade;
+    ASSERT_EQ(0, crossfade.setup(SND_PCM_FORMAT_S16_LE, 2, 48000, frames));
+
+    /* sink A is hot without any fade requested */
+    vector<int16_t> bufA(frames * 2, 10000);
+    vector<int16_t> bufB(frames * 2, 10000);
+    crossfade.advance(frames);
+    crossfade.apply(HS_SINKA, bufA.data(), frames);
+    crossfade.apply(HS_SINKB, bufB.data(), frames);
+    ASSERT_EQ(10000, bufA[0]);
+    ASSERT_EQ(0, bufB[0]);
+    ASSERT_FALSE(crossfade.isFading());
+
+    /* equal power fade to sink B within 10 periods */
+    crossfade.setTarget(HS_SINKB, RAMP_GENIVI_EXP, 100);
+    ASSERT_TRUE(crossfade.isFading());
+    for (int p = 0; p < 10; ++p)
+    {
+        fill(bufA.begin(), bufA.end(), 10000);
+        fill(bufB.begin(), bufB.end(), 10000);
+        crossfade.advance(frames);
+        crossfade.apply(HS_SINKA, bufA.data(), frames);
+        crossfade.apply(HS_SINKB, bufB.data(), frames);
+        for (size_t i = 0; i < bufA.size(); i++)
+        {
+            float a = bufA[i] / 10000.0f;
+            float b = bufB[i] / 10000.0f;
+            ASSERT_NEAR(1.0f, a * a + b * b, 0.001f);
+        }
+        ASSERT_TRUE(crossfade.isFading());
+    }
+    ASSERT_EQ(0, bufA.back());
+    ASSERT_EQ(10000, bufB.back());
+
+    /* completion is reported with the next period */
+    crossfade.advance(frames);
+    ASSERT_FALSE(crossfade.isFading());
+    ASSERT_EQ(HS_SINKB, crossfade.getHotSink());
+
+    /* linear fade to the middle keeps the sum of both sides */
+    crossfade.setTarget(HS_INTERMEDIATE, RAMP_GENIVI_LINEAR, 10);
+    fill(bufA.begin(), bufA.end(), 10000);
+    fill(bufB.begin(), bufB.end(), 10000);
+    crossfade.advance(frames);
+    crossfade.apply(HS_SINKA, bufA.data(), frames);
+    crossfade.apply(HS_SINKB, bufB.data(), frames);
+    for (size_t i = 0; i < bufA.size(); i++)
+    {
+        ASSERT_NEAR(10000, bufA[i] + bufB[i], 1);
+    }
+    ASSERT_EQ(5000, bufA.back());
+    crossfade.advance(frames);
+    ASSERT_EQ(HS_INTERMEDIATE, crossfade.getHotSink());
+}
+
+static void fillDomains(vector<ra_domainInfo_s> & domains, const uint16_t devices)
+{
+    /* the devices are spread over four domains, one proxy per source and sink */
+    for (uint16_t d = 0; d < 4; ++d)
+    {
+        ra_domainInfo_s domain;
+        domain.domain.domainID = d + 1;
+        domain.domain.name = "domain" + to_string(d);
+        domains.push_back(domain);
+    }
+    for (uint16_t i = 0; i < devices; ++i)
+    {
+        ra_domainInfo_s & domain = domains[i % domains.size()];
+        ra_sourceInfo_s source(static_cast<am_sourceID_t>(100 + i));
+        source.amInfo.name = "source" + to_string(i);
+        ra_sinkInfo_s sink(static_cast<am_sinkID_t>(100 + i));
+        sink.amInfo.name = "sink" + to_string(i);
+        ra_proxyInfo_s proxy(source.amInfo.sourceID, sink.amInfo.sinkID);
+        proxy.srcNam = source.amInfo.name;
+        proxy.sinkNam = sink.amInfo.name;
+        domain.lSourceInfo.push_back(source);
+        domain.lSinkInfo.push_back(sink);
+        domain.lProxyInfo.push_back(proxy);
+    }
+}
+
+/* lookups of CAmRoutingAdapterALSAdb before the index, kept as reference and baseline */
+static ra_domainInfo_s * formerFindDomain(vector<ra_domainInfo_s> & domains, ra_sourceInfo_s & source,
+        ra_sinkInfo_s & sink)
+{
+    for (ra_domainInfo_s & domain : domains)
+    {
+        /* find source id */
+        vector<ra_sourceInfo_s>::iterator itSource =
+                find_if(domain.lSourceInfo.begin(), domain.lSourceInfo.end(), source);
+        if (itSource == domain.lSourceInfo.end())
+        {
+            continue; /* in case the sink id is not in domain search in other domain */
+        }
+
+        /* find sink id and check for causality */
+        vector<ra_sinkInfo_s>::iterator itSink =
+                find_if(domain.lSinkInfo.begin(),domain.lSinkInfo.end(), sink);
+        if (itSink != domain.lSinkInfo.end())
+        {
+            source = *itSource;
+            sink = *itSink;
+            return &domain;
+        }
+    }
+    return NULL;
+}
+
+static ra_proxyInfo_s * formerFindProxyInDomain(ra_domainInfo_s * pDomain, const am_sourceID_t sourceID,
+        const am_sinkID_t sinkID)
+{
+    std::vector<ra_proxyInfo_s>::iterator itr =
+            find_if(pDomain->lProxyInfo.begin(), pDomain->lProxyInfo.end(), ra_proxyInfo_s(sourceID, sinkID));
+    if (itr != pDomain->lProxyInfo.end())
+    {
+        return &(*itr);
+    }
+    return NULL;
+}
+
+TEST(testDbIndex, lookups)
+{
+    vector<ra_domainInfo_s> domains;
+    fillDomains(domains, 20);
+    CAmRoutingAdapterALSAdbIndex index(domains);
+
+    ra_domainInfo_s *pDomain = NULL;
+    ra_sourceInfo_s *pSource = index.findSource(105, &pDomain);
+    ASSERT_TRUE(pSource != NULL);
+    ASSERT_EQ("source5", pSource->amInfo.name);
+    ASSERT_EQ(&domains[1], pDomain);
+    ASSERT_EQ(pSource, index.findSource("source5"));
+    ASSERT_EQ(&domains[3], index.findDomain("domain3"));
+    ASSERT_EQ(&domains[3], index.findDomain(static_cast<am_domainID_t>(4)));
+    ASSERT_TRUE(index.findSink(static_cast<am_sinkID_t>(99)) == NULL);
+
+    ra_proxyInfo_s *pProxy = index.findProxy(pDomain, 105, 105);
+    ASSERT_TRUE(pProxy != NULL);
+    ASSERT_EQ("sink5", pProxy->sinkNam);
+    ASSERT_EQ(pProxy, index.findProxy(pDomain, "source5", ""));
+    ASSERT_EQ(pProxy, index.findProxy(pDomain, "source5", "sink5"));
+    ASSERT_TRUE(index.findProxy(pDomain, 105, 106) == NULL);
+    ASSERT_TRUE(index.findProxy(&domains[0], 105, 105) == NULL);
+
+    /* a proxy without sink serves all sinks, new elements are found after invalidate() */
+    ra_proxyInfo_s proxy(200, 0);
+    domains[0].lProxyInfo.push_back(proxy);
+    index.invalidate();
+    ASSERT_EQ(&domains[0].lProxyInfo.back(), index.findProxy(&domains[0], 200, 104));
+    ASSERT_EQ("sink4", index.findSink(104)->amInfo.name);
+
+    /* of a proxy for the sink and one for all sinks the one configured first is used */
+    ra_proxyInfo_s exact(300, 104);
+    ra_proxyInfo_s any(300, 0);
+    domains[0].lProxyInfo.push_back(any);
+    domains[0].lProxyInfo.push_back(exact);
+    domains[1].lProxyInfo.push_back(exact);
+    domains[1].lProxyInfo.push_back(any);
+    index.invalidate();
+    ASSERT_EQ(&domains[0].lProxyInfo.end()[-2], index.findProxy(&domains[0], 300, 104));
+    ASSERT_EQ(&domains[1].lProxyInfo.end()[-2], index.findProxy(&domains[1], 300, 104));
+    ASSERT_EQ(&domains[1].lProxyInfo.back(), index.findProxy(&domains[1], 300, 105));
+    for (ra_domainInfo_s & domain : domains)
+    {
+        for (am_sinkID_t sinkID : {0, 104, 105})
+        {
+            ASSERT_EQ(formerFindProxyInDomain(&domain, 300, sinkID), index.findProxy(&domain, 300, sinkID));
+        }
+    }
+}
+
+TEST(testDbIndex, benchmark)
+{
+    /* lookups per second of the source and sink of a route and of its proxy */
+    for (uint16_t devices : {50, 200, 800})
+    {
+        vector<ra_domainInfo_s> domains;
+        fillDomains(domains, devices);
+        CAmRoutingAdapterALSAdb db(NULL);
+        for (ra_domainInfo_s & domain : domains)
+        {
+            db.createDomain(domain);
+        }
+        const int lookups = 20000;
+
+        /* the route lookup of asyncConnect */
+        timespec start, end;
+        size_t found = 0;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < lookups; ++i)
+        {
+            am_sourceID_t id = static_cast<am_sourceID_t>(100 + (i * 7) % devices);
+            ra_sourceInfo_s source(id);
+            ra_sinkInfo_s sink(id);
+            ra_domainInfo_s *pDomain = formerFindDomain(domains, source, sink);
+            found += (pDomain != NULL) && (formerFindProxyInDomain(pDomain, id, id) != NULL);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double linear = lookups / ((end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+        ASSERT_EQ(static_cast<size_t>(lookups), found);
+
+        found = 0;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < lookups; ++i)
+        {
+            am_sourceID_t id = static_cast<am_sourceID_t>(100 + (i * 7) % devices);
+            ra_sourceInfo_s source(id);
+            ra_sinkInfo_s sink(id);
+            ra_domainInfo_s *pDomain = db.findDomain(source, sink);
+            found += (pDomain != NULL) && (db.findProxyInDomain(pDomain, id, id) != NULL);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double hashed = lookups / ((end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+        ASSERT_EQ(static_cast<size_t>(lookups), found);
+
+        cout << "db devices " << devices << " routes/s linear " << linear << " indexed " << hashed << endl;
+    }
+}
+
+/* scripted ramp, counts the calls of the volume scheduler */
+class CAmTestRamp : public IAmRoutingAdapterALSARamp
+{
+public:
+    CAmTestRamp(const string & name, int steps, CAmRoutingAdapterALSAVolumeScheduler *pScheduler = NULL,
+            IAmRoutingAdapterALSARamp *pRemove = NULL)
+        : mName(name), mSteps(steps), mpScheduler(pScheduler), mpRemove(pRemove),
+          mExecuted(0), mFinished(0), mResult(0), mRemoved(false), mHold(false), mStepping(false)
+    {
+    }
+
+    const string & getElementName() const override
+    {
+        return mName;
+    }
+
+    int prepareRamp() override
+    {
+        return (mSteps > 0) ? 0 : -EINVAL;
+    }
+
+    int executeStep() override
+    {
+        /* a slow mixer write */
+        mStepping = true;
+        while (mHold)
+        {
+            usleep(100);
+        }
+        mStepping = false;
+        return (++mExecuted < mSteps) ? 0 : 1;
+    }
+
+    __useconds_t getStepTime() override
+    {
+        return 1000;
+    }
+
+    void finishRamp(int err) override
+    {
+        /* the scheduler has to be usable while the end of a ramp is reported */
+        if (mpRemove != NULL)
+        {
+            mRemoved = mpScheduler->removeRamp(mpRemove);
+        }
+        mResult = err;
+        ++mFinished;
+    }
+
+    bool waitFinished()
+    {
+        for (int i = 0; (i < 2000) && (mFinished == 0); ++i)
+        {
+            usleep(1000);
+        }
+        return (mFinished != 0);
+    }
+
+    string mName;
+    int mSteps;
+    CAmRoutingAdapterALSAVolumeScheduler *mpScheduler;
+    IAmRoutingAdapterALSARamp *mpRemove;
+    atomic<int> mExecuted;
+    atomic<int> mFinished;
+    atomic<int> mResult;
+    atomic<bool> mRemoved;
+    atomic<bool> mHold;
+    atomic<bool> mStepping;
+};
+
+/* lets the poll of the volume scheduler thread fail once */
+static atomic<bool> gFailSchedulerPoll(false);
+
+extern "C" int poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+    typedef int (*poll_t)(struct pollfd*, nfds_t, int);
+    static poll_t pPoll = reinterpret_cast<poll_t>(dlsym(RTLD_NEXT, "poll"));
+    if (gFailSchedulerPoll)
+    {
+        char name[16] = "";
+        prctl(PR_GET_NAME, name);
+        if ((strcmp(name, "raa_vol_sched") == 0) && gFailSchedulerPoll.exchange(false))
+        {
+            errno = EBADF;
+            return -1;
+        }
+    }
+    return pPoll(fds, nfds, timeout);
+}
+
+TEST(testVolumeScheduler, rampsFinishOutsideLock)
+{
+    CAmRoutingAdapterALSAVolumeScheduler scheduler;
+    CAmTestRamp endless("B", INT_MAX);
+    CAmTestRamp ramp("A", 5, &scheduler, &endless);
+
+    int err = scheduler.addRamp(&endless);
+    if (err != 0)
+    {
+        /* no permission for the real-time thread, the ramp ends with the error right away */
+        ASSERT_LT(err, 0);
+        ASSERT_EQ(1, endless.mFinished.load());
+        ASSERT_EQ(err, endless.mResult.load());
+        ASSERT_FALSE(scheduler.removeRamp(&endless));
+        return;
+    }
+
+    /* the finished ramp removes the endless one from within its report */
+    ASSERT_EQ(0, scheduler.addRamp(&ramp));
+    ASSERT_TRUE(ramp.waitFinished());
+    ASSERT_EQ(5, ramp.mExecuted.load());
+    ASSERT_EQ(1, ramp.mResult.load());
+    ASSERT_TRUE(ramp.mRemoved.load());
+    ASSERT_EQ(0, endless.mFinished.load());
+    ASSERT_FALSE(scheduler.removeRamp(&endless));
+    ASSERT_FALSE(scheduler.removeRamp(&ramp));
+    ASSERT_EQ(1, ramp.mFinished.load());
+}
+
+TEST(testVolumeScheduler, retargetAndFailure)
+{
+    CAmRoutingAdapterALSAVolumeScheduler scheduler;
+    CAmTestRamp first("C", INT_MAX);
+    CAmTestRamp second("C", 3);
+    CAmTestRamp invalid("D", 0);
+
+    /* a failed preparation is reported before the thread is needed */
+    ASSERT_EQ(-EINVAL, scheduler.addRamp(&invalid));
+    ASSERT_EQ(1, invalid.mFinished.load());
+    ASSERT_EQ(-EINVAL, invalid.mResult.load());
+    ASSERT_FALSE(scheduler.removeRamp(&invalid));
+
+    int err = scheduler.addRamp(&first);
+    if (err != 0)
+    {
+        ASSERT_EQ(1, first.mFinished.load());
+        ASSERT_EQ(err, first.mResult.load());
+        ASSERT_FALSE(scheduler.removeRamp(&first));
+        return;
+    }
+
+    /* the new target of the same element aborts the running ramp */
+    ASSERT_EQ(0, scheduler.addRamp(&second));
+    ASSERT_EQ(1, first.mFinished.load());
+    ASSERT_EQ(0, first.mResult.load());
+    ASSERT_TRUE(second.waitFinished());
+    ASSERT_EQ(1, second.mResult.load());
+    ASSERT_EQ(1, first.mFinished.load());
+    ASSERT_FALSE(scheduler.removeRamp(&first));
+}
+
+TEST(testVolumeScheduler, stepsOutsideLock)
+{
+    CAmRoutingAdapterALSAVolumeScheduler scheduler;
+    CAmTestRamp held("E", INT_MAX);
+    CAmTestRamp other("F", 3);
+    CAmTestRamp same("E", 2);
+
+    held.mHold = true;
+    int err = scheduler.addRamp(&held);
+    if (err != 0)
+    {
+        ASSERT_LT(err, 0);
+        ASSERT_EQ(1, held.mFinished.load());
+        return;
+    }
+    for (int i = 0; (i < 2000) && !held.mStepping; ++i)
+    {
+        usleep(1000);
+    }
+    ASSERT_TRUE(held.mStepping.load());
+
+    /* other elements are scheduled while a mixer is written */
+    err = scheduler.addRamp(&other);
+    bool stepping = held.mStepping;
+    held.mHold = false;
+    ASSERT_EQ(0, err);
+    ASSERT_TRUE(stepping);
+    ASSERT_TRUE(other.waitFinished());
+    ASSERT_EQ(1, other.mResult.load());
+
+    /* the same element waits for a running step, then replaces the ramp */
+    ASSERT_EQ(0, scheduler.addRamp(&same));
+    ASSERT_EQ(1, held.mFinished.load());
+    ASSERT_EQ(0, held.mResult.load());
+    ASSERT_TRUE(same.waitFinished());
+    ASSERT_EQ(1, same.mResult.load());
+}
+
+TEST(testVolumeScheduler, restartAfterThreadError)
+{
+    CAmRoutingAdapterALSAVolumeScheduler scheduler;
+    CAmTestRamp endless("G", INT_MAX);
+    CAmTestRamp next("H", 3);
+
+    int err = scheduler.addRamp(&endless);
+    if (err != 0)
+    {
+        ASSERT_LT(err, 0);
+        ASSERT_EQ(1, endless.mFinished.load());
+        return;
+    }
+
+    /* the failing thread ends the ramps it was driving */
+    gFailSchedulerPoll = true;
+    ASSERT_TRUE(endless.waitFinished());
+    ASSERT_EQ(-EBADF, endless.mResult.load());
+    ASSERT_FALSE(gFailSchedulerPoll.load());
+    ASSERT_FALSE(scheduler.removeRamp(&endless));
+
+    /* the next ramp starts a new thread */
+    ASSERT_EQ(0, scheduler.addRamp(&next));
+    ASSERT_TRUE(next.waitFinished());
+    ASSERT_EQ(1, next.mResult.load());
+    ASSERT_EQ(3, next.mExecuted.load());
+}
+
+/*
+ * Card "hw:test" with the single volume element "Master" replacing the mixer
+ * of ALSA. Each loaded mixer keeps its own copy of the value until it handles
+ * the change events, like ALSA does.
+ */
+struct ra_testMixer_s
+{
+    long volume;
+    uint32_t events;
+    snd_mixer_elem_callback_t callback;
+    void *callbackPrivate;
+};
+static long gCardVolume = 0;
+static uint32_t gCardEvents = 0;
+static uint32_t gMixerOpens = 0;
+static uint32_t gMixerCloses = 0;
+
+/* another application changes the volume of the card */
+static void changeCardVolume(const long volume)
+{
+    gCardVolume = volume;
+    ++gCardEvents;
+}
+
+extern "C" int snd_mixer_open(snd_mixer_t **mixer, int mode)
+{
+    (void)mode;
+    ra_testMixer_s *pMixer = new ra_testMixer_s();
+    ++gMixerOpens;
+    *mixer = reinterpret_cast<snd_mixer_t*>(pMixer);
+    return 0;
+}
+
+extern "C" int snd_mixer_close(snd_mixer_t *mixer)
+{
+    ++gMixerCloses;
+    delete reinterpret_cast<ra_testMixer_s*>(mixer);
+    return 0;
+}
+
+extern "C" int snd_mixer_attach(snd_mixer_t *mixer, const char *name)
+{
+    (void)mixer;
+    return (string(name) == "hw:test") ? 0 : -ENODEV;
+}
+
+extern "C" int snd_mixer_selem_register(snd_mixer_t *mixer, struct snd_mixer_selem_regopt *options,
+        snd_mixer_class_t **classp)
+{
+    (void)mixer;
+    (void)options;
+    (void)classp;
+    return 0;
+}
+
+extern "C" int snd_mixer_load(snd_mixer_t *mixer)
+{
+    ra_testMixer_s *pMixer = reinterpret_cast<ra_testMixer_s*>(mixer);
+    pMixer->volume = gCardVolume;
+    pMixer->events = gCardEvents;
+    return 0;
+}
+
+extern "C" int snd_mixer_handle_events(snd_mixer_t *mixer)
+{
+    ra_testMixer_s *pMixer = reinterpret_cast<ra_testMixer_s*>(mixer);
+    if (pMixer->events == gCardEvents)
+    {
+        return 0;
+    }
+    pMixer->volume = gCardVolume;
+    pMixer->events = gCardEvents;
+    if (pMixer->callback != NULL)
+    {
+        pMixer->callback(reinterpret_cast<snd_mixer_elem_t*>(pMixer), SND_CTL_EVENT_MASK_VALUE);
+    }
+    return 1;
+}
+
+extern "C" int snd_mixer_selem_id_malloc(snd_mixer_selem_id_t **ptr)
+{
+    *ptr = reinterpret_cast<snd_mixer_selem_id_t*>(new string());
+    return 0;
+}
+
+extern "C" void snd_mixer_selem_id_free(snd_mixer_selem_id_t *obj)
+{
+    delete reinterpret_cast<string*>(obj);
+}
+
+extern "C" void snd_mixer_selem_id_set_name(snd_mixer_selem_id_t *obj, const char *val)
+{
+    *reinterpret_cast<string*>(obj) = val;
+}
+
+extern "C" void snd_mixer_selem_id_set_index(snd_mixer_selem_id_t *obj, unsigned int val)
+{
+    (void)obj;
+    (void)val;
+}
+
+extern "C" snd_mixer_elem_t *snd_mixer_find_selem(snd_mixer_t *mixer, const snd_mixer_selem_id_t *id)
+{
+    if (*reinterpret_cast<const string*>(id) != "Master")
+    {
+        return NULL;
+    }
+    return reinterpret_cast<snd_mixer_elem_t*>(mixer);
+}
+
+extern "C" void snd_mixer_elem_set_callback(snd_mixer_elem_t *obj, snd_mixer_elem_callback_t val)
+{
+    reinterpret_cast<ra_testMixer_s*>(obj)->callback = val;
+}
+
+extern "C" void snd_mixer_elem_set_callback_private(snd_mixer_elem_t *obj, void *val)
+{
+    reinterpret_cast<ra_testMixer_s*>(obj)->callbackPrivate = val;
+}
+
+extern "C" void *snd_mixer_elem_get_callback_private(const snd_mixer_elem_t *obj)
+{
+    return reinterpret_cast<const ra_testMixer_s*>(obj)->callbackPrivate;
+}
+
+extern "C" int snd_mixer_selem_get_playback_volume(snd_mixer_elem_t *elem, snd_mixer_selem_channel_id_t channel,
+        long *value)
+{
+    (void)channel;
+    *value = reinterpret_cast<ra_testMixer_s*>(elem)->volume;
+    return 0;
+}
+
+extern "C" int snd_mixer_selem_set_playback_volume_all(snd_mixer_elem_t *elem, long value)
+{
+    reinterpret_cast<ra_testMixer_s*>(elem)->volume = value;
+    changeCardVolume(value);
+    return 0;
+}
+
+/* reports each volume change notification */
+class CAmTestMixerCtrl : public CAmRoutingAdapterALSAMixerCtrl
+{
+public:
+    CAmTestMixerCtrl(std::shared_ptr<ra_mixerHandle_s> shared)
+        : CAmRoutingAdapterALSAMixerCtrl(shared), mNotified(0), mNotifications(0)
+    {
+    }
+
+    long mNotified;
+    uint32_t mNotifications;
+
+protected:
+    int cbVolumeChange(const long int & volume) override
+    {
+        mNotified = volume;
+        ++mNotifications;
+        return 0;
+    }
+};
+
+TEST(testMixerCache, refreshAndInvalidate)
+{
+    gMixerOpens = 0;
+    gMixerCloses = 0;
+    gCardVolume = 10;
+    CAmRoutingAdapterALSAMixerCache cache;
+    ASSERT_EQ(nullptr, cache.getHandle("hw:missing"));
+    ASSERT_EQ(0u, cache.size());
+    ASSERT_EQ(gMixerOpens, gMixerCloses);
+
+    gMixerOpens = 0;
+    gMixerCloses = 0;
+    shared_ptr<ra_mixerHandle_s> handle = cache.getHandle("hw:test");
+    ASSERT_NE(nullptr, handle);
+    ASSERT_EQ(handle, cache.getHandle("hw:test"));
+    ASSERT_EQ(1u, cache.size());
+    {
+        CAmTestMixerCtrl ctrl(handle);
+        ASSERT_EQ(0, ctrl.openMixer("hw:test", "Master"));
+        ctrl.activateVolumeChangeNotification();
+        long volume = 0;
+        ASSERT_EQ(0, ctrl.getVolume(volume));
+        ASSERT_EQ(10, volume);
+
+        /* the change of another application is seen by the next read of the cached mixer */
+        changeCardVolume(20);
+        ASSERT_EQ(0, ctrl.getVolume(volume));
+        ASSERT_EQ(20, volume);
+        ASSERT_EQ(20, ctrl.mNotified);
+        ASSERT_EQ(1u, ctrl.mNotifications);
+
+        /* a second control shares the loaded mixer and sees the changes of the first */
+        CAmTestMixerCtrl other(cache.getHandle("hw:test"));
+        ASSERT_EQ(0, other.openMixer("hw:test", "Master"));
+        ASSERT_LE(0, ctrl.setVolume(30));
+        ASSERT_EQ(0, other.getVolume(volume));
+        ASSERT_EQ(30, volume);
+        ASSERT_EQ(1u, gMixerOpens);
+
+        /* dropped mixers stay loaded while controls use them, the next request loads the card again */
+        cache.invalidate();
+        ASSERT_EQ(0u, cache.size());
+        shared_ptr<ra_mixerHandle_s> reloaded = cache.getHandle("hw:test");
+        ASSERT_NE(handle, reloaded);
+        ASSERT_EQ(2u, gMixerOpens);
+        ASSERT_EQ(0u, gMixerCloses);
+        changeCardVolume(40);
+        CAmTestMixerCtrl fresh(reloaded);
+        ASSERT_EQ(0, fresh.openMixer("hw:test", "Master"));
+        ASSERT_EQ(0, fresh.getVolume(volume));
+        ASSERT_EQ(40, volume);
+        ASSERT_EQ(0, other.getVolume(volume));
+        ASSERT_EQ(40, volume);
+    }
+    handle.reset();
+    ASSERT_EQ(1u, gMixerCloses);
+    cache.invalidate();
+    ASSERT_EQ(2u, gMixerCloses);
+}
+
+/* gives the tests access to the state of the streaming */
+class CAmTestProxy : public CAmRoutingAdapterALSAProxyDefault
+{
+public:
+    CAmTestProxy(const ra_Proxy_s & proxy)
+        : CAmRoutingAdapterALSAProxyDefault(proxy), mCpuUs(0)
+    {
+    }
+
+    bool isMmap() const
+    {
+        return mCap.mmap || mPb.mmap;
+    }
+
+    bool isMmapTransfer() const
+    {
+        return mMmapTransfer;
+    }
+
+    uint32_t getPeriods() const
+    {
+        return mCnt;
+    }
+
+    uint32_t getRecoveries() const
+    {
+        return mStats.getRecoveries();
+    }
+
+    /* CPU time of the streaming thread, measured in the thread itself */
+    uint64_t getCpuUs() const
+    {
+        return mCpuUs;
+    }
+
+private:
+    int initThread() override
+    {
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &mCpuBegin);
+        return CAmRoutingAdapterALSAProxyDefault::initThread();
+    }
+
+    void deinitThread(int errInit) override
+    {
+        timespec cpuEnd;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuEnd);
+        mCpuUs = (cpuEnd.tv_sec - mCpuBegin.tv_sec) * 1000000ULL + (cpuEnd.tv_nsec - mCpuBegin.tv_nsec) / 1000;
+        CAmRoutingAdapterALSAProxyDefault::deinitThread(errInit);
+    }
+
+    timespec mCpuBegin;
+    uint64_t mCpuUs;
+};
+
+/* proxy between the null PCMs of ALSA, which never block */
+static ra_Proxy_s getNullProxy(const bool mmap)
+{
+    ra_Proxy_s proxy;
+    proxy.pcmSrc = "null";
+    proxy.pcmSink = "null";
+    proxy.format = SND_PCM_FORMAT_S16_LE;
+    proxy.channels = 2;
+    proxy.rate = 48000;
+    proxy.duplex = 0;
+    proxy.msBuffersize = 10;
+    proxy.msPrefill = 10;
+    proxy.msInitTimeout = 0;
+    proxy.cpuScheduler.policy = SCHED_OTHER;
+    proxy.cpuScheduler.priority = 0;
+    proxy.softVolume = false;
+    proxy.mixing = false;
+    proxy.mmapAccess = mmap;
+    proxy.sinkFormat = -1;
+    proxy.sinkChannels = 0;
+    proxy.sinkRate = 0;
+    proxy.driftCompensation = false;
+    proxy.warm = false;
+    return proxy;
+}
+
+TEST(testProxy, mmapFallsBackToRw)
+{
+    /* accessMode="mmap" is configured, but neither device provides it */
+    gRejectMmap = true;
+    ra_Proxy_s config = getNullProxy(true);
+    CAmTestProxy proxy(config);
+    ASSERT_EQ(E_OK, proxy.openStreaming());
+    ASSERT_EQ(E_OK, proxy.prepareStreaming());
+    gRejectMmap = false;
+    ASSERT_FALSE(proxy.isMmap());
+
+    /* the periods are copied with RW access instead */
+    ASSERT_EQ(E_OK, proxy.startStreaming());
+    usleep(50000);
+    proxy.stopStreaming();
+    proxy.closeStreaming();
+    ASSERT_FALSE(proxy.isMmapTransfer());
+    ASSERT_GT(proxy.getPeriods(), 0u);
+}
+
+/* streams one connection for 200 ms, returns the CPU time of the streaming thread per period in us */
+static double benchmarkProxy(const ra_Proxy_s & config, bool & mmap, am_timeSync_t & delay)
+{
+    CAmTestProxy proxy(config);
+    if ((proxy.openStreaming() != E_OK) || (proxy.prepareStreaming() != E_OK) || (proxy.startStreaming() != E_OK))
+    {
+        return -1;
+    }
+    usleep(200000);
+    delay = proxy.getDelay();
+    proxy.stopStreaming();
+    proxy.closeStreaming();
+    mmap = proxy.isMmapTransfer();
+    return proxy.getPeriods() ? static_cast<double>(proxy.getCpuUs()) / proxy.getPeriods() : -1;
+}
+
+TEST(testProxy, benchmark)
+{
+    /* the null PCMs never block, the thread streams as fast as it can copy */
+    for (bool mmapAccess : {false, true})
+    {
+        ra_Proxy_s config = getNullProxy(mmapAccess);
+        bool mmap = false;
+        am_timeSync_t delay = 0;
+        double cpu = benchmarkProxy(config, mmap, delay);
+        cout << "proxy null to null " << (mmap ? "mmap" : "rw") << " CPU per period [us] " << cpu << endl;
+        ASSERT_GT(cpu, 0);
+    }
+}
+
+TEST(testProxy, benchmarkAgainstPlug)
+{
+    /*
+     * The same rate conversion once written to the null PCM directly and once through
+     * the plug plugin of ALSA, delay and CPU time of the streaming thread are printed.
+     */
+    for (const char *pcmSink : {"null", "plug:null"})
+    {
+        ra_Proxy_s config = getNullProxy(false);
+        config.pcmSink = pcmSink;
+        config.sinkRate = 44100;
+        bool mmap = false;
+        am_timeSync_t delay = 0;
+        double cpu = benchmarkProxy(config, mmap, delay);
+        cout << "proxy null to " << pcmSink << " 48->44.1 kHz delay [ms] " << delay
+             << " CPU per period [us] " << cpu << endl;
+        ASSERT_GT(cpu, 0);
+        ASSERT_GT(delay, 0);
+    }
+}
+
+class CAmTestMixer : public CAmRoutingAdapterALSAProxyMixer
+{
+public:
+    CAmTestMixer(const ra_Proxy_s & proxy)
+        : CAmRoutingAdapterALSAProxyMixer(proxy)
+    {
+    }
+
+    uint32_t getPeriods() const
+    {
+        return mCnt;
+    }
+};
+
+TEST(testProxy, mixerKeepsPlaybackRunning)
+{
+    ra_Proxy_s config = getNullProxy(false);
+    config.mixing = true;
+    ra_Proxy_s first = getNullProxy(false);
+    ra_Proxy_s second = getNullProxy(false);
+    CAmTestMixer mixer(config);
+
+    /* inputs not matching the playback are refused before anything is opened */
+    ra_Proxy_s wrongRate = getNullProxy(false);
+    wrongRate.rate = 44100;
+    gPlaybackOpens = 0;
+    ASSERT_EQ(E_WRONG_FORMAT, mixer.addInput(wrongRate));
+    ASSERT_EQ(0u, gPlaybackOpens.load());
+
+    /* the first input starts the playback, the second one joins it */
+    ASSERT_EQ(E_OK, mixer.addInput(first));
+    ASSERT_EQ(E_ALREADY_EXISTS, mixer.addInput(first));
+    usleep(20000);
+    uint32_t periods = mixer.getPeriods();
+    ASSERT_GT(periods, 0u);
+    ASSERT_EQ(E_OK, mixer.addInput(second));
+    usleep(20000);
+    ASSERT_GT(mixer.getPeriods(), periods);
+
+    /* removing an input keeps the playback of the other one running */
+    periods = mixer.getPeriods();
+    ASSERT_EQ(E_OK, mixer.removeInput(first));
+    ASSERT_EQ(E_NON_EXISTENT, mixer.removeInput(first));
+    usleep(20000);
+    ASSERT_GT(mixer.getPeriods(), periods);
+    ASSERT_EQ(E_OK, mixer.removeInput(second));
+    ASSERT_EQ(1u, gPlaybackOpens.load());
+}
+
+TEST(testRealTime, noAllocationInStreamingPath)
+{
+    const size_t frames = 480;
+    CAmRoutingAdapterALSAGain gain;
+    CAmRoutingAdapterALSAConverter converter;
+    CAmRoutingAdapterALSADrift drift;
+    CAmRoutingAdapterALSAStats stats;
+    CAmRoutingAdapterALSALevel level;
+    CAmRoutingAdapterALSACrossfade crossfade;
+    ASSERT_EQ(0, level.setup(SND_PCM_FORMAT_S16_LE, 2));
+    level.setEnabled(true);
+    ASSERT_EQ(0, crossfade.setup(SND_PCM_FORMAT_S16_LE, 2, 48000, frames));
+    crossfade.setTarget(HS_SINKB, RAMP_GENIVI_EXP, 100);
+    ASSERT_EQ(0, gain.setup(SND_PCM_FORMAT_S16_LE, 2, 48000, frames));
+    ASSERT_EQ(0, converter.setup(SND_PCM_FORMAT_S16_LE, 2, 48000, SND_PCM_FORMAT_S32_LE, 2, 44100, frames));
+    drift.setup(44100);
+    vector<int16_t> capture(frames * 2, 1000);
+    vector<int16_t> mixed(frames * 2, 0);
+    vector<int32_t> playback((converter.getMaxOutputFrames() + 1) * 2);
+    gain.setTarget(-200, RAMP_GENIVI_LINEAR, 100);
+
+    /* same order of calls as the proxy worker per period */
+    gAllocations = 0;
+    gCountAllocations = true;
+    for (int p = 0; p < 200; ++p)
+    {
+        crossfade.advance(frames);
+        gain.apply(capture.data(), frames);
+        crossfade.apply(HS_SINKA, capture.data(), frames);
+        level.analyze(capture.data(), frames);
+        CAmRoutingAdapterALSAGain::mix(mixed.data(), capture.data(), mixed.size());
+        size_t out = converter.process(mixed.data(), frames, playback.data());
+        drift.update(2 * frames, out);
+        stats.add(RA_STATS_READ, p);
+        stats.setDelay(out);
+    }
+    gCountAllocations = false;
+    ASSERT_EQ(0u, gAllocations.load());
+}
+
+TEST(testRealTime, noAllocationInProxyThreads)
+{
+    /* own thread with conversion, drift compensation and software volume */
+    ra_Proxy_s config = getNullProxy(false);
+    config.sinkRate = 44100;
+    config.softVolume = true;
+    config.driftCompensation = true;
+    CAmTestProxy converting(config);
+    /* own thread forwarding between the ring buffers, if the PCMs provide mmap */
+    ra_Proxy_s mmapConfig = getNullProxy(true);
+    CAmTestProxy direct(mmapConfig);
+    /* serviced by an engine */
+    CAmRoutingAdapterALSAEngine engine("raa_engine", -1);
+    ra_Proxy_s engineConfig = getNullProxy(false);
+    CAmTestProxy serviced(engineConfig);
+    serviced.setEngine(&engine);
+
+    vector<CAmTestProxy*> proxies = {&converting, &direct, &serviced};
+    for (CAmTestProxy *pProxy : proxies)
+    {
+        ASSERT_EQ(E_OK, pProxy->openStreaming());
+        ASSERT_EQ(E_OK, pProxy->prepareStreaming());
+        ASSERT_EQ(E_OK, pProxy->startStreaming());
+    }
+    ASSERT_EQ(E_OK, converting.setVolume(-100, RAMP_GENIVI_LINEAR, 50));
+
+    /* streaming, recovery of timed out PCMs and prefill */
+    for (ra_threadAllocations_s & thread : gThreadAllocations)
+    {
+        thread.count = 0;
+    }
+    gCountedThreads = 0;
+    gCountThreads = true;
+    usleep(50000);
+    gTimeout = true;
+    usleep(50000);
+    gTimeout = false;
+    usleep(50000);
+    gCountThreads = false;
+
+    for (CAmTestProxy *pProxy : proxies)
+    {
+        pProxy->stopStreaming();
+        pProxy->closeStreaming();
+        ASSERT_GT(pProxy->getPeriods(), 0u);
+        ASSERT_GT(pProxy->getRecoveries(), 0u);
+    }
+    string stats;
+    ASSERT_EQ(E_OK, converting.getStatistics(stats));
+    ASSERT_NE(string::npos, stats.find("drift[ppm] ")) << stats;
+    ASSERT_EQ(E_OK, direct.getStatistics(stats));
+    ASSERT_EQ(string::npos, stats.find("drift[ppm] ")) << stats;
+    uint32_t threads = min<uint32_t>(gCountedThreads, MAX_COUNTED_THREADS);
+    for (uint32_t i = 0; i < threads; ++i)
+    {
+        EXPECT_EQ(0u, gThreadAllocations[i].count.load()) << "allocations by thread " << gThreadAllocations[i].name;
+    }
+}
+
 } /* namespace am */
 
 int main(int argc, char **argv)